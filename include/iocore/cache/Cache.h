@@ -44,8 +44,18 @@ static constexpr ts::ModuleVersion CACHE_MODULE_VERSION(1, 0);
 #define CACHE_COMPRESSION_FASTLZ  1
 #define CACHE_COMPRESSION_LIBZ    2
 #define CACHE_COMPRESSION_LIBLZMA 3
-
-enum { RAM_HIT_COMPRESS_NONE = 1, RAM_HIT_COMPRESS_FASTLZ, RAM_HIT_COMPRESS_LIBZ, RAM_HIT_COMPRESS_LIBLZMA, RAM_HIT_LAST_ENTRY };
+#define CACHE_COMPRESSION_ZSTD    4
+#define CACHE_COMPRESSION_LZ4     5
+
+enum {
+  RAM_HIT_COMPRESS_NONE = 1,
+  RAM_HIT_COMPRESS_FASTLZ,
+  RAM_HIT_COMPRESS_LIBZ,
+  RAM_HIT_COMPRESS_LIBLZMA,
+  RAM_HIT_COMPRESS_ZSTD,
+  RAM_HIT_COMPRESS_LZ4,
+  RAM_HIT_LAST_ENTRY
+};
 
 struct CacheVC;
 class CacheEvacuateDocVC;
@@ -203,6 +213,16 @@ struct CacheVConnection : public VConnection {
     return nullptr;
   }
 
+  /** Hand the data of fragments read from disk to the reader as file ranges rather than memory.
+      The reader's buffer must then only be written to a VConnection that supports sendfile.
+      @return @c true if the VC will, @c false if it keeps filling the buffer from memory.
+  */
+  virtual bool
+  enable_sendfile()
+  {
+    return false;
+  }
+
   /** Test if the VC can support pread.
       @return @c true if @c do_io_pread will work, @c false if not.
   */
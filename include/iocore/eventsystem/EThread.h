@@ -25,6 +25,7 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 
 #include "tscore/ink_platform.h"
 #include "tscore/ink_rand.h"
@@ -32,6 +33,8 @@
 #include "iocore/eventsystem/Thread.h"
 #include "iocore/eventsystem/PriorityEventQueue.h"
 #include "iocore/eventsystem/ProtectedQueue.h"
+#include "iocore/eventsystem/WorkStealingDeque.h"
+#include "iocore/eventsystem/LoopProfiler.h"
 #include "tsutil/Histogram.h"
 #include "iocore/eventsystem/Watchdog.h"
 
@@ -303,6 +306,9 @@ public:
   // Set the tail handler.
   void set_tail_handler(LoopTailHandler *handler);
 
+  /// Wake the thread if it is waiting for activity. Does nothing if it is busy or already being woken.
+  void wake();
+
   void set_specific() override;
 
   /* private */
@@ -323,6 +329,8 @@ public:
   ~EThread() override;
 
   Event *schedule(Event *e);
+  /// Queue the stealable immediate event @a e for this thread from any thread, see @c WorkStealing.
+  void enqueue_stealable(Event *e);
 
   /** Block of memory to allocate thread specific data e.g. stat system arrays. */
   char thread_private[PER_THREAD_DATA];
@@ -336,6 +344,8 @@ public:
 #if TS_USE_HWLOC
   hwloc_obj_t hwloc_obj = nullptr;
 #endif
+  /// The NUMA node the thread runs on, by logical index, or -1 if not in NUMA mode.
+  int numa_node = -1;
 
   unsigned int event_types = 0;
 
@@ -348,6 +358,8 @@ public:
   void             execute_regular();
   ink_hrtime       process_queue(Que(Event, link) * NegativeQueue, int *ev_count, int *nq_count, ink_hrtime event_time);
   ink_hrtime       process_event(Event *e, int calling_code, ink_hrtime event_time);
+  ink_hrtime       process_stealable(int *ev_count, ink_hrtime event_time);
+  int              steal_work();
   void             free_event(Event *e);
   LoopTailHandler *tail_cb = &DEFAULT_TAIL_HANDLER;
 
@@ -390,12 +402,7 @@ public:
     void
     signalActivity() override
     {
-      /* Try to acquire the `EThread::lock` of the Event Thread:
-       *   - Acquired, indicating that the Event Thread is sleep,
-       *               must send a wakeup signal to the Event Thread.
-       *   - Failed, indicating that the Event Thread is busy, do nothing.
-       */
-      (void)_q.try_signal();
+      _q.signal();
     }
 
     ProtectedQueue &_q;
@@ -580,6 +587,31 @@ public:
 
   Watchdog::Heartbeat heartbeat_state;
 
+  /** Work stealing state, for threads of a group that allows it.
+
+      Stealable immediate events (@see Event::stealable) are queued from other threads on @a inbox
+      rather than on the external queue. The thread moves them from there, and from its external
+      queue, to @a deque rather than dispatching them at once. It runs them from the bottom while
+      idle threads of the same group steal them from the top. An idle thread also empties the inbox
+      of a sibling that is busy with a long running event, which has not moved them yet.
+   */
+  struct WorkStealing {
+    static constexpr size_t DEQUE_SIZE = 1024;
+
+    WorkStealing();
+
+    InkAtomicList                        inbox; ///< Stealable events queued by other threads, newest first.
+    WorkStealingDeque<Event, DEQUE_SIZE> deque;
+    EventType                            type = 0;     ///< The group the thread steals within.
+    std::atomic<uint64_t>                attempts{0};  ///< # of times the thread went looking for work.
+    std::atomic<uint64_t>                stolen{0};    ///< # of events taken from other threads.
+    std::atomic<size_t>                  depth_max{0}; ///< Deepest the deque got since the last stats sync.
+  };
+  std::unique_ptr<WorkStealing> work_stealing;
+
+  /// Handler time profile, for regular threads. Samples only while @c LoopProfiler::sample_period is set.
+  std::unique_ptr<LoopProfiler> profiler;
+
 private:
   void cons_common();
 };
@@ -720,6 +752,14 @@ this_event_thread()
   }
 }
 
+inline void
+EThread::wake()
+{
+  if (EventQueueExternal.claim_wakeup()) {
+    tail_cb->signalActivity();
+  }
+}
+
 inline void
 EThread::free_event(Event *e)
 {
@@ -25,6 +25,7 @@
 #pragma once
 
 #include "iocore/eventsystem/Action.h"
+#include "iocore/eventsystem/TimingWheel.h"
 
 //
 //  Defines
@@ -212,12 +213,15 @@ public:
   unsigned int in_the_priority_queue : 1;
   unsigned int immediate             : 1;
   unsigned int globally_allocated    : 1;
-  unsigned int in_heap               : 4;
+  unsigned int stealable             : 1; ///< Any thread of the group may run this, see @c EThread::WorkStealing.
   int          callback_event = 0;
 
   ink_hrtime timeout_at = 0;
   ink_hrtime period     = 0;
 
+  /// Where the event is in its thread's @c PriorityEventQueue.
+  TimingWheelEntry wheel_entry;
+
   /**
     This field can be set when an event is created. It is returned
     as part of the Event structure to the continuation when handleEvent
@@ -228,7 +232,14 @@ public:
 
   // Private
 
-  Event() : in_the_prot_queue(false), in_the_priority_queue(false), immediate(false), globally_allocated(true), in_heap(false) {}
+  Event()
+    : in_the_prot_queue(false),
+      in_the_priority_queue(false),
+      immediate(false),
+      globally_allocated(true),
+      stealable(false)
+  {
+  }
 
   Event *
   init(Continuation *c, ink_hrtime atimeout_at = 0, ink_hrtime aperiod = 0)
@@ -237,6 +248,7 @@ public:
     timeout_at   = atimeout_at;
     period       = aperiod;
     immediate    = !period && !atimeout_at;
+    stealable    = false;
     cancelled    = false;
     return this;
   }
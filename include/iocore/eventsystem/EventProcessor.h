@@ -297,6 +297,10 @@ public:
     Que(Event, link) _spawnQueue;                                 ///< Events to dispatch when thread is spawned.
     EThread              *_thread[MAX_THREADS_IN_EACH_TYPE] = {}; ///< The actual threads in this group.
     std::function<void()> _afterStartCallback               = nullptr;
+    /// Events scheduled for the group may run on any of its threads, which steal from each other
+    /// when idle. Only for groups whose continuations do not depend on a thread. Must be set before
+    /// the threads are spawned.
+    bool _work_stealing = false;
   };
 
   /// Storage for per group data.
@@ -313,6 +317,10 @@ public:
   */
   int n_ethreads = 0;
 
+  /// The number of NUMA nodes the ET_NET threads are spread over, 0 if not in NUMA mode.
+  /// @see EThread::numa_node
+  int numa_nodes = 0;
+
   bool has_tg_started(int etype);
 
   /*------------------------------------------------------*\
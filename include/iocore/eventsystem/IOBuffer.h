@@ -44,6 +44,8 @@
 #include "tscore/ink_assert.h"
 #include "tscore/ink_resource.h"
 
+#include <sys/types.h>
+
 struct MIOBufferAccessor;
 
 class MIOBuffer;
@@ -54,6 +56,8 @@ enum AllocType {
   NO_ALLOC,
   MEMALIGNED,
   DEFAULT_ALLOC,
+  REGISTERED,
+  FILE_RANGE,
 };
 
 #define DEFAULT_BUFFER_NUMBER               128
@@ -127,6 +131,23 @@ void init_buffer_allocators(int iobuffer_advice);
 
 bool parse_buffer_chunk_sizes(const char *s, int chunk_sizes[DEFAULT_BUFFER_SIZES]);
 
+/**
+  Set aside @a count buffers of size class @a size_index in one page aligned region.
+
+  Buffers allocated as REGISTERED come from the region, which disk I/O can
+  register with the kernel once instead of mapping every buffer on every
+  operation. May be called only once.
+*/
+void init_registered_buffers(int64_t size_index, int64_t count);
+
+/**
+  The registered buffer region.
+
+  @param size Set to the size of the region in bytes.
+  @return The start of the region, or @c nullptr if there is none.
+*/
+char *registered_buffer_region(int64_t *size);
+
 /**
   A reference counted wrapper around fast allocated or malloced memory.
   The IOBufferData class provides two basic services around a portion
@@ -154,6 +175,11 @@ bool parse_buffer_chunk_sizes(const char *s, int chunk_sizes[DEFAULT_BUFFER_SIZE
       <td>DEFAULT_ALLOC</td>
       <td></td>
     </tr>
+    <tr>
+      <td>REGISTERED</td>
+      <td>From the registered buffer region, see init_registered_buffers().
+      MEMALIGNED if the size class has no region or it is used up.</td>
+    </tr>
   </table>
 
  */
@@ -253,6 +279,53 @@ public:
 
 extern ClassAllocator<IOBufferData, false> ioDataAllocator;
 
+/**
+  IOBufferData standing for a range of a file rather than memory.
+
+  The bytes stay in the file until a socket write hands the range to the kernel with sendfile(2),
+  so they never pass through user space. Everything else may only size, consume and clone the
+  blocks on top of it: '_data' points into a reserved region without access, so code reading the
+  bytes faults instead of sending garbage. Such blocks may only be written to a VConnection whose
+  @c supports_sendfile() is @c true.
+*/
+class IOBufferFileRange : public IOBufferData
+{
+public:
+  /// The longest range, the size of the reserved region.
+  static constexpr int64_t MAX_LEN = 16 * 1024 * 1024;
+
+  IOBufferFileRange(int fd, off_t offset, int64_t len);
+
+  int
+  fd() const
+  {
+    return _fd;
+  }
+
+  /// The offset in the file of @a p, a pointer into the range.
+  off_t
+  file_offset(const char *p) const
+  {
+    return _offset + (p - _data);
+  }
+
+  /**
+    Whether the file still holds the bytes of the range. Checked after they were sent, since the
+    owner of the file may reuse the space at any time.
+  */
+  virtual bool
+  still_valid() const
+  {
+    return true;
+  }
+
+  void free() override;
+
+private:
+  int   _fd;
+  off_t _offset;
+};
+
 /**
   A linkable portion of IOBufferData. IOBufferBlock is a chainable
   buffer block descriptor. The IOBufferBlock represents both the used
@@ -412,6 +485,16 @@ public:
   */
   IOBufferBlock *clone() const;
 
+  /**
+    The file range this block stands for, @c nullptr if its data is in memory.
+
+  */
+  IOBufferFileRange *
+  file_range() const
+  {
+    return data && data->_mem_type == FILE_RANGE ? static_cast<IOBufferFileRange *>(data.get()) : nullptr;
+  }
+
   /**
     Clear the IOBufferData this IOBufferBlock handles. Clears this
     IOBufferBlock's reference to the data buffer (IOBufferData). You can
@@ -0,0 +1,177 @@
+/** @file
+
+  Sampling profiler for event loop handlers.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "tscore/ink_hrtime.h"
+#include "iocore/eventsystem/Continuation.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+  Attributes the time an event thread spends in continuation handlers to the handlers.
+
+  One event in every @c sample_period is timed, and the time is charged to the code the handler
+  of the continuation points at. For a plugin continuation that is the plugin's event function
+  rather than the API dispatcher, see @c set_dispatcher. The sites taking the most time are kept
+  in a small table by the Space-Saving algorithm (Metwally et al., ICDT 2005): when a new site
+  turns up and the table is full it takes over the entry with the least time, keeping that time as
+  its error, so the busiest handlers stay in the table however many there are.
+
+  The table is written only by its thread. Each entry has a sequence count that is odd while the
+  entry is being written, so other threads read it without a lock and retry if it changed.
+ */
+class LoopProfiler
+{
+public:
+  static constexpr size_t TABLE_SIZE = 32;
+  /// How many events to let by between checks for the profiler being turned on.
+  static constexpr int IDLE_CHECK = 1024;
+
+  /// What a handler site has cost so far.
+  struct Site {
+    uintptr_t  site    = 0;
+    uint64_t   samples = 0;
+    ink_hrtime total   = 0;
+    ink_hrtime max     = 0;
+    ink_hrtime error   = 0; ///< Up to this much of @a total was taken by sites this one replaced.
+  };
+
+  /// Map a continuation, known to be dispatched through a shared function, to the code it dispatches to.
+  using Resolver = uintptr_t (*)(Continuation *);
+
+  /// Sample one in this many events, 0 to turn the profiler off. Shared by all threads.
+  static inline std::atomic<int> sample_period{0};
+
+  /// @return @c true if the next event should be timed.
+  bool
+  sample()
+  {
+    if (--_countdown > 0) {
+      return false;
+    }
+    int period = sample_period.load(std::memory_order_relaxed);
+    _countdown = period > 0 ? period : IDLE_CHECK;
+    return period > 0;
+  }
+
+  /** The code @a c will run for an event.
+
+      This must be taken before the handler is called, as the continuation can be freed or change
+      its handler while it runs.
+   */
+  static uintptr_t site_of(Continuation *c);
+
+  /// Charge @a elapsed to @a site.
+  void record(uintptr_t site, ink_hrtime elapsed);
+
+  /// A consistent copy of each entry in use. May be called from any thread.
+  std::vector<Site> snapshot() const;
+
+  /// The time charged to all sites, including those that have since been dropped from the table.
+  ink_hrtime
+  total() const
+  {
+    return _total.load(std::memory_order_relaxed);
+  }
+
+  /** Resolve continuations whose handler is @a handler with @a resolver.
+
+      This is for a handler that calls on to other code, such as the one the plugin API uses for
+      every plugin continuation, which would otherwise take all their time as its own.
+   */
+  static void set_dispatcher(ContinuationHandler handler, Resolver resolver);
+
+  /// A readable name for @a site, @see ink_stack_trace_symbol.
+  static std::string describe(uintptr_t site);
+
+private:
+  /// A pointer to member function as laid out by the Itanium C++ ABI.
+  struct MemberFn {
+    uintptr_t ptr;
+    ptrdiff_t adj;
+  };
+  static_assert(sizeof(MemberFn) == sizeof(ContinuationHandler));
+
+  struct Entry {
+    std::atomic<uint32_t>   seq{0};
+    std::atomic<uintptr_t>  site{0};
+    std::atomic<uint64_t>   samples{0};
+    std::atomic<ink_hrtime> total{0};
+    std::atomic<ink_hrtime> max{0};
+    std::atomic<ink_hrtime> error{0};
+  };
+
+  static uintptr_t _decode(ContinuationHandler handler, Continuation *c);
+
+  int                     _countdown = 1;
+  size_t                  _used      = 0;
+  std::atomic<ink_hrtime> _total{0};
+  Entry                   _table[TABLE_SIZE];
+
+  static inline uintptr_t _dispatch_site     = 0;
+  static inline Resolver  _dispatch_resolver = nullptr;
+};
+
+inline uintptr_t
+LoopProfiler::_decode(ContinuationHandler handler, Continuation *c)
+{
+  MemberFn fn;
+  memcpy(&fn, &handler, sizeof(fn));
+  // A virtual function is marked by the low bit of the pointer, or of the adjustment on ARM where
+  // code addresses can be odd, and is an offset into the vtable.
+#if defined(__arm__) || defined(__aarch64__)
+  bool      is_virtual = fn.adj & 1;
+  ptrdiff_t adj        = fn.adj >> 1;
+  uintptr_t offset     = fn.ptr;
+#else
+  bool      is_virtual = fn.ptr & 1;
+  ptrdiff_t adj        = fn.adj;
+  uintptr_t offset     = fn.ptr - 1;
+#endif
+  if (!is_virtual) {
+    return fn.ptr;
+  }
+  if (c == nullptr) {
+    return 0;
+  }
+  char const *vtable = *reinterpret_cast<char const *const *>(reinterpret_cast<char const *>(c) + adj);
+  return *reinterpret_cast<uintptr_t const *>(vtable + offset);
+}
+
+inline uintptr_t
+LoopProfiler::site_of(Continuation *c)
+{
+  uintptr_t site = _decode(c->handler, c);
+  if (site == _dispatch_site && _dispatch_resolver) {
+    if (uintptr_t target = _dispatch_resolver(c); target) {
+      site = target;
+    }
+  }
+  return site;
+}
@@ -1,6 +1,6 @@
 /** @file
 
-  Queue of Events sorted by the "at_timeout" field
+  Queue of Events sorted by the "timeout_at" field
 
   @section license License
 
@@ -25,64 +25,34 @@
 
 #include "tscore/ink_platform.h"
 #include "iocore/eventsystem/Event.h"
-
-// <5ms, 10, 20, 40, 80, 160, 320, 640, 1280, 2560, 5120
-#define N_PQ_LIST          10
-#define PQ_BUCKET_TIME(_i) (HRTIME_MSECONDS(5) << (_i))
+#include "iocore/eventsystem/TimingWheel.h"
 
 class EThread;
 
+/**
+  The timed events of a thread, on a @c TimingWheel.
+
+  Scheduling, rescheduling and taking the expired events are constant time however many events
+  are waiting. Cancelled events are freed as they come off the wheel or, for events far out, by
+  a sweep of the wheel that frees each one within about @c REAP_PERIOD of its cancellation.
+ */
 struct PriorityEventQueue {
-  Que(Event, link) after[N_PQ_LIST];
-  ink_hrtime last_check_time;
-  uint32_t   last_check_buckets;
+  /// The length of a tick, which is how late an event can be run.
+  static constexpr ink_hrtime RESOLUTION = HRTIME_MSECOND;
+  /// How long it takes to sweep the whole wheel for cancelled events.
+  static constexpr ink_hrtime REAP_PERIOD = HRTIME_SECONDS(2);
+
+  using Wheel = TimingWheel<Event, &Event::wheel_entry>;
+
+  Wheel      wheel;
+  ink_hrtime last_reap_time;
 
   void
   enqueue(Event *e, ink_hrtime now)
   {
-    ink_hrtime t = e->timeout_at - now;
-    int        i = 0;
-    // equivalent but faster
-    if (t <= PQ_BUCKET_TIME(3)) {
-      if (t <= PQ_BUCKET_TIME(1)) {
-        if (t <= PQ_BUCKET_TIME(0)) {
-          i = 0;
-        } else {
-          i = 1;
-        }
-      } else {
-        if (t <= PQ_BUCKET_TIME(2)) {
-          i = 2;
-        } else {
-          i = 3;
-        }
-      }
-    } else {
-      if (t <= PQ_BUCKET_TIME(7)) {
-        if (t <= PQ_BUCKET_TIME(5)) {
-          if (t <= PQ_BUCKET_TIME(4)) {
-            i = 4;
-          } else {
-            i = 5;
-          }
-        } else {
-          if (t <= PQ_BUCKET_TIME(6)) {
-            i = 6;
-          } else {
-            i = 7;
-          }
-        }
-      } else {
-        if (t <= PQ_BUCKET_TIME(8)) {
-          i = 8;
-        } else {
-          i = 9;
-        }
-      }
-    }
+    (void)now;
     e->in_the_priority_queue = 1;
-    e->in_heap               = i;
-    after[i].enqueue(e);
+    wheel.schedule(e, e->timeout_at);
   }
 
   void
@@ -90,14 +60,14 @@ struct PriorityEventQueue {
   {
     ink_assert(e->in_the_priority_queue);
     e->in_the_priority_queue = 0;
-    after[e->in_heap].remove(e);
+    wheel.cancel(e);
   }
 
   Event *
   dequeue_ready(ink_hrtime t)
   {
     (void)t;
-    Event *e = after[0].dequeue();
+    Event *e = wheel.pop_expired();
     if (e) {
       ink_assert(e->in_the_priority_queue);
       e->in_the_priority_queue = 0;
@@ -110,12 +80,7 @@ struct PriorityEventQueue {
   ink_hrtime
   earliest_timeout()
   {
-    for (int i = 0; i < N_PQ_LIST; i++) {
-      if (after[i].head) {
-        return last_check_time + (PQ_BUCKET_TIME(i) / 2);
-      }
-    }
-    return last_check_time + HRTIME_FOREVER;
+    return wheel.next_expiry();
   }
 
   PriorityEventQueue();
@@ -24,11 +24,12 @@
 /****************************************************************************
 
   Protected Queue, a FIFO queue with the following functionality:
-  (1). Multiple threads could be simultaneously trying to enqueue
-       and dequeue. Hence the queue needs to be protected with mutex.
-  (2). In case the queue is empty, dequeue() sleeps for a specified
-       amount of time, or until a new element is inserted, whichever
-       is earlier
+  (1). Multiple threads could be simultaneously trying to enqueue,
+       only the owning thread dequeues. Both are lock free.
+  (2). In case the queue is empty, the owning thread sleeps for a
+       specified amount of time, or until a new element is inserted,
+       whichever is earlier. Only an insertion that finds it asleep
+       wakes it, so a busy thread is never signalled.
 
 
  ****************************************************************************/
@@ -36,19 +37,39 @@
 
 #include "tscore/ink_platform.h"
 #include "iocore/eventsystem/Event.h"
+
+#include <atomic>
+
 struct ProtectedQueue {
   void   enqueue(Event *e);
-  void   signal();
-  int    try_signal();            // Use non blocking lock and if acquired, signal
+  void   signal();                // Wake the owning thread if it is in @c wait.
   void   enqueue_local(Event *e); // Safe when called from the same thread
   Event *dequeue_local();
   void   dequeue_external();       // Dequeue any external events.
   void   wait(ink_hrtime timeout); // Wait for @a timeout nanoseconds on a condition variable if there are no events.
 
+  /** The owning thread is about to wait for activity.
+
+      From here until @c finish_sleep a thread that queues an event wakes the owner, through
+      whatever it waits on.
+
+      @return @c false if there are external events already, so the owner should not block.
+   */
+  bool prepare_sleep();
+  /// The owning thread is done waiting.
+  void finish_sleep();
+  /** Claim the wakeup of a sleeping owner.
+
+      Only the first of any number of threads that queue work for a sleeping owner gets @c true,
+      the rest need not signal.
+   */
+  bool claim_wakeup();
+
   InkAtomicList al;
   ink_mutex     lock;
   ink_cond      might_have_data;
   Que(Event, link) localQueue;
+  std::atomic<bool> sleeping{false}; ///< The owning thread is waiting for activity, or about to.
 
   ProtectedQueue();
 };
@@ -64,26 +85,38 @@ inline ProtectedQueue::ProtectedQueue()
 inline void
 ProtectedQueue::signal()
 {
-  // Need to get the lock before you can signal the thread
+  // Wait for the owner to be in the condition wait, or to have given up on it.
   ink_mutex_acquire(&lock);
   ink_cond_signal(&might_have_data);
   ink_mutex_release(&lock);
 }
 
-inline int
-ProtectedQueue::try_signal()
+inline bool
+ProtectedQueue::prepare_sleep()
 {
-  // Need to get the lock before you can signal the thread
-  if (ink_mutex_try_acquire(&lock)) {
-    ink_cond_signal(&might_have_data);
-    ink_mutex_release(&lock);
-    return 1;
-  } else {
-    return 0;
+  sleeping.store(true, std::memory_order_seq_cst);
+  // Pairs with the barrier of the push in @c enqueue, one of the two sees the other.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!INK_ATOMICLIST_EMPTY(al)) {
+    sleeping.store(false, std::memory_order_relaxed);
+    return false;
   }
+  return true;
+}
+
+inline void
+ProtectedQueue::finish_sleep()
+{
+  sleeping.store(false, std::memory_order_relaxed);
+}
+
+inline bool
+ProtectedQueue::claim_wakeup()
+{
+  // Read first, so threads queueing for a busy owner do not contend on the cache line.
+  return sleeping.load(std::memory_order_seq_cst) && sleeping.exchange(false, std::memory_order_seq_cst);
 }
 
-// Called from the same thread (don't need to signal)
 inline void
 ProtectedQueue::enqueue_local(Event *e)
 {
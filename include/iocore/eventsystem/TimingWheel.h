@@ -0,0 +1,344 @@
+/** @file
+
+  A hierarchical timing wheel.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "tscore/ink_assert.h"
+#include "tscore/ink_hrtime.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/// Where an item is in a @c TimingWheel. Embedded in the item.
+struct TimingWheelEntry {
+  uint64_t tick = 0; ///< The tick the item expires at.
+  uint16_t list = 0; ///< The list holding the item, 1 based, 0 if not scheduled.
+};
+
+/**
+  A hierarchical timing wheel, after Varghese and Lauck, "Hashed and Hierarchical Timing Wheels"
+  (SOSP 1987).
+
+  Time is counted in ticks of a fixed resolution. There are @c LEVELS wheels of @c SLOTS slots,
+  each slot of a level spanning a whole turn of the level below. An item goes on the lowest level
+  where its tick and the current tick differ, in the slot given by its tick there. When the
+  current tick reaches a slot of a higher level the items in it are cascaded to the levels below,
+  and when it reaches a slot of the lowest level the items in it have expired. Items further out
+  than the top level can reach wait on an overflow list that is cascaded when the top level turns.
+
+  Scheduling and cancelling are constant time, and advancing costs a constant per tick plus one
+  cascade per level per item, however many items there are.
+
+  The wheel does not own its items and is not thread safe. It links items through their list
+  link, so an item must not be on another list using that link while it is scheduled.
+
+  @tparam T The item type.
+  @tparam E The @c TimingWheelEntry member of @a T.
+  @tparam L The link descriptor, as for @c Que.
+ */
+template <class T, TimingWheelEntry T::*E, class L = typename T::Link_link> class TimingWheel
+{
+public:
+  static constexpr int        LEVELS        = 4;
+  static constexpr int        SLOT_BITS     = 8;
+  static constexpr unsigned   SLOTS         = 1u << SLOT_BITS;
+  static constexpr uint64_t   SLOT_MASK     = SLOTS - 1;
+  static constexpr uint16_t   OVERFLOW_LIST = LEVELS * SLOTS;
+  static constexpr uint16_t   EXPIRED_LIST  = LEVELS * SLOTS + 1;
+  static constexpr size_t     N_LISTS       = LEVELS * SLOTS + 2;
+  static constexpr ink_hrtime NEVER         = std::numeric_limits<ink_hrtime>::max();
+
+  /**
+    @param resolution The length of a tick.
+    @param now The current time.
+   */
+  TimingWheel(ink_hrtime resolution, ink_hrtime now) : _resolution(resolution), _current(now / resolution) {}
+
+  /// Schedule @a item to expire at @a when. It must not be scheduled already.
+  void
+  schedule(T *item, ink_hrtime when)
+  {
+    ink_assert((item->*E).list == 0);
+    // Round up so an item never expires early.
+    (item->*E).tick = when > 0 ? (when + _resolution - 1) / _resolution : 0;
+    _place(item);
+    ++_count;
+  }
+
+  /// Take @a item off the wheel if it is scheduled.
+  void
+  cancel(T *item)
+  {
+    if ((item->*E).list != 0) {
+      _unlink(item);
+      --_count;
+    }
+  }
+
+  bool
+  scheduled(const T *item) const
+  {
+    return (item->*E).list != 0;
+  }
+
+  /// The time @a item is scheduled to expire at, rounded up to a tick.
+  ink_hrtime
+  expires_at(const T *item) const
+  {
+    return (item->*E).tick * _resolution;
+  }
+
+  /// Move the wheel forward to @a now. The items that expire on the way are queued for @c pop_expired.
+  void
+  advance(ink_hrtime now)
+  {
+    uint64_t target = now / _resolution;
+
+    while (_current < target) {
+      if (_count == 0) {
+        _current = target;
+        break;
+      }
+      // Expire the slots of the lowest level up to the target or the end of its turn.
+      uint64_t end = std::min(target, _current | SLOT_MASK);
+      for (unsigned s = _find(0, (_current & SLOT_MASK) + 1); s <= (end & SLOT_MASK); s = _find(0, s + 1)) {
+        _expire(s);
+      }
+      _current = end;
+      if (_current < target) {
+        // The lowest level turns, bring down what is due in its next turn.
+        ++_current;
+        _cascade();
+      }
+    }
+  }
+
+  /// Take the next expired item, oldest first. @return @c nullptr if there is none.
+  T *
+  pop_expired()
+  {
+    T *item = _lists[EXPIRED_LIST].head;
+    if (item) {
+      _unlink(item);
+      --_count;
+    }
+    return item;
+  }
+
+  /**
+    The earliest time @c advance might find something expired or due to cascade, which is no later
+    than the earliest expiry. @c NEVER if the wheel is empty.
+   */
+  ink_hrtime
+  next_expiry() const
+  {
+    if (_lists[EXPIRED_LIST].head) {
+      return _current * _resolution;
+    }
+    for (int level = 0; level < LEVELS; ++level) {
+      unsigned shift = SLOT_BITS * level;
+      unsigned s     = _find(level, ((_current >> shift) & SLOT_MASK) + 1);
+      if (s < SLOTS) {
+        uint64_t above = _current >> (shift + SLOT_BITS) << (shift + SLOT_BITS);
+        return (above | (static_cast<uint64_t>(s) << shift)) * _resolution;
+      }
+    }
+    if (_lists[OVERFLOW_LIST].head) {
+      return (((_current >> (SLOT_BITS * LEVELS)) + 1) << (SLOT_BITS * LEVELS)) * _resolution;
+    }
+    return NEVER;
+  }
+
+  /**
+    Go through the next @a nlists lists, taking round all of them in turn, and remove the items for
+    which @a dead returns @c true, passing each to @a dispose once it is off the wheel. This
+    reclaims items that were abandoned rather than cancelled, which would otherwise stay until they
+    expired.
+   */
+  template <typename D, typename F>
+  void
+  reap(size_t nlists, D &&dead, F &&dispose)
+  {
+    // The expired list is left out, it is drained anyway.
+    for (size_t n = 0; n < std::min(nlists, N_LISTS - 1); ++n) {
+      T *next = nullptr;
+      for (T *item = _lists[_reap_cursor].head; item; item = next) {
+        next = L::next_link(item);
+        if (dead(item)) {
+          _unlink(item);
+          --_count;
+          dispose(item);
+        }
+      }
+      _reap_cursor = (_reap_cursor + 1) % (N_LISTS - 1);
+    }
+  }
+
+  /// The number of items on the wheel, expired or not.
+  size_t
+  size() const
+  {
+    return _count;
+  }
+
+  ink_hrtime
+  resolution() const
+  {
+    return _resolution;
+  }
+
+private:
+  struct List {
+    T *head = nullptr;
+    T *tail = nullptr;
+  };
+
+  void
+  _push(uint16_t idx, T *item)
+  {
+    List &list         = _lists[idx];
+    L::prev_link(item) = list.tail;
+    L::next_link(item) = nullptr;
+    if (list.tail) {
+      L::next_link(list.tail) = item;
+    } else {
+      list.head = item;
+    }
+    list.tail       = item;
+    (item->*E).list = idx + 1;
+    if (idx < OVERFLOW_LIST) {
+      _occupied[idx / 64] |= uint64_t(1) << (idx % 64);
+    }
+  }
+
+  void
+  _unlink(T *item)
+  {
+    uint16_t idx  = (item->*E).list - 1;
+    List    &list = _lists[idx];
+    T       *prev = L::prev_link(item);
+    T       *next = L::next_link(item);
+
+    (prev ? L::next_link(prev) : list.head) = next;
+    (next ? L::prev_link(next) : list.tail) = prev;
+    L::next_link(item)                      = nullptr;
+    L::prev_link(item)                      = nullptr;
+    (item->*E).list                         = 0;
+    if (idx < OVERFLOW_LIST && list.head == nullptr) {
+      _occupied[idx / 64] &= ~(uint64_t(1) << (idx % 64));
+    }
+  }
+
+  /// Take list @a idx off the wheel. @return Its first item.
+  T *
+  _detach(uint16_t idx)
+  {
+    T *item     = _lists[idx].head;
+    _lists[idx] = List{};
+    if (idx < OVERFLOW_LIST) {
+      _occupied[idx / 64] &= ~(uint64_t(1) << (idx % 64));
+    }
+    return item;
+  }
+
+  /// Put @a item on the list for its tick relative to the current tick.
+  void
+  _place(T *item)
+  {
+    uint64_t tick = (item->*E).tick;
+    if (tick <= _current) {
+      _push(EXPIRED_LIST, item);
+      return;
+    }
+    int level = (63 - __builtin_clzll(tick ^ _current)) / SLOT_BITS;
+    if (level >= LEVELS) {
+      _push(OVERFLOW_LIST, item);
+    } else {
+      _push(level * SLOTS + ((tick >> (SLOT_BITS * level)) & SLOT_MASK), item);
+    }
+  }
+
+  /// Place the items of list @a idx again, relative to the current tick.
+  void
+  _replace(uint16_t idx)
+  {
+    T *next = nullptr;
+    for (T *item = _detach(idx); item; item = next) {
+      next            = L::next_link(item);
+      (item->*E).list = 0;
+      _place(item);
+    }
+  }
+
+  /// Move the items in slot @a s of the lowest level, which have all reached their tick, to the expired list.
+  void
+  _expire(unsigned s)
+  {
+    T *next = nullptr;
+    for (T *item = _detach(s); item; item = next) {
+      next = L::next_link(item);
+      _push(EXPIRED_LIST, item);
+    }
+  }
+
+  /// The current tick starts a turn of the lowest level, cascade each level whose slot it reaches.
+  void
+  _cascade()
+  {
+    int top = 0;
+    while (top < LEVELS && (_current & ((uint64_t(1) << (SLOT_BITS * (top + 1))) - 1)) == 0) {
+      ++top;
+    }
+    if (top == LEVELS) {
+      _replace(OVERFLOW_LIST);
+      top = LEVELS - 1;
+    }
+    for (int level = top; level > 0; --level) {
+      _replace(level * SLOTS + ((_current >> (SLOT_BITS * level)) & SLOT_MASK));
+    }
+  }
+
+  /// The first occupied slot of @a level at or after @a from, @c SLOTS if none.
+  unsigned
+  _find(int level, unsigned from) const
+  {
+    while (from < SLOTS) {
+      unsigned idx  = level * SLOTS + from;
+      uint64_t bits = _occupied[idx / 64] >> (idx % 64);
+      if (bits) {
+        return std::min<unsigned>(from + __builtin_ctzll(bits), SLOTS);
+      }
+      from = (from | 63) + 1;
+    }
+    return SLOTS;
+  }
+
+  ink_hrtime _resolution;
+  uint64_t   _current; ///< The tick the wheel has been advanced to.
+  size_t     _count                         = 0;
+  uint16_t   _reap_cursor                   = 0;
+  uint64_t   _occupied[LEVELS * SLOTS / 64] = {}; ///< Which slot lists are not empty.
+  List       _lists[N_LISTS];
+};
@@ -36,6 +36,8 @@
 
 #include <atomic>
 #include <chrono>
+#include <mutex>
+#include <string>
 #include <vector>
 #include <thread>
 
@@ -52,6 +54,43 @@ struct Heartbeat {
   std::atomic<uint64_t> warned_seq{0};             // last seq we logged a warning about
 };
 
+/// A stack sample of an event thread that has been awake too long.
+struct Stall {
+  std::chrono::system_clock::time_point when;
+  std::string                           thread;
+  std::chrono::milliseconds             awake{0};
+  uint64_t                              seq = 0; ///< The loop iteration, the same for each sample of one stall.
+  std::vector<void const *>             frames;
+};
+
+/** The most recent stalls, for @c get_thread_stalls.
+
+    The oldest stall is dropped to make room for a new one. Nothing is kept while the capacity is 0,
+    which is also when the watchdog does not take stack samples.
+ */
+class StallLog
+{
+public:
+  void   set_capacity(size_t n);
+  size_t capacity() const;
+
+  void add(Stall &&stall);
+
+  /// The stalls kept, oldest first.
+  std::vector<Stall> stalls() const;
+  /// The number of stalls ever added.
+  uint64_t total() const;
+
+private:
+  mutable std::mutex _mutex;
+  std::vector<Stall> _ring;
+  size_t             _capacity = 0;
+  size_t             _next     = 0; ///< Where the next stall goes once the ring is full.
+  uint64_t           _total    = 0;
+};
+
+StallLog &stall_log();
+
 class Monitor
 {
 public:
@@ -65,6 +104,8 @@ private:
   const std::chrono::milliseconds _timeout;
   std::atomic<bool>               _shutdown = false;
   void                            monitor_loop() const;
+  void                            sample_stall(EThread *t, size_t idx, uint64_t seq, std::chrono::milliseconds awake,
+                                               bool first) const;
 };
 
 } // namespace Watchdog
@@ -0,0 +1,123 @@
+/** @file
+
+  A bounded lock-free work stealing deque.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+  The Chase-Lev deque, as given for the C11 memory model by Lê et al., "Correct and Efficient
+  Work-Stealing for Weak Memory Models" (PPoPP 2013), with a fixed capacity.
+
+  One thread, the owner, pushes and pops at the bottom. Any thread may steal from the top. The
+  deque holds pointers it does not own.
+
+  @tparam T The type of the elements pointed to.
+  @tparam N The capacity, a power of two.
+ */
+template <typename T, size_t N> class WorkStealingDeque
+{
+  static_assert(N > 0 && (N & (N - 1)) == 0, "WorkStealingDeque capacity must be a power of two");
+
+public:
+  static constexpr size_t CAPACITY = N;
+
+  /// Add @a item at the bottom. Owner only. @return @c false if the deque is full.
+  bool
+  push(T *item)
+  {
+    int64_t b = _bottom.load(std::memory_order_relaxed);
+    int64_t t = _top.load(std::memory_order_acquire);
+    if (b - t >= static_cast<int64_t>(N)) {
+      return false;
+    }
+    _slots[b & MASK].store(item, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(b + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /// Take the item at the bottom, the last pushed. Owner only. @return @c nullptr if empty.
+  T *
+  pop()
+  {
+    int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+    _bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t    = _top.load(std::memory_order_relaxed);
+    T      *item = nullptr;
+    if (t <= b) {
+      item = _slots[b & MASK].load(std::memory_order_relaxed);
+      if (t == b) {
+        // The last item, race the thieves for it.
+        if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+          item = nullptr;
+        }
+        _bottom.store(b + 1, std::memory_order_relaxed);
+      }
+    } else {
+      _bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  /// Take the item at the top, the first pushed. Any thread. @return @c nullptr if empty or lost to another thread.
+  T *
+  steal()
+  {
+    int64_t t = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = _bottom.load(std::memory_order_acquire);
+    if (t < b) {
+      T *item = _slots[t & MASK].load(std::memory_order_relaxed);
+      if (_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return item;
+      }
+    }
+    return nullptr;
+  }
+
+  /// An estimate of the number of items, exact only for the owner while nobody steals.
+  size_t
+  size() const
+  {
+    int64_t n = _bottom.load(std::memory_order_relaxed) - _top.load(std::memory_order_relaxed);
+    return n > 0 ? n : 0;
+  }
+
+  bool
+  empty() const
+  {
+    return size() == 0;
+  }
+
+private:
+  static constexpr int64_t MASK = N - 1;
+
+  alignas(64) std::atomic<int64_t> _top{0};
+  alignas(64) std::atomic<int64_t> _bottom{0};
+  std::array<std::atomic<T *>, N> _slots{};
+};
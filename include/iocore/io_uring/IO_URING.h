@@ -74,6 +74,39 @@ public:
 
   int register_eventfd();
 
+  /** Register a region of memory for fixed buffer reads and writes.
+
+      The kernel pins the region once, so operations on it skip mapping their
+      buffer. It is registered in pieces of at most 1 GiB, the kernel limit for
+      one buffer.
+
+      @return 0 on success, otherwise a negative errno.
+  */
+  int register_buffers(char *region, size_t size);
+
+  /** Set up a ring of provided buffers for buffer group @a bgid.
+
+      Receives that select a buffer from the group take the next one the
+      caller has added to the ring.
+
+      @return The ring, or @c nullptr if the kernel does not support it.
+  */
+  io_uring_buf_ring *setup_buf_ring(unsigned entries, int bgid);
+  void               free_buf_ring(io_uring_buf_ring *br, unsigned entries, int bgid);
+
+  /// The index of the registered buffer holding all of [buf, buf + len), or -1.
+  int
+  fixed_buffer_index(const void *buf, size_t len) const
+  {
+    auto *p = static_cast<const char *>(buf);
+    if (fixed_region == nullptr || p < fixed_region || p + len > fixed_region + fixed_size || len == 0) {
+      return -1;
+    }
+    size_t first = (p - fixed_region) / MAX_FIXED_BUFFER_SIZE;
+    size_t last  = (p + len - 1 - fixed_region) / MAX_FIXED_BUFFER_SIZE;
+    return first == last ? static_cast<int>(first) : -1;
+  }
+
   // assigns the global iouring config
   static void            set_config(const IOUringConfig &);
   static IOUringContext *local_context();
@@ -87,9 +120,13 @@ public:
   }
 
 private:
-  io_uring        ring  = {};
-  io_uring_probe *probe = nullptr;
-  int             evfd  = -1;
+  static constexpr size_t MAX_FIXED_BUFFER_SIZE = size_t{1} << 30;
+
+  io_uring        ring         = {};
+  io_uring_probe *probe        = nullptr;
+  int             evfd         = -1;
+  const char     *fixed_region = nullptr;
+  size_t          fixed_size   = 0;
 
   void                 handle_cqe(io_uring_cqe *);
   static IOUringConfig config;
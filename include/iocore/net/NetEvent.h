@@ -28,6 +28,7 @@
 #include "tscore/List.h"
 #include "iocore/eventsystem/VIO.h"
 #include "iocore/eventsystem/EventSystem.h"
+#include "iocore/eventsystem/TimingWheel.h"
 #include "iocore/net/EventIO.h"
 #include "iocore/net/ReadWriteEventIO.h"
 
@@ -78,6 +79,15 @@ public:
   bool has_error() const;
   void set_error_from_socket();
 
+  /// The socket reported an error condition, which is also how the kernel signals its error queue.
+  virtual void
+  error_queue_ready()
+  {
+  }
+
+  /// Tell the NetHandler a timeout may now be sooner, so the InactivityCop looks at this in time. Any thread.
+  void timeouts_changed();
+
   // get fd
   virtual int              get_fd()            = 0;
   virtual Ptr<ProxyMutex> &get_mutex()         = 0;
@@ -120,8 +130,13 @@ public:
   /** Whether the current timeout is a default inactivity timeout. */
   bool use_default_inactivity_timeout = false;
 
+  /// When the InactivityCop next looks at this, on @c NetHandler::cop_wheel.
+  TimingWheelEntry cop_entry;
+  int              in_cop_update_list = 0;
+
   LINK(NetEvent, open_link);
   LINK(NetEvent, cop_link);
+  SLINK(NetEvent, cop_update_link);
   LINKM(NetEvent, read, ready_link)
   SLINKM(NetEvent, read, enable_link)
   LINKM(NetEvent, write, ready_link)
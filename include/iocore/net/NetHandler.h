@@ -28,6 +28,10 @@
 #include "iocore/eventsystem/Continuation.h"
 #include "iocore/eventsystem/EThread.h"
 #include "iocore/net/NetEvent.h"
+#include "tsutil/Metrics.h"
+
+class NetUringBufferRing;
+struct NetNumaStats;
 
 //
 // NetHandler
@@ -101,7 +105,10 @@ public:
   QueM(NetEvent, NetState, read, ready_link) read_ready_list;
   QueM(NetEvent, NetState, write, ready_link) write_ready_list;
   Que(NetEvent, open_link) open_list;
-  DList(NetEvent, cop_link) cop_list;
+  /// The open NetEvents by when the InactivityCop next has to look at them.
+  TimingWheel<NetEvent, &NetEvent::cop_entry, NetEvent::Link_cop_link> cop_wheel{COP_RESOLUTION, ink_get_hrtime()};
+  /// NetEvents whose timeouts changed on another thread, for @c cop_wheel.
+  ASLL(NetEvent, cop_update_link) cop_update_list;
   ASLLM(NetEvent, NetState, read, enable_link) read_enable_list;
   ASLLM(NetEvent, NetState, write, enable_link) write_enable_list;
   Que(NetEvent, keep_alive_queue_link) keep_alive_queue;
@@ -155,6 +162,22 @@ public:
   /// updated. Event type threads that use @c NetHandler must set the
   /// corresponding bit.
   static std::bitset<std::numeric_limits<unsigned int>::digits> active_thread_types;
+  /// Whether accepted TCP connections do their socket I/O through the thread's io_uring.
+  static bool uring_data_path;
+  /// Provided buffers for this thread's io_uring receives, @c nullptr if not in use.
+  NetUringBufferRing *uring_buffers = nullptr;
+  /// Traffic counters of this thread's NUMA node, @c nullptr if not in NUMA mode.
+  NetNumaStats *numa_stats = nullptr;
+  /// Connections accepted for this thread. Accept threads add to it too.
+  std::atomic<uint64_t> accept_count{0};
+  /// @c accept_count when the accept rate was last worked out, for the stats sync only.
+  uint64_t accept_count_synced = 0;
+  /// This thread's accept rate, @c nullptr if it is not an ET_NET thread.
+  ts::Metrics::Gauge::AtomicType *accept_rate = nullptr;
+  /// How far apart the InactivityCop can tell timeouts.
+  static constexpr ink_hrtime COP_RESOLUTION = HRTIME_MSECONDS(100);
+  /// The longest the InactivityCop goes without looking at a NetEvent, whatever its timeouts.
+  static constexpr ink_hrtime MAX_COP_INTERVAL = HRTIME_SECONDS(60);
 
   int        mainNetEvent(int event, Event *data);
   int        waitForActivity(ink_hrtime timeout) override;
@@ -198,22 +221,36 @@ public:
 
   /**
     Start to handle active timeout and inactivity timeout on a NetEvent.
-    Put the ne into open_list. All NetEvents in the open_list is checked for
-    timeout by InactivityCop. Only be called when holding the mutex of this
-    NetHandler and must call startIO(ne) first.
+    Put the ne into open_list and on the cop_wheel. The InactivityCop checks
+    each NetEvent in the open_list for timeout when it comes off the cop_wheel.
+    Only be called when holding the mutex of this NetHandler and must call
+    startIO(ne) first.
 
     @param ne NetEvent to be managed by InactivityCop
    */
   void startCop(NetEvent *ne);
   /**
     Stop to handle active timeout and inactivity on a NetEvent.
-    Remove the ne from open_list and cop_list.
+    Remove the ne from open_list and the cop_wheel.
     Also remove the ne from keep_alive_queue and active_queue if its context is
     IN. Only be called when holding the mutex of this NetHandler.
 
     @param ne NetEvent to be released.
    */
   void stopCop(NetEvent *ne);
+  /**
+    Put the ne on the cop_wheel for when the InactivityCop next has to look at
+    it: its earliest timeout, at once if it is closed or due the default
+    inactivity timeout, and at least every MAX_COP_INTERVAL. If the ne is on the wheel
+    already it is only moved sooner. Only be called when holding the mutex of
+    this NetHandler.
+
+    @param ne NetEvent managed by InactivityCop.
+    @param now The current time.
+   */
+  void arm_cop(NetEvent *ne, ink_hrtime now);
+  /// Call @c arm_cop for @a ne from any thread, at once if the mutex is free or else on the next loop.
+  void update_cop(NetEvent *ne);
 
   // Signal the epoll_wait to terminate.
   void signalActivity() override;
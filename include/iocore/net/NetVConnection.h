@@ -329,6 +329,15 @@ public:
     return 0;
   }
 
+  /** Whether a write can send IOBufferFileRange blocks, handing them to the kernel with sendfile.
+   * @return @c false if the VC would have to read the bytes of such a block.
+   */
+  virtual bool
+  supports_sendfile() const
+  {
+    return false;
+  }
+
   /** Structure holding user options. */
   NetVCOptions options;
 
@@ -62,6 +62,12 @@ public:
   void receive_data(quiche_conn *quiche_con);
   void send_data(quiche_conn *quiche_con);
 
+  /**
+   * Set the RFC 9218 priority quiche schedules this stream by. It takes effect the next time
+   * data is sent.
+   */
+  void set_priority(uint8_t urgency, bool incremental);
+
   /*
    * QUICApplication need to call one of these functions when it process VC_EVENT_*
    */
@@ -85,6 +91,9 @@ protected:
   uint64_t                    _received_bytes   = 0;
   uint64_t                    _sent_bytes       = 0;
   bool                        _has_no_more_data = false;
+  uint8_t                     _urgency          = 3;
+  bool                        _incremental      = false;
+  bool                        _priority_changed = false;
 };
 
 class QUICStreamStateListener
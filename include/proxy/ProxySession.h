@@ -108,6 +108,7 @@ public:
   virtual void hook_add(TSHttpHookID id, INKContInternal *cont);
 
   virtual bool is_chunked_encoding_supported() const;
+  virtual bool supports_sendfile() const;
   virtual void set_half_close_flag(bool flag);
   virtual bool get_half_close_flag() const;
 
@@ -90,6 +90,8 @@ public:
 
   virtual bool get_half_close_flag() const;
   virtual bool is_chunked_encoding_supported() const;
+  /// Whether the response body may hold file ranges, which only the netvc can send.
+  virtual bool supports_sendfile() const;
 
   // Returns true if there is a request body for this request
   virtual bool has_request_body(int64_t content_length, bool is_chunked_set) const;
@@ -188,6 +190,11 @@ ProxyTransaction::is_chunked_encoding_supported() const
 {
   return _proxy_ssn ? _proxy_ssn->is_chunked_encoding_supported() : false;
 }
+inline bool
+ProxyTransaction::supports_sendfile() const
+{
+  return _proxy_ssn ? _proxy_ssn->supports_sendfile() : false;
+}
 inline void
 ProxyTransaction::set_half_close_flag(bool flag)
 {
@@ -0,0 +1,195 @@
+/** @file
+
+  Extensible prioritization of HTTP responses, RFC 9218.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "swoc/TextView.h"
+
+#include <cstdint>
+#include <set>
+#include <utility>
+
+class HTTPHdr;
+
+/// The priority parameters of a response, [RFC 9218] 4.
+struct HttpPriority {
+  static constexpr uint8_t URGENCY_DEFAULT = 3;
+  static constexpr uint8_t URGENCY_LOWEST  = 7;
+
+  /// 0 is the most urgent, 7 the least.
+  uint8_t urgency = URGENCY_DEFAULT;
+  /// Whether the response can be used as it arrives, so it may share the connection with others of the same urgency.
+  bool incremental = false;
+
+  /** Update from a Priority field value such as "u=1, i".
+
+      Members that are not priority parameters, and parameters with an invalid value, are ignored
+      as [RFC 9218] 4 requires, leaving the corresponding parameter as it was.
+   */
+  void parse(swoc::TextView text);
+
+  /// @return The priority signalled by the Priority fields of @a hdr, the defaults if there are none.
+  static HttpPriority from_header(HTTPHdr const *hdr);
+
+  bool
+  operator==(HttpPriority const &that) const
+  {
+    return urgency == that.urgency && incremental == that.incremental;
+  }
+};
+
+/**
+  Streams ready to send, ordered for the [RFC 9218] 10 scheduling of a connection.
+
+  The most urgent stream goes first. Among streams of the same urgency, non-incremental ones are
+  sent one at a time in the order of their identifiers, each to completion, before the incremental
+  ones, which take turns a frame at a time. Selecting the next stream is constant time and every
+  change is logarithmic in the number of ready streams.
+
+  The scheduler allocates nothing per stream: each stream owns its @c Node, which is in the
+  scheduler while the stream is active and must be deactivated before the stream goes away.
+ */
+template <typename T> class HttpPriorityScheduler
+{
+public:
+  class Node
+  {
+  public:
+    explicit Node(T t) : t(t) {}
+
+    Node(const Node &)            = delete;
+    Node &operator=(const Node &) = delete;
+
+    T            t;
+    uint64_t     id = 0;
+    HttpPriority priority;
+    bool         active = false;
+
+  private:
+    friend class HttpPriorityScheduler;
+
+    /// The identifier of a non-incremental stream, the turn of an incremental one.
+    uint64_t _order = 0;
+  };
+
+  /// @return The stream to send from next, @c nullptr if none is ready.
+  Node *
+  top() const
+  {
+    return _ready.empty() ? nullptr : *_ready.begin();
+  }
+
+  /// Mark @a node ready to send.
+  void activate(Node &node);
+
+  /// Mark @a node no longer ready to send.
+  void deactivate(Node &node);
+
+  /// Note that @a node sent a frame, so an incremental stream yields to the others of its urgency.
+  void update(Node &node);
+
+  /// Change the priority of @a node, [RFC 9218] 6.
+  void reprioritize(Node &node, HttpPriority priority);
+
+  /// @return The number of streams ready to send.
+  size_t
+  size() const
+  {
+    return _ready.size();
+  }
+
+private:
+  struct Order {
+    bool
+    operator()(Node const *lhs, Node const *rhs) const
+    {
+      if (lhs->priority.urgency != rhs->priority.urgency) {
+        return lhs->priority.urgency < rhs->priority.urgency;
+      }
+      if (lhs->priority.incremental != rhs->priority.incremental) {
+        return rhs->priority.incremental;
+      }
+      return lhs->_order < rhs->_order;
+    }
+  };
+
+  void
+  _set_order(Node &node)
+  {
+    node._order = node.priority.incremental ? ++_turn : node.id;
+  }
+
+  std::set<Node *, Order> _ready;
+  /// Last turn handed to an incremental stream.
+  uint64_t _turn = 0;
+};
+
+template <typename T>
+void
+HttpPriorityScheduler<T>::activate(Node &node)
+{
+  if (node.active) {
+    return;
+  }
+  _set_order(node);
+  _ready.insert(&node);
+  node.active = true;
+}
+
+template <typename T>
+void
+HttpPriorityScheduler<T>::deactivate(Node &node)
+{
+  if (!node.active) {
+    return;
+  }
+  _ready.erase(&node);
+  node.active = false;
+}
+
+template <typename T>
+void
+HttpPriorityScheduler<T>::update(Node &node)
+{
+  if (!node.active || !node.priority.incremental) {
+    return;
+  }
+  // Reuse the set node so taking a turn does not allocate.
+  auto handle = _ready.extract(&node);
+  _set_order(node);
+  _ready.insert(std::move(handle));
+}
+
+template <typename T>
+void
+HttpPriorityScheduler<T>::reprioritize(Node &node, HttpPriority priority)
+{
+  if (!node.active) {
+    node.priority = priority;
+    return;
+  }
+  auto handle   = _ready.extract(&node);
+  node.priority = priority;
+  _set_order(node);
+  _ready.insert(std::move(handle));
+}
@@ -419,6 +419,23 @@ MIMEHdrImpl::iterator::operator++(int) -> self_type
  *                                                                     *
  ***********************************************************************/
 
+/** Where a header parser has to stop in a line of text.
+ *
+ * The text is scanned up to its first LF. Each offset is from the start of the text, and is the size
+ * of the text if there is no such character before the LF.
+ */
+struct MIMELineScan {
+  size_t lf;    ///< The first LF.
+  size_t colon; ///< The first ':'.
+  size_t nul;   ///< The first NUL.
+  size_t ctl;   ///< The first control character after the first ':', @see ParseRules::is_control.
+};
+
+/// Scan @a text a vector at a time, with the widest instructions the CPU has.
+MIMELineScan mime_scan_line(swoc::TextView text);
+/// Scan @a text a byte at a time, for checking and measuring @c mime_scan_line.
+MIMELineScan mime_scan_line_scalar(swoc::TextView text);
+
 /** A pre-parser used to extract MIME "lines" from raw input for further parsing.
  *
  * This maintains an internal line buffer which is used to keeping content between calls
@@ -25,6 +25,7 @@
 
 #include <cstdint>
 #include <string_view>
+#include <vector>
 #include "tscore/Arena.h"
 
 const static int XPACK_ERROR_COMPRESSION_ERROR   = -1;
@@ -49,6 +50,12 @@ struct XpackDynamicTableEntry {
   uint32_t    value_len = 0;
   uint32_t    ref_count = 0;
   const char *wks       = nullptr;
+
+  // Hashes of the name and of the whole field, and the next older entries in the same index buckets.
+  uint32_t name_hash  = 0;
+  uint32_t field_hash = 0;
+  uint32_t name_next  = 0;
+  uint32_t field_next = 0;
 };
 
 /** The memory containing the header fields. */
@@ -239,6 +246,16 @@ private:
   uint32_t                       _entries_tail = 0;
   XpackDynamicTableStorage       _storage;
 
+  /** Hash indexes of the entries by name and by name and value.
+   *
+   * A bucket holds one more than the absolute index of the newest entry that hashed to it, or 0,
+   * and each entry links to the next older one in the same bucket the same way. Entries are only
+   * evicted oldest first, so a chain ends at 0 or at the first entry older than the oldest in the
+   * table and nothing has to be unlinked on eviction.
+   */
+  std::vector<uint32_t> _name_index;
+  std::vector<uint32_t> _field_index;
+
   /** Expand @a _storage to the new size.
    *
    * This takes care of expanding @a _storage's size and handles updating the
@@ -269,4 +286,7 @@ private:
    * offset references the first entry in the buffer.
    */
   uint32_t _calc_index(uint32_t base, int64_t offset) const;
+
+  /** The position in @a _entries of the entry with absolute index @a index, which must be in the table. */
+  uint32_t _position(uint32_t index) const;
 };
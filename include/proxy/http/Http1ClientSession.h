@@ -69,6 +69,7 @@ public:
   bool         get_half_close_flag() const override;
   int          get_transact_count() const override;
   bool         is_chunked_encoding_supported() const override;
+  bool         supports_sendfile() const override;
   virtual bool is_outbound_transparent() const;
 
   PoolableSession *get_server_session() const override;
@@ -29,8 +29,11 @@
 #include "proxy/hdrs/MIME.h"
 #include "records/RecDefs.h"
 
+#include "tsutil/Histogram.h"
 #include "tsutil/Metrics.h"
 
+#include <array>
+
 using ts::Metrics;
 
 class HTTPHdr;
@@ -57,6 +60,7 @@ const size_t HTTP2_PING_LEN               = 8;
 const size_t HTTP2_GOAWAY_LEN             = 8;
 const size_t HTTP2_WINDOW_UPDATE_LEN      = 4;
 const size_t HTTP2_SETTINGS_PARAMETER_LEN = 6;
+const size_t HTTP2_PRIORITY_UPDATE_LEN    = 4;
 
 // SETTINGS initial values. NOTE: These should not be modified
 // unless the protocol changes! Do not change this thinking you
@@ -76,6 +80,10 @@ const uint32_t HTTP2_PRIORITY_DEFAULT_STREAM_DEPENDENCY = 0;
 const uint8_t  HTTP2_PRIORITY_DEFAULT_WEIGHT            = 15;
 
 // Statistics
+
+/// Frames a session hands to the network in one write, a bucket per power of 2 up to 512 and over.
+using Http2FramesPerWriteHistogram = ts::Histogram<9, 0>;
+
 struct Http2StatsBlock {
   Metrics::Gauge::AtomicType   *current_client_session_count;
   Metrics::Gauge::AtomicType   *current_server_session_count;
@@ -120,6 +128,8 @@ struct Http2StatsBlock {
   Metrics::Counter::AtomicType *window_update_frames_in;
   Metrics::Counter::AtomicType *continuation_frames_in;
   Metrics::Counter::AtomicType *unknown_frames_in;
+
+  std::array<Metrics::Counter::AtomicType *, Http2FramesPerWriteHistogram::N_BUCKETS> frames_per_write;
 };
 
 extern Http2StatsBlock http2_rsb;
@@ -178,6 +188,9 @@ enum Http2FrameType {
   HTTP2_FRAME_TYPE_CONTINUATION  = 9,
 
   HTTP2_FRAME_TYPE_MAX,
+
+  // Extension frames, outside the densely numbered core types.
+  HTTP2_FRAME_TYPE_PRIORITY_UPDATE = 0x10, // [RFC 9218] 7.1
 };
 
 extern Metrics::Counter::AtomicType *http2_frame_metrics_in[HTTP2_FRAME_TYPE_MAX + 1];
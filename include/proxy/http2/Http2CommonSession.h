@@ -94,6 +94,15 @@ public:
   int64_t xmit(const Http2TxFrame &frame, bool flush = true);
   void    flush();
 
+  /** Hold back the writes of the frames sent until the matching end_batch().
+
+      A flush asked for while a batch is open, by xmit() or flush(), is done once when the outermost
+      batch ends, so the frames of an event callback reach the network in one write rather than a
+      write per frame.
+   */
+  void begin_batch();
+  void end_batch();
+
   int64_t          get_connection_id();
   Ptr<ProxyMutex> &get_mutex();
   NetVConnection  *get_netvc();
@@ -179,6 +188,9 @@ protected:
   int    _n_frame_read   = 0;
 
   uint32_t _pending_sending_data_size = 0;
+  int      _batch_depth               = 0;
+  uint32_t _pending_frames            = 0;     ///< Frames written since the last flush.
+  bool     _flush_pending             = false; ///< A flush was held back by an open batch.
 
   int64_t read_from_early_data      = 0;
   bool    cur_frame_from_early_data = false;
@@ -268,3 +280,23 @@ Http2CommonSession::do_clear_session_active()
 {
   get_proxy_session()->clear_session_active();
 }
+
+inline void
+Http2CommonSession::begin_batch()
+{
+  ++this->_batch_depth;
+}
+
+/// A batch of frames for the scope, @see Http2CommonSession::begin_batch.
+class Http2FrameBatch
+{
+public:
+  explicit Http2FrameBatch(Http2CommonSession *session) : _session(session) { _session->begin_batch(); }
+  ~Http2FrameBatch() { _session->end_batch(); }
+
+  Http2FrameBatch(const Http2FrameBatch &)            = delete;
+  Http2FrameBatch &operator=(const Http2FrameBatch &) = delete;
+
+private:
+  Http2CommonSession *_session;
+};
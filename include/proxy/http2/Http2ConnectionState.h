@@ -24,6 +24,7 @@
 #pragma once
 
 #include <atomic>
+#include <map>
 #include <queue>
 
 #include "iocore/net/NetTimeout.h"
@@ -31,7 +32,7 @@
 #include "proxy/http2/HTTP2.h"
 #include "proxy/http2/HPACK.h"
 #include "proxy/http2/Http2Stream.h"
-#include "proxy/http2/Http2DependencyTree.h"
+#include "proxy/http2/Http2StreamTable.h"
 #include "tscore/FrequencyCounter.h"
 
 class Http2CommonSession;
@@ -84,7 +85,6 @@ public:
   Http2CommonSession      *session            = nullptr;
   HpackHandle             *local_hpack_handle = nullptr;
   HpackHandle             *peer_hpack_handle  = nullptr;
-  DependencyTree          *dependency_tree    = nullptr;
   ActivityCop<Http2Stream> _cop;
 
   /** The HTTP/2 settings configured by ATS and dictated to the peer via
@@ -225,6 +225,7 @@ private:
   Http2Error rcv_goaway_frame(const Http2Frame &);
   Http2Error rcv_window_update_frame(const Http2Frame &);
   Http2Error rcv_continuation_frame(const Http2Frame &);
+  Http2Error rcv_priority_update_frame(const Http2Frame &);
 
   using http2_frame_dispatch = Http2Error (Http2ConnectionState::*)(const Http2Frame &);
   static constexpr http2_frame_dispatch _frame_handlers[HTTP2_FRAME_TYPE_MAX] = {
@@ -249,6 +250,13 @@ private:
    */
   void _process_incoming_settings_ack_frame();
 
+  /** Set the priority of a request stream once its header is decoded.
+   *
+   * A PRIORITY_UPDATE frame received before the stream was opened takes
+   * precedence over the Priority header field, [RFC 9218] 7.1.
+   */
+  void _set_stream_priority(Http2Stream *stream);
+
   // Getters for stream control configurations that retrieve the inbound or
   // outbound values per the configured session.
   uint32_t               _get_configured_max_concurrent_streams() const;
@@ -277,9 +285,18 @@ private:
   //   If given Stream Identifier is not found in stream_list and it is greater
   //   than latest_streamid_in, the state of Stream is IDLE.
   Queue<Http2Stream> stream_list;
-  Http2StreamId      latest_streamid_in  = 0;
-  Http2StreamId      latest_streamid_out = 0;
-  std::atomic<int>   stream_requests     = 0;
+  // The streams of 'stream_list' by Stream Identifier. An outbound stream is
+  //   added once it is given one, when its HEADERS frame is sent.
+  Http2StreamTable<Http2Stream> stream_table;
+  Http2StreamId                 latest_streamid_in  = 0;
+  Http2StreamId                 latest_streamid_out = 0;
+  std::atomic<int>              stream_requests     = 0;
+
+  // The streams with DATA frames to send, in the order of their priority, when stream priority is
+  //   enabled.
+  PriorityScheduler priority_scheduler;
+  // The priorities of PRIORITY_UPDATE frames received before the streams they are for.
+  std::map<Http2StreamId, HttpPriority> pending_priorities;
 
   // Counter for current active streams which are started by the client.
   std::atomic<uint32_t> peer_streams_count_in = 0;
@@ -28,14 +28,14 @@
 #include "proxy/http2/HTTP2.h"
 #include "proxy/ProxyTransaction.h"
 #include "proxy/http2/Http2DebugNames.h"
-#include "proxy/http2/Http2DependencyTree.h"
+#include "proxy/hdrs/HttpPriority.h"
 #include "tscore/History.h"
 #include "proxy/Milestones.h"
 
 class Http2Stream;
 class Http2ConnectionState;
 
-using DependencyTree = Http2DependencyTree::Tree<Http2Stream *>;
+using PriorityScheduler = HttpPriorityScheduler<Http2Stream *>;
 
 enum class Http2StreamMilestone {
   OPEN = 0,
@@ -190,9 +190,9 @@ public:
   bool parsing_header_done       = false;
   bool is_first_transaction_flag = false;
 
-  HTTPHdr                    _send_header;
-  IOBufferReader            *_send_reader  = nullptr;
-  Http2DependencyTree::Node *priority_node = nullptr;
+  HTTPHdr                 _send_header;
+  IOBufferReader         *_send_reader = nullptr;
+  PriorityScheduler::Node priority_node{this};
 
   Http2ConnectionState &get_connection_state();
 
@@ -0,0 +1,148 @@
+/** @file
+
+  HTTP/2 streams of a connection by identifier.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "tscore/ink_assert.h"
+#include "proxy/http2/HTTP2.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/**
+  The streams of a connection by their identifier, so the stream for a frame is found in constant
+  time however many streams are open.
+
+  This is an open addressing table with linear probing. The identifiers of the streams opened by
+  one end go up by two, so the home slot of an identifier is the identifier halved and the streams
+  open at any one time, mostly recent ones, fall in consecutive slots with few collisions. The
+  table is kept no more than half full.
+
+  A removed entry is filled by moving up the entries after it that would otherwise no longer be
+  found, so there are no tombstones and a lookup ends at the first empty slot.
+ */
+template <typename T> class Http2StreamTable
+{
+public:
+  /// @return The stream with identifier @a id, @c nullptr if there is none.
+  T *find(Http2StreamId id) const;
+
+  /// Add @a t as the stream with identifier @a id, which must not be in the table.
+  void insert(Http2StreamId id, T *t);
+
+  /// Remove the stream with identifier @a id. @return @c true if there was one.
+  bool erase(Http2StreamId id);
+
+  size_t
+  size() const
+  {
+    return _count;
+  }
+
+private:
+  struct Slot {
+    Http2StreamId id = 0;
+    T            *t  = nullptr;
+  };
+
+  static constexpr size_t MIN_SLOTS = 16;
+
+  size_t
+  _home(Http2StreamId id) const
+  {
+    return (id >> 1) & (_slots.size() - 1);
+  }
+
+  /// @return The slot holding @a id, or the empty slot that ends its probe sequence.
+  size_t _probe(Http2StreamId id) const;
+
+  std::vector<Slot> _slots;
+  size_t            _count = 0;
+};
+
+template <typename T>
+size_t
+Http2StreamTable<T>::_probe(Http2StreamId id) const
+{
+  size_t const mask = _slots.size() - 1;
+  size_t       i    = _home(id);
+  while (_slots[i].t != nullptr && _slots[i].id != id) {
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+template <typename T>
+T *
+Http2StreamTable<T>::find(Http2StreamId id) const
+{
+  if (_count == 0) {
+    return nullptr;
+  }
+  return _slots[_probe(id)].t;
+}
+
+template <typename T>
+void
+Http2StreamTable<T>::insert(Http2StreamId id, T *t)
+{
+  if (2 * (_count + 1) > _slots.size()) {
+    std::vector<Slot> old(std::max(2 * _slots.size(), MIN_SLOTS));
+    old.swap(_slots);
+    for (auto const &slot : old) {
+      if (slot.t != nullptr) {
+        _slots[_probe(slot.id)] = slot;
+      }
+    }
+  }
+  Slot &slot = _slots[_probe(id)];
+  ink_assert(slot.t == nullptr);
+  slot = {id, t};
+  ++_count;
+}
+
+template <typename T>
+bool
+Http2StreamTable<T>::erase(Http2StreamId id)
+{
+  if (_count == 0) {
+    return false;
+  }
+  size_t i = _probe(id);
+  if (_slots[i].t == nullptr) {
+    return false;
+  }
+
+  // Move each later entry of the run whose home slot is not after the hole into it.
+  size_t const mask = _slots.size() - 1;
+  for (size_t j = (i + 1) & mask; _slots[j].t != nullptr; j = (j + 1) & mask) {
+    if (((j - _home(_slots[j].id)) & mask) >= ((j - i) & mask)) {
+      _slots[i] = _slots[j];
+      i         = j;
+    }
+  }
+  _slots[i] = Slot{};
+  --_count;
+  return true;
+}
@@ -28,6 +28,7 @@
 #include "iocore/net/quic/QUICStreamVCAdapter.h"
 #include "proxy/http3/Http3FrameDispatcher.h"
 #include "proxy/http3/Http3FrameCollector.h"
+#include "proxy/hdrs/HttpPriority.h"
 
 class QUICStreamIO;
 class HQSession;
@@ -69,6 +70,9 @@ public:
   virtual int             state_stream_closed(int event, Event *data) = 0;
   NetVConnectionContext_t direction() const;
 
+  /// Set the priority the response is sent with, [RFC 9218].
+  void set_priority(const HttpPriority &priority);
+
   // For Queue from tscore/Link.h
   LINK(HQTransaction, link);
 
@@ -23,6 +23,10 @@
 
 #pragma once
 
+#include "tscore/ink_thread.h"
+
+#include <string>
+
 // The max number of levels in the stack trace
 #define INK_STACK_TRACE_MAX_LEVELS 100
 
@@ -33,3 +37,32 @@ void ink_stack_trace_dump();
   Get symbol of @n-th frame
 */
 const void *ink_backtrace(const int n);
+
+/**
+  Get ready for @c ink_stack_trace_thread: load the unwinder and install the signal handler. Call it
+  at startup, the first call to @c ink_stack_trace_thread does it otherwise. Only the first call has
+  any effect.
+
+  @return @c true if threads can be captured.
+*/
+bool ink_stack_trace_thread_init();
+
+/**
+  Capture the stack of another thread.
+
+  The thread is sent a signal whose handler takes the trace, so this works on a thread that is busy
+  or blocked without stopping the rest of the process. Only one capture runs at a time.
+
+  @param thread The thread to capture.
+  @param frames Where to put the return addresses, innermost first.
+  @param max The most frames to put in @a frames.
+  @param timeout_ms How long to wait for the thread to take the signal.
+  @return The number of frames captured, 0 if the stack could not be taken.
+*/
+int ink_stack_trace_thread(ink_thread thread, const void **frames, int max, int timeout_ms);
+
+/**
+  A readable name for the code at @a addr: the demangled symbol and the offset into it, or the
+  offset into the module if there is no symbol, with the module if it is not the program itself.
+*/
+std::string ink_stack_trace_symbol(const void *addr);
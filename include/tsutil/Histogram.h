@@ -104,6 +104,15 @@ public:
    */
   static raw_type min_for_bucket(unsigned idx);
 
+  /** Bucket for a sample.
+   *
+   * @param sample Value to classify.
+   * @return The index of the bucket that @a sample increments.
+   *
+   * For tallies kept elsewhere, such as a metric per bucket.
+   */
+  static unsigned bucket_for(raw_type sample);
+
   /** Add counts from another histogram.
    *
    * @param that Source histogram.
@@ -141,6 +150,14 @@ Histogram<R, S>::operator+=(self_type const &that) -> self_type &
 template <auto R, auto S>
 auto
 Histogram<R, S>::operator()(raw_type sample) -> self_type &
+{
+  ++_bucket[bucket_for(sample)];
+  return *this;
+}
+
+template <auto R, auto S>
+unsigned
+Histogram<R, S>::bucket_for(raw_type sample)
 {
   int idx = N_BUCKETS - 1; // index of overflow bucket
   if (sample < UNDERFLOW_BOUND) {
@@ -160,8 +177,7 @@ Histogram<R, S>::operator()(raw_type sample) -> self_type &
     }
     idx += (sample >> normalize_shift_count) & SPAN_MASK;
   } // else idx remains the overflow bucket.
-  ++_bucket[idx];
-  return *this;
+  return idx;
 }
 
 template <auto R, auto S>
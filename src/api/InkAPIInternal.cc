@@ -24,6 +24,8 @@
 #include "iocore/net/SSLAPIHooks.h"
 #include "api/LifecycleAPIHooks.h"
 #include "api/InkAPIInternal.h"
+#include "iocore/eventsystem/LoopProfiler.h"
+#include "ts/InkAPIPrivateIOCore.h"
 
 char traffic_server_version[128] = "";
 int  ts_major_version            = 0;
@@ -793,6 +795,10 @@ api_init()
 
     init_global_http_hooks();
     init_global_lifecycle_hooks();
+    // Charge the time of plugin continuations to the plugin's function rather than the dispatcher.
+    LoopProfiler::set_dispatcher(continuation_handler_void_ptr(&INKContInternal::handle_event), [](Continuation *c) -> uintptr_t {
+      return reinterpret_cast<uintptr_t>(static_cast<INKContInternal *>(c)->m_event_func);
+    });
     global_config_cbs = new ConfigUpdateCbTable;
 
     // Setup the version string for returning to plugins
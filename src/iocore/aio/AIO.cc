@@ -29,6 +29,7 @@
 #include "iocore/eventsystem/EThread.h"
 #include "iocore/eventsystem/Event.h"
 #include "iocore/eventsystem/EventProcessor.h"
+#include "iocore/eventsystem/IOBuffer.h"
 #include "records/RecCore.h"
 #include "records/RecDefs.h"
 #include "tscore/TSSystemState.h"
@@ -147,6 +148,7 @@ struct AIOStatsBlock {
   ts::Metrics::Counter::AtomicType *kb_read;
   ts::Metrics::Counter::AtomicType *write_count;
   ts::Metrics::Counter::AtomicType *kb_write;
+  ts::Metrics::Counter::AtomicType *registered_count;
 };
 
 AIOStatsBlock aio_rsb;
@@ -193,10 +195,11 @@ ink_aio_init(ts::ModuleVersion v, [[maybe_unused]] AIOBackend backend)
 {
   ink_release_assert(v.check(AIO_MODULE_INTERNAL_VERSION));
 
-  aio_rsb.read_count  = ts::Metrics::Counter::createPtr("proxy.process.cache.aio.read_count");
-  aio_rsb.write_count = ts::Metrics::Counter::createPtr("proxy.process.cache.aio.write_count");
-  aio_rsb.kb_read     = ts::Metrics::Counter::createPtr("proxy.process.cache.aio.KB_read");
-  aio_rsb.kb_write    = ts::Metrics::Counter::createPtr("proxy.process.cache.aio.KB_write");
+  aio_rsb.read_count       = ts::Metrics::Counter::createPtr("proxy.process.cache.aio.read_count");
+  aio_rsb.write_count      = ts::Metrics::Counter::createPtr("proxy.process.cache.aio.write_count");
+  aio_rsb.kb_read          = ts::Metrics::Counter::createPtr("proxy.process.cache.aio.KB_read");
+  aio_rsb.kb_write         = ts::Metrics::Counter::createPtr("proxy.process.cache.aio.KB_write");
+  aio_rsb.registered_count = ts::Metrics::Counter::createPtr("proxy.process.cache.aio.registered_count");
 
   memset(&aio_reqs, 0, MAX_DISKS_POSSIBLE * sizeof(AIO_Reqs *));
   ink_mutex_init(&insert_mutex);
@@ -246,6 +249,12 @@ ink_aio_init(ts::ModuleVersion v, [[maybe_unused]] AIOBackend backend)
 
   if (use_io_uring) {
     Note("Using io_uring for AIO");
+    // Cache disk reads allocate their buffers from this region, see CacheVC::do_read_call().
+    int64_t buffers = RecGetRecordInt("proxy.config.io_uring.registered_buffers").value_or(0);
+    if (buffers > 0) {
+      int64_t size = RecGetRecordInt("proxy.config.io_uring.registered_buffer_size").value_or(0);
+      init_registered_buffers(iobuffer_size_to_index(size, MAX_BUFFER_SIZE_INDEX), buffers);
+    }
   } else {
     Note("Using thread for AIO");
   }
@@ -585,6 +594,16 @@ prep_writev(io_uring_sqe *sqe, AIOCallback *op)
   io_uring_prep_writev(sqe, op->aiocb.aio_fildes, &op->iov, 1, op->aiocb.aio_offset);
 }
 
+void
+prep_fixed(io_uring_sqe *sqe, AIOCallback *op, int op_type, int buf_index)
+{
+  if (op_type == LIO_READ) {
+    io_uring_prep_read_fixed(sqe, op->aiocb.aio_fildes, op->aiocb.aio_buf, op->aiocb.aio_nbytes, op->aiocb.aio_offset, buf_index);
+  } else {
+    io_uring_prep_write_fixed(sqe, op->aiocb.aio_fildes, op->aiocb.aio_buf, op->aiocb.aio_nbytes, op->aiocb.aio_offset, buf_index);
+  }
+}
+
 using prep_op = void (*)(io_uring_sqe *, AIOCallback *);
 
 prep_op prep_ops[] = {
@@ -606,18 +625,45 @@ setup_prep_ops(IOUringContext *ur)
   }
 }
 
+/*
+ * Every thread has its own ring, so each one registers the IOBuffer registered region the first time it
+ * does disk IO.  The region is allocated before any disk IO is issued.
+ */
+void
+register_buffers(IOUringContext *ur)
+{
+  thread_local bool registered = false;
+  if (registered) {
+    return;
+  }
+  registered = true;
+
+  int64_t size   = 0;
+  char   *region = registered_buffer_region(&size);
+  if (region != nullptr && ur->supports_op(IORING_OP_READ_FIXED) && ur->register_buffers(region, size) != 0) {
+    Warning("io_uring could not register %" PRId64 " bytes of buffers, disk IO will use them unregistered", size);
+  }
+}
+
 void
 io_uring_prep_ops_internal(AIOCallback *op_in, int op_type)
 {
   IOUringContext *ur = IOUringContext::local_context();
   AIOCallback    *op = op_in;
+
+  register_buffers(ur);
   while (op) {
     op->this_op       = op;
     io_uring_sqe *sqe = ur->next_sqe(op);
 
     ink_release_assert(sqe != nullptr);
 
-    prep_ops[op_type](sqe, op);
+    if (int buf_index = ur->fixed_buffer_index(op->aiocb.aio_buf, op->aiocb.aio_nbytes); buf_index >= 0) {
+      prep_fixed(sqe, op, op_type, buf_index);
+      ts::Metrics::Counter::increment(aio_rsb.registered_count);
+    } else {
+      prep_ops[op_type](sqe, op);
+    }
 
     op->aiocb.aio_lio_opcode = op_type;
     if (op->then) {
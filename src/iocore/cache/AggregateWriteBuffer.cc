@@ -27,6 +27,25 @@
 
 #include <cstring>
 
+AggregateWriteBuffer::~AggregateWriteBuffer()
+{
+  ats_free(this->_buffer);
+  for (auto &flight : this->_in_flight) {
+    ats_free(flight.buffer);
+  }
+  for (auto *buffer : this->_spare_buffers) {
+    ats_free(buffer);
+  }
+}
+
+char *
+AggregateWriteBuffer::_alloc_buffer()
+{
+  char *buffer = static_cast<char *>(ats_memalign(ats_pagesize(), AGG_SIZE));
+  memset(buffer, 0, AGG_SIZE);
+  return buffer;
+}
+
 void
 AggregateWriteBuffer::add(Doc const *doc, int approx_size)
 {
@@ -61,3 +80,59 @@ AggregateWriteBuffer::copy_from(char *dest, int offset, size_t nbytes) const
   ink_assert((offset + nbytes) <= static_cast<size_t>(this->_buffer_pos));
   memcpy(dest, this->_buffer + offset, nbytes);
 }
+
+AggregateWriteBuffer::InFlight &
+AggregateWriteBuffer::submit(off_t offset)
+{
+  InFlight &flight        = this->_in_flight.emplace_back();
+  flight.buffer           = this->_buffer;
+  flight.offset           = offset;
+  flight.len              = this->_buffer_pos;
+  this->_bytes_in_flight += flight.len;
+  this->_writes_in_flight++;
+
+  if (this->_spare_buffers.empty()) {
+    this->_buffer = _alloc_buffer();
+  } else {
+    this->_buffer = this->_spare_buffers.back();
+    this->_spare_buffers.pop_back();
+  }
+  this->_buffer_pos = 0;
+  return flight;
+}
+
+void
+AggregateWriteBuffer::retire()
+{
+  ink_assert(!this->_in_flight.empty() && this->_in_flight.front().done);
+  InFlight &flight = this->_in_flight.front();
+  if (!flight.flushed) {
+    this->_bytes_in_flight -= flight.len;
+    this->_writes_in_flight--;
+  }
+  this->_spare_buffers.push_back(flight.buffer);
+  this->_in_flight.pop_front();
+}
+
+void
+AggregateWriteBuffer::mark_flushed()
+{
+  for (auto &flight : this->_in_flight) {
+    flight.flushed = true;
+  }
+  this->_bytes_in_flight  = 0;
+  this->_writes_in_flight = 0;
+}
+
+bool
+AggregateWriteBuffer::copy_from_in_flight(char *dest, off_t offset, size_t nbytes) const
+{
+  for (auto const &flight : this->_in_flight) {
+    if (offset >= flight.offset && offset < flight.offset + flight.len) {
+      ink_assert(offset + static_cast<off_t>(nbytes) <= flight.offset + flight.len);
+      memcpy(dest, flight.buffer + (offset - flight.offset), nbytes);
+      return true;
+    }
+  }
+  return false;
+}
@@ -31,6 +31,8 @@
 #include "tscore/List.h"
 
 #include <cstring>
+#include <deque>
+#include <vector>
 
 #define AGG_SIZE       (4 * 1024 * 1024) // 4MB
 #define AGG_HIGH_WATER (AGG_SIZE / 2)    // 2MB
@@ -40,13 +42,24 @@ struct CacheVC;
 class AggregateWriteBuffer
 {
 public:
-  AggregateWriteBuffer()
-  {
-    this->_buffer = static_cast<char *>(ats_memalign(ats_pagesize(), AGG_SIZE));
-    memset(this->_buffer, 0, AGG_SIZE);
-  }
+  /**
+   * A filled buffer that has been handed to the disk.
+   *
+   * Buffers are written in the order they were submitted and lie back to
+   * back on disk, the first one starting at the stripe's write position.
+   */
+  struct InFlight {
+    char *buffer  = nullptr;
+    off_t offset  = 0; ///< Stripe offset the buffer is written to.
+    int   len     = 0;
+    bool  done    = false; ///< The disk write has completed.
+    bool  ok      = false; ///< The disk write succeeded.
+    bool  flushed = false; ///< Rewritten by a flush, the write position already covers it.
+  };
 
-  ~AggregateWriteBuffer() { ats_free(this->_buffer); }
+  AggregateWriteBuffer() { this->_buffer = _alloc_buffer(); }
+
+  ~AggregateWriteBuffer();
 
   AggregateWriteBuffer(AggregateWriteBuffer const &)            = delete;
   AggregateWriteBuffer &operator=(AggregateWriteBuffer const &) = delete;
@@ -133,6 +146,51 @@ public:
    */
   void copy_from(char *dest, int offset, size_t nbytes) const;
 
+  /**
+   * Hand the filled part of the buffer to the disk.
+   *
+   * The filled buffer moves to the back of the in flight queue, where it
+   * stays readable until it is retired, and aggregation continues in an
+   * empty buffer. Pending writers and bytes pending aggregation are not
+   * affected.
+   *
+   * @param offset The stripe offset the buffer will be written to.
+   * @return Returns the in flight entry for the buffer. It remains valid
+   *   until it is retired.
+   */
+  InFlight &submit(off_t offset);
+
+  /**
+   * Release the oldest in flight buffer for reuse.
+   *
+   * The buffer's disk write must have completed.
+   */
+  void retire();
+
+  /**
+   * Mark every in flight buffer as flushed.
+   *
+   * Called once the buffers have been written synchronously during shutdown.
+   * Flushed buffers no longer count toward the bytes or writes in flight,
+   * but each is kept until its own disk write completes and it is retired.
+   */
+  void mark_flushed();
+
+  /**
+   * Copy part of an in flight buffer.
+   *
+   * @param dest: The destination buffer.
+   * @param offset: Stripe offset to begin copying at.
+   * @param nbytes: Number of bytes to copy.
+   * @return Returns true if the range lies within an in flight buffer and
+   *   was copied, otherwise false.
+   */
+  bool copy_from_in_flight(char *dest, off_t offset, size_t nbytes) const;
+
+  std::deque<InFlight>                    &get_in_flight();
+  std::deque<InFlight> const              &get_in_flight() const;
+  int64_t                                  get_bytes_in_flight() const;
+  int                                      get_writes_in_flight() const;
   Queue<CacheVC, Continuation::Link_link> &get_pending_writers();
   char                                    *get_buffer();
   int                                      get_buffer_pos() const;
@@ -146,8 +204,38 @@ private:
   char                                   *_buffer                    = nullptr;
   int                                     _bytes_pending_aggregation = 0;
   int                                     _buffer_pos                = 0;
+  std::deque<InFlight>                    _in_flight;
+  int64_t                                 _bytes_in_flight  = 0;
+  int                                     _writes_in_flight = 0;
+  std::vector<char *>                     _spare_buffers;
+
+  static char *_alloc_buffer();
 };
 
+inline std::deque<AggregateWriteBuffer::InFlight> &
+AggregateWriteBuffer::get_in_flight()
+{
+  return this->_in_flight;
+}
+
+inline std::deque<AggregateWriteBuffer::InFlight> const &
+AggregateWriteBuffer::get_in_flight() const
+{
+  return this->_in_flight;
+}
+
+inline int64_t
+AggregateWriteBuffer::get_bytes_in_flight() const
+{
+  return this->_bytes_in_flight;
+}
+
+inline int
+AggregateWriteBuffer::get_writes_in_flight() const
+{
+  return this->_writes_in_flight;
+}
+
 inline Queue<CacheVC, Continuation::Link_link> &
 AggregateWriteBuffer::get_pending_writers()
 {
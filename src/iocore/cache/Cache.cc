@@ -45,6 +45,7 @@
 #include <unordered_set>
 #include <fstream>
 #include <string>
+#include <vector>
 #include <filesystem>
 
 #define SCAN_BUF_SIZE              RECOVERY_SIZE
@@ -60,7 +61,10 @@ int64_t cache_config_ram_cache_size                      = AUTO_SIZE_RAM_CACHE;
 int     cache_config_ram_cache_algorithm                 = 1;
 int     cache_config_ram_cache_compress                  = 0;
 int     cache_config_ram_cache_compress_percent          = 90;
+int     cache_config_ram_cache_compress_dictionary_size  = 0;
 int     cache_config_ram_cache_use_seen_filter           = 1;
+int     cache_config_ram_cache_admission                 = 0;
+int     cache_config_ram_cache_shards                    = 0;
 int     cache_config_ram_cache_s3fifo_main_percent       = 90;
 int     cache_config_ram_cache_s3fifo_ghost_size_percent = 90;
 int     cache_config_ram_cache_s3fifo_ghost_mem_percent  = 25;
@@ -71,6 +75,10 @@ int     cache_config_dir_sync_frequency                  = 60;
 int     cache_config_dir_sync_delay                      = 500;
 int     cache_config_dir_sync_max_write                  = (2 * 1024 * 1024);
 int     cache_config_dir_sync_parallel_tasks             = 1;
+int     cache_config_dir_sync_incremental                = 1;
+int     cache_config_dir_async_load                      = 0;
+int     cache_config_dir_vectorized_probe                = 0;
+int     cache_config_dir_wide_buckets                    = 0;
 int     cache_config_permit_pinning                      = 0;
 int     cache_config_select_alternate                    = 1;
 int     cache_config_max_doc_size                        = 0;
@@ -82,12 +90,16 @@ int     cache_config_hit_evacuate_size_limit             = 0;
 int     cache_config_force_sector_size                   = 0;
 int     cache_config_target_fragment_size                = DEFAULT_TARGET_FRAGMENT_SIZE;
 int     cache_config_agg_write_backlog                   = AGG_SIZE * 2;
+int     cache_config_agg_write_queue_depth               = 1;
+int64_t cache_config_agg_write_disk_bandwidth            = 0;
 int     cache_config_enable_checksum                     = 0;
 int     cache_config_alt_rewrite_max_size                = 4096;
 int     cache_config_read_while_writer                   = 0;
 int     cache_config_mutex_retry_delay                   = 2;
 int     cache_read_while_writer_retry_delay              = 50;
 int     cache_config_read_while_writer_max_retries       = 10;
+int     cache_config_read_while_writer_fragment_ring     = 4;
+int     cache_config_sendfile                            = 0;
 int     cache_config_persist_bad_disks                   = false;
 
 // Globals
@@ -302,7 +314,8 @@ Cache::open(bool clear, bool /* fix ATS_UNUSED */)
   RecEstablishStaticConfigInt32(cache_config_min_average_object_size, "proxy.config.cache.min_average_object_size");
   Dbg(dbg_ctl_cache_init, "Cache::open - proxy.config.cache.min_average_object_size = %d", cache_config_min_average_object_size);
 
-  CacheVol *cp = cp_list.head;
+  std::vector<StripeSM *> opened;
+  CacheVol               *cp = cp_list.head;
   for (; cp; cp = cp->link.next) {
     if (cp->scheme == scheme) {
       cp->stripes = static_cast<StripeSM **>(ats_malloc(cp->num_vols * sizeof(StripeSM *)));
@@ -317,8 +330,12 @@ Cache::open(bool clear, bool /* fix ATS_UNUSED */)
             cp->stripes[vol_no]->cache     = this;
             cp->stripes[vol_no]->cache_vol = cp;
 
+            std::string stat_prefix         = "proxy.process.cache.volume_" + std::to_string(cp->vol_number) + ".stripe_";
+            cp->stripes[vol_no]->ready_time = ts::Metrics::Gauge::createPtr(stat_prefix, std::to_string(vol_no) + ".ready_time");
+
             bool vol_clear = clear || d->cleared || q->new_block;
             cp->stripes[vol_no]->init(vol_clear);
+            opened.push_back(cp->stripes[vol_no]);
             vol_no++;
             cache_size += blocks;
           }
@@ -330,7 +347,20 @@ Cache::open(bool clear, bool /* fix ATS_UNUSED */)
   if (total_nvol == 0) {
     return open_done();
   }
-  cache_read_done = 1;
+  // Open the cache without waiting for the directories, each stripe starts
+  // serving once its own directory is loaded.
+  if (cache_config_dir_async_load) {
+    for (auto stripe : opened) {
+      stripe->register_early();
+    }
+  }
+  // Publishes the stripes registered above to dir_init_done().
+  cache_read_done.store(1, std::memory_order_release);
+  if (cache_config_dir_async_load) {
+    for (auto stripe : opened) {
+      vol_initialized(stripe->fd != -1);
+    }
+  }
   return 0;
 }
 
@@ -349,7 +379,11 @@ Cache::lookup(Continuation *cont, const CacheKey *key, CacheFragType type, std::
   }
 
   StripeSM *stripe = key_to_stripe(key, hostname);
-  CacheVC  *c      = new_CacheVC(cont);
+  if (!stripe->is_ready()) {
+    cont->handleEvent(CACHE_EVENT_LOOKUP_FAILED, nullptr);
+    return ACTION_RESULT_DONE;
+  }
+  CacheVC *c = new_CacheVC(cont);
   SET_CONTINUATION_HANDLER(c, &CacheVC::openReadStartHead);
   c->vio.op  = VIO::READ;
   c->op_type = static_cast<int>(CacheOpType::Lookup);
@@ -382,6 +416,10 @@ Cache::open_read(Continuation *cont, const CacheKey *key, CacheFragType type, st
   ProxyMutex   *mutex = cont->mutex.get();
   OpenDirEntry *od    = nullptr;
   CacheVC      *c     = nullptr;
+  if (!stripe->is_ready()) {
+    cont->handleEvent(CACHE_EVENT_OPEN_READ_FAILED, reinterpret_cast<void *>(-ECACHE_NOT_READY));
+    return ACTION_RESULT_DONE;
+  }
   {
     CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
     if (!lock.is_locked() || (od = stripe->open_read(key)) || stripe->directory.probe(key, stripe, &result, &last_collision)) {
@@ -447,13 +485,18 @@ Cache::open_write(Continuation *cont, const CacheKey *key, CacheFragType frag_ty
 
   ink_assert(caches[frag_type] == this);
 
+  StripeSM *stripe = key_to_stripe(key, hostname);
+  if (!stripe->is_ready()) {
+    cont->handleEvent(CACHE_EVENT_OPEN_WRITE_FAILED, reinterpret_cast<void *>(-ECACHE_NOT_READY));
+    return ACTION_RESULT_DONE;
+  }
+
   intptr_t res = 0;
   CacheVC *c   = new_CacheVC(cont);
   SCOPED_MUTEX_LOCK(lock, c->mutex, this_ethread());
-  c->vio.op        = VIO::WRITE;
-  c->op_type       = static_cast<int>(CacheOpType::Write);
-  c->stripe        = key_to_stripe(key, hostname);
-  StripeSM *stripe = c->stripe;
+  c->vio.op  = VIO::WRITE;
+  c->op_type = static_cast<int>(CacheOpType::Write);
+  c->stripe  = stripe;
   ts::Metrics::Gauge::increment(cache_rsb.status[c->op_type].active);
   ts::Metrics::Gauge::increment(stripe->cache_vol->vol_rsb.status[c->op_type].active);
   c->first_key = c->key = *key;
@@ -513,6 +556,14 @@ Cache::remove(Continuation *cont, const CacheKey *key, CacheFragType type, std::
     return ACTION_RESULT_DONE;
   }
 
+  StripeSM *stripe = key_to_stripe(key, hostname);
+  if (!stripe->is_ready()) {
+    if (cont) {
+      cont->handleEvent(CACHE_EVENT_REMOVE_FAILED, nullptr);
+    }
+    return ACTION_RESULT_DONE;
+  }
+
   Ptr<ProxyMutex> mutex;
   if (!cont) {
     cont = new_CacheRemoveCont();
@@ -520,7 +571,6 @@ Cache::remove(Continuation *cont, const CacheKey *key, CacheFragType type, std::
 
   CACHE_TRY_LOCK(lock, cont->mutex, this_ethread());
   ink_assert(lock.is_locked());
-  StripeSM *stripe = key_to_stripe(key, hostname);
   // coverity[var_decl]
   Dir result;
   dir_clear(&result); // initialized here, set result empty so we can recognize missed lock
@@ -584,6 +634,10 @@ Cache::open_read(Continuation *cont, const CacheKey *key, CacheHTTPHdr *request,
   ProxyMutex   *mutex = cont->mutex.get();
   OpenDirEntry *od    = nullptr;
   CacheVC      *c     = nullptr;
+  if (!stripe->is_ready()) {
+    cont->handleEvent(CACHE_EVENT_OPEN_READ_FAILED, reinterpret_cast<void *>(-ECACHE_NOT_READY));
+    return ACTION_RESULT_DONE;
+  }
 
   {
     CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
@@ -654,6 +708,12 @@ Cache::open_write(Continuation *cont, const CacheKey *key, CacheHTTPInfo *old_in
   }
 
   ink_assert(caches[type] == this);
+  StripeSM *stripe = key_to_stripe(key, hostname, volume_host_rec);
+  if (!stripe->is_ready()) {
+    cont->handleEvent(CACHE_EVENT_OPEN_WRITE_FAILED, reinterpret_cast<void *>(-ECACHE_NOT_READY));
+    return ACTION_RESULT_DONE;
+  }
+
   intptr_t err        = 0;
   int      if_writers = reinterpret_cast<uintptr_t>(old_info) == CACHE_ALLOW_MULTIPLE_WRITES;
   CacheVC *c          = new_CacheVC(cont);
@@ -670,10 +730,9 @@ Cache::open_write(Continuation *cont, const CacheKey *key, CacheHTTPInfo *old_in
     rand_CacheKey(&c->key);
   } while (DIR_MASK_TAG(c->key.slice32(2)) == DIR_MASK_TAG(c->first_key.slice32(2)));
   c->earliest_key  = c->key;
-  c->frag_type     = CACHE_FRAG_TYPE_HTTP;
-  c->stripe        = key_to_stripe(key, hostname, volume_host_rec);
-  StripeSM *stripe = c->stripe;
-  c->info          = old_info;
+  c->frag_type    = CACHE_FRAG_TYPE_HTTP;
+  c->stripe       = stripe;
+  c->info         = old_info;
   if (c->info && reinterpret_cast<uintptr_t>(old_info) != CACHE_ALLOW_MULTIPLE_WRITES) {
     /*
        Update has the following code paths :
@@ -867,7 +926,11 @@ ink_cache_init(ts::ModuleVersion v)
   RecEstablishStaticConfigInt32(cache_config_ram_cache_algorithm, "proxy.config.cache.ram_cache.algorithm");
   RecEstablishStaticConfigInt32(cache_config_ram_cache_compress, "proxy.config.cache.ram_cache.compress");
   RecEstablishStaticConfigInt32(cache_config_ram_cache_compress_percent, "proxy.config.cache.ram_cache.compress_percent");
+  RecEstablishStaticConfigInt32(cache_config_ram_cache_compress_dictionary_size,
+                                "proxy.config.cache.ram_cache.compress_dictionary_size");
   cache_config_ram_cache_use_seen_filter = RecGetRecordInt("proxy.config.cache.ram_cache.use_seen_filter").value_or(0);
+  RecEstablishStaticConfigInt32(cache_config_ram_cache_admission, "proxy.config.cache.ram_cache.admission");
+  RecEstablishStaticConfigInt32(cache_config_ram_cache_shards, "proxy.config.cache.ram_cache.shards");
 
   RecEstablishStaticConfigInt32(cache_config_ram_cache_s3fifo_main_percent, "proxy.config.cache.ram_cache.s3fifo.main_percent");
   RecEstablishStaticConfigInt32(cache_config_ram_cache_s3fifo_ghost_size_percent,
@@ -899,6 +962,12 @@ ink_cache_init(ts::ModuleVersion v)
   RecEstablishStaticConfigInt32(cache_config_dir_sync_max_write, "proxy.config.cache.dir.sync_max_write");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.dir.sync_max_write = %d", cache_config_dir_sync_max_write);
 
+  RecEstablishStaticConfigInt32(cache_config_dir_sync_incremental, "proxy.config.cache.dir.sync_incremental");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.dir.sync_incremental = %d", cache_config_dir_sync_incremental);
+
+  RecEstablishStaticConfigInt32(cache_config_dir_async_load, "proxy.config.cache.dir.async_load");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.dir.async_load = %d", cache_config_dir_async_load);
+
   RecEstablishStaticConfigInt32(cache_config_select_alternate, "proxy.config.cache.select_alternate");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.select_alternate = %d", cache_config_select_alternate);
 
@@ -915,6 +984,12 @@ ink_cache_init(ts::ModuleVersion v)
   RecEstablishStaticConfigInt32(cache_read_while_writer_retry_delay, "proxy.config.cache.read_while_writer_retry.delay");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.read_while_writer_retry.delay = %dms", cache_read_while_writer_retry_delay);
 
+  RecEstablishStaticConfigInt32(cache_config_read_while_writer_fragment_ring, "proxy.config.cache.read_while_writer.fragment_ring");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.read_while_writer.fragment_ring = %d", cache_config_read_while_writer_fragment_ring);
+
+  RecEstablishStaticConfigInt32(cache_config_sendfile, "proxy.config.cache.sendfile");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.sendfile = %d", cache_config_sendfile);
+
   RecEstablishStaticConfigInt32(cache_config_hit_evacuate_percent, "proxy.config.cache.hit_evacuate_percent");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.hit_evacuate_percent = %d", cache_config_hit_evacuate_percent);
 
@@ -939,6 +1014,12 @@ ink_cache_init(ts::ModuleVersion v)
   RecEstablishStaticConfigInt32(cache_config_agg_write_backlog, "proxy.config.cache.agg_write_backlog");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.agg_write_backlog = %d", cache_config_agg_write_backlog);
 
+  RecEstablishStaticConfigInt32(cache_config_agg_write_queue_depth, "proxy.config.cache.agg_write_queue_depth");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.agg_write_queue_depth = %d", cache_config_agg_write_queue_depth);
+
+  RecEstablishStaticConfigInt(cache_config_agg_write_disk_bandwidth, "proxy.config.cache.agg_write_disk_bandwidth");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.agg_write_disk_bandwidth = %" PRId64, cache_config_agg_write_disk_bandwidth);
+
   RecEstablishStaticConfigInt32(cache_config_enable_checksum, "proxy.config.cache.enable_checksum");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.enable_checksum = %d", cache_config_enable_checksum);
 
@@ -957,6 +1038,11 @@ ink_cache_init(ts::ModuleVersion v)
   RecEstablishStaticConfigInt32(cache_config_dir_sync_parallel_tasks, "proxy.config.cache.dir.sync_parallel_tasks");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.dir.sync_parallel_tasks = %d", cache_config_dir_sync_parallel_tasks);
 
+  RecEstablishStaticConfigInt32(cache_config_dir_vectorized_probe, "proxy.config.cache.dir.vectorized_probe");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.dir.vectorized_probe = %d", cache_config_dir_vectorized_probe);
+  RecEstablishStaticConfigInt32(cache_config_dir_wide_buckets, "proxy.config.cache.dir.wide_buckets");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.dir.wide_buckets = %d", cache_config_dir_wide_buckets);
+
   RecEstablishStaticConfigInt32(cache_config_persist_bad_disks, "proxy.config.cache.persist_bad_disks");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.persist_bad_disks = %d", cache_config_persist_bad_disks);
   if (cache_config_persist_bad_disks) {
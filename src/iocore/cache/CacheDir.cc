@@ -108,6 +108,7 @@ OpenDir::open_write(CacheVC *cont, int allow_if_writers, int max_writers)
   od->move_resident_alt     = false;
   od->reading_vec           = false;
   od->writing_vec           = false;
+  od->fragment_ring         = nullptr;
   dir_clear(&od->first_dir);
   cont->od           = od;
   cont->write_vector = &od->vector;
@@ -153,12 +154,37 @@ OpenDir::close_write(CacheVC *cont)
     delayed_readers.append(cont->od->readers);
     signal_readers(0, nullptr);
     cont->od->vector.clear();
+    delete cont->od->fragment_ring;
+    cont->od->fragment_ring = nullptr;
     THREAD_FREE(cont->od, openDirEntryAllocator, cont->mutex->thread_holding);
   }
   cont->od = nullptr;
   return 0;
 }
 
+void
+OpenDirFragmentRing::publish(const CacheKey &key, int fragment, IOBufferData *data)
+{
+  Slot &slot    = slots[fragment % slots.size()];
+  slot.key      = key;
+  slot.fragment = fragment;
+  slot.data     = data;
+  if (fragment > newest) {
+    newest = fragment;
+  }
+}
+
+IOBufferData *
+OpenDirFragmentRing::find(const CacheKey &key, int fragment, int *lag) const
+{
+  Slot const &slot = slots[fragment % slots.size()];
+  *lag             = newest - fragment;
+  if (slot.fragment == fragment && slot.key == key) {
+    return slot.data.get();
+  }
+  return nullptr;
+}
+
 OpenDirEntry *
 OpenDir::open_read(const CryptoHash *key) const
 {
@@ -179,7 +205,7 @@ OpenDir::open_read(const CryptoHash *key) const
 // return value 1 means no loop
 // zero indicates loop
 int
-dir_bucket_loop_check(Dir *start_dir, Dir *seg)
+dir_bucket_loop_check(Directory const &directory, Dir *start_dir, Dir *seg)
 {
   if (start_dir == nullptr) {
     return 1;
@@ -191,11 +217,11 @@ dir_bucket_loop_check(Dir *start_dir, Dir *seg)
   while (p2) {
     // p1 moves by one entry per iteration
     ink_assert(p1);
-    p1 = next_dir(p1, seg);
+    p1 = directory.next_dir(p1, seg);
     // p2 moves by two entries per iteration
-    p2 = next_dir(p2, seg);
+    p2 = directory.next_dir(p2, seg);
     if (p2) {
-      p2 = next_dir(p2, seg);
+      p2 = directory.next_dir(p2, seg);
     } else {
       return 1;
     }
@@ -215,13 +241,53 @@ Directory::init_segment(int s)
   this->header->freelist[s] = 0;
   Dir *seg                  = this->get_segment(s);
   int  l, b;
-  memset(static_cast<void *>(seg), 0, SIZEOF_DIR * DIR_DEPTH * this->buckets);
-  for (l = 1; l < DIR_DEPTH; l++) {
+  memset(static_cast<void *>(seg), 0, this->bucket_size() * this->buckets);
+  for (l = 1; l < this->depth(); l++) {
     for (b = 0; b < this->buckets; b++) {
-      Dir *bucket = dir_bucket(b, seg);
+      Dir *bucket = this->bucket(b, seg);
       this->free_entry(dir_bucket_row(bucket, l), s);
     }
   }
+  this->mark_dirty(s);
+}
+
+void
+Directory::reset_sync_state()
+{
+  this->segment_version.assign(this->segments, 1);
+  this->synced_version[0].assign(this->segments, 0);
+  this->synced_version[1].assign(this->segments, 0);
+}
+
+// Every link in a bucket chain or the freelist has to name a non head row
+// of the segment, and no walk can be longer than the segment. Anything else
+// was corrupted on disk, start the segment over.
+void
+Directory::_validate_segment(int s)
+{
+  Dir    *seg   = this->get_segment(s);
+  int64_t depth = this->depth();
+  int64_t limit = this->buckets * depth;
+
+  auto chain_ok = [&](int64_t o) {
+    for (int64_t n = 0; o; ++n) {
+      if (o >= limit || o % depth == 0 || n >= limit) {
+        return false;
+      }
+      o = dir_next(this->from_offset(o, seg));
+    }
+    return true;
+  };
+
+  bool ok = chain_ok(this->header->freelist[s]);
+  for (int64_t b = 0; ok && b < this->buckets; b++) {
+    ok = chain_ok(dir_next(this->bucket(b, seg)));
+  }
+  this->segment_valid[s] = 1;
+  if (!ok) {
+    Warning("Dir segment %d is corrupt, clearing segment", s);
+    this->init_segment(s);
+  }
 }
 
 // break the infinite loop in directory entries
@@ -229,7 +295,7 @@ Directory::init_segment(int s)
 int
 Directory::bucket_loop_fix(Dir *start_dir, int s)
 {
-  if (!dir_bucket_loop_check(start_dir, this->get_segment(s))) {
+  if (!dir_bucket_loop_check(*this, start_dir, this->get_segment(s))) {
     Warning("Dir loop exists, clearing segment %d", s);
     this->init_segment(s);
     return 1;
@@ -242,13 +308,13 @@ Directory::freelist_length(int s)
 {
   int  free = 0;
   Dir *seg  = this->get_segment(s);
-  Dir *e    = dir_from_offset(this->header->freelist[s], seg);
+  Dir *e    = this->from_offset(this->header->freelist[s], seg);
   if (this->bucket_loop_fix(e, s)) {
-    return (DIR_DEPTH - 1) * this->buckets;
+    return (this->depth() - 1) * this->buckets;
   }
   while (e) {
     free++;
-    e = next_dir(e, seg);
+    e = this->next_dir(e, seg);
   }
   return free;
 }
@@ -268,7 +334,7 @@ Directory::bucket_length(Dir *b, int s)
     if (i > 100) {
       return -1;
     }
-    e = next_dir(e, seg);
+    e = this->next_dir(e, seg);
   }
   return i;
 }
@@ -281,14 +347,14 @@ Directory::check()
   for (s = 0; s < this->segments; s++) {
     Dir *seg = this->get_segment(s);
     for (i = 0; i < this->buckets; i++) {
-      Dir *b = dir_bucket(i, seg);
+      Dir *b = this->bucket(i, seg);
       if (!(this->bucket_length(b, s) >= 0)) {
         return 0;
       }
       if (!(!dir_next(b) || dir_offset(b))) {
         return 0;
       }
-      if (!(dir_bucket_loop_check(b, seg))) {
+      if (!(dir_bucket_loop_check(*this, b, seg))) {
         return 0;
       }
     }
@@ -322,22 +388,24 @@ dir_clean_bucket(Dir *b, int s, StripeSM *stripe)
         ts::Metrics::Gauge::decrement(stripe->cache_vol->vol_rsb.direntries_used);
       }
       // Match cache_dir_remove arguments
-      ATS_PROBE7(cache_dir_remove_clean_bucket, stripe->fd, s, dir_to_offset(e, seg), dir_offset(e), dir_approx_size(e), 0, 0);
+      ATS_PROBE7(cache_dir_remove_clean_bucket, stripe->fd, s, stripe->directory.to_offset(e, seg), dir_offset(e),
+                 dir_approx_size(e), 0, 0);
       e = stripe->directory.delete_entry(e, p, s);
       continue;
     }
     p = e;
-    e = next_dir(e, seg);
+    e = stripe->directory.next_dir(e, seg);
   } while (e);
 }
 
 void
 Directory::clean_segment(int s, StripeSM *stripe)
 {
+  this->validate_segment(s);
   Dir *seg = this->get_segment(s);
   for (int64_t i = 0; i < this->buckets; i++) {
-    dir_clean_bucket(dir_bucket(i, seg), s, stripe);
-    ink_assert(!dir_next(dir_bucket(i, seg)) || dir_offset(dir_bucket(i, seg)));
+    dir_clean_bucket(this->bucket(i, seg), s, stripe);
+    ink_assert(!dir_next(this->bucket(i, seg)) || dir_offset(this->bucket(i, seg)));
   }
 }
 
@@ -354,7 +422,7 @@ void
 Directory::clear_range(off_t start, off_t end, StripeSM *stripe)
 {
   for (off_t i = 0; i < this->entries(); i++) {
-    Dir *e = dir_index(stripe, i);
+    Dir *e = this->entry(i);
     if (dir_offset(e) >= static_cast<int64_t>(start) && dir_offset(e) < static_cast<int64_t>(end)) {
       ts::Metrics::Gauge::decrement(cache_rsb.direntries_used);
       ts::Metrics::Gauge::decrement(stripe->cache_vol->vol_rsb.direntries_used);
@@ -365,14 +433,14 @@ Directory::clear_range(off_t start, off_t end, StripeSM *stripe)
 }
 
 void
-check_bucket_not_contains(Dir *b, Dir *e, Dir *seg)
+check_bucket_not_contains(Directory const &directory, Dir *b, Dir *e, Dir *seg)
 {
   Dir *x = b;
   do {
     if (x == e) {
       break;
     }
-    x = next_dir(x, seg);
+    x = directory.next_dir(x, seg);
   } while (x);
   ink_assert(!x);
 }
@@ -388,8 +456,8 @@ freelist_clean(int s, StripeSM *stripe)
   int  n   = 0;
   Dir *seg = stripe->directory.get_segment(s);
   for (int bi = 0; bi < stripe->directory.buckets; bi++) {
-    Dir *b = dir_bucket(bi, seg);
-    for (int l = 0; l < DIR_DEPTH; l++) {
+    Dir *b = stripe->directory.bucket(bi, seg);
+    for (int l = 0; l < stripe->directory.depth(); l++) {
       Dir *e = dir_bucket_row(b, l);
       if (dir_head(e) && !(n++ % 10)) {
         ts::Metrics::Gauge::decrement(cache_rsb.direntries_used);
@@ -405,7 +473,7 @@ inline Dir *
 freelist_pop(int s, StripeSM *stripe)
 {
   Dir *seg = stripe->directory.get_segment(s);
-  Dir *e   = dir_from_offset(stripe->directory.header->freelist[s], seg);
+  Dir *e   = stripe->directory.from_offset(stripe->directory.header->freelist[s], seg);
   if (!e) {
     freelist_clean(s, stripe);
     return nullptr;
@@ -416,7 +484,7 @@ freelist_pop(int s, StripeSM *stripe)
     stripe->directory.init_segment(s);
     return nullptr;
   }
-  Dir *h = dir_from_offset(stripe->directory.header->freelist[s], seg);
+  Dir *h = stripe->directory.from_offset(stripe->directory.header->freelist[s], seg);
   if (h) {
     dir_set_prev(h, 0);
   }
@@ -428,10 +496,10 @@ Directory::free_entry(Dir *e, int s)
 {
   Dir         *seg = this->get_segment(s);
   unsigned int fo  = this->header->freelist[s];
-  unsigned int eo  = dir_to_offset(e, seg);
+  unsigned int eo  = this->to_offset(e, seg);
   dir_set_next(e, fo);
   if (fo) {
-    dir_set_prev(dir_from_offset(fo, seg), eo);
+    dir_set_prev(this->from_offset(fo, seg), eo);
   }
   this->header->freelist[s] = eo;
 }
@@ -440,18 +508,29 @@ int
 Directory::probe(const CacheKey *key, StripeSM *stripe, Dir *result, Dir **last_collision)
 {
   ink_assert(stripe->mutex->thread_holding == this_ethread());
-  int  s   = key->slice32(0) % this->segments;
-  int  b   = key->slice32(1) % this->buckets;
+  int s = key->slice32(0) % this->segments;
+  int b = key->slice32(1) % this->buckets;
+  this->validate_segment(s);
   Dir *seg = this->get_segment(s);
   Dir *e = nullptr, *p = nullptr, *collision = *last_collision;
   CHECK_DIR(d);
 #ifdef LOOP_CHECK_MODE
-  if (this->bucket_loop_fix(dir_bucket(b, seg), s))
+  if (this->bucket_loop_fix(this->bucket(b, seg), s))
     return 0;
 #endif
 Lagain:
-  e = dir_bucket(b, seg);
+  e = this->bucket(b, seg);
   if (dir_offset(e)) {
+    // Most misses resolve inside the bucket rows, check them all at once
+    // before walking the chain.
+    if (cache_config_dir_vectorized_probe && this->layout == DirLayout::CLASSIC && !collision) {
+      uint32_t base = this->to_offset(e, seg);
+      if (dir_bucket_scan_miss(e, base, dir_bucket_scan(e, base, key->slice32(2)))) {
+        DDbg(dbg_ctl_dir_probe_miss, "missed %X %X on vol %d bucket %d at %p (bucket scan)", key->slice32(0), key->slice32(1),
+             stripe->fd, b, seg);
+        return 0;
+      }
+    }
     do {
       if (dir_compare_tag(e, key)) {
         ink_assert(dir_offset(e));
@@ -482,7 +561,7 @@ Lagain:
         } else { // delete the invalid entry
           ts::Metrics::Gauge::decrement(cache_rsb.direntries_used);
           ts::Metrics::Gauge::decrement(stripe->cache_vol->vol_rsb.direntries_used);
-          ATS_PROBE7(cache_dir_remove_invalid, stripe->fd, s, dir_to_offset(e, seg), dir_offset(e), dir_approx_size(e),
+          ATS_PROBE7(cache_dir_remove_invalid, stripe->fd, s, this->to_offset(e, seg), dir_offset(e), dir_approx_size(e),
                      key->slice64(0), key->slice64(1));
           e = this->delete_entry(e, p, s);
           continue;
@@ -492,7 +571,7 @@ Lagain:
       }
     Lcont:
       p = e;
-      e = next_dir(e, seg);
+      e = this->next_dir(e, seg);
     } while (e);
   }
   if (collision) { // last collision no longer in the list, retry
@@ -514,15 +593,16 @@ Directory::insert(const CacheKey *key, StripeSM *stripe, Dir *to_part)
   int s  = key->slice32(0) % this->segments, l;
   int bi = key->slice32(1) % this->buckets;
   ink_assert(dir_approx_size(to_part) <= MAX_FRAG_SIZE + sizeof(Doc));
+  this->validate_segment(s);
   Dir *seg = this->get_segment(s);
   Dir *e   = nullptr;
-  Dir *b   = dir_bucket(bi, seg);
+  Dir *b   = this->bucket(bi, seg);
 #if defined(DEBUG) && defined(DO_CHECK_DIR_FAST)
   unsigned int t   = DIR_MASK_TAG(key->slice32(2));
   Dir         *col = b;
   while (col) {
     ink_assert((dir_tag(col) != t) || (dir_offset(col) != dir_offset(to_part)));
-    col = next_dir(col, seg);
+    col = this->next_dir(col, seg);
   }
 #endif
   CHECK_DIR(d);
@@ -533,12 +613,20 @@ Lagain:
   if (dir_is_empty(e)) {
     goto Lfill;
   }
-  for (l = 1; l < DIR_DEPTH; l++) {
-    e = dir_bucket_row(b, l);
-    if (dir_is_empty(e)) {
+  if (cache_config_dir_vectorized_probe && this->layout == DirLayout::CLASSIC) {
+    if (uint32_t empty = dir_bucket_scan(b, this->to_offset(b, seg), key->slice32(2)).empty; empty) {
+      e = dir_bucket_row(b, __builtin_ctz(empty));
       this->unlink_from_freelist(e, s);
       goto Llink;
     }
+  } else {
+    for (l = 1; l < this->depth(); l++) {
+      e = dir_bucket_row(b, l);
+      if (dir_is_empty(e)) {
+        this->unlink_from_freelist(e, s);
+        goto Llink;
+      }
+    }
   }
   // get one from the freelist
   e = freelist_pop(s, stripe);
@@ -556,21 +644,21 @@ Llink:
   last = b;
   do {
     prev = last;
-    last = next_dir(last, seg);
-  } while (last && (++l <= this->buckets * DIR_DEPTH));
+    last = this->next_dir(last, seg);
+  } while (last && (++l <= this->buckets * this->depth()));
 
   dir_set_next(e, 0);
-  dir_set_next(prev, dir_to_offset(e, seg));
+  dir_set_next(prev, this->to_offset(e, seg));
 Lfill:
   dir_assign_data(e, to_part);
   dir_set_tag(e, key->slice32(2));
   ink_assert(stripe->vol_offset(e) < (stripe->skip + stripe->len));
   DDbg(dbg_ctl_dir_insert, "insert %p %X into vol %d bucket %d at %p tag %X %X boffset %" PRId64 "", e, key->slice32(0), stripe->fd,
        bi, e, key->slice32(1), dir_tag(e), dir_offset(e));
-  ATS_PROBE7(cache_dir_insert, stripe->fd, s, dir_to_offset(e, seg), dir_offset(e), dir_approx_size(e), key->slice64(0),
+  ATS_PROBE7(cache_dir_insert, stripe->fd, s, this->to_offset(e, seg), dir_offset(e), dir_approx_size(e), key->slice64(0),
              key->slice64(1));
   CHECK_DIR(d);
-  stripe->directory.header->dirty = 1;
+  this->mark_dirty(s);
   ts::Metrics::Gauge::increment(cache_rsb.direntries_used);
   ts::Metrics::Gauge::increment(stripe->cache_vol->vol_rsb.direntries_used);
 
@@ -581,11 +669,12 @@ int
 Directory::overwrite(const CacheKey *key, StripeSM *stripe, Dir *dir, Dir *overwrite, bool must_overwrite)
 {
   ink_assert(stripe->mutex->thread_holding == this_ethread());
-  int          s   = key->slice32(0) % this->segments, l;
-  int          bi  = key->slice32(1) % this->buckets;
+  int s  = key->slice32(0) % this->segments, l;
+  int bi = key->slice32(1) % this->buckets;
+  this->validate_segment(s);
   Dir         *seg = this->get_segment(s);
   Dir         *e   = nullptr;
-  Dir         *b   = dir_bucket(bi, seg);
+  Dir         *b   = this->bucket(bi, seg);
   unsigned int t   = DIR_MASK_TAG(key->slice32(2));
   int          res = 1;
 #ifdef LOOP_CHECK_MODE
@@ -613,7 +702,7 @@ Lagain:
       if (dir_tag(e) == t && dir_offset(e) == dir_offset(overwrite)) {
         goto Lfill;
       }
-      e = next_dir(e, seg);
+      e = this->next_dir(e, seg);
     } while (e);
   }
   if (must_overwrite) {
@@ -627,12 +716,20 @@ Lagain:
     ts::Metrics::Gauge::increment(stripe->cache_vol->vol_rsb.direntries_used);
     goto Lfill;
   }
-  for (l = 1; l < DIR_DEPTH; l++) {
-    e = dir_bucket_row(b, l);
-    if (dir_is_empty(e)) {
+  if (cache_config_dir_vectorized_probe && this->layout == DirLayout::CLASSIC) {
+    if (uint32_t empty = dir_bucket_scan(b, this->to_offset(b, seg), t).empty; empty) {
+      e = dir_bucket_row(b, __builtin_ctz(empty));
       this->unlink_from_freelist(e, s);
       goto Llink;
     }
+  } else {
+    for (l = 1; l < this->depth(); l++) {
+      e = dir_bucket_row(b, l);
+      if (dir_is_empty(e)) {
+        this->unlink_from_freelist(e, s);
+        goto Llink;
+      }
+    }
   }
   // get one from the freelist
   e = freelist_pop(s, stripe);
@@ -649,11 +746,11 @@ Llink:
   last = b;
   do {
     prev = last;
-    last = next_dir(last, seg);
-  } while (last && (++l <= this->buckets * DIR_DEPTH));
+    last = this->next_dir(last, seg);
+  } while (last && (++l <= this->buckets * this->depth()));
 
   dir_set_next(e, 0);
-  dir_set_next(prev, dir_to_offset(e, seg));
+  dir_set_next(prev, this->to_offset(e, seg));
 Lfill:
   dir_assign_data(e, dir);
   dir_set_tag(e, t);
@@ -661,7 +758,7 @@ Lfill:
   DDbg(dbg_ctl_dir_overwrite, "overwrite %p %X into vol %d bucket %d at %p tag %X %X boffset %" PRId64 "", e, key->slice32(0),
        stripe->fd, bi, e, t, dir_tag(e), dir_offset(e));
   CHECK_DIR(d);
-  this->header->dirty = 1;
+  this->mark_dirty(s);
   return res;
 }
 
@@ -669,8 +766,9 @@ int
 Directory::remove(const CacheKey *key, StripeSM *stripe, Dir *del)
 {
   ink_assert(stripe->mutex->thread_holding == this_ethread());
-  int  s   = key->slice32(0) % this->segments;
-  int  b   = key->slice32(1) % this->buckets;
+  int s = key->slice32(0) % this->segments;
+  int b = key->slice32(1) % this->buckets;
+  this->validate_segment(s);
   Dir *seg = this->get_segment(s);
   Dir *e = nullptr, *p = nullptr;
 #ifdef LOOP_CHECK_MODE
@@ -678,13 +776,13 @@ Directory::remove(const CacheKey *key, StripeSM *stripe, Dir *del)
 #endif
   CHECK_DIR(vol);
 
-  e = dir_bucket(b, seg);
+  e = this->bucket(b, seg);
   if (dir_offset(e)) {
     do {
 #ifdef LOOP_CHECK_MODE
       loop_count++;
       if (loop_count > DIR_LOOP_THRESHOLD) {
-        if (this->bucket_loop_fix(dir_bucket(b, seg), s))
+        if (this->bucket_loop_fix(this->bucket(b, seg), s))
           return 0;
       }
 #endif
@@ -692,14 +790,14 @@ Directory::remove(const CacheKey *key, StripeSM *stripe, Dir *del)
       if (dir_compare_tag(e, key) && offset == dir_offset(del)) {
         ts::Metrics::Gauge::decrement(cache_rsb.direntries_used);
         ts::Metrics::Gauge::decrement(stripe->cache_vol->vol_rsb.direntries_used);
-        ATS_PROBE7(cache_dir_remove, stripe->fd, s, dir_to_offset(e, seg), offset, dir_approx_size(e), key->slice64(0),
+        ATS_PROBE7(cache_dir_remove, stripe->fd, s, this->to_offset(e, seg), offset, dir_approx_size(e), key->slice64(0),
                    key->slice64(1));
         this->delete_entry(e, p, s);
         CHECK_DIR(d);
         return 1;
       }
       p = e;
-      e = next_dir(e, seg);
+      e = this->next_dir(e, seg);
     } while (e);
   }
   CHECK_DIR(vol);
@@ -880,6 +978,63 @@ CacheSync::aio_write(int fd, char *b, int n, off_t o)
   ink_assert(ink_aio_write(&io) >= 0);
 }
 
+/* Lays out the writes that sync the directory of @a stripe to on-disk copy
+   @a copy and snapshots the bytes they cover into buf. Incremental syncs
+   include only the segments changed since that copy was last written,
+   merging runs of adjacent segments into one write.
+ */
+void
+CacheSync::plan_writes(StripeSM *stripe, int copy)
+{
+  Directory &directory = stripe->directory;
+  off_t      headerlen = stripe->headerlen();
+  off_t      footerlen = ROUND_TO_STORE_BLOCK(sizeof(StripeHeaderFooter));
+  off_t      dirlen    = stripe->dirlen();
+  off_t      seglen    = directory.buckets * directory.bucket_size();
+  int        skipped   = 0;
+
+  writes.clear();
+  write_index = 0;
+  segments_written.clear();
+  pass_bytes = 0;
+
+  auto add = [&](off_t pos, off_t end) {
+    memcpy(buf + pos, directory.raw_dir + pos, end - pos);
+    while (pos < end) {
+      off_t l = std::min<off_t>(end - pos, cache_config_dir_sync_max_write);
+      writes.emplace_back(pos, l);
+      pos += l;
+    }
+  };
+
+  // The header carries the new sync serial and the freelist heads.
+  add(0, headerlen);
+  for (int s = 0; s < directory.segments;) {
+    if (cache_config_dir_sync_incremental && !directory.segment_dirty(s, copy)) {
+      ++skipped;
+      ++s;
+      continue;
+    }
+    int first = s;
+    do {
+      segments_written.emplace_back(s, directory.segment_version[s]);
+      ++s;
+    } while (s < directory.segments && (!cache_config_dir_sync_incremental || directory.segment_dirty(s, copy)));
+    // Segments do not start on store block boundaries, so round the run out
+    // to whole blocks. Any neighbouring bytes this pulls in belong to
+    // segments that are either unchanged since this copy was written or are
+    // being written anyway.
+    off_t pos = headerlen + (first * seglen) / STORE_BLOCK_SIZE * STORE_BLOCK_SIZE;
+    off_t end = std::min(headerlen + static_cast<off_t>(ROUND_TO_STORE_BLOCK(s * seglen)), dirlen - footerlen);
+    add(pos, end);
+  }
+  // The footer goes last, a copy is only valid once it matches the header.
+  add(dirlen - footerlen, dirlen);
+
+  ts::Metrics::Counter::increment(cache_rsb.directory_sync_segments_skipped, skipped);
+  ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.directory_sync_segments_skipped, skipped);
+}
+
 uint64_t
 Directory::entries_used()
 {
@@ -889,7 +1044,7 @@ Directory::entries_used()
     Dir *seg = this->get_segment(s);
     sfull    = 0;
     for (int b = 0; b < this->buckets; b++) {
-      Dir *e = dir_bucket(b, seg);
+      Dir *e = this->bucket(b, seg);
       if (this->bucket_loop_fix(e, s)) {
         sfull = 0;
         break;
@@ -898,7 +1053,7 @@ Directory::entries_used()
         if (dir_offset(e)) {
           sfull++;
         }
-        e = next_dir(e, seg);
+        e = this->next_dir(e, seg);
         if (!e) {
           break;
         }
@@ -991,6 +1146,7 @@ Lrestart:
     }
     ts::Metrics::Counter::increment(cache_rsb.directory_sync_bytes, io.aio_result);
     ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.directory_sync_bytes, io.aio_result);
+    pass_bytes += io.aio_result;
     trigger = eventProcessor.schedule_in(this, HRTIME_MSECONDS(cache_config_dir_sync_delay));
     return EVENT_CONT;
   }
@@ -1007,13 +1163,12 @@ Lrestart:
 
     stripe->recompute_hit_evacuate_window();
 
-    if (DISK_BAD(stripe->disk)) {
+    if (DISK_BAD(stripe->disk) || !stripe->is_ready()) {
       goto Ldone;
     }
 
-    int    headerlen = ROUND_TO_STORE_BLOCK(sizeof(StripeHeaderFooter));
-    size_t dirlen    = stripe->dirlen();
-    if (!writepos) {
+    size_t dirlen = stripe->dirlen();
+    if (writes.empty()) {
       // start
       Dbg(dbg_ctl_cache_dir_sync, "sync started");
       /* Don't sync the directory to disk if its not dirty. Syncing the
@@ -1025,7 +1180,7 @@ Lrestart:
         Dbg(dbg_ctl_cache_dir_sync, "Dir %s not dirty", stripe->hash_text.get());
         goto Ldone;
       }
-      if (stripe->is_io_in_progress() || stripe->get_agg_buf_pos()) {
+      if (stripe->is_io_in_progress() || stripe->is_agg_write_in_flight() || stripe->get_agg_buf_pos()) {
         Dbg(dbg_ctl_cache_dir_sync, "Dir %s: waiting for agg buffer", stripe->hash_text.get());
         stripe->dir_sync_waiting = true;
         stripe->waiting_dir_sync = this;
@@ -1059,42 +1214,39 @@ Lrestart:
       stripe->directory.header->sync_serial++;
       stripe->directory.footer->sync_serial = stripe->directory.header->sync_serial;
       CHECK_DIR(d);
-      memcpy(buf, stripe->directory.raw_dir, dirlen);
+      this->plan_writes(stripe, stripe->directory.header->sync_serial & 1);
       stripe->dir_sync_in_progress = true;
     }
     size_t B     = stripe->directory.header->sync_serial & 1;
     off_t  start = stripe->skip + (B ? dirlen : 0);
 
-    if (!writepos) {
-      // write header
-      aio_write(stripe->fd, buf + writepos, headerlen, start + writepos);
-      writepos += headerlen;
-    } else if (writepos < static_cast<off_t>(dirlen) - headerlen) {
-      // write part of body
-      int l = cache_config_dir_sync_max_write;
-      if (writepos + l > static_cast<off_t>(dirlen) - headerlen) {
-        l = dirlen - headerlen - writepos;
-      }
-      aio_write(stripe->fd, buf + writepos, l, start + writepos);
-      writepos += l;
-    } else if (writepos < static_cast<off_t>(dirlen)) {
-      ink_assert(writepos == (off_t)dirlen - headerlen);
-      // write footer
-      aio_write(stripe->fd, buf + writepos, headerlen, start + writepos);
-      writepos += headerlen;
+    if (write_index < writes.size()) {
+      auto [pos, len] = writes[write_index++];
+      aio_write(stripe->fd, buf + pos, len, start + pos);
     } else {
+      for (auto [s, version] : segments_written) {
+        stripe->directory.synced_version[B][s] = version;
+      }
+      ink_hrtime elapsed           = ink_get_hrtime() - start_time;
       stripe->dir_sync_in_progress = false;
       ts::Metrics::Counter::increment(cache_rsb.directory_sync_count);
       ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.directory_sync_count);
-      ts::Metrics::Counter::increment(cache_rsb.directory_sync_time, ink_get_hrtime() - start_time);
-      ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.directory_sync_time, ink_get_hrtime() - start_time);
+      ts::Metrics::Counter::increment(cache_rsb.directory_sync_time, elapsed);
+      ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.directory_sync_time, elapsed);
+      ts::Metrics::Gauge::store(cache_rsb.directory_sync_pass_bytes, pass_bytes);
+      ts::Metrics::Gauge::store(stripe->cache_vol->vol_rsb.directory_sync_pass_bytes, pass_bytes);
+      ts::Metrics::Gauge::store(cache_rsb.directory_sync_pass_time, elapsed);
+      ts::Metrics::Gauge::store(stripe->cache_vol->vol_rsb.directory_sync_pass_time, elapsed);
+      Dbg(dbg_ctl_cache_dir_sync, "Dir %s: synced %zu of %d segments, %" PRId64 " bytes in %" PRId64 " ms", stripe->hash_text.get(),
+          segments_written.size(), stripe->directory.segments, pass_bytes, ink_hrtime_to_msec(elapsed));
       start_time = 0;
       goto Ldone;
     }
     return EVENT_CONT;
   }
 Ldone:
-  writepos = 0;
+  writes.clear();
+  write_index = 0;
   current_index++;
   goto Lrestart;
 }
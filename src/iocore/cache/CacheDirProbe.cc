@@ -0,0 +1,178 @@
+/** @file
+
+  Vectorized cache directory bucket scan.
+
+  The rows of a directory bucket are stored contiguously as DIR_DEPTH
+  five-word @c Dir entries. Rather than decoding them one at a time through
+  the @c dir_* accessors, the bucket is loaded as a vector of 16 bit words
+  and the tag, offset and next fields of every row are tested in parallel.
+  The kernel is compiled for each target supported by Highway and the best
+  one is selected at runtime.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_CacheDir.h"
+
+#include <cstring>
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "CacheDirProbe.cc"
+#include "hwy/foreach_target.h" // IWYU pragma: keep
+#include "hwy/highway.h"
+
+// This part is compiled once per Highway target.
+HWY_BEFORE_NAMESPACE();
+namespace cache_dir_probe
+{
+namespace HWY_NAMESPACE
+{
+  namespace hn = hwy::HWY_NAMESPACE;
+
+  // Number of 16 bit words in a bucket, and in the zero padded copy of it
+  // that is actually scanned so that full vector loads never leave the buffer.
+  constexpr size_t BUCKET_WORDS = DIR_DEPTH * (SIZEOF_DIR / sizeof(uint16_t));
+  constexpr size_t SCAN_WORDS   = 32;
+
+  static_assert(SIZEOF_DIR == 5 * sizeof(uint16_t), "bucket scan assumes five 16 bit words per Dir");
+  static_assert(BUCKET_WORDS <= SCAN_WORDS, "bucket does not fit the scan buffer");
+  static_assert(DIR_DEPTH == 4, "lane tables are laid out for four rows per bucket");
+
+  // Lane classes within a row: the offset is spread over w[0], the low byte
+  // of w[1] and w[4], the tag lives in w[2] and the chain link in w[3].
+  alignas(64) constexpr uint16_t OFFSET_WORD_MASK[SCAN_WORDS] = {
+    0xFFFF, 0x00FF, 0, 0, 0xFFFF, // row 0
+    0xFFFF, 0x00FF, 0, 0, 0xFFFF, // row 1
+    0xFFFF, 0x00FF, 0, 0, 0xFFFF, // row 2
+    0xFFFF, 0x00FF, 0, 0, 0xFFFF, // row 3
+  };
+  alignas(64) constexpr uint16_t TAG_LANE[SCAN_WORDS] = {
+    0, 0, 0xFFFF, 0, 0, 0, 0, 0xFFFF, 0, 0, 0, 0, 0xFFFF, 0, 0, 0, 0, 0xFFFF, 0, 0,
+  };
+  alignas(64) constexpr uint16_t NEXT_LANE[SCAN_WORDS] = {
+    0, 0, 0, 0xFFFF, 0, 0, 0, 0, 0xFFFF, 0, 0, 0, 0, 0xFFFF, 0, 0, 0, 0, 0xFFFF, 0,
+  };
+
+  DirBucketScan
+  ScanBucket(const uint16_t *words, uint32_t base, uint32_t tag)
+  {
+    alignas(64) uint16_t buf[SCAN_WORDS] = {};
+    memcpy(buf, words, BUCKET_WORDS * sizeof(uint16_t));
+
+    const hn::CappedTag<uint16_t, SCAN_WORDS> d;
+    const size_t                              N = hn::Lanes(d);
+
+    const auto v_zero     = hn::Zero(d);
+    const auto v_tag_mask = hn::Set(d, static_cast<uint16_t>((1 << DIR_TAG_WIDTH) - 1));
+    const auto v_tag      = hn::Set(d, static_cast<uint16_t>(DIR_MASK_TAG(tag)));
+    // A link is local if it is 0 (end of chain) or names row 1 .. DIR_DEPTH - 1
+    // of this bucket, which with unsigned wraparound is (next - (base + 1)) < DIR_DEPTH - 1.
+    const auto v_first = hn::Set(d, static_cast<uint16_t>(base + 1));
+    const auto v_span  = hn::Set(d, static_cast<uint16_t>(DIR_DEPTH - 1));
+
+    // Every lane answers the question for its own word class, so a single
+    // mask holds the tag, offset and link results for all rows.
+    uint64_t lanes = 0;
+    for (size_t i = 0; i < BUCKET_WORDS; i += N) {
+      const auto v       = hn::Load(d, buf + i);
+      const auto m_tag   = hn::Eq(hn::And(v, v_tag_mask), v_tag);
+      const auto m_used  = hn::Ne(hn::And(v, hn::Load(d, OFFSET_WORD_MASK + i)), v_zero);
+      const auto m_local = hn::Or(hn::Eq(v, v_zero), hn::Lt(hn::Sub(v, v_first), v_span));
+      const auto is_tag  = hn::MaskFromVec(hn::Load(d, TAG_LANE + i));
+      const auto is_next = hn::MaskFromVec(hn::Load(d, NEXT_LANE + i));
+      const auto m_row =
+        hn::Or(hn::Or(hn::And(is_tag, m_tag), hn::And(is_next, m_local)), hn::AndNot(hn::Or(is_tag, is_next), m_used));
+
+      uint8_t  bits[8] = {};
+      uint64_t chunk   = 0;
+      hn::StoreMaskBits(d, m_row, bits);
+      memcpy(&chunk, bits, sizeof(chunk));
+      lanes |= chunk << i;
+    }
+
+    DirBucketScan scan;
+    for (int r = 0; r < DIR_DEPTH; ++r, lanes >>= 5) {
+      scan.tag_match  |= static_cast<uint32_t>((lanes >> 2) & 1) << r;
+      scan.local_next |= static_cast<uint32_t>((lanes >> 3) & 1) << r;
+      scan.empty      |= static_cast<uint32_t>((lanes & 0b10011) == 0) << r;
+    }
+    return scan;
+  }
+
+} // namespace HWY_NAMESPACE
+} // namespace cache_dir_probe
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+
+namespace cache_dir_probe
+{
+HWY_EXPORT(ScanBucket);
+} // namespace cache_dir_probe
+
+DirBucketScan
+dir_bucket_scan(const Dir *b, uint32_t base, uint32_t tag)
+{
+  return HWY_DYNAMIC_DISPATCH(cache_dir_probe::ScanBucket)(b->w, base, tag);
+}
+
+DirBucketScan
+dir_bucket_scan_scalar(const Dir *b, uint32_t base, uint32_t tag)
+{
+  DirBucketScan scan;
+  uint32_t      t = DIR_MASK_TAG(tag);
+  for (int r = 0; r < DIR_DEPTH; ++r) {
+    const Dir *e    = dir_bucket_row(const_cast<Dir *>(b), r);
+    uint32_t   next = dir_next(e);
+    if (dir_tag(e) == t) {
+      scan.tag_match |= 1u << r;
+    }
+    if (dir_is_empty(e)) {
+      scan.empty |= 1u << r;
+    }
+    if (next == 0 || (next > base && next < base + DIR_DEPTH)) {
+      scan.local_next |= 1u << r;
+    }
+  }
+  return scan;
+}
+
+bool
+dir_bucket_scan_miss(const Dir *b, uint32_t base, const DirBucketScan &scan)
+{
+  // Follow the chain from the head row for as long as it stays inside the
+  // bucket. Any tag match, a link leaving the bucket or a revisited row means
+  // the caller has to walk the chain itself.
+  uint32_t seen = 0;
+  int      r    = 0;
+  for (;;) {
+    uint32_t bit = 1u << r;
+    if ((scan.tag_match & bit) || !(scan.local_next & bit) || (seen & bit)) {
+      return false;
+    }
+    seen         |= bit;
+    uint32_t next = dir_next(dir_bucket_row(const_cast<Dir *>(b), r));
+    if (next == 0) {
+      return true;
+    }
+    r = next - base;
+  }
+}
+
+#endif // HWY_ONCE
@@ -54,6 +54,22 @@ CacheDisk::incrErrors(const AIOCallback *io)
   Warning("failed operation: %s (opcode=%d), span: %s (fd=%d)", opname, opcode, path, fd);
 }
 
+ink_hrtime
+CacheDisk::charge_write_budget(int64_t bytes, int64_t bytes_per_sec)
+{
+  ink_hrtime now   = ink_get_hrtime();
+  ink_hrtime cost  = bytes * HRTIME_SECOND / bytes_per_sec;
+  ink_hrtime clock = write_budget_clock.load(std::memory_order_relaxed);
+  // A write may go once the earlier ones are paid for. The charge starts from
+  // now, so an idle disk does not bank bandwidth for a later burst.
+  do {
+    if (clock > now) {
+      return clock - now;
+    }
+  } while (!write_budget_clock.compare_exchange_weak(clock, now + cost, std::memory_order_relaxed));
+  return 0;
+}
+
 int
 CacheDisk::open(char *s, off_t blocks, off_t askip, int ahw_sector_size, int fildes, bool clear)
 {
@@ -163,7 +163,7 @@ CachePeriodicMetricsUpdate()
 inline int64_t
 cache_bytes_used(int index)
 {
-  if (!DISK_BAD(gstripes[index]->disk)) {
+  if (!DISK_BAD(gstripes[index]->disk) && gstripes[index]->is_ready()) {
     if (!gstripes[index]->directory.header->cycle) {
       return gstripes[index]->directory.header->write_pos - gstripes[index]->start;
     } else {
@@ -386,7 +386,9 @@ int
 CacheProcessor::dir_check(bool /* afix ATS_UNUSED */)
 {
   for (int i = 0; i < gnstripes; i++) {
-    gstripes[i]->dir_check();
+    if (gstripes[i]->is_ready()) {
+      gstripes[i]->dir_check();
+    }
   }
   return 0;
 }
@@ -478,7 +480,7 @@ CacheProcessor::mark_storage_offline(CacheDisk *d, ///< Target disk
   for (p = 0; p < gnstripes; p++) {
     if (d->fd == gstripes[p]->fd) {
       total_dir_delete   += gstripes[p]->directory.entries();
-      used_dir_delete    += gstripes[p]->directory.entries_used();
+      used_dir_delete    += gstripes[p]->is_ready() ? gstripes[p]->directory.entries_used() : 0;
       total_bytes_delete += gstripes[p]->len - gstripes[p]->dirlen();
     }
   }
@@ -1178,44 +1180,68 @@ register_cache_stats(CacheStatsBlock *rsb, const std::string &prefix)
   rsb->fragment_document_count[1] = ts::Metrics::Counter::createPtr(prefix + ".frags_per_doc.2");
   rsb->fragment_document_count[2] = ts::Metrics::Counter::createPtr(prefix + ".frags_per_doc.3+");
 
+  // Buckets of aggregation write latency
+  rsb->agg_write_latency[0] = ts::Metrics::Counter::createPtr(prefix + ".agg_write.latency.lt_1ms");
+  rsb->agg_write_latency[1] = ts::Metrics::Counter::createPtr(prefix + ".agg_write.latency.lt_4ms");
+  rsb->agg_write_latency[2] = ts::Metrics::Counter::createPtr(prefix + ".agg_write.latency.lt_16ms");
+  rsb->agg_write_latency[3] = ts::Metrics::Counter::createPtr(prefix + ".agg_write.latency.lt_64ms");
+  rsb->agg_write_latency[4] = ts::Metrics::Counter::createPtr(prefix + ".agg_write.latency.lt_256ms");
+  rsb->agg_write_latency[5] = ts::Metrics::Counter::createPtr(prefix + ".agg_write.latency.ge_256ms");
+
   // And then everything else
-  rsb->bytes_used             = ts::Metrics::Gauge::createPtr(prefix + ".bytes_used");
-  rsb->bytes_total            = ts::Metrics::Gauge::createPtr(prefix + ".bytes_total");
-  rsb->stripes                = ts::Metrics::Gauge::createPtr(prefix + ".stripes");
-  rsb->ram_cache_bytes_total  = ts::Metrics::Gauge::createPtr(prefix + ".ram_cache.total_bytes");
-  rsb->ram_cache_bytes        = ts::Metrics::Gauge::createPtr(prefix + ".ram_cache.bytes_used");
-  rsb->ram_cache_hits         = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.hits");
-  rsb->last_open_read_hits    = ts::Metrics::Counter::createPtr(prefix + ".last_open_read.hits");
-  rsb->agg_buffer_hits        = ts::Metrics::Counter::createPtr(prefix + ".aggregation_buffer.hits");
-  rsb->ram_cache_misses       = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.misses");
-  rsb->all_mem_misses         = ts::Metrics::Counter::createPtr(prefix + ".all_memory_caches.misses");
-  rsb->pread_count            = ts::Metrics::Counter::createPtr(prefix + ".pread_count");
-  rsb->percent_full           = ts::Metrics::Gauge::createPtr(prefix + ".percent_full");
-  rsb->read_seek_fail         = ts::Metrics::Counter::createPtr(prefix + ".read.seek.failure");
-  rsb->read_invalid           = ts::Metrics::Counter::createPtr(prefix + ".read.invalid");
-  rsb->write_backlog_failure  = ts::Metrics::Counter::createPtr(prefix + ".write.backlog.failure");
-  rsb->direntries_total       = ts::Metrics::Gauge::createPtr(prefix + ".direntries.total");
-  rsb->direntries_used        = ts::Metrics::Gauge::createPtr(prefix + ".direntries.used");
-  rsb->directory_collision    = ts::Metrics::Counter::createPtr(prefix + ".directory_collision");
-  rsb->read_busy_success      = ts::Metrics::Counter::createPtr(prefix + ".read_busy.success");
-  rsb->read_busy_failure      = ts::Metrics::Counter::createPtr(prefix + ".read_busy.failure");
-  rsb->write_bytes            = ts::Metrics::Counter::createPtr(prefix + ".write_bytes_stat");
-  rsb->hdr_vector_marshal     = ts::Metrics::Counter::createPtr(prefix + ".vector_marshals");
-  rsb->hdr_marshal            = ts::Metrics::Counter::createPtr(prefix + ".hdr_marshals");
-  rsb->hdr_marshal_bytes      = ts::Metrics::Counter::createPtr(prefix + ".hdr_marshal_bytes");
-  rsb->gc_bytes_evacuated     = ts::Metrics::Counter::createPtr(prefix + ".gc_bytes_evacuated");
-  rsb->gc_frags_evacuated     = ts::Metrics::Counter::createPtr(prefix + ".gc_frags_evacuated");
-  rsb->directory_wrap         = ts::Metrics::Counter::createPtr(prefix + ".wrap_count");
-  rsb->directory_sync_count   = ts::Metrics::Counter::createPtr(prefix + ".sync.count");
-  rsb->directory_sync_bytes   = ts::Metrics::Counter::createPtr(prefix + ".sync.bytes");
-  rsb->directory_sync_time    = ts::Metrics::Counter::createPtr(prefix + ".sync.time");
-  rsb->span_errors_read       = ts::Metrics::Counter::createPtr(prefix + ".span.errors.read");
-  rsb->span_errors_write      = ts::Metrics::Counter::createPtr(prefix + ".span.errors.write");
-  rsb->span_failing           = ts::Metrics::Gauge::createPtr(prefix + ".span.failing");
-  rsb->span_offline           = ts::Metrics::Gauge::createPtr(prefix + ".span.offline");
-  rsb->span_online            = ts::Metrics::Gauge::createPtr(prefix + ".span.online");
-  rsb->stripe_lock_contention = ts::Metrics::Counter::createPtr(prefix + ".stripe.lock_contention");
-  rsb->writer_lock_contention = ts::Metrics::Counter::createPtr(prefix + ".writer.lock_contention");
+  rsb->bytes_used                      = ts::Metrics::Gauge::createPtr(prefix + ".bytes_used");
+  rsb->bytes_total                     = ts::Metrics::Gauge::createPtr(prefix + ".bytes_total");
+  rsb->stripes                         = ts::Metrics::Gauge::createPtr(prefix + ".stripes");
+  rsb->stripes_ready                   = ts::Metrics::Gauge::createPtr(prefix + ".stripes.ready");
+  rsb->ram_cache_bytes_total           = ts::Metrics::Gauge::createPtr(prefix + ".ram_cache.total_bytes");
+  rsb->ram_cache_bytes                 = ts::Metrics::Gauge::createPtr(prefix + ".ram_cache.bytes_used");
+  rsb->ram_cache_hits                  = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.hits");
+  rsb->last_open_read_hits             = ts::Metrics::Counter::createPtr(prefix + ".last_open_read.hits");
+  rsb->agg_buffer_hits                 = ts::Metrics::Counter::createPtr(prefix + ".aggregation_buffer.hits");
+  rsb->ram_cache_misses                = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.misses");
+  rsb->ram_cache_admission_rejects     = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.admission_rejects");
+  rsb->ram_cache_unlocked_hits         = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.unlocked_hits");
+  rsb->ram_cache_compressions          = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.compressions");
+  rsb->ram_cache_compress_time         = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.compress_time");
+  rsb->ram_cache_decompressions        = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.decompressions");
+  rsb->ram_cache_decompress_time       = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.decompress_time");
+  rsb->all_mem_misses                  = ts::Metrics::Counter::createPtr(prefix + ".all_memory_caches.misses");
+  rsb->pread_count                     = ts::Metrics::Counter::createPtr(prefix + ".pread_count");
+  rsb->percent_full                    = ts::Metrics::Gauge::createPtr(prefix + ".percent_full");
+  rsb->read_seek_fail                  = ts::Metrics::Counter::createPtr(prefix + ".read.seek.failure");
+  rsb->read_invalid                    = ts::Metrics::Counter::createPtr(prefix + ".read.invalid");
+  rsb->write_backlog_failure           = ts::Metrics::Counter::createPtr(prefix + ".write.backlog.failure");
+  rsb->agg_write_in_flight             = ts::Metrics::Gauge::createPtr(prefix + ".agg_write.in_flight");
+  rsb->agg_write_throttled             = ts::Metrics::Counter::createPtr(prefix + ".agg_write.throttled");
+  rsb->direntries_total                = ts::Metrics::Gauge::createPtr(prefix + ".direntries.total");
+  rsb->direntries_used                 = ts::Metrics::Gauge::createPtr(prefix + ".direntries.used");
+  rsb->directory_collision             = ts::Metrics::Counter::createPtr(prefix + ".directory_collision");
+  rsb->read_busy_success               = ts::Metrics::Counter::createPtr(prefix + ".read_busy.success");
+  rsb->read_busy_failure               = ts::Metrics::Counter::createPtr(prefix + ".read_busy.failure");
+  rsb->rww_fragments_published         = ts::Metrics::Counter::createPtr(prefix + ".read_while_writer.fragments_published");
+  rsb->rww_fragments_shared            = ts::Metrics::Counter::createPtr(prefix + ".read_while_writer.fragments_shared");
+  rsb->rww_reader_lag                  = ts::Metrics::Counter::createPtr(prefix + ".read_while_writer.reader_lag");
+  rsb->rww_lag_fallbacks               = ts::Metrics::Counter::createPtr(prefix + ".read_while_writer.lag_fallbacks");
+  rsb->write_bytes                     = ts::Metrics::Counter::createPtr(prefix + ".write_bytes_stat");
+  rsb->hdr_vector_marshal              = ts::Metrics::Counter::createPtr(prefix + ".vector_marshals");
+  rsb->hdr_marshal                     = ts::Metrics::Counter::createPtr(prefix + ".hdr_marshals");
+  rsb->hdr_marshal_bytes               = ts::Metrics::Counter::createPtr(prefix + ".hdr_marshal_bytes");
+  rsb->gc_bytes_evacuated              = ts::Metrics::Counter::createPtr(prefix + ".gc_bytes_evacuated");
+  rsb->gc_frags_evacuated              = ts::Metrics::Counter::createPtr(prefix + ".gc_frags_evacuated");
+  rsb->directory_wrap                  = ts::Metrics::Counter::createPtr(prefix + ".wrap_count");
+  rsb->directory_sync_count            = ts::Metrics::Counter::createPtr(prefix + ".sync.count");
+  rsb->directory_sync_bytes            = ts::Metrics::Counter::createPtr(prefix + ".sync.bytes");
+  rsb->directory_sync_time             = ts::Metrics::Counter::createPtr(prefix + ".sync.time");
+  rsb->directory_sync_pass_bytes       = ts::Metrics::Gauge::createPtr(prefix + ".sync.pass_bytes");
+  rsb->directory_sync_pass_time        = ts::Metrics::Gauge::createPtr(prefix + ".sync.pass_time");
+  rsb->directory_sync_segments_skipped = ts::Metrics::Counter::createPtr(prefix + ".sync.segments_skipped");
+  rsb->span_errors_read                = ts::Metrics::Counter::createPtr(prefix + ".span.errors.read");
+  rsb->span_errors_write               = ts::Metrics::Counter::createPtr(prefix + ".span.errors.write");
+  rsb->span_failing                    = ts::Metrics::Gauge::createPtr(prefix + ".span.failing");
+  rsb->span_offline                    = ts::Metrics::Gauge::createPtr(prefix + ".span.offline");
+  rsb->span_online                     = ts::Metrics::Gauge::createPtr(prefix + ".span.online");
+  rsb->stripe_lock_contention          = ts::Metrics::Counter::createPtr(prefix + ".stripe.lock_contention");
+  rsb->writer_lock_contention          = ts::Metrics::Counter::createPtr(prefix + ".writer.lock_contention");
 }
 
 // Copy the per-volume tuning fields from the volume config onto the CacheVol.
@@ -1480,13 +1506,17 @@ CacheProcessor::cacheInitialized()
     caches[CACHE_FRAG_TYPE_NONE] = theCache;
   }
 
-  // Update stripe version data.
-  if (gnstripes) { // start with whatever the first stripe is.
-    cacheProcessor.min_stripe_version = cacheProcessor.max_stripe_version = gstripes[0]->directory.header->version;
-  }
-  // scan the rest of the stripes.
-  for (int i = 1; i < gnstripes; i++) {
+  // Update stripe version data, from the stripes that have loaded their directory.
+  bool have_version = false;
+  for (int i = 0; i < gnstripes; i++) {
     StripeSM *v = gstripes[i];
+    if (!v->is_ready()) {
+      continue;
+    }
+    if (!have_version) { // start with whatever the first stripe is.
+      cacheProcessor.min_stripe_version = cacheProcessor.max_stripe_version = v->directory.header->version;
+      have_version                                                          = true;
+    }
     if (v->directory.header->version < cacheProcessor.min_stripe_version) {
       cacheProcessor.min_stripe_version = v->directory.header->version;
     }
@@ -1505,19 +1535,28 @@ CacheProcessor::cacheInitialized()
       int const                ram_alg                    = cache_config_ram_cache_algorithm;
       Dbg(dbg_ctl_cache_init, "ram_cache algorithm = %d (%s)", ram_alg,
           (ram_alg >= 0 && ram_alg <= RAM_CACHE_ALGORITHM_S3FIFO) ? ram_cache_algorithm_name[ram_alg] : "unknown");
+      RamCache *(*new_ram_cache)() = nullptr;
+      switch (cache_config_ram_cache_algorithm) {
+      default:
+      case RAM_CACHE_ALGORITHM_CLFUS:
+        new_ram_cache = new_RamCacheCLFUS;
+        break;
+      case RAM_CACHE_ALGORITHM_LRU:
+        new_ram_cache = new_RamCacheLRU;
+        break;
+      case RAM_CACHE_ALGORITHM_S3FIFO:
+        new_ram_cache = new_RamCacheS3FIFO;
+        break;
+      }
+      // In NUMA mode every node gets its own shards, at least one.
+      int const  ram_nodes   = std::max(eventProcessor.numa_nodes, 1);
+      bool const ram_sharded = cache_config_ram_cache_shards > 1 || ram_nodes > 1;
+      if (ram_sharded) {
+        Dbg(dbg_ctl_cache_init, "ram_cache shards = %d, NUMA nodes = %d", cache_config_ram_cache_shards, ram_nodes);
+      }
       for (int i = 0; i < gnstripes; i++) {
-        switch (cache_config_ram_cache_algorithm) {
-        default:
-        case RAM_CACHE_ALGORITHM_CLFUS:
-          gstripes[i]->ram_cache = new_RamCacheCLFUS();
-          break;
-        case RAM_CACHE_ALGORITHM_LRU:
-          gstripes[i]->ram_cache = new_RamCacheLRU();
-          break;
-        case RAM_CACHE_ALGORITHM_S3FIFO:
-          gstripes[i]->ram_cache = new_RamCacheS3FIFO();
-          break;
-        }
+        gstripes[i]->ram_cache =
+          ram_sharded ? new_RamCacheSharded(new_ram_cache, cache_config_ram_cache_shards, ram_nodes) : new_ram_cache();
       }
 
       // Calculate total private RAM allocations from per-volume configurations
@@ -1644,7 +1683,8 @@ CacheProcessor::cacheInitialized()
 
         uint64_t vol_total_cache_bytes = stripe->len - stripe->dirlen();
         uint64_t vol_total_direntries  = stripe->directory.entries();
-        uint64_t vol_used_direntries   = stripe->directory.entries_used();
+        // A stripe loading asynchronously counts its own entries once loaded.
+        uint64_t vol_used_direntries = stripe->is_async_load() ? 0 : stripe->directory.entries_used();
 
         total_cache_bytes += vol_total_cache_bytes;
         ts::Metrics::Gauge::increment(stripe->cache_vol->vol_rsb.bytes_total, vol_total_cache_bytes);
@@ -1670,6 +1710,16 @@ CacheProcessor::cacheInitialized()
       case CACHE_COMPRESSION_LIBLZMA:
 #ifndef HAVE_LZMA_H
         Fatal("lzma not available for RAM cache compression");
+#endif
+        break;
+      case CACHE_COMPRESSION_ZSTD:
+#ifndef HAVE_ZSTD_H
+        Fatal("zstd not available for RAM cache compression");
+#endif
+        break;
+      case CACHE_COMPRESSION_LZ4:
+#ifndef HAVE_LZ4_H
+        Fatal("lz4 not available for RAM cache compression");
 #endif
         break;
       }
@@ -1677,7 +1727,7 @@ CacheProcessor::cacheInitialized()
       ts::Metrics::Gauge::store(cache_rsb.ram_cache_bytes_total, total_ram_cache_bytes);
       ts::Metrics::Gauge::store(cache_rsb.bytes_total, total_cache_bytes);
       ts::Metrics::Gauge::store(cache_rsb.direntries_total, total_direntries);
-      ts::Metrics::Gauge::store(cache_rsb.direntries_used, used_direntries);
+      ts::Metrics::Gauge::increment(cache_rsb.direntries_used, used_direntries);
 
       if (!check) {
         dir_sync_init();
@@ -48,6 +48,28 @@ DbgCtl dbg_ctl_cache_hit_evac{"cache_hit_evac"};
 
 constexpr int MAX_READ_RECURSION_DEPTH = 10;
 
+// The data of a fragment left in the stripe, handed to the reader to be sent with sendfile(2).
+class CacheFileRange : public IOBufferFileRange
+{
+public:
+  CacheFileRange(StripeSM *stripe, const Dir &dir, int64_t reach, int64_t pos, int64_t len)
+    : IOBufferFileRange(stripe->fd, stripe->vol_offset(&dir) + pos, len), _stripe(stripe), _reach(reach + pos)
+  {
+  }
+
+  // Called from the net thread, without the stripe lock. The writer claims the data it is about to
+  // write over before it issues the write, so the range is intact until it has claimed up to it.
+  bool
+  still_valid() const override
+  {
+    return _stripe->write_reach() <= _reach;
+  }
+
+private:
+  StripeSM *_stripe;
+  int64_t   _reach;
+};
+
 } // end anonymous namespace
 
 uint32_t
@@ -674,8 +696,14 @@ CacheVC::openReadMain(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
   if (bytes > vio.ntodo()) {
     bytes = vio.ntodo();
   }
-  b           = new_IOBufferBlock(buf, bytes, doc_pos);
-  b->_buf_end = b->_end;
+  if (f.data_on_disk) {
+    // Only the Doc header was read, the reader sends the data straight from the stripe.
+    Ptr<IOBufferData> range = make_ptr<IOBufferData>(new CacheFileRange(stripe, dir, data_reach, doc_pos, bytes));
+    b                       = new_IOBufferBlock(range, bytes, 0);
+  } else {
+    b           = new_IOBufferBlock(buf, bytes, doc_pos);
+    b->_buf_end = b->_end;
+  }
   vio.get_writer()->append_block(b);
   vio.ndone += bytes;
   doc_pos   += bytes;
@@ -699,16 +727,31 @@ Lread: {
   }
   last_collision    = nullptr;
   writer_lock_retry = 0;
+  f.data_on_disk    = false;
   // if the state machine calls reenable on the callback from the cache,
   // we set up a schedule_imm event. The openReadReadDone discards
   // EVENT_IMMEDIATE events. So, we have to cancel that trigger and set
   // a new EVENT_INTERVAL event.
   cancel_trigger();
+  if (load_from_ram_cache_unlocked()) {
+    Doc *doc = reinterpret_cast<Doc *>(buf->data());
+    fragment++;
+    doc_pos = doc->prefix_len();
+    next_CacheKey(&key, &key);
+    return openReadMain(EVENT_CALL, nullptr);
+  }
   CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
   if (!lock.is_locked()) {
     SET_HANDLER(&CacheVC::openReadMain);
     VC_SCHED_LOCK_RETRY();
   }
+  if (write_vc && load_from_writer_fragment_ring()) {
+    Doc *doc = reinterpret_cast<Doc *>(buf->data());
+    fragment++;
+    doc_pos = doc->prefix_len();
+    next_CacheKey(&key, &key);
+    return openReadMain(EVENT_CALL, nullptr);
+  }
   if (stripe->directory.probe(&key, stripe, &dir, &last_collision)) {
     SET_HANDLER(&CacheVC::openReadReadDone);
     int ret = do_read_call(&key);
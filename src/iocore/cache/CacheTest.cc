@@ -685,6 +685,13 @@ REGRESSION_TEST(ram_cache)(RegressionTest *t, int level, int *pstatus)
     }
   }
 
+  // A sharded cache splits the budget evenly, so it must meet the same hit-rate floor and size
+  // invariant as a single cache of the full size.
+  if (!test_RamCache(t, new_RamCacheSharded(new_RamCacheLRU, 8), "LRU sharded", 1LL << 24) ||
+      !test_RamCache(t, new_RamCacheSharded(new_RamCacheCLFUS, 8), "CLFUS sharded", 1LL << 24)) {
+    *pstatus = REGRESSION_TEST_FAILED;
+  }
+
   // Exercise the S3-FIFO tunables with valid non-default values: the policy must still pass the
   // hit-rate floor and the size invariant, proving the records -> init() config plumbing is wired
   // and that a non-default queue split, ghost bound, and promotion threshold remain correct.
@@ -79,6 +79,9 @@ DbgCtl dbg_ctl_cache_scan_truss{"cache_scan_truss"};
 DbgCtl dbg_ctl_cache_close{"cache_close"};
 DbgCtl dbg_ctl_cache_reenable{"cache_reenable"};
 #endif
+
+// What is read of a data fragment whose data is sent from the file, enough for any Doc header.
+constexpr size_t DOC_HEADER_READ_SIZE = 4096;
 } // end anonymous namespace
 
 // Compilation Options
@@ -133,7 +136,7 @@ make_vol_map(Stripe *stripe)
   for (int s = 0; s < stripe->directory.segments; s++) {
     Dir *seg = stripe->directory.get_segment(s);
     for (int b = 0; b < stripe->directory.buckets; b++) {
-      Dir *e = dir_bucket(b, seg);
+      Dir *e = stripe->directory.bucket(b, seg);
       if (stripe->directory.bucket_loop_fix(e, s)) {
         break;
       }
@@ -144,7 +147,7 @@ make_vol_map(Stripe *stripe)
             vol_map[offset / SCAN_BUF_SIZE] = 1;
           }
         }
-        e = next_dir(e, seg);
+        e = stripe->directory.next_dir(e, seg);
         if (!e) {
           break;
         }
@@ -381,6 +384,16 @@ CacheVC::handleReadDone(int event, Event * /* e ATS_UNUSED */)
           doc->key.toHexStr(xt), doc->data_len(), doc->len, doc->total_len, doc->prefix_len());
     }
 
+    if (f.data_on_disk) {
+      // Only the header is in memory. Data fragments never carry HTTP headers, nothing to unmarshal.
+      if (doc->hlen) {
+        doc->magic = DOC_CORRUPT;
+      }
+      // The data is intact now, note when the writer gets to it.
+      data_reach = stripe->write_reach_at(&dir);
+      goto Ldone;
+    }
+
     // put into ram cache?
     if (io.ok() && ((doc->first_key == *read_key) || (doc->key == *read_key) || STORE_COLLISION) && doc->magic == DOC_MAGIC) {
       int okay = 1;
@@ -451,11 +464,14 @@ CacheVC::handleRead(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
   cancel_trigger();
 
   f.doc_from_ram_cache = false;
+  f.data_on_disk       = false;
 
   ink_assert(stripe->mutex->thread_holding == this_ethread());
 
-  // 1. check RAM cache
-  if (load_from_ram_cache()) {
+  // 1. check RAM cache, unless the lookup without the stripe lock just missed
+  bool ram_cache_probed = f.ram_cache_probed;
+  f.ram_cache_probed    = false;
+  if (!ram_cache_probed && load_from_ram_cache()) {
     Dbg(dbg_ctl_cache_ram, "RAM cache hit");
     f.doc_from_ram_cache = true;
     io.aio_result        = io.aiocb.aio_nbytes;
@@ -502,7 +518,13 @@ CacheVC::handleRead(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
   if (static_cast<off_t>(io.aiocb.aio_offset + io.aiocb.aio_nbytes) > static_cast<off_t>(stripe->skip + stripe->len)) {
     io.aiocb.aio_nbytes = stripe->skip + stripe->len - io.aiocb.aio_offset;
   }
-  buf              = new_IOBufferData(iobuffer_size_to_index(io.aiocb.aio_nbytes, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
+  // A data fragment the reader sends from the file needs only its Doc header.
+  f.data_on_disk = f.sendfile && save_handler == reinterpret_cast<ContinuationHandler>(&CacheVC::openReadReadDone) &&
+                   io.aiocb.aio_nbytes > DOC_HEADER_READ_SIZE;
+  if (f.data_on_disk) {
+    io.aiocb.aio_nbytes = DOC_HEADER_READ_SIZE;
+  }
+  buf              = new_IOBufferData(iobuffer_size_to_index(io.aiocb.aio_nbytes, MAX_BUFFER_SIZE_INDEX), REGISTERED);
   io.aiocb.aio_buf = buf->data();
   io.action        = this;
   io.thread        = mutex->thread_holding->tt == DEDICATED ? AIO_CALLBACK_THREAD_ANY : mutex->thread_holding;
@@ -526,6 +548,72 @@ CacheVC::load_from_ram_cache()
   return ram_hit_state >= RAM_HIT_COMPRESS_NONE;
 }
 
+/**
+  Look up the fragment @c key in a thread safe RAM cache without the stripe lock.
+
+  Only used for data fragments after the earliest one. Their keys are derived from the earliest key,
+  which is chosen at random for every write, and they never carry headers, so a fragment key always
+  names the same bytes wherever the fragment is stored. That lets the lookup skip the directory and
+  accept an entry stored under any offset. A miss is remembered so the locked path that follows does
+  not look up and count the same key again.
+ */
+bool
+CacheVC::load_from_ram_cache_unlocked()
+{
+  if (!this->stripe->ram_cache->is_thread_safe() || f.ram_cache_probed) {
+    return false;
+  }
+  Ptr<IOBufferData> data;
+  int               ram_hit_state = this->stripe->ram_cache->get(&this->key, &data, RAM_CACHE_ANY_AUXKEY);
+  if (ram_hit_state < RAM_HIT_COMPRESS_NONE) {
+    f.ram_cache_probed = true;
+    return false;
+  }
+  Doc *doc = reinterpret_cast<Doc *>(data->data());
+  if (doc->magic != DOC_MAGIC || doc->key != this->key || doc->hlen) {
+    return false;
+  }
+  this->buf            = data;
+  f.doc_from_ram_cache = true;
+  f.compressed_in_ram  = (ram_hit_state > RAM_HIT_COMPRESS_NONE) ? 1 : 0;
+  ts::Metrics::Counter::increment(cache_rsb.ram_cache_unlocked_hits);
+  ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.ram_cache_unlocked_hits);
+  return true;
+}
+
+/**
+  Take the next fragment @c key from the fragments the writer shares with its readers.
+
+  The caller must hold the stripe lock. A reader that has fallen further behind than the ring holds
+  is counted and left to read the fragment from the stripe.
+ */
+bool
+CacheVC::load_from_writer_fragment_ring()
+{
+  OpenDirEntry *cod = this->stripe->open_read(&this->first_key);
+  if (!cod || !cod->fragment_ring) {
+    return false;
+  }
+  int           wanted = this->fragment + 1;
+  int           lag    = 0;
+  IOBufferData *data   = cod->fragment_ring->find(this->key, wanted, &lag);
+  if (!data) {
+    if (lag > 0) {
+      ts::Metrics::Counter::increment(cache_rsb.rww_lag_fallbacks);
+      ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.rww_lag_fallbacks);
+    }
+    return false;
+  }
+  this->buf            = data;
+  f.doc_from_ram_cache = true;
+  f.compressed_in_ram  = 0;
+  ts::Metrics::Counter::increment(cache_rsb.rww_fragments_shared);
+  ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.rww_fragments_shared);
+  ts::Metrics::Counter::increment(cache_rsb.rww_reader_lag, lag);
+  ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.rww_reader_lag, lag);
+  return true;
+}
+
 bool
 CacheVC::load_from_last_open_read_call()
 {
@@ -663,6 +751,7 @@ CacheVC::scanStripe(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
     }
     stripe = rec->stripes[0];
   } else {
+  Lnext:
     for (int i = 0; i < rec->num_vols - 1; i++) {
       if (stripe == rec->stripes[i]) {
         stripe = rec->stripes[i + 1];
@@ -672,6 +761,10 @@ CacheVC::scanStripe(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
     goto Ldone;
   }
 Lcont:
+  // The directory of this stripe is still loading, there is nothing to scan.
+  if (!stripe->is_ready()) {
+    goto Lnext;
+  }
   fragment = 0;
   SET_HANDLER(&CacheVC::scanObject);
   eventProcessor.schedule_in(this, HRTIME_MSECONDS(scan_msec_delay));
@@ -1095,6 +1188,17 @@ CacheVC::is_pread_capable()
   return !f.read_from_writer_called;
 }
 
+bool
+CacheVC::enable_sendfile()
+{
+  // The checksum of a fragment left on disk cannot be verified.
+  if (!cache_config_sendfile || cache_config_enable_checksum || vio.op != VIO::READ) {
+    return false;
+  }
+  f.sendfile = true;
+  return true;
+}
+
 bool
 CacheVC::set_pin_in_cache(time_t time_pin)
 {
@@ -124,6 +124,8 @@ struct CacheVC : public CacheVConnection {
     return f.compressed_in_ram;
   }
 
+  bool enable_sendfile() override;
+
   bool writer_done();
   int  calluser(int event);
   int  callcont(int event);
@@ -133,6 +135,8 @@ struct CacheVC : public CacheVConnection {
   int  handleReadDone(int event, Event *e);
   int  handleRead(int event, Event *e);
   bool load_from_ram_cache();
+  bool load_from_ram_cache_unlocked();
+  bool load_from_writer_fragment_ring();
   bool load_from_last_open_read_call();
   bool load_from_aggregation_buffer();
   int  do_read_call(CacheKey *akey);
@@ -275,6 +279,7 @@ struct CacheVC : public CacheVConnection {
   int64_t                   writer_offset; // offset of the writer for reading from a writer
   int64_t                   length;        // length of data available to write
   int64_t                   doc_pos;       // read position in 'buf'
+  int64_t                   data_reach;    // stripe write reach that overwrites a fragment left on disk
   uint64_t                  write_pos;     // length written
   uint64_t                  total_len;     // total length written and available to write
   uint64_t                  doc_len;       // total_length (of the selected alternate for HTTP)
@@ -309,6 +314,9 @@ struct CacheVC : public CacheVConnection {
       unsigned int hit_evacuate             : 1;
       unsigned int compressed_in_ram        : 1; // compressed state in ram cache
       unsigned int allow_empty_doc          : 1; // used for cache empty http document
+      unsigned int ram_cache_probed         : 1; // read_key already missed in a thread safe ram cache
+      unsigned int sendfile                 : 1; // leave data fragments read from disk in the file
+      unsigned int data_on_disk             : 1; // buf holds only the Doc header, the data is in the file
     } f;
   };
   // BTF optimization used to skip reading stuff in cache partition that doesn't contain any
@@ -34,6 +34,8 @@
 
 #include <cstdint>
 #include <ctime>
+#include <utility>
+#include <vector>
 
 class Stripe;
 class StripeSM;
@@ -58,6 +60,8 @@ class CacheEvacuateDocVC;
 #define DIR_DEPTH               4
 #define MAX_ENTRIES_PER_SEGMENT (1 << 16)
 #define MAX_BUCKETS_PER_SEGMENT (MAX_ENTRIES_PER_SEGMENT / DIR_DEPTH)
+#define DIR_WIDE_DEPTH          6  // rows per bucket in the wide layout
+#define DIR_WIDE_BUCKET_SIZE    64 // bytes per bucket in the wide layout, one cache line
 #define DIR_SIZE_WIDTH          6
 #define DIR_BLOCK_SIZES         4
 #define DIR_BLOCK_SHIFT(_i)     (3 * (_i))
@@ -81,7 +85,6 @@ class CacheEvacuateDocVC;
 #define CHECK_DIR(_d) ((void)0)
 #endif
 
-#define dir_index(_e, _i) ((Dir *)((char *)(_e)->directory.dir + (SIZEOF_DIR * (_i))))
 #define dir_assign(_e, _x)   \
   do {                       \
     (_e)->w[0] = (_x)->w[0]; \
@@ -202,6 +205,38 @@ struct Dir {
 // is deleted/inserted into the vector just before writing the vector disk
 // (CacheVC::updateVector).
 LINK_FORWARD_DECLARATION(CacheVC, opendir_link) // forward declaration
+/**
+  The newest fragments of an object being written, shared by the readers following the writer.
+
+  The writer copies each data fragment out of the aggregation buffer once, and every reader takes
+  a reference to that copy instead of copying it out of the aggregation buffer or reading it back
+  from disk itself. Only the newest @a size fragments are kept; a reader further behind than that
+  reads from the stripe as before.
+ */
+struct OpenDirFragmentRing {
+  struct Slot {
+    CacheKey          key;
+    int               fragment = -1;
+    Ptr<IOBufferData> data;
+  };
+
+  explicit OpenDirFragmentRing(int size) : slots(size) {}
+
+  /// Keep @a data, the fragment numbered @a fragment, in place of the oldest one.
+  void publish(const CacheKey &key, int fragment, IOBufferData *data);
+
+  /**
+    Look up the fragment numbered @a fragment.
+
+    @param lag Set to the number of fragments the writer has published past this one.
+    @return The fragment, or @c nullptr if it is not in the ring.
+   */
+  IOBufferData *find(const CacheKey &key, int fragment, int *lag) const;
+
+  std::vector<Slot> slots;
+  int               newest = -1; ///< Number of the newest fragment published.
+};
+
 struct OpenDirEntry {
   DLL<CacheVC, Link_CacheVC_opendir_link> writers; // list of all the current writers
   DLL<CacheVC, Link_CacheVC_opendir_link> readers; // list of all the current readers - not used
@@ -219,6 +254,8 @@ struct OpenDirEntry {
   bool     reading_vec;                            // somebody is currently reading the vector
   bool     writing_vec;                            // somebody is currently writing the vector
 
+  OpenDirFragmentRing *fragment_ring; // fragments shared with readers, allocated on first use
+
   LINK(OpenDirEntry, link);
 
   bool
@@ -245,7 +282,6 @@ struct CacheSync : public Continuation {
   char       *buf          = nullptr;
   size_t      buflen       = 0;
   bool        buf_huge     = false;
-  off_t       writepos     = 0;
   AIOCallback io;
   Event      *trigger    = nullptr;
   ink_hrtime  start_time = 0;
@@ -253,8 +289,18 @@ struct CacheSync : public Continuation {
   std::vector<int> stripe_indices;
   int              current_index{0};
 
+  /* The pass in progress: byte ranges of the snapshot in @a buf still to be
+     written (header, changed segments, footer), and the segment versions
+     they carry.
+   */
+  std::vector<std::pair<off_t, size_t>> writes;
+  size_t                                write_index{0};
+  std::vector<std::pair<int, uint32_t>> segments_written;
+  int64_t                               pass_bytes{0};
+
   int  mainEvent(int event, Event *e);
   void aio_write(int fd, char *b, int n, off_t o);
+  void plan_writes(StripeSM *stripe, int copy);
 
   CacheSync() : Continuation(new_ProxyMutex()) { SET_HANDLER(&CacheSync::mainEvent); }
 
@@ -284,10 +330,22 @@ struct StripeHeaderFooter {
   uint32_t          write_serial;
   uint32_t          dirty;
   uint32_t          sector_size;
-  uint32_t          unused; // pad out to 8 byte boundary
+  uint32_t          dir_layout; // DirLayout, also pads out to 8 byte boundary
   uint16_t          freelist[1];
 };
 
+/* Arrangement of the entries of a stripe directory, recorded in the stripe
+   header. CLASSIC packs DIR_DEPTH entries per bucket back to back, which is
+   what every stripe written before the layout was recorded uses (the field
+   was zeroed padding). WIDE stores DIR_WIDE_DEPTH entries per bucket, padded
+   to DIR_WIDE_BUCKET_SIZE bytes so that each bucket is exactly one cache
+   line and a lookup that resolves within its bucket costs a single fetch.
+ */
+enum class DirLayout : uint32_t {
+  CLASSIC = 0,
+  WIDE    = 1,
+};
+
 class Directory
 {
 public:
@@ -299,15 +357,64 @@ public:
   off_t               buckets{};
   size_t              raw_dir_size{0};     // size of raw_dir allocation (for freeing hugepages)
   bool                raw_dir_huge{false}; // true if raw_dir was allocated with hugepages
+  DirLayout           layout{DirLayout::CLASSIC};
+
+  /* Change tracking for the incremental directory sync. Every change to
+     segment s bumps segment_version[s]; synced_version[c][s] is the version
+     last written to on-disk copy c (A or B).
+   */
+  std::vector<uint32_t> segment_version;
+  std::vector<uint32_t> synced_version[2];
+
+  /* Segments that have been validated since the directory was loaded.
+   */
+  std::vector<uint8_t> segment_valid;
 
   /* Total number of dir entries.
    */
   int entries() const;
 
+  /* Number of entries, and bytes, per bucket for the current layout.
+   */
+  int depth() const;
+  int bucket_size() const;
+
   /* Returns the first dir in segment @a s.
    */
   Dir *get_segment(int s) const;
 
+  /* Position helpers. Entry offsets are the 16 bit values stored in the
+     next/prev links and the freelist heads, relative to segment @a seg.
+   */
+  Dir    *bucket(int64_t b, Dir *seg) const;
+  Dir    *from_offset(int64_t i, Dir *seg) const;
+  int64_t to_offset(const Dir *d, const Dir *seg) const;
+  Dir    *next_dir(Dir *d, Dir *seg) const;
+
+  /* Returns entry @a i counting across all segments, for 0 <= i < entries().
+   */
+  Dir *entry(int64_t i) const;
+
+  /* Records a change to segment @a s for the next directory sync.
+   */
+  void mark_dirty(int s);
+
+  /* Forgets what has been synced, so the next sync of each copy writes
+     every segment.
+   */
+  void reset_sync_state();
+
+  /* Returns true if segment @a s has changed since it was last written to
+     on-disk copy @a copy.
+   */
+  bool segment_dirty(int s, int copy) const;
+
+  /* Checks the chains and freelist of segment @a s the first time it is
+     used after the directory is loaded, and clears the segment if they are
+     broken. Deferring this keeps it off the startup path.
+   */
+  void validate_segment(int s);
+
   int      probe(const CacheKey *, StripeSM *, Dir *, Dir **);
   int      insert(const CacheKey *key, StripeSM *stripe, Dir *to_part);
   int      overwrite(const CacheKey *key, StripeSM *stripe, Dir *to_part, Dir *overwrite, bool must_overwrite = true);
@@ -326,10 +433,22 @@ public:
 
 private:
   void unlink_from_freelist(Dir *e, int s);
+  void _validate_segment(int s);
+};
+
+// Result of scanning all rows of a bucket at once, one bit per row.
+struct DirBucketScan {
+  uint32_t tag_match{0};  // row tag equals the probed tag
+  uint32_t empty{0};      // row offset is zero
+  uint32_t local_next{0}; // row next is zero or another row of the same bucket
 };
 
 // Global Functions
 
+DirBucketScan dir_bucket_scan(const Dir *b, uint32_t base, uint32_t tag);
+DirBucketScan dir_bucket_scan_scalar(const Dir *b, uint32_t base, uint32_t tag);
+bool          dir_bucket_scan_miss(const Dir *b, uint32_t base, const DirBucketScan &scan);
+
 int  dir_lookaside_probe(const CacheKey *key, StripeSM *stripe, Dir *result, EvacuationBlock **eblock);
 int  dir_lookaside_insert(EvacuationBlock *b, StripeSM *stripe, Dir *to);
 int  dir_lookaside_fixup(const CacheKey *key, StripeSM *stripe);
@@ -393,29 +512,106 @@ dir_bucket_row(Dir *b, int64_t i)
   return dir_in_seg(b, i);
 }
 
+inline int
+Directory::depth() const
+{
+  return this->layout == DirLayout::WIDE ? DIR_WIDE_DEPTH : DIR_DEPTH;
+}
+
+inline int
+Directory::bucket_size() const
+{
+  return this->layout == DirLayout::WIDE ? DIR_WIDE_BUCKET_SIZE : DIR_DEPTH * SIZEOF_DIR;
+}
+
 inline int
 Directory::entries() const
 {
-  return this->buckets * DIR_DEPTH * this->segments;
+  return this->buckets * this->depth() * this->segments;
 }
 
 inline Dir *
 Directory::get_segment(int s) const
 {
-  return reinterpret_cast<Dir *>((reinterpret_cast<char *>(this->dir)) + (s * this->buckets) * DIR_DEPTH * SIZEOF_DIR);
+  return reinterpret_cast<Dir *>((reinterpret_cast<char *>(this->dir)) + (s * this->buckets) * this->bucket_size());
+}
+
+inline Dir *
+Directory::bucket(int64_t b, Dir *seg) const
+{
+  if (this->layout == DirLayout::WIDE) {
+    return reinterpret_cast<Dir *>(reinterpret_cast<char *>(seg) + b * DIR_WIDE_BUCKET_SIZE);
+  }
+  return dir_bucket(b, seg);
+}
+
+inline Dir *
+Directory::from_offset(int64_t i, Dir *seg) const
+{
+  if (this->layout == DirLayout::WIDE) {
+    if (!i) {
+      return nullptr;
+    }
+    return dir_bucket_row(this->bucket(i / DIR_WIDE_DEPTH, seg), i % DIR_WIDE_DEPTH);
+  }
+  return dir_from_offset(i, seg);
+}
+
+inline int64_t
+Directory::to_offset(const Dir *d, const Dir *seg) const
+{
+  if (this->layout == DirLayout::WIDE) {
+    int64_t bytes = reinterpret_cast<const char *>(d) - reinterpret_cast<const char *>(seg);
+    return (bytes / DIR_WIDE_BUCKET_SIZE) * DIR_WIDE_DEPTH + (bytes % DIR_WIDE_BUCKET_SIZE) / SIZEOF_DIR;
+  }
+  return dir_to_offset(d, seg);
+}
+
+inline Dir *
+Directory::next_dir(Dir *d, Dir *seg) const
+{
+  return this->from_offset(dir_next(d), seg);
+}
+
+inline Dir *
+Directory::entry(int64_t i) const
+{
+  int64_t const depth = this->depth();
+  return dir_bucket_row(this->bucket(i / depth, this->dir), i % depth);
+}
+
+inline void
+Directory::mark_dirty(int s)
+{
+  this->header->dirty = 1;
+  ++this->segment_version[s];
+}
+
+inline bool
+Directory::segment_dirty(int s, int copy) const
+{
+  return this->synced_version[copy][s] != this->segment_version[s];
+}
+
+inline void
+Directory::validate_segment(int s)
+{
+  if (!this->segment_valid[s]) {
+    this->_validate_segment(s);
+  }
 }
 
 inline void
 Directory::unlink_from_freelist(Dir *e, int s)
 {
   Dir *seg = this->get_segment(s);
-  Dir *p   = dir_from_offset(dir_prev(e), seg);
+  Dir *p   = this->from_offset(dir_prev(e), seg);
   if (p) {
     dir_set_next(p, dir_next(e));
   } else {
     this->header->freelist[s] = dir_next(e);
   }
-  Dir *n = dir_from_offset(dir_next(e), seg);
+  Dir *n = this->from_offset(dir_next(e), seg);
   if (n) {
     dir_set_prev(n, dir_prev(e));
   }
@@ -424,25 +620,25 @@ Directory::unlink_from_freelist(Dir *e, int s)
 inline Dir *
 Directory::delete_entry(Dir *e, Dir *p, int s)
 {
-  Dir *seg            = this->get_segment(s);
-  int  no             = dir_next(e);
-  this->header->dirty = 1;
+  Dir *seg = this->get_segment(s);
+  int  no  = dir_next(e);
+  this->mark_dirty(s);
   if (p) {
     unsigned int fo = this->header->freelist[s];
-    unsigned int eo = dir_to_offset(e, seg);
+    unsigned int eo = this->to_offset(e, seg);
     dir_clear(e);
     dir_set_next(p, no);
     dir_set_next(e, fo);
     if (fo) {
-      dir_set_prev(dir_from_offset(fo, seg), eo);
+      dir_set_prev(this->from_offset(fo, seg), eo);
     }
     this->header->freelist[s] = eo;
   } else {
-    Dir *n = next_dir(e, seg);
+    Dir *n = this->next_dir(e, seg);
     if (n) {
       // "Shuffle" here means that we're copying the second entry's data to the head entry's location, and removing the second entry
       // - because the head entry can't be moved.
-      ATS_PROBE3(cache_dir_shuffle, s, dir_to_offset(e, seg), dir_to_offset(n, seg));
+      ATS_PROBE3(cache_dir_shuffle, s, this->to_offset(e, seg), this->to_offset(n, seg));
       dir_assign(e, n);
       this->delete_entry(n, e, s);
       return e;
@@ -451,5 +647,5 @@ Directory::delete_entry(Dir *e, Dir *p, int s)
       return nullptr;
     }
   }
-  return dir_from_offset(no, seg);
+  return this->from_offset(no, seg);
 }
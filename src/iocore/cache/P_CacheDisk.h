@@ -26,6 +26,10 @@
 #include "iocore/aio/AIO.h"
 #include "iocore/cache/Cache.h"
 
+#include "tscore/ink_hrtime.h"
+
+#include <atomic>
+
 extern int cache_config_max_disk_errors;
 
 #define DISK_BAD(_x)           ((_x)->num_errors >= cache_config_max_disk_errors)
@@ -92,6 +96,11 @@ struct CacheDisk : public Continuation {
   bool                        read_only_p       = false;
   bool online = true; /* flag marking cache disk online or offline (because of too many failures or by the operator). */
 
+  /* Time at which the aggregation writes charged so far have used up the
+     disk's write bandwidth. Shared by all the stripes on the disk.
+   */
+  std::atomic<ink_hrtime> write_budget_clock{0};
+
   // Extra configuration values
   int            forced_volume_num = -1; ///< Volume number for this disk.
   ats_scoped_str span_name;              ///< Span name
@@ -115,4 +124,14 @@ struct CacheDisk : public Continuation {
   void             update_header();
   DiskStripe      *get_diskvol(int vol_number);
   void             incrErrors(const AIOCallback *io);
+
+  /**
+   * Charge an aggregation write against the disk's write bandwidth.
+   *
+   * @param bytes The size of the write.
+   * @param bytes_per_sec The disk's write bandwidth.
+   * @return Returns 0 if the write may be issued now, in which case it is
+   *   charged, otherwise how long to wait before trying again.
+   */
+  ink_hrtime charge_write_budget(int64_t bytes, int64_t bytes_per_sec);
 };
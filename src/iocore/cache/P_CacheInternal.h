@@ -116,6 +116,10 @@ extern int cache_config_dir_sync_frequency;
 extern int cache_config_dir_sync_delay;
 extern int cache_config_dir_sync_max_write;
 extern int cache_config_dir_sync_parallel_tasks;
+extern int cache_config_dir_sync_incremental;
+extern int cache_config_dir_async_load;
+extern int cache_config_dir_vectorized_probe;
+extern int cache_config_dir_wide_buckets;
 extern int cache_config_http_max_alts;
 extern int cache_config_log_alternate_eviction;
 extern int cache_config_permit_pinning;
@@ -123,13 +127,18 @@ extern int cache_config_select_alternate;
 extern int cache_config_max_doc_size;
 extern int cache_config_min_average_object_size;
 extern int cache_config_agg_write_backlog;
+extern int cache_config_agg_write_queue_depth;
+extern int64_t cache_config_agg_write_disk_bandwidth;
 extern int cache_config_enable_checksum;
 extern int cache_config_alt_rewrite_max_size;
 extern int cache_config_read_while_writer;
 extern int cache_config_agg_write_backlog;
 extern int cache_config_ram_cache_compress;
 extern int cache_config_ram_cache_compress_percent;
+extern int cache_config_ram_cache_compress_dictionary_size;
 extern int cache_config_ram_cache_use_seen_filter;
+extern int cache_config_ram_cache_admission;
+extern int cache_config_ram_cache_shards;
 extern int cache_config_ram_cache_s3fifo_main_percent;
 extern int cache_config_ram_cache_s3fifo_ghost_size_percent;
 extern int cache_config_ram_cache_s3fifo_ghost_mem_percent;
@@ -141,6 +150,8 @@ extern int cache_config_target_fragment_size;
 extern int cache_config_mutex_retry_delay;
 extern int cache_read_while_writer_retry_delay;
 extern int cache_config_read_while_writer_max_retries;
+extern int cache_config_read_while_writer_fragment_ring;
+extern int cache_config_sendfile;
 
 #define PUSH_HANDLER(_x)                                          \
   do {                                                            \
@@ -469,13 +480,13 @@ class StripeSM;
 class CacheHostTable;
 
 struct Cache {
-  int            cache_read_done       = 0;
-  int            total_good_nvol       = 0;
-  int            total_nvol            = 0;
-  CacheInitState ready                 = CacheInitState::INITIALIZING;
-  int64_t        cache_size            = 0; // in store block size
-  int            total_initialized_vol = 0;
-  CacheType      scheme                = CacheType::NONE;
+  std::atomic<int> cache_read_done       = 0;
+  int              total_good_nvol       = 0;
+  int              total_nvol            = 0;
+  CacheInitState   ready                 = CacheInitState::INITIALIZING;
+  int64_t          cache_size            = 0; // in store block size
+  int              total_initialized_vol = 0;
+  CacheType        scheme                = CacheType::NONE;
 
   mutable ReplaceablePtr<CacheHostTable> hosttable;
 
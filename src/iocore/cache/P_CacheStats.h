@@ -37,41 +37,60 @@ struct CacheStatsBlock {
 
   ts::Metrics::Counter::AtomicType *fragment_document_count[3] = {nullptr, nullptr, nullptr}; // For 1, 2 and 3+ fragments
 
-  ts::Metrics::Gauge::AtomicType   *bytes_used             = nullptr;
-  ts::Metrics::Gauge::AtomicType   *bytes_total            = nullptr;
-  ts::Metrics::Gauge::AtomicType   *stripes                = nullptr;
-  ts::Metrics::Gauge::AtomicType   *ram_cache_bytes        = nullptr;
-  ts::Metrics::Gauge::AtomicType   *ram_cache_bytes_total  = nullptr;
-  ts::Metrics::Gauge::AtomicType   *direntries_total       = nullptr;
-  ts::Metrics::Gauge::AtomicType   *direntries_used        = nullptr;
-  ts::Metrics::Counter::AtomicType *ram_cache_hits         = nullptr;
-  ts::Metrics::Counter::AtomicType *last_open_read_hits    = nullptr;
-  ts::Metrics::Counter::AtomicType *agg_buffer_hits        = nullptr;
-  ts::Metrics::Counter::AtomicType *ram_cache_misses       = nullptr;
-  ts::Metrics::Counter::AtomicType *all_mem_misses         = nullptr;
-  ts::Metrics::Counter::AtomicType *pread_count            = nullptr;
-  ts::Metrics::Gauge::AtomicType   *percent_full           = nullptr;
-  ts::Metrics::Counter::AtomicType *read_seek_fail         = nullptr;
-  ts::Metrics::Counter::AtomicType *read_invalid           = nullptr;
-  ts::Metrics::Counter::AtomicType *write_backlog_failure  = nullptr;
-  ts::Metrics::Counter::AtomicType *directory_collision    = nullptr;
-  ts::Metrics::Counter::AtomicType *read_busy_success      = nullptr;
-  ts::Metrics::Counter::AtomicType *read_busy_failure      = nullptr;
-  ts::Metrics::Counter::AtomicType *gc_bytes_evacuated     = nullptr;
-  ts::Metrics::Counter::AtomicType *gc_frags_evacuated     = nullptr;
-  ts::Metrics::Counter::AtomicType *write_bytes            = nullptr;
-  ts::Metrics::Counter::AtomicType *hdr_vector_marshal     = nullptr;
-  ts::Metrics::Counter::AtomicType *hdr_marshal            = nullptr;
-  ts::Metrics::Counter::AtomicType *hdr_marshal_bytes      = nullptr;
-  ts::Metrics::Counter::AtomicType *directory_wrap         = nullptr;
-  ts::Metrics::Counter::AtomicType *directory_sync_count   = nullptr;
-  ts::Metrics::Counter::AtomicType *directory_sync_time    = nullptr;
-  ts::Metrics::Counter::AtomicType *directory_sync_bytes   = nullptr;
-  ts::Metrics::Counter::AtomicType *span_errors_read       = nullptr;
-  ts::Metrics::Counter::AtomicType *span_errors_write      = nullptr;
-  ts::Metrics::Gauge::AtomicType   *span_offline           = nullptr;
-  ts::Metrics::Gauge::AtomicType   *span_online            = nullptr;
-  ts::Metrics::Gauge::AtomicType   *span_failing           = nullptr;
-  ts::Metrics::Counter::AtomicType *stripe_lock_contention = nullptr;
-  ts::Metrics::Counter::AtomicType *writer_lock_contention = nullptr;
+  // Aggregation write latency, for under 1, 4, 16, 64 and 256ms and the rest
+  ts::Metrics::Counter::AtomicType *agg_write_latency[6] = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+
+  ts::Metrics::Gauge::AtomicType   *bytes_used                      = nullptr;
+  ts::Metrics::Gauge::AtomicType   *bytes_total                     = nullptr;
+  ts::Metrics::Gauge::AtomicType   *stripes                         = nullptr;
+  ts::Metrics::Gauge::AtomicType   *stripes_ready                   = nullptr;
+  ts::Metrics::Gauge::AtomicType   *ram_cache_bytes                 = nullptr;
+  ts::Metrics::Gauge::AtomicType   *ram_cache_bytes_total           = nullptr;
+  ts::Metrics::Gauge::AtomicType   *direntries_total                = nullptr;
+  ts::Metrics::Gauge::AtomicType   *direntries_used                 = nullptr;
+  ts::Metrics::Counter::AtomicType *ram_cache_hits                  = nullptr;
+  ts::Metrics::Counter::AtomicType *last_open_read_hits             = nullptr;
+  ts::Metrics::Counter::AtomicType *agg_buffer_hits                 = nullptr;
+  ts::Metrics::Counter::AtomicType *ram_cache_misses                = nullptr;
+  ts::Metrics::Counter::AtomicType *ram_cache_admission_rejects     = nullptr;
+  ts::Metrics::Counter::AtomicType *ram_cache_unlocked_hits         = nullptr;
+  ts::Metrics::Counter::AtomicType *ram_cache_compressions          = nullptr;
+  ts::Metrics::Counter::AtomicType *ram_cache_compress_time         = nullptr;
+  ts::Metrics::Counter::AtomicType *ram_cache_decompressions        = nullptr;
+  ts::Metrics::Counter::AtomicType *ram_cache_decompress_time       = nullptr;
+  ts::Metrics::Counter::AtomicType *all_mem_misses                  = nullptr;
+  ts::Metrics::Counter::AtomicType *pread_count                     = nullptr;
+  ts::Metrics::Gauge::AtomicType   *percent_full                    = nullptr;
+  ts::Metrics::Counter::AtomicType *read_seek_fail                  = nullptr;
+  ts::Metrics::Counter::AtomicType *read_invalid                    = nullptr;
+  ts::Metrics::Counter::AtomicType *write_backlog_failure           = nullptr;
+  ts::Metrics::Gauge::AtomicType   *agg_write_in_flight             = nullptr;
+  ts::Metrics::Counter::AtomicType *agg_write_throttled             = nullptr;
+  ts::Metrics::Counter::AtomicType *directory_collision             = nullptr;
+  ts::Metrics::Counter::AtomicType *read_busy_success               = nullptr;
+  ts::Metrics::Counter::AtomicType *read_busy_failure               = nullptr;
+  ts::Metrics::Counter::AtomicType *rww_fragments_published         = nullptr;
+  ts::Metrics::Counter::AtomicType *rww_fragments_shared            = nullptr;
+  ts::Metrics::Counter::AtomicType *rww_reader_lag                  = nullptr;
+  ts::Metrics::Counter::AtomicType *rww_lag_fallbacks               = nullptr;
+  ts::Metrics::Counter::AtomicType *gc_bytes_evacuated              = nullptr;
+  ts::Metrics::Counter::AtomicType *gc_frags_evacuated              = nullptr;
+  ts::Metrics::Counter::AtomicType *write_bytes                     = nullptr;
+  ts::Metrics::Counter::AtomicType *hdr_vector_marshal              = nullptr;
+  ts::Metrics::Counter::AtomicType *hdr_marshal                     = nullptr;
+  ts::Metrics::Counter::AtomicType *hdr_marshal_bytes               = nullptr;
+  ts::Metrics::Counter::AtomicType *directory_wrap                  = nullptr;
+  ts::Metrics::Counter::AtomicType *directory_sync_count            = nullptr;
+  ts::Metrics::Counter::AtomicType *directory_sync_time             = nullptr;
+  ts::Metrics::Counter::AtomicType *directory_sync_bytes            = nullptr;
+  ts::Metrics::Gauge::AtomicType   *directory_sync_pass_bytes       = nullptr;
+  ts::Metrics::Gauge::AtomicType   *directory_sync_pass_time        = nullptr;
+  ts::Metrics::Counter::AtomicType *directory_sync_segments_skipped = nullptr;
+  ts::Metrics::Counter::AtomicType *span_errors_read                = nullptr;
+  ts::Metrics::Counter::AtomicType *span_errors_write               = nullptr;
+  ts::Metrics::Gauge::AtomicType   *span_offline                    = nullptr;
+  ts::Metrics::Gauge::AtomicType   *span_online                     = nullptr;
+  ts::Metrics::Gauge::AtomicType   *span_failing                    = nullptr;
+  ts::Metrics::Counter::AtomicType *stripe_lock_contention          = nullptr;
+  ts::Metrics::Counter::AtomicType *writer_lock_contention          = nullptr;
 };
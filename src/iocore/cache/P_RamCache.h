@@ -28,8 +28,60 @@
 #include "iocore/eventsystem/IOBuffer.h"
 #include "tscore/CryptoHash.h"
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 class StripeSM;
 
+enum { RAM_CACHE_ADMISSION_NONE = 0, RAM_CACHE_ADMISSION_TINYLFU = 1 };
+
+/// Lookup auxkey that matches an entry stored under any auxkey.
+constexpr uint64_t RAM_CACHE_ANY_AUXKEY = UINT64_MAX;
+
+/**
+  TinyLFU admission filter.
+
+  A count-min sketch of four bit counters estimates how often each key has
+  been requested recently. A new object is only let into a full RAM cache if
+  it is estimated to be more popular than the object it would displace, which
+  keeps one-hit-wonders from pushing out hot objects. Every counter is halved
+  once the sketch has seen ten accesses per tracked object, so the estimate
+  follows changes in popularity.
+ */
+class RamCacheAdmission
+{
+public:
+  /// Size the sketch for about @a objects distinct objects.
+  explicit RamCacheAdmission(int64_t objects);
+
+  /// Count an access to @a key.
+  void record(const CryptoHash *key);
+
+  /// The estimated number of recent accesses to @a key, at most 15.
+  int frequency(const CryptoHash *key) const;
+
+  /// Whether @a candidate should displace @a victim, which may be @c nullptr.
+  bool
+  admit(const CryptoHash *candidate, const CryptoHash *victim) const
+  {
+    return victim == nullptr || frequency(candidate) > frequency(victim);
+  }
+
+private:
+  static constexpr int DEPTH = 4;
+
+  std::vector<uint64_t> _table; // sixteen 4 bit counters per word
+  uint64_t              _mask        = 0;
+  int64_t               _additions   = 0;
+  int64_t               _sample_size = 0;
+
+  void _index(const CryptoHash *key, uint64_t (&idx)[DEPTH]) const;
+  int  _counter(uint64_t idx) const;
+  void _age();
+};
+
 class RamCache
 {
 public:
@@ -41,8 +93,53 @@ public:
 
   virtual void init(int64_t max_bytes, StripeSM *stripe) = 0;
   virtual ~RamCache(){};
+
+  /// Whether the cache may be used without holding the stripe mutex.
+  virtual bool
+  is_thread_safe() const
+  {
+    return false;
+  }
+
+  /// Have background work lock @a mutex rather than the stripe mutex, for the shards of a sharded cache.
+  void
+  set_shard_mutex(std::mutex *mutex)
+  {
+    _shard_mutex = mutex;
+  }
+
+protected:
+  std::mutex *_shard_mutex = nullptr;
+
+  /// Whether an entry stored with @a entry_auxkey satisfies a lookup for @a auxkey.
+  static bool
+  _auxkey_match(uint64_t entry_auxkey, uint64_t auxkey)
+  {
+    return auxkey == RAM_CACHE_ANY_AUXKEY || entry_auxkey == auxkey;
+  }
+
+  /// Set up the policy selected by proxy.config.cache.ram_cache.admission, called from init().
+  void _init_admission(int64_t max_bytes, StripeSM *stripe);
+
+  /// Count a request for @a key, called on every get().
+  void
+  _record_access(const CryptoHash *key)
+  {
+    if (_admission) {
+      _admission->record(key);
+    }
+  }
+
+  /// Whether a new object may displace @a victim to make room, always true without a policy.
+  bool _admit(const CryptoHash *key, const CryptoHash *victim);
+
+private:
+  std::unique_ptr<RamCacheAdmission> _admission;
+  StripeSM                          *_admission_stripe = nullptr;
 };
 
 RamCache *new_RamCacheLRU();
 RamCache *new_RamCacheCLFUS();
 RamCache *new_RamCacheS3FIFO();
+/// A RAM cache of @a shards shards made by @a create, for each of @a nodes NUMA nodes.
+RamCache *new_RamCacheSharded(RamCache *(*create)(), int shards, int nodes = 1);
@@ -167,21 +167,21 @@ void
 PreservationTable::scan_for_pinned_documents(Stripe const *stripe)
 {
   if (cache_config_permit_pinning) {
-    // we can't evacuate anything between header->write_pos and
-    // header->write_pos + AGG_SIZE.
-    int ps = stripe->offset_to_vol_offset(stripe->directory.header->write_pos + AGG_SIZE);
+    // we can't evacuate anything between header->write_pos and the end of
+    // the aggregation buffer, AGG_SIZE past the writes in flight.
+    int ps = stripe->offset_to_vol_offset(stripe->get_agg_buf_offset() + AGG_SIZE);
     int pe =
       stripe->offset_to_vol_offset(stripe->directory.header->write_pos + 2 * EVACUATION_SIZE + (stripe->len / PIN_SCAN_EVERY));
     int vol_end_offset    = stripe->offset_to_vol_offset(stripe->len + stripe->skip);
     int before_end_of_vol = pe < vol_end_offset;
     DDbg(dbg_ctl_cache_evac, "scan %d %d", ps, pe);
     for (int i = 0; i < stripe->directory.entries(); i++) {
+      Dir *e = stripe->directory.entry(i);
       // is it a valid pinned object?
-      if (!dir_is_empty(&stripe->directory.dir[i]) && dir_pinned(&stripe->directory.dir[i]) &&
-          dir_head(&stripe->directory.dir[i])) {
+      if (!dir_is_empty(e) && dir_pinned(e) && dir_head(e)) {
         // select objects only within this PIN_SCAN region
-        int o = dir_offset(&stripe->directory.dir[i]);
-        if (dir_phase(&stripe->directory.dir[i]) == stripe->directory.header->phase) {
+        int o = dir_offset(e);
+        if (dir_phase(e) == stripe->directory.header->phase) {
           if (before_end_of_vol || o >= (pe - vol_end_offset)) {
             continue;
           }
@@ -190,7 +190,7 @@ PreservationTable::scan_for_pinned_documents(Stripe const *stripe)
             continue;
           }
         }
-        force_evacuate_head(&stripe->directory.dir[i], 1);
+        force_evacuate_head(e, 1);
       }
     }
   }
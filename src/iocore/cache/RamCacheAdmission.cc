@@ -0,0 +1,139 @@
+/** @file
+
+  TinyLFU admission filter for the RAM caches.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+// The sketch follows Einziger, Friedman & Manes, "TinyLFU: A Highly Efficient Cache Admission
+// Policy" (ACM ToS 2017). Keys are already cryptographic hashes, so the DEPTH counter positions are
+// derived from the two halves of the key by double hashing rather than rehashing it.
+
+#include "P_RamCache.h"
+#include "P_CacheInternal.h"
+#include "StripeSM.h"
+
+#include <algorithm>
+
+namespace
+{
+DbgCtl dbg_ctl_ram_cache{"ram_cache"};
+
+constexpr uint64_t COUNTER_MAX      = 15;
+constexpr uint64_t RESET_MASK       = 0x7777777777777777ULL; // clears the bit shifted in from the next counter
+constexpr int64_t  MIN_OBJECTS      = 64;
+constexpr int      SAMPLE_PER_ENTRY = 10; // accesses per tracked object between agings
+} // namespace
+
+RamCacheAdmission::RamCacheAdmission(int64_t objects)
+{
+  // One word of sixteen counters per expected object, rounded up to a power of two.
+  uint64_t words = 1;
+  while (words < static_cast<uint64_t>(std::max(objects, MIN_OBJECTS))) {
+    words <<= 1;
+  }
+  _table.assign(words, 0);
+  _mask        = words * 16 - 1;
+  _sample_size = std::max(objects, MIN_OBJECTS) * SAMPLE_PER_ENTRY;
+}
+
+void
+RamCacheAdmission::_index(const CryptoHash *key, uint64_t (&idx)[DEPTH]) const
+{
+  uint64_t a = key->u64[0];
+  uint64_t b = key->u64[1] | 1;
+  for (int i = 0; i < DEPTH; i++) {
+    idx[i] = (a + i * b) & _mask;
+  }
+}
+
+int
+RamCacheAdmission::_counter(uint64_t idx) const
+{
+  return (_table[idx >> 4] >> ((idx & 15) << 2)) & COUNTER_MAX;
+}
+
+int
+RamCacheAdmission::frequency(const CryptoHash *key) const
+{
+  uint64_t idx[DEPTH];
+  int      f = COUNTER_MAX;
+  _index(key, idx);
+  for (auto i : idx) {
+    f = std::min(f, _counter(i));
+  }
+  return f;
+}
+
+void
+RamCacheAdmission::record(const CryptoHash *key)
+{
+  uint64_t idx[DEPTH];
+  _index(key, idx);
+
+  // Conservative update: only the counters holding the current estimate are raised, which keeps
+  // collisions from inflating the others.
+  int f = COUNTER_MAX;
+  for (auto i : idx) {
+    f = std::min(f, _counter(i));
+  }
+  if (f < static_cast<int>(COUNTER_MAX)) {
+    for (auto i : idx) {
+      if (_counter(i) == f) {
+        _table[i >> 4] += uint64_t{1} << ((i & 15) << 2);
+      }
+    }
+  }
+  if (++_additions >= _sample_size) {
+    _age();
+  }
+}
+
+void
+RamCacheAdmission::_age()
+{
+  for (auto &w : _table) {
+    w = (w >> 1) & RESET_MASK;
+  }
+  _additions /= 2;
+}
+
+void
+RamCache::_init_admission(int64_t max_bytes, StripeSM *stripe)
+{
+  _admission_stripe = stripe;
+  if (cache_config_ram_cache_admission == RAM_CACHE_ADMISSION_TINYLFU && max_bytes > 0) {
+    int64_t objects = max_bytes / std::max(cache_config_min_average_object_size, 1);
+    _admission      = std::make_unique<RamCacheAdmission>(objects);
+    Dbg(dbg_ctl_ram_cache, "TinyLFU admission for %" PRId64 " bytes, about %" PRId64 " objects", max_bytes, objects);
+  } else {
+    _admission.reset();
+  }
+}
+
+bool
+RamCache::_admit(const CryptoHash *key, const CryptoHash *victim)
+{
+  if (!_admission || _admission->admit(key, victim)) {
+    return true;
+  }
+  ts::Metrics::Counter::increment(cache_rsb.ram_cache_admission_rejects);
+  ts::Metrics::Counter::increment(_admission_stripe->cache_vol->vol_rsb.ram_cache_admission_rejects);
+  return false;
+}
@@ -36,6 +36,17 @@
 #ifdef HAVE_LZMA_H
 #include <lzma.h>
 #endif
+#ifdef HAVE_ZSTD_H
+#include <zstd.h>
+#include <zdict.h>
+#endif
+#ifdef HAVE_LZ4_H
+#include <lz4.h>
+#endif
+
+#include <memory>
+#include <string>
+#include <vector>
 
 // #define CHECK_ACOUNTING 1 // very expensive double checking of all sizes
 
@@ -47,6 +58,11 @@ constexpr uint32_t entry_overhead       = 256; // per-entry overhead to consider
 #ifdef HAVE_LZMA_H
 constexpr uint32_t lzma_base_memlimit = 64 * 1024 * 1024;
 #endif
+#ifdef HAVE_ZSTD_H
+constexpr uint32_t dictionary_sample_max  = 16 * 1024; // bytes of one entry used for dictionary training
+constexpr size_t   dictionary_min_samples = 64;
+constexpr size_t   dictionary_sample_over = 100; // ask for this many times the dictionary size in samples
+#endif
 
 constexpr uint32_t average_value_over = 100;
 constexpr uint32_t requeue_limit      = 100;
@@ -76,6 +92,7 @@ struct RamCacheCLFUSEntry {
       uint32_t incompressible : 1;
       uint32_t lru            : 1;
       uint32_t copy           : 1; // copy-in-copy-out
+      uint32_t dictionary     : 1; // compressed with the trained zstd dictionary
     } flag_bits;
     uint32_t flags;
   };
@@ -102,10 +119,31 @@ cache_value(const RamCacheCLFUSEntry *const e)
   return cache_value_hits_size(e->hits, e->size);
 }
 
+#ifdef HAVE_ZSTD_H
+namespace
+{
+// The compression contexts are reused by every RAM cache on a thread.
+ZSTD_CCtx *
+zstd_cctx()
+{
+  thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> ctx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+  return ctx.get();
+}
+
+ZSTD_DCtx *
+zstd_dctx()
+{
+  thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> ctx{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+  return ctx.get();
+}
+} // end anonymous namespace
+#endif
+
 class RamCacheCLFUS : public RamCache
 {
 public:
   RamCacheCLFUS() {}
+  ~RamCacheCLFUS() override;
 
   // returns 1 on found/stored, 0 on not found/stored, if provided auxkey1 and auxkey2 must match
   int     get(CryptoHash *key, Ptr<IOBufferData> *ret_data, uint64_t auxkey = 0) override;
@@ -140,8 +178,48 @@ private:
   RamCacheCLFUSEntry *_destroy(RamCacheCLFUSEntry *e);
   void                _requeue_victims(Que(RamCacheCLFUSEntry, lru_link) & victims);
   void                _tick(); // move CLOCK on history
+  void                _lock(EThread *thread);
+  void                _unlock(EThread *thread);
+
+#ifdef HAVE_ZSTD_H
+  // Trained once from the resident entries and never replaced, so an entry compressed with it can
+  // always be decompressed.
+  ZSTD_CDict *_cdict              = nullptr;
+  ZSTD_DDict *_ddict              = nullptr;
+  bool        _dictionary_trained = false;
+
+  void _train_dictionary(EThread *thread);
+#endif
 };
 
+RamCacheCLFUS::~RamCacheCLFUS()
+{
+#ifdef HAVE_ZSTD_H
+  ZSTD_freeCDict(this->_cdict);
+  ZSTD_freeDDict(this->_ddict);
+#endif
+}
+
+void
+RamCacheCLFUS::_lock(EThread *thread)
+{
+  if (this->_shard_mutex) {
+    this->_shard_mutex->lock();
+  } else {
+    MUTEX_TAKE_LOCK(stripe->mutex, thread);
+  }
+}
+
+void
+RamCacheCLFUS::_unlock(EThread *thread)
+{
+  if (this->_shard_mutex) {
+    this->_shard_mutex->unlock();
+  } else {
+    MUTEX_UNTAKE_LOCK(stripe->mutex, thread);
+  }
+}
+
 int64_t
 RamCacheCLFUS::size() const
 {
@@ -183,6 +261,16 @@ RamCacheCLFUSCompressor::mainEvent(int /* event ATS_UNUSED */, Event *e)
   case CACHE_COMPRESSION_LIBLZMA:
 #ifndef HAVE_LZMA_H
     Warning("lzma not available for RAM cache compression");
+#endif
+    break;
+  case CACHE_COMPRESSION_ZSTD:
+#ifndef HAVE_ZSTD_H
+    Warning("zstd not available for RAM cache compression");
+#endif
+    break;
+  case CACHE_COMPRESSION_LZ4:
+#ifndef HAVE_LZ4_H
+    Warning("lz4 not available for RAM cache compression");
 #endif
     break;
   }
@@ -236,6 +324,7 @@ RamCacheCLFUS::init(int64_t abytes, StripeSM *astripe)
     return;
   }
   this->_resize_hashtable();
+  this->_init_admission(this->_max_bytes, stripe);
   if (cache_config_ram_cache_compress) {
     eventProcessor.schedule_every(new RamCacheCLFUSCompressor(this), HRTIME_SECOND, ET_TASK);
   }
@@ -271,11 +360,12 @@ RamCacheCLFUS::get(CryptoHash *key, Ptr<IOBufferData> *ret_data, uint64_t auxkey
   if (!this->_max_bytes) {
     return 0;
   }
+  this->_record_access(key);
   int64_t             i = key->slice32(3) % this->_nbuckets;
   RamCacheCLFUSEntry *e = this->_bucket[i].head;
   char               *b = nullptr;
   while (e) {
-    if (e->key == *key && e->auxkey == auxkey) {
+    if (e->key == *key && this->_auxkey_match(e->auxkey, auxkey)) {
       this->_move_compressed(e);
       if (!e->flag_bits.lru) { // in memory
         if (cache_value(e) > this->_average_value) {
@@ -285,7 +375,8 @@ RamCacheCLFUS::get(CryptoHash *key, Ptr<IOBufferData> *ret_data, uint64_t auxkey
         e->hits++;
         uint32_t ram_hit_state = RAM_HIT_COMPRESS_NONE;
         if (e->flag_bits.compressed) {
-          b = static_cast<char *>(ats_malloc(e->len));
+          ink_hrtime start = ink_get_hrtime();
+          b                = static_cast<char *>(ats_malloc(e->len));
           switch (e->flag_bits.compressed) {
           default:
             goto Lfailed;
@@ -318,7 +409,34 @@ RamCacheCLFUS::get(CryptoHash *key, Ptr<IOBufferData> *ret_data, uint64_t auxkey
             break;
           }
 #endif
+#ifdef HAVE_ZSTD_H
+          case CACHE_COMPRESSION_ZSTD: {
+            size_t l = e->flag_bits.dictionary ?
+                         ZSTD_decompress_usingDDict(zstd_dctx(), b, e->len, e->data->data(), e->compressed_len, this->_ddict) :
+                         ZSTD_decompressDCtx(zstd_dctx(), b, e->len, e->data->data(), e->compressed_len);
+            if (ZSTD_isError(l) || l != e->len) {
+              goto Lfailed;
+            }
+            ram_hit_state = RAM_HIT_COMPRESS_ZSTD;
+            break;
           }
+#endif
+#ifdef HAVE_LZ4_H
+          case CACHE_COMPRESSION_LZ4: {
+            int l = static_cast<int>(e->len);
+            if (l != LZ4_decompress_safe(e->data->data(), b, e->compressed_len, l)) {
+              goto Lfailed;
+            }
+            ram_hit_state = RAM_HIT_COMPRESS_LZ4;
+            break;
+          }
+#endif
+          }
+          ink_hrtime elapsed = ink_get_hrtime() - start;
+          ts::Metrics::Counter::increment(cache_rsb.ram_cache_decompressions);
+          ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.ram_cache_decompressions);
+          ts::Metrics::Counter::increment(cache_rsb.ram_cache_decompress_time, elapsed);
+          ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.ram_cache_decompress_time, elapsed);
           IOBufferData *data = new_xmalloc_IOBufferData(b, e->len);
           data->_mem_type    = DEFAULT_ALLOC;
           if (!e->flag_bits.copy) { // don't bother if we have to copy anyway
@@ -329,6 +447,7 @@ RamCacheCLFUS::get(CryptoHash *key, Ptr<IOBufferData> *ret_data, uint64_t auxkey
             e->size = e->compressed_len;
             check_accounting(this);
             e->flag_bits.compressed = 0;
+            e->flag_bits.dictionary = 0;
             e->data                 = data;
           }
           (*ret_data) = data;
@@ -450,7 +569,13 @@ RamCacheCLFUS::compress_entries(EThread *thread, int do_at_most)
     return;
   }
   ink_assert(stripe != nullptr);
-  MUTEX_TAKE_LOCK(stripe->mutex, thread);
+  this->_lock(thread);
+#ifdef HAVE_ZSTD_H
+  if (cache_config_ram_cache_compress == CACHE_COMPRESSION_ZSTD && cache_config_ram_cache_compress_dictionary_size > 0 &&
+      !this->_dictionary_trained) {
+    this->_train_dictionary(thread);
+  }
+#endif
   if (!this->_compressed) {
     this->_compressed  = this->_lru[0].head;
     this->_ncompressed = 0;
@@ -484,15 +609,30 @@ RamCacheCLFUS::compress_entries(EThread *thread, int do_at_most)
       case CACHE_COMPRESSION_LIBLZMA:
         l = e->len;
         break;
+#endif
+#ifdef HAVE_ZSTD_H
+      case CACHE_COMPRESSION_ZSTD:
+        l = static_cast<uint32_t>(ZSTD_compressBound(e->len));
+        break;
+#endif
+#ifdef HAVE_LZ4_H
+      case CACHE_COMPRESSION_LZ4:
+        l = static_cast<uint32_t>(LZ4_compressBound(e->len));
+        break;
 #endif
       }
       // store transient data for lock release
       Ptr<IOBufferData> edata = e->data;
       uint32_t          elen  = e->len;
       CryptoHash        key   = e->key;
-      MUTEX_UNTAKE_LOCK(stripe->mutex, thread);
-      b           = static_cast<char *>(ats_malloc(l));
-      bool failed = false;
+#ifdef HAVE_ZSTD_H
+      const ZSTD_CDict *cdict = this->_cdict;
+#endif
+      this->_unlock(thread);
+      ink_hrtime start           = ink_get_hrtime();
+      b                          = static_cast<char *>(ats_malloc(l));
+      bool       failed          = false;
+      bool       used_dictionary = false;
       switch (ctype) {
       default:
         goto Lfailed;
@@ -524,8 +664,35 @@ RamCacheCLFUS::compress_entries(EThread *thread, int do_at_most)
         break;
       }
 #endif
+#ifdef HAVE_ZSTD_H
+      case CACHE_COMPRESSION_ZSTD: {
+        size_t ll = cdict ? ZSTD_compress_usingCDict(zstd_cctx(), b, l, edata->data(), elen, cdict) :
+                            ZSTD_compressCCtx(zstd_cctx(), b, l, edata->data(), elen, ZSTD_CLEVEL_DEFAULT);
+        if (ZSTD_isError(ll)) {
+          failed = true;
+        }
+        l               = static_cast<uint32_t>(ll);
+        used_dictionary = cdict != nullptr;
+        break;
+      }
+#endif
+#ifdef HAVE_LZ4_H
+      case CACHE_COMPRESSION_LZ4: {
+        int ll = LZ4_compress_default(edata->data(), b, static_cast<int>(elen), static_cast<int>(l));
+        if (ll <= 0) {
+          failed = true;
+        }
+        l = static_cast<uint32_t>(ll);
+        break;
       }
-      MUTEX_TAKE_LOCK(stripe->mutex, thread);
+#endif
+      }
+      ink_hrtime elapsed = ink_get_hrtime() - start;
+      ts::Metrics::Counter::increment(cache_rsb.ram_cache_compressions);
+      ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.ram_cache_compressions);
+      ts::Metrics::Counter::increment(cache_rsb.ram_cache_compress_time, elapsed);
+      ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.ram_cache_compress_time, elapsed);
+      this->_lock(thread);
       // see if the entry is till around
       {
         if (failed) {
@@ -553,6 +720,7 @@ RamCacheCLFUS::compress_entries(EThread *thread, int do_at_most)
       }
       if (l < e->len) {
         e->flag_bits.compressed = cache_config_ram_cache_compress;
+        e->flag_bits.dictionary = used_dictionary;
         bb                      = static_cast<char *>(ats_malloc(l));
         memcpy(bb, b, l);
         ats_free(b);
@@ -591,10 +759,54 @@ RamCacheCLFUS::compress_entries(EThread *thread, int do_at_most)
     this->_compressed = e->lru_link.next;
     this->_ncompressed++;
   }
-  MUTEX_UNTAKE_LOCK(stripe->mutex, thread);
+  this->_unlock(thread);
   return;
 }
 
+#ifdef HAVE_ZSTD_H
+// Called and returns with the cache locked. Samples are copied out of the resident entries so the
+// training itself, which can take a while, runs without the lock.
+void
+RamCacheCLFUS::_train_dictionary(EThread *thread)
+{
+  size_t              dictionary_size = cache_config_ram_cache_compress_dictionary_size;
+  size_t              want            = dictionary_size * dictionary_sample_over;
+  std::string         samples;
+  std::vector<size_t> sample_sizes;
+  forl_LL(RamCacheCLFUSEntry, e, this->_lru[0])
+  {
+    if (samples.size() >= want) {
+      break;
+    }
+    if (e->flag_bits.compressed || !e->data) {
+      continue;
+    }
+    size_t n = std::min(e->len, dictionary_sample_max);
+    samples.append(e->data->data(), n);
+    sample_sizes.push_back(n);
+  }
+  // Wait for the cache to warm up, the samples must be representative.
+  if (samples.size() < want && (sample_sizes.size() < dictionary_min_samples || samples.size() < 10 * dictionary_size)) {
+    return;
+  }
+
+  this->_unlock(thread);
+  std::vector<char> dictionary(dictionary_size);
+  size_t            l = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), samples.data(), sample_sizes.data(),
+                                              static_cast<unsigned>(sample_sizes.size()));
+  this->_lock(thread);
+
+  this->_dictionary_trained = true;
+  if (ZDICT_isError(l)) {
+    Warning("unable to train RAM cache compression dictionary for %s: %s", stripe->hash_text.get(), ZDICT_getErrorName(l));
+    return;
+  }
+  this->_cdict = ZSTD_createCDict(dictionary.data(), l, ZSTD_CLEVEL_DEFAULT);
+  this->_ddict = ZSTD_createDDict(dictionary.data(), l);
+  DDbg(dbg_ctl_ram_cache, "trained %zu byte dictionary from %zu samples", l, sample_sizes.size());
+}
+#endif
+
 void
 RamCacheCLFUS::_requeue_victims(Que(RamCacheCLFUSEntry, lru_link) & victims)
 {
@@ -680,6 +892,13 @@ RamCacheCLFUS::put(CryptoHash *key, IOBufferData *data, uint32_t len, bool copy,
       return 0;
     }
   }
+  // Objects coming back from history already won the value comparison below, only new ones are
+  // checked against the next eviction candidate.
+  if (!e && this->_bytes + size > this->_max_bytes &&
+      !this->_admit(key, this->_lru[0].head ? &this->_lru[0].head->key : nullptr)) {
+    DDbg(dbg_ctl_ram_cache, "put %X %" PRId64 " size %d NOT ADMITTED", key->slice32(3), auxkey, size);
+    return 0;
+  }
   while (true) {
     victim = this->_lru[0].dequeue();
     if (!victim) {
@@ -133,6 +133,7 @@ RamCacheLRU::init(int64_t abytes, StripeSM *astripe)
     return;
   }
   resize_hashtable();
+  _init_admission(max_bytes, stripe);
 }
 
 int
@@ -141,10 +142,11 @@ RamCacheLRU::get(CryptoHash *key, Ptr<IOBufferData> *ret_data, uint64_t auxkey)
   if (!max_bytes) {
     return 0;
   }
+  _record_access(key);
   uint32_t          i = key->slice32(3) % nbuckets;
   RamCacheLRUEntry *e = bucket[i].head;
   while (e) {
-    if (e->key == *key && e->auxkey == auxkey) {
+    if (e->key == *key && _auxkey_match(e->auxkey, auxkey)) {
       lru.remove(e);
       lru.enqueue(e);
       (*ret_data) = e->data;
@@ -221,6 +223,10 @@ RamCacheLRU::put(CryptoHash *key, IOBufferData *data, [[maybe_unused]] uint32_t
     }
     e = e->hash_link.next;
   }
+  if (bytes + ENTRY_OVERHEAD + data->block_size() > max_bytes && !_admit(key, lru.head ? &lru.head->key : nullptr)) {
+    DDbg(dbg_ctl_ram_cache, "put %X %" PRIu64 " len %d NOT ADMITTED", key->slice32(3), auxkey, len);
+    return 0;
+  }
   e         = THREAD_ALLOC(ramCacheLRUEntryAllocator, this_ethread());
   e->key    = *key;
   e->auxkey = auxkey;
@@ -161,6 +161,7 @@ RamCacheS3FIFO::init(int64_t abytes, StripeSM *astripe)
       _main_percent, ghost_size_percent, ghost_mem_percent, _promote_threshold);
 
   _resize_hashtable();
+  _init_admission(_max_bytes, _stripe);
 }
 
 int64_t
@@ -177,7 +178,7 @@ RamCacheS3FIFO::_lookup(const CryptoHash *key, uint64_t auxkey)
   uint32_t             i = key->slice32(3) % _nbuckets;
   RamCacheS3FIFOEntry *e = _bucket[i].head;
   while (e) {
-    if (e->key == *key && e->auxkey == auxkey) {
+    if (e->key == *key && _auxkey_match(e->auxkey, auxkey)) {
       return e;
     }
     e = e->hash_link.next;
@@ -323,6 +324,7 @@ RamCacheS3FIFO::get(CryptoHash *key, Ptr<IOBufferData> *ret_data, uint64_t auxke
   if (!_max_bytes) {
     return 0;
   }
+  _record_access(key);
   RamCacheS3FIFOEntry *e = _lookup(key, auxkey);
   if (e && e->seg != SEG_GHOST) {
     if (e->freq < FREQ_MAX) {
@@ -379,6 +381,16 @@ RamCacheS3FIFO::put(CryptoHash *key, IOBufferData *data, [[maybe_unused]] uint32
   // metadata (ENTRY_OVERHEAD per remembered key) must fit. Evict resident first; if that is
   // exhausted but ghost metadata still pushes over, drop ghost keys too.
   int64_t need = ENTRY_OVERHEAD + size;
+  if (!ghost_hit && _s_bytes + _m_bytes + _g_count * ENTRY_OVERHEAD + need > _max_bytes) {
+    // A ghost hit was already admitted by S3-FIFO itself. Otherwise compare against the queue head
+    // _evict() would take from first.
+    int64_t              resident_budget = _max_bytes - _g_count * ENTRY_OVERHEAD;
+    bool                 from_main       = _m_bytes > resident_budget * _main_percent / 100 || _s_bytes == 0;
+    RamCacheS3FIFOEntry *victim          = _seg[from_main ? SEG_MAIN : SEG_SMALL].head;
+    if (!_admit(key, victim ? &victim->key : nullptr)) {
+      return 0;
+    }
+  }
   while (_s_bytes + _m_bytes + _g_count * ENTRY_OVERHEAD + need > _max_bytes) {
     if (_s_bytes + _m_bytes > 0) {
       _evict();
@@ -0,0 +1,170 @@
+/** @file
+
+  A RAM cache split into independently locked shards.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+// Each shard is a complete RAM cache of the configured algorithm holding an equal share of the
+// stripe's budget, guarded by its own mutex. Keys are spread over the shards by a different slice
+// of the hash than the shards use for their own buckets, so shard buckets stay evenly loaded.
+// Because every operation holds its shard's mutex, the cache does not depend on the stripe mutex
+// and a hot stripe no longer serializes RAM hits across threads.
+//
+// In NUMA mode each node has its own set of shards, and a thread uses only those of its node so
+// the objects it is served were put there by threads on the same node, in that node's memory.
+
+#include "P_RamCache.h"
+#include "P_CacheInternal.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+namespace
+{
+DbgCtl dbg_ctl_ram_cache{"ram_cache"};
+
+constexpr int MAX_SHARDS = 256;
+
+class RamCacheSharded : public RamCache
+{
+public:
+  RamCacheSharded(RamCache *(*create)(), int shards, int nodes);
+
+  int     get(CryptoHash *key, Ptr<IOBufferData> *ret_data, uint64_t auxkey = 0) override;
+  int     put(CryptoHash *key, IOBufferData *data, uint32_t len, bool copy = false, uint64_t auxkey = 0) override;
+  int     fixup(const CryptoHash *key, uint64_t old_auxkey, uint64_t new_auxkey) override;
+  int64_t size() const override;
+
+  void init(int64_t max_bytes, StripeSM *stripe) override;
+
+  bool
+  is_thread_safe() const override
+  {
+    return true;
+  }
+
+private:
+  // Keep shards on separate cache lines so threads working different shards do not share one.
+  struct alignas(64) Shard {
+    mutable std::mutex        mutex;
+    std::unique_ptr<RamCache> cache;
+  };
+
+  std::unique_ptr<Shard[]> _shards;
+  uint32_t                 _mask  = 0; ///< Picks a shard within a node.
+  int                      _nodes = 1;
+
+  /// The shards of @a node start here.
+  uint32_t
+  _node_base(int node) const
+  {
+    return static_cast<uint32_t>(node) * (_mask + 1);
+  }
+
+  /// The shards of the calling thread's node.
+  uint32_t
+  _local_base() const
+  {
+    EThread *t = this_ethread();
+    return t && t->numa_node >= 0 && t->numa_node < _nodes ? _node_base(t->numa_node) : 0;
+  }
+
+  Shard &
+  _shard(const CryptoHash *key) const
+  {
+    return _shards[_local_base() + (key->slice32(2) & _mask)];
+  }
+};
+
+RamCacheSharded::RamCacheSharded(RamCache *(*create)(), int shards, int nodes) : _nodes(std::max(nodes, 1))
+{
+  // Round down to a power of two so a shard is picked with a mask.
+  int n = 1;
+  while (n * 2 <= std::min(shards, MAX_SHARDS)) {
+    n *= 2;
+  }
+  _shards = std::make_unique<Shard[]>(n * _nodes);
+  _mask   = n - 1;
+  for (int i = 0; i < n * _nodes; i++) {
+    _shards[i].cache.reset(create());
+    _shards[i].cache->set_shard_mutex(&_shards[i].mutex);
+  }
+}
+
+void
+RamCacheSharded::init(int64_t max_bytes, StripeSM *stripe)
+{
+  uint32_t count       = _node_base(_nodes);
+  int64_t  shard_bytes = max_bytes / count;
+  Dbg(dbg_ctl_ram_cache, "initializing %u ram_cache shards of %" PRId64 " bytes on %d nodes", count, shard_bytes, _nodes);
+  for (uint32_t i = 0; i < count; i++) {
+    std::lock_guard lock(_shards[i].mutex);
+    _shards[i].cache->init(shard_bytes, stripe);
+  }
+}
+
+int
+RamCacheSharded::get(CryptoHash *key, Ptr<IOBufferData> *ret_data, uint64_t auxkey)
+{
+  Shard          &shard = _shard(key);
+  std::lock_guard lock(shard.mutex);
+  return shard.cache->get(key, ret_data, auxkey);
+}
+
+int
+RamCacheSharded::put(CryptoHash *key, IOBufferData *data, uint32_t len, bool copy, uint64_t auxkey)
+{
+  Shard          &shard = _shard(key);
+  std::lock_guard lock(shard.mutex);
+  return shard.cache->put(key, data, len, copy, auxkey);
+}
+
+int
+RamCacheSharded::fixup(const CryptoHash *key, uint64_t old_auxkey, uint64_t new_auxkey)
+{
+  // The object may have been put on any node.
+  int ret = 0;
+  for (int node = 0; node < _nodes; node++) {
+    Shard          &shard = _shards[_node_base(node) + (key->slice32(2) & _mask)];
+    std::lock_guard lock(shard.mutex);
+    ret |= shard.cache->fixup(key, old_auxkey, new_auxkey);
+  }
+  return ret;
+}
+
+int64_t
+RamCacheSharded::size() const
+{
+  int64_t total = 0;
+  for (uint32_t i = 0; i < _node_base(_nodes); i++) {
+    std::lock_guard lock(_shards[i].mutex);
+    total += _shards[i].cache->size();
+  }
+  return total;
+}
+
+} // namespace
+
+RamCache *
+new_RamCacheSharded(RamCache *(*create)(), int shards, int nodes)
+{
+  return new RamCacheSharded(create, shards, nodes);
+}
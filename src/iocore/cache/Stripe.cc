@@ -89,10 +89,12 @@ Stripe::Stripe(CacheDisk *disk, off_t blocks, off_t dir_skip, int avg_obj_size,
   : frag_size{fragment_size},
     skip{ROUND_TO_STORE_BLOCK((dir_skip < START_POS ? START_POS : dir_skip))},
     start{skip},
-    len{blocks * STORE_BLOCK_SIZE}
+    len{blocks * STORE_BLOCK_SIZE},
+    _avg_obj_size{avg_obj_size}
 {
   ink_assert(this->len < MAX_STRIPE_SIZE);
 
+  this->directory.layout = _configured_dir_layout();
   this->_init_hash_text(disk, blocks, dir_skip);
   this->_init_data(STORE_BLOCK_SIZE, avg_obj_size);
   this->_init_directory(this->dirlen(), this->headerlen(), DIRECTORY_FOOTER_SIZE);
@@ -132,9 +134,10 @@ Stripe::_init_data_internal(int avg_obj_size)
   // step1: calculate the number of entries.
   off_t total_entries = (this->len - (this->start - this->skip)) / avg_obj_size;
   // step2: calculate the number of buckets
-  off_t total_buckets = total_entries / DIR_DEPTH;
-  // step3: calculate the number of segments, no segment has more than 16384 buckets
-  this->directory.segments = (total_buckets + (((1 << 16) - 1) / DIR_DEPTH)) / ((1 << 16) / DIR_DEPTH);
+  off_t total_buckets = total_entries / this->directory.depth();
+  // step3: calculate the number of segments, no segment has more than 64k entries
+  off_t max_buckets        = MAX_ENTRIES_PER_SEGMENT / this->directory.depth();
+  this->directory.segments = (total_buckets + max_buckets - 1) / max_buckets;
   // step4: divide total_buckets into segments on average.
   this->directory.buckets = (total_buckets + this->directory.segments - 1) / this->directory.segments;
   // step5: set the start pointer.
@@ -168,10 +171,39 @@ Stripe::_init_directory(std::size_t directory_size, int header_size, int footer_
   this->directory.header       = reinterpret_cast<StripeHeaderFooter *>(this->directory.raw_dir);
   std::size_t const footer_offset{directory_size - static_cast<std::size_t>(footer_size)};
   this->directory.footer = reinterpret_cast<StripeHeaderFooter *>(this->directory.raw_dir + footer_offset);
+  this->directory.reset_sync_state();
+  this->directory.segment_valid.assign(this->directory.segments, 0);
+}
+
+DirLayout
+Stripe::_configured_dir_layout()
+{
+  return cache_config_dir_wide_buckets ? DirLayout::WIDE : DirLayout::CLASSIC;
+}
+
+void
+Stripe::_set_dir_layout(DirLayout layout)
+{
+  if (layout == this->directory.layout) {
+    return;
+  }
+  Dbg(dbg_ctl_cache_init, "Stripe %s: switching to the %s directory layout", hash_text.get(),
+      layout == DirLayout::WIDE ? "wide" : "classic");
+  this->_free_directory();
+  this->directory.layout = layout;
+  this->start            = this->skip;
+  this->_init_data(STORE_BLOCK_SIZE, this->_avg_obj_size);
+  this->_init_directory(this->dirlen(), this->headerlen(), DIRECTORY_FOOTER_SIZE);
 }
 
 // coverity[exn_spec_violation] - ink_assert aborts (doesn't throw), Dbg is exception-safe
 Stripe::~Stripe()
+{
+  this->_free_directory();
+}
+
+void
+Stripe::_free_directory()
 {
   if (this->directory.raw_dir != nullptr) {
     // Debug logging to track cleanup - helps correlate with crash location
@@ -205,7 +237,7 @@ Stripe::dir_check()
   unsigned short   chain_tag[MAX_ENTRIES_PER_SEGMENT];
   int32_t          chain_mark[MAX_ENTRIES_PER_SEGMENT];
   uint64_t         total_buckets = directory.buckets * directory.segments;
-  uint64_t         total_entries = total_buckets * DIR_DEPTH;
+  uint64_t         total_entries = total_buckets * directory.depth();
   int              frag_demographics[1 << DIR_SIZE_WIDTH][DIR_BLOCK_SIZES];
 
   int j;
@@ -218,7 +250,7 @@ Stripe::dir_check()
   ink_zero(frag_demographics);
 
   printf("Stripe '[%s]'\n", hash_text.get());
-  printf("  Directory Bytes: %" PRIu64 "\n", total_buckets * SIZEOF_DIR);
+  printf("  Directory Bytes: %" PRIu64 "\n", total_buckets * directory.bucket_size());
   printf("  Segments:  %d\n", directory.segments);
   printf("  Buckets per segment:   %" PRIu64 "\n", directory.buckets);
   printf("  Entries:   %" PRIu64 "\n", total_entries);
@@ -237,22 +269,22 @@ Stripe::dir_check()
     memset(chain_mark, -1, sizeof(chain_mark));
 
     for (int b = 0; b < directory.buckets; b++) {
-      Dir *root = dir_bucket(b, seg);
+      Dir *root = directory.bucket(b, seg);
       int  h    = 0; // chain length starting in this bucket
 
       // Walk the chain starting in this bucket
       int chain_idx = 0;
       int mark      = 0;
       ++seg_buckets_in_use;
-      for (Dir *e = root; e; e = next_dir(e, seg)) {
+      for (Dir *e = root; e; e = directory.next_dir(e, seg)) {
         if (!dir_offset(e)) {
           ++seg_empty;
           --seg_buckets_in_use;
           // this should only happen on the first dir in a bucket
-          ink_assert(nullptr == next_dir(e, seg));
+          ink_assert(nullptr == directory.next_dir(e, seg));
           break;
         } else {
-          int e_idx = e - seg;
+          int e_idx = directory.to_offset(e, seg);
           ++h;
           chain_tag[chain_idx++] = dir_tag(e);
           if (chain_mark[e_idx] == mark) {
@@ -362,6 +394,9 @@ Stripe::_clear_init(std::uint32_t hw_sector_size)
   this->directory.header->magic          = STRIPE_MAGIC;
   this->directory.header->version._major = CACHE_DB_MAJOR_VERSION;
   this->directory.header->version._minor = CACHE_DB_MINOR_VERSION;
+  this->directory.header->dir_layout     = static_cast<uint32_t>(this->directory.layout);
+  // Whatever was in the stripe is gone, as if the writer had been all the way round.
+  this->_write_reach.fetch_add(this->skip + this->len - this->start, std::memory_order_release);
   this->scan_pos = this->directory.header->agg_pos = this->directory.header->write_pos = this->start;
   this->directory.header->last_write_pos                                               = this->directory.header->write_pos;
   this->directory.header->phase                                                        = 0;
@@ -380,29 +415,51 @@ Stripe::_init_dir()
   for (s = 0; s < this->directory.segments; s++) {
     this->directory.header->freelist[s] = 0;
     Dir *seg                            = this->directory.get_segment(s);
-    for (l = 1; l < DIR_DEPTH; l++) {
+    for (l = 1; l < this->directory.depth(); l++) {
       for (b = 0; b < this->directory.buckets; b++) {
-        Dir *bucket = dir_bucket(b, seg);
+        Dir *bucket = this->directory.bucket(b, seg);
         this->directory.free_entry(dir_bucket_row(bucket, l), s);
       }
     }
   }
 }
 
+void
+Stripe::_set_agg_pos(off_t pos)
+{
+  off_t agg = this->directory.header->agg_pos;
+  // It moves back only when the writer wraps, over the end of the data to the start.
+  off_t ahead = pos >= agg ? pos - agg : (this->skip + this->len - agg) + (pos - this->start);
+  // Claimed before the writes are issued, so readers see it before the data changes.
+  this->_write_reach.fetch_add(ahead, std::memory_order_release);
+  this->directory.header->agg_pos = pos;
+}
+
 bool
 Stripe::flush_aggregate_write_buffer(int fd)
 {
+  off_t offset = this->get_agg_buf_offset();
+
   // set write limit
-  this->directory.header->agg_pos = this->directory.header->write_pos + this->_write_buffer.get_buffer_pos();
+  this->_set_agg_pos(offset + this->_write_buffer.get_buffer_pos());
 
-  if (!this->_write_buffer.flush(fd, this->directory.header->write_pos)) {
+  // Buffers still in flight may never reach the disk now, so write them
+  // again along with the aggregation buffer.
+  for (auto const &flight : this->_write_buffer.get_in_flight()) {
+    if (!flight.flushed && pwrite(fd, flight.buffer, flight.len, flight.offset) != flight.len) {
+      return false;
+    }
+  }
+  if (!this->_write_buffer.flush(fd, offset)) {
     return false;
   }
   this->directory.header->last_write_pos  = this->directory.header->write_pos;
-  this->directory.header->write_pos      += this->_write_buffer.get_buffer_pos();
-  ink_assert(this->directory.header->write_pos == this->directory.header->agg_pos);
+  this->directory.header->write_pos       = this->directory.header->agg_pos;
+  this->directory.header->write_serial   += this->_write_buffer.get_writes_in_flight() + !this->_write_buffer.is_empty();
   this->_write_buffer.reset_buffer_pos();
-  this->directory.header->write_serial++;
+  // The writes still in flight complete later and must not move the write
+  // position again.
+  this->_write_buffer.mark_flushed();
 
   return true;
 }
@@ -414,7 +471,10 @@ Stripe::copy_from_aggregate_write_buffer(char *dest, Dir const &dir, size_t nbyt
     return false;
   }
 
-  int agg_offset = this->vol_offset(&dir) - this->directory.header->write_pos;
-  this->_write_buffer.copy_from(dest, agg_offset, nbytes);
+  off_t offset = this->vol_offset(&dir);
+  if (offset < this->get_agg_buf_offset()) {
+    return this->_write_buffer.copy_from_in_flight(dest, offset, nbytes);
+  }
+  this->_write_buffer.copy_from(dest, offset - this->get_agg_buf_offset(), nbytes);
   return true;
 }
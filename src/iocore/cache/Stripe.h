@@ -33,6 +33,7 @@
 #include "tscore/ink_align.h"
 #include "tscore/ink_memory.h"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 
@@ -129,6 +130,10 @@ public:
   off_t vol_relative_length(off_t start_offset) const;
 
   int get_agg_buf_pos() const;
+  /* Offset of the start of the aggregation buffer: the write position plus
+     the buffers still on their way to disk.
+   */
+  off_t get_agg_buf_offset() const;
 
   /**
    * Retrieve a document from the aggregate write buffer.
@@ -144,19 +149,43 @@ public:
    */
   bool copy_from_aggregate_write_buffer(char *dest, Dir const &dir, size_t nbytes) const;
 
+  /* How far writes have been issued over the data, in bytes counted across
+     wraps. It only grows, and can be read without the stripe lock.
+   */
+  int64_t write_reach() const;
+  /* The write_reach() at which the writer starts over the data at @a dir.
+     The data is intact as long as write_reach() has not passed it. Only with
+     the stripe lock held.
+   */
+  int64_t write_reach_at(Dir const *dir) const;
+
 protected:
   off_t                data_blocks{};
   AggregateWriteBuffer _write_buffer;
 
   void _clear_init(std::uint32_t hw_sector_size);
   void _init_dir();
+  /* Switch the in memory directory to @a layout, recomputing the stripe
+     geometry and reallocating the directory. Existing contents are lost.
+   */
+  void _set_dir_layout(DirLayout layout);
+  /* Layout for stripes that are initialized or cleared.
+   */
+  static DirLayout _configured_dir_layout();
   bool flush_aggregate_write_buffer(int fd);
+  /* Move the aggregation position, up to which writes are issued, to @a pos.
+   */
+  void _set_agg_pos(off_t pos);
 
 private:
+  int                  _avg_obj_size{-1};
+  std::atomic<int64_t> _write_reach{0};
+
   void _init_hash_text(CacheDisk const *disk, off_t blocks, off_t dir_skip);
   void _init_data(off_t store_block_size, int avg_obj_size = -1);
   void _init_data_internal(int avg_obj_size = -1); // Defaults to cache_config_min_average_object_size;
   void _init_directory(std::size_t directory_size, int header_size, int footer_size);
+  void _free_directory();
 };
 
 inline uint32_t
@@ -176,7 +205,7 @@ inline size_t
 Stripe::dirlen() const
 {
   return this->headerlen() +
-         ROUND_TO_STORE_BLOCK(((size_t)this->directory.buckets) * DIR_DEPTH * this->directory.segments * SIZEOF_DIR) +
+         ROUND_TO_STORE_BLOCK(((size_t)this->directory.buckets) * this->directory.bucket_size() * this->directory.segments) +
          ROUND_TO_STORE_BLOCK(sizeof(StripeHeaderFooter));
 }
 
@@ -192,6 +221,22 @@ Stripe::dir_valid(const Dir *dir) const
 /**
   entry is valid and outside of write aggregation region
  */
+inline int64_t
+Stripe::write_reach() const
+{
+  return this->_write_reach.load(std::memory_order_acquire);
+}
+
+inline int64_t
+Stripe::write_reach_at(Dir const *dir) const
+{
+  off_t pos = this->vol_offset(dir);
+  off_t agg = this->directory.header->agg_pos;
+  // Data behind the aggregation position is reached after the next wrap.
+  off_t ahead = pos >= agg ? pos - agg : (this->skip + this->len - agg) + (pos - this->start);
+  return this->_write_reach.load(std::memory_order_relaxed) + ahead;
+}
+
 inline bool
 Stripe::dir_agg_valid(const Dir *dir) const
 {
@@ -226,14 +271,14 @@ inline int
 Stripe::vol_in_phase_valid(Dir const *e) const
 {
   return (dir_offset(e) - 1 <
-          ((this->directory.header->write_pos + this->_write_buffer.get_buffer_pos() - this->start) / CACHE_BLOCK_SIZE));
+          ((this->get_agg_buf_offset() + this->_write_buffer.get_buffer_pos() - this->start) / CACHE_BLOCK_SIZE));
 }
 
 inline int
 Stripe::vol_in_phase_agg_buf_valid(Dir const *e) const
 {
   return (this->vol_offset(e) >= this->directory.header->write_pos &&
-          this->vol_offset(e) < (this->directory.header->write_pos + this->_write_buffer.get_buffer_pos()));
+          this->vol_offset(e) < (this->get_agg_buf_offset() + this->_write_buffer.get_buffer_pos()));
 }
 
 inline off_t
@@ -265,3 +310,9 @@ Stripe::get_agg_buf_pos() const
 {
   return this->_write_buffer.get_buffer_pos();
 }
+
+inline off_t
+Stripe::get_agg_buf_offset() const
+{
+  return this->directory.header->write_pos + this->_write_buffer.get_bytes_in_flight();
+}
@@ -73,6 +73,10 @@ DbgCtl dbg_ctl_cache_disk_error{"cache_disk_error"};
 DbgCtl dbg_ctl_cache_evac{"cache_evac"};
 DbgCtl dbg_ctl_cache_init{"cache_init"};
 
+// The directory is read in chunks of this size so that a large directory is
+// spread over the AIO threads of its disk instead of a single request.
+constexpr size_t DIR_READ_CHUNK_SIZE = 16 * 1024 * 1024;
+
 #ifdef DEBUG
 
 DbgCtl dbg_ctl_agg_read{"agg_read"};
@@ -88,9 +92,13 @@ static void update_header_info(CacheVC *vc, Doc *doc);
 static int  evacuate_fragments(CacheKey *key, CacheKey *earliest_key, int force, StripeSM *stripe);
 
 struct StripeInitInfo {
-  off_t       recover_pos;
-  AIOCallback vol_aio[4];
-  char       *vol_h_f;
+  off_t        recover_pos;
+  AIOCallback  vol_aio[4];
+  char        *vol_h_f;
+  AIOCallback *dir_aio         = nullptr;
+  int          dir_aio_count   = 0;
+  int          dir_aio_pending = 0;
+  bool         dir_aio_failed  = false;
 
   StripeInitInfo()
   {
@@ -105,6 +113,11 @@ struct StripeInitInfo {
       i.action = nullptr;
       i.mutex.clear();
     }
+    for (int i = 0; i < dir_aio_count; ++i) {
+      dir_aio[i].action = nullptr;
+      dir_aio[i].mutex.clear();
+    }
+    delete[] dir_aio;
     free(vol_h_f);
   }
 };
@@ -117,7 +130,8 @@ StripeSM::StripeSM(CacheDisk *disk, off_t blocks, off_t dir_skip, int avg_obj_si
     Stripe{disk, blocks, dir_skip, avg_obj_size, fragment_size},
     fd{disk->fd},
     disk{disk},
-    _preserved_dirs{len}
+    _preserved_dirs{len},
+    _load_start{ink_get_hrtime()}
 {
   open_dir.mutex = this->mutex;
   SET_HANDLER(&StripeSM::aggWrite);
@@ -153,6 +167,7 @@ StripeSM::close_read(CacheVC *cont) const
 int
 StripeSM::clear_dir()
 {
+  this->_set_dir_layout(_configured_dir_layout());
   size_t dir_len = this->dirlen();
   this->_clear_init(this->disk->hw_sector_size);
 
@@ -242,10 +257,20 @@ StripeSM::handle_dir_read(int event, void *data)
 
   if (event == AIO_EVENT_DONE) {
     if (!op->ok()) {
+      disk->incrErrors(op);
+      init_info->dir_aio_failed = true;
+    }
+    // Wait for every chunk, a failed read must not race the clear.
+    if (--init_info->dir_aio_pending > 0) {
+      return EVENT_CONT;
+    }
+    if (init_info->dir_aio_failed) {
       Note("Directory read failed: clearing cache directory %s", this->hash_text.get());
       clear_dir_aio();
       return EVENT_DONE;
     }
+    Dbg(dbg_ctl_cache_init, "read directory '%s' in %d chunks, %" PRId64 " ms", hash_text.get(), init_info->dir_aio_count,
+        ink_hrtime_to_msec(ink_get_hrtime() - _load_start));
   }
 
   if (!(directory.header->magic == STRIPE_MAGIC && directory.footer->magic == STRIPE_MAGIC &&
@@ -273,6 +298,7 @@ StripeSM::handle_dir_read(int event, void *data)
 int
 StripeSM::clear_dir_aio()
 {
+  this->_set_dir_layout(_configured_dir_layout());
   size_t dir_len = this->dirlen();
   this->_clear_init(this->disk->hw_sector_size);
 
@@ -644,6 +670,18 @@ StripeSM::handle_header_read(int event, void *data)
       op = op->then;
     }
 
+    // Header A sits at the start of the stripe whatever the directory layout.
+    // If it records a different layout than the directory was sized for, the
+    // other copies were read from the wrong place, resize and start over.
+    if (hf[0]->magic == STRIPE_MAGIC && hf[0]->dir_layout != static_cast<uint32_t>(directory.layout) &&
+        hf[0]->dir_layout <= static_cast<uint32_t>(DirLayout::WIDE)) {
+      this->_set_dir_layout(static_cast<DirLayout>(hf[0]->dir_layout));
+      delete init_info;
+      init_info = nullptr;
+      this->init(false);
+      return EVENT_DONE;
+    }
+
     io.aiocb.aio_fildes = fd;
     io.aiocb.aio_nbytes = this->dirlen();
     io.aiocb.aio_buf    = directory.raw_dir;
@@ -657,8 +695,7 @@ StripeSM::handle_header_read(int event, void *data)
       if (dbg_ctl_cache_init.on()) {
         Note("using directory A for '%s'", hash_text.get());
       }
-      io.aiocb.aio_offset = skip;
-      ink_assert(ink_aio_read(&io));
+      _read_dir(skip);
     }
     // try B
     else if (hf[2]->sync_serial == hf[3]->sync_serial) {
@@ -666,8 +703,7 @@ StripeSM::handle_header_read(int event, void *data)
       if (dbg_ctl_cache_init.on()) {
         Note("using directory B for '%s'", hash_text.get());
       }
-      io.aiocb.aio_offset = skip + this->dirlen();
-      ink_assert(ink_aio_read(&io));
+      _read_dir(skip + this->dirlen());
     } else {
       Note("no good directory, clearing '%s' since sync_serials on both A and B copies are invalid", hash_text.get());
       Note("Header A: %d\nFooter A: %d\n Header B: %d\n Footer B %d\n", hf[0]->sync_serial, hf[1]->sync_serial, hf[2]->sync_serial,
@@ -686,19 +722,110 @@ StripeSM::handle_header_read(int event, void *data)
 int
 StripeSM::dir_init_done(int /* event ATS_UNUSED */, void * /* data ATS_UNUSED */)
 {
-  if (!cache->cache_read_done) {
+  if (!cache->cache_read_done.load(std::memory_order_acquire)) {
     eventProcessor.schedule_in(this, HRTIME_MSECONDS(5), ET_CALL);
     return EVENT_CONT;
+  } else if (_async_load.load(std::memory_order_acquire)) {
+    // The cache opened without waiting for this stripe, it only has to start
+    // serving now.
+    SET_HANDLER(&StripeSM::aggWrite);
+    _mark_ready();
+    ts::Metrics::Gauge::increment(cache_rsb.direntries_used, directory.entries_used());
+    ts::Metrics::Gauge::increment(cache_vol->vol_rsb.direntries_used, directory.entries_used());
+    return EVENT_DONE;
   } else {
-    int i = gnstripes++;
-    ink_assert(!gstripes[i]);
-    gstripes[i] = this;
+    _register();
     SET_HANDLER(&StripeSM::aggWrite);
+    _mark_ready();
     cache->vol_initialized(fd != -1);
     return EVENT_DONE;
   }
 }
 
+void
+StripeSM::register_early()
+{
+  _register();
+  _async_load.store(true, std::memory_order_release);
+}
+
+void
+StripeSM::_register()
+{
+  int i = gnstripes++;
+  ink_assert(!gstripes[i]);
+  gstripes[i] = this;
+}
+
+void
+StripeSM::_mark_ready()
+{
+  ink_hrtime elapsed = ink_get_hrtime() - _load_start;
+  _ready.store(true, std::memory_order_release);
+  ts::Metrics::Gauge::increment(cache_rsb.stripes_ready);
+  ts::Metrics::Gauge::increment(cache_vol->vol_rsb.stripes_ready);
+  if (ready_time) {
+    ts::Metrics::Gauge::store(ready_time, ink_hrtime_to_msec(elapsed));
+  }
+  Dbg(dbg_ctl_cache_init, "stripe '%s' ready after %" PRId64 " ms", hash_text.get(), ink_hrtime_to_msec(elapsed));
+}
+
+void
+StripeSM::_read_dir(off_t offset)
+{
+  size_t dir_len = this->dirlen();
+  int    n       = (dir_len + DIR_READ_CHUNK_SIZE - 1) / DIR_READ_CHUNK_SIZE;
+
+  init_info->dir_aio         = new AIOCallback[n];
+  init_info->dir_aio_count   = n;
+  init_info->dir_aio_pending = n;
+  init_info->dir_aio_failed  = false;
+  for (int i = 0; i < n; i++) {
+    AIOCallback *aio      = &init_info->dir_aio[i];
+    size_t       pos      = i * DIR_READ_CHUNK_SIZE;
+    aio->aiocb.aio_fildes = fd;
+    aio->aiocb.aio_buf    = directory.raw_dir + pos;
+    aio->aiocb.aio_nbytes = std::min(DIR_READ_CHUNK_SIZE, dir_len - pos);
+    aio->aiocb.aio_offset = offset + pos;
+    aio->action           = this;
+    aio->thread           = AIO_CALLBACK_THREAD_ANY;
+    aio->then             = nullptr;
+  }
+  // The chunks are independent requests, so the AIO threads of the disk
+  // read them concurrently.
+  for (int i = 0; i < n; i++) {
+    ink_assert(ink_aio_read(&init_info->dir_aio[i]));
+  }
+}
+
+AggWriteOp::AggWriteOp(StripeSM *stripe, AggregateWriteBuffer::InFlight *flight)
+  : Continuation(stripe->mutex), stripe{stripe}, flight{flight}, start{ink_get_hrtime()}
+{
+  SET_HANDLER(&AggWriteOp::handle_write_done);
+}
+
+/* Called on the AIO thread with the stripe lock held.
+ */
+int
+AggWriteOp::handle_write_done(int /* event ATS_UNUSED */, void * /* data ATS_UNUSED */)
+{
+  flight->done = true;
+  flight->ok   = io.ok();
+
+  // Buckets are powers of 4 milliseconds, see CacheStatsBlock::agg_write_latency.
+  ink_hrtime elapsed = ink_get_hrtime() - start;
+  int        bucket  = 0;
+  for (ink_hrtime limit = HRTIME_MSECONDS(1); bucket < 5 && elapsed >= limit; limit *= 4) {
+    bucket++;
+  }
+  ts::Metrics::Counter::increment(cache_rsb.agg_write_latency[bucket]);
+  ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.agg_write_latency[bucket]);
+
+  stripe->aggWriteDone(AIO_EVENT_DONE, nullptr);
+  delete this;
+  return EVENT_DONE;
+}
+
 /* NOTE:: This state can be called by an AIO thread, so DON'T DON'T
    DON'T schedule any events on this thread using VC_SCHED_XXX or
    mutex->thread_holding->schedule_xxx_local(). ALWAYS use
@@ -707,46 +834,54 @@ StripeSM::dir_init_done(int /* event ATS_UNUSED */, void * /* data ATS_UNUSED */
 int
 StripeSM::aggWriteDone(int event, Event *e)
 {
-  cancel_trigger();
+  ink_assert(this->mutex->thread_holding == this_ethread());
 
-  // ensure we have the waiting_dir_sync lock if we intend to call it later
-  // retaking the current mutex recursively is a NOOP
-  CACHE_TRY_LOCK(lock, dir_sync_waiting ? waiting_dir_sync->mutex : mutex, mutex->thread_holding);
-  if (!lock.is_locked()) {
-    eventProcessor.schedule_in(this, HRTIME_MSECONDS(cache_config_mutex_retry_delay));
-    return EVENT_CONT;
-  }
-  if (io.ok()) {
+  // Writes complete in any order, but the write position only moves over
+  // buffers once every buffer before them is on disk.
+  auto &in_flight = this->_write_buffer.get_in_flight();
+  while (!in_flight.empty() && in_flight.front().done) {
+    auto &flight = in_flight.front();
+    if (flight.flushed) {
+      // A flush already wrote the buffer and moved the write position over it.
+      this->_write_buffer.retire();
+      ts::Metrics::Gauge::decrement(cache_rsb.agg_write_in_flight);
+      ts::Metrics::Gauge::decrement(cache_vol->vol_rsb.agg_write_in_flight);
+      continue;
+    }
+    if (!flight.ok) {
+      // delete all the directory entries that we inserted
+      // for fragments is this aggregation buffer
+      Dbg(dbg_ctl_cache_disk_error, "Write error on disk %s\n \
+            write range : [%" PRIu64 " - %" PRIu64 " bytes]  [%" PRIu64 " - %" PRIu64 " blocks] \n",
+          hash_text.get(), (uint64_t)flight.offset, (uint64_t)flight.offset + flight.len,
+          (uint64_t)flight.offset / CACHE_BLOCK_SIZE, (uint64_t)(flight.offset + flight.len) / CACHE_BLOCK_SIZE);
+      Dir del_dir;
+      dir_clear(&del_dir);
+      for (int done = 0; done < flight.len;) {
+        Doc *doc = reinterpret_cast<Doc *>(flight.buffer + done);
+        dir_set_offset(&del_dir, flight.offset + done);
+        this->directory.remove(&doc->key, this, &del_dir);
+        done += round_to_approx_size(doc->len);
+      }
+    }
+    // A failed buffer is skipped rather than rewritten, the buffers behind it
+    // were placed after it.
     directory.header->last_write_pos  = directory.header->write_pos;
-    directory.header->write_pos      += io.aiocb.aio_nbytes;
+    directory.header->write_pos      += flight.len;
     ink_assert(directory.header->write_pos >= start);
+    ink_assert(directory.header->write_pos == flight.offset + flight.len);
     DDbg(dbg_ctl_cache_agg, "Dir %s, Write: %" PRIu64 ", last Write: %" PRIu64 "", hash_text.get(), directory.header->write_pos,
          directory.header->last_write_pos);
-    ink_assert(directory.header->write_pos == directory.header->agg_pos);
     if (directory.header->write_pos + EVACUATION_SIZE > scan_pos) {
-      ink_assert(this->mutex->thread_holding == this_ethread());
       this->_preserved_dirs.periodic_scan(this);
     }
-    this->_write_buffer.reset_buffer_pos();
     directory.header->write_serial++;
-  } else {
-    // delete all the directory entries that we inserted
-    // for fragments is this aggregation buffer
-    Dbg(dbg_ctl_cache_disk_error, "Write error on disk %s\n \
-            write range : [%" PRIu64 " - %" PRIu64 " bytes]  [%" PRIu64 " - %" PRIu64 " blocks] \n",
-        hash_text.get(), (uint64_t)io.aiocb.aio_offset, (uint64_t)io.aiocb.aio_offset + io.aiocb.aio_nbytes,
-        (uint64_t)io.aiocb.aio_offset / CACHE_BLOCK_SIZE, (uint64_t)(io.aiocb.aio_offset + io.aiocb.aio_nbytes) / CACHE_BLOCK_SIZE);
-    Dir del_dir;
-    dir_clear(&del_dir);
-    for (int done = 0; done < this->_write_buffer.get_buffer_pos();) {
-      Doc *doc = reinterpret_cast<Doc *>(this->_write_buffer.get_buffer() + done);
-      dir_set_offset(&del_dir, directory.header->write_pos + done);
-      this->directory.remove(&doc->key, this, &del_dir);
-      done += round_to_approx_size(doc->len);
-    }
-    this->_write_buffer.reset_buffer_pos();
+    this->_write_buffer.retire();
+    ts::Metrics::Gauge::decrement(cache_rsb.agg_write_in_flight);
+    ts::Metrics::Gauge::decrement(cache_vol->vol_rsb.agg_write_in_flight);
   }
-  set_io_not_in_progress();
+  ink_assert(!in_flight.empty() || directory.header->write_pos == directory.header->agg_pos);
+
   // callback ready sync CacheVCs
   CacheVC *c = nullptr;
   while ((c = sync.dequeue())) {
@@ -758,11 +893,20 @@ StripeSM::aggWriteDone(int event, Event *e)
     }
   }
   if (dir_sync_waiting) {
-    dir_sync_waiting = false;
-    waiting_dir_sync->handleEvent(EVENT_IMMEDIATE, nullptr);
-    waiting_dir_sync = nullptr;
+    CacheSync *waiting = waiting_dir_sync;
+    dir_sync_waiting   = false;
+    waiting_dir_sync   = nullptr;
+    // the sync checks again whether it has to wait for the aggregation buffer
+    CACHE_TRY_LOCK(lock, waiting->mutex, mutex->thread_holding);
+    if (lock.is_locked()) {
+      waiting->handleEvent(EVENT_IMMEDIATE, nullptr);
+    } else {
+      eventProcessor.schedule_imm(waiting);
+    }
   }
-  if (this->_write_buffer.get_pending_writers().head || sync.head) {
+  // An evacuation read in progress calls aggWrite() when it is done.
+  if (!is_io_in_progress() && (this->_write_buffer.get_pending_writers().head || sync.head ||
+                               this->_write_buffer.get_buffer_pos() >= AGG_HIGH_WATER)) {
     return aggWrite(event, e);
   }
   return EVENT_CONT;
@@ -782,6 +926,7 @@ StripeSM::aggWrite(int event, void * /* e ATS_UNUSED */)
 
   Que(CacheVC, link) tocall;
   CacheVC *c;
+  off_t    end;
 
   cancel_trigger();
 
@@ -791,7 +936,11 @@ Lagain:
   // if we got nothing...
   if (this->_write_buffer.is_empty()) {
     if (!this->_write_buffer.get_pending_writers().head && !sync.head) { // nothing to get
-      return EVENT_CONT;
+      goto Lwait;
+    }
+    // wait for the writes in flight, they call back when they are done
+    if (this->is_agg_write_in_flight()) {
+      goto Lwait;
     }
     if (directory.header->write_pos == start) {
       // write aggregation too long, bad bad, punt on everything.
@@ -812,8 +961,8 @@ Lagain:
   }
 
   // evacuate space
-  off_t end = directory.header->write_pos + this->_write_buffer.get_buffer_pos() + EVACUATION_SIZE;
-  if (evac_range(directory.header->write_pos, end, !directory.header->phase) < 0) {
+  end = this->get_agg_buf_offset() + this->_write_buffer.get_buffer_pos() + EVACUATION_SIZE;
+  if (evac_range(this->get_agg_buf_offset(), end, !directory.header->phase) < 0) {
     goto Lwait;
   }
   if (end > skip + len) {
@@ -829,6 +978,24 @@ Lagain:
     goto Lwait;
   }
 
+  // the writes in flight call back when there is room for another one
+  if (static_cast<int>(this->_write_buffer.get_in_flight().size()) >= cache_config_agg_write_queue_depth) {
+    goto Lwait;
+  }
+
+  // cache fill must leave the disk enough bandwidth to serve hits
+  if (cache_config_agg_write_disk_bandwidth > 0) {
+    int        bytes = this->_write_buffer.is_empty() ? round_to_approx_size(sizeof(Doc)) : this->_write_buffer.get_buffer_pos();
+    ink_hrtime delay = disk->charge_write_budget(bytes, cache_config_agg_write_disk_bandwidth);
+    if (delay) {
+      ts::Metrics::Counter::increment(cache_rsb.agg_write_throttled);
+      ts::Metrics::Counter::increment(cache_vol->vol_rsb.agg_write_throttled);
+      SET_HANDLER(&StripeSM::aggWrite);
+      trigger = eventProcessor.schedule_in(this, delay);
+      goto Lwait;
+    }
+  }
+
   // write sync marker
   if (this->_write_buffer.is_empty()) {
     ink_assert(sync.head);
@@ -839,25 +1006,34 @@ Lagain:
     d->magic        = DOC_MAGIC;
     d->len          = l;
     d->sync_serial  = directory.header->sync_serial;
-    d->write_serial = directory.header->write_serial;
+    d->write_serial = this->_agg_write_serial();
   }
 
   // set write limit
-  directory.header->agg_pos = directory.header->write_pos + this->_write_buffer.get_buffer_pos();
+  this->_set_agg_pos(this->get_agg_buf_offset() + this->_write_buffer.get_buffer_pos());
 
-  io.aiocb.aio_fildes = fd;
-  io.aiocb.aio_offset = directory.header->write_pos;
-  io.aiocb.aio_buf    = this->_write_buffer.get_buffer();
-  io.aiocb.aio_nbytes = this->_write_buffer.get_buffer_pos();
-  io.action           = this;
-  /*
-    Callback on AIO thread so that we can issue a new write ASAP
-    as all writes are serialized in the volume.  This is not necessary
-    for reads proceed independently.
-   */
-  io.thread = AIO_CALLBACK_THREAD_AIO;
-  SET_HANDLER(&StripeSM::aggWriteDone);
-  ink_aio_write(&io);
+  {
+    auto       &flight = this->_write_buffer.submit(this->get_agg_buf_offset());
+    AggWriteOp *op     = new AggWriteOp(this, &flight);
+
+    op->io.aiocb.aio_fildes = fd;
+    op->io.aiocb.aio_offset = flight.offset;
+    op->io.aiocb.aio_buf    = flight.buffer;
+    op->io.aiocb.aio_nbytes = flight.len;
+    op->io.action           = op;
+    /*
+      Callback on AIO thread so that we can issue a new write ASAP
+      as all writes are serialized in the volume.  This is not necessary
+      for reads proceed independently.
+     */
+    op->io.thread = AIO_CALLBACK_THREAD_AIO;
+    ink_aio_write(&op->io);
+    ts::Metrics::Gauge::increment(cache_rsb.agg_write_in_flight);
+    ts::Metrics::Gauge::increment(cache_vol->vol_rsb.agg_write_in_flight);
+  }
+  // Keep filling buffers while the queue has room. With io_uring the writes
+  // issued here go to the kernel in a single submission.
+  goto Lagain;
 
 Lwait:
   int ret = EVENT_CONT;
@@ -879,11 +1055,11 @@ StripeSM::aggregate_pending_writes(Queue<CacheVC, Continuation::Link_link> &toca
     // [amc] this is checked multiple places, on here was it strictly less.
     ink_assert(writelen <= AGG_SIZE);
     if (this->_write_buffer.get_buffer_pos() + writelen > AGG_SIZE ||
-        this->directory.header->write_pos + this->_write_buffer.get_buffer_pos() + writelen > (this->skip + this->len)) {
+        this->get_agg_buf_offset() + this->_write_buffer.get_buffer_pos() + writelen > (this->skip + this->len)) {
       break;
     }
     DDbg(dbg_ctl_agg_read, "copying: %d, %" PRIu64 ", key: %d", this->_write_buffer.get_buffer_pos(),
-         this->directory.header->write_pos + this->_write_buffer.get_buffer_pos(), c->first_key.slice32(0));
+         this->get_agg_buf_offset() + this->_write_buffer.get_buffer_pos(), c->first_key.slice32(0));
     [[maybe_unused]] int wrotelen = this->_agg_copy(c);
     ink_assert(writelen == wrotelen);
     CacheVC *n = static_cast<CacheVC *>(c->link.next);
@@ -923,9 +1099,9 @@ StripeSM::_copy_evacuator_to_aggregation(CacheVC *vc)
   ts::Metrics::Counter::increment(this->cache_vol->vol_rsb.gc_frags_evacuated);
 
   doc->sync_serial  = this->directory.header->sync_serial;
-  doc->write_serial = this->directory.header->write_serial;
+  doc->write_serial = this->_agg_write_serial();
 
-  off_t doc_offset{this->directory.header->write_pos + this->_write_buffer.get_buffer_pos()};
+  off_t doc_offset{this->get_agg_buf_offset() + this->_write_buffer.get_buffer_pos()};
   this->_write_buffer.add(doc, approx_size);
 
   vc->dir = vc->overwrite_dir;
@@ -937,7 +1113,7 @@ StripeSM::_copy_evacuator_to_aggregation(CacheVC *vc)
 int
 StripeSM::_copy_writer_to_aggregation(CacheVC *vc)
 {
-  off_t          doc_offset{this->directory.header->write_pos + this->get_agg_buf_pos()};
+  off_t          doc_offset{this->get_agg_buf_offset() + this->get_agg_buf_pos()};
   uint32_t       len         = vc->write_len + vc->header_len + vc->frag_len + sizeof(Doc);
   Doc           *doc         = this->_write_buffer.emplace(this->round_to_approx_size(len));
   IOBufferBlock *res_alt_blk = nullptr;
@@ -953,7 +1129,7 @@ StripeSM::_copy_writer_to_aggregation(CacheVC *vc)
   // fill in document header
   init_document(vc, doc, len);
   doc->sync_serial = this->directory.header->sync_serial;
-  vc->write_serial = doc->write_serial = this->directory.header->write_serial;
+  vc->write_serial = doc->write_serial = this->_agg_write_serial();
   if (vc->get_pin_in_cache()) {
     dir_set_pinned(&vc->dir, 1);
     doc->pin(vc->get_pin_in_cache());
@@ -998,6 +1174,11 @@ StripeSM::_copy_writer_to_aggregation(CacheVC *vc)
   if (vc->frag_type == CACHE_FRAG_TYPE_HTTP && vc->f.single_fragment) {
     ink_assert(doc->hlen);
   }
+  // share data fragments with the readers following this writer
+  if (vc->f.readers && vc->od && vc->fragment > 0 && !vc->header_len && !vc->f.use_first_key &&
+      cache_config_read_while_writer_fragment_ring > 0 && len <= BUFFER_SIZE_FOR_INDEX(MAX_BUFFER_SIZE_INDEX)) {
+    this->_publish_fragment(vc, doc);
+  }
 
   if (res_alt_blk) {
     res_alt_blk->free();
@@ -1006,6 +1187,19 @@ StripeSM::_copy_writer_to_aggregation(CacheVC *vc)
   return vc->agg_len;
 }
 
+void
+StripeSM::_publish_fragment(CacheVC *vc, Doc const *doc)
+{
+  Ptr<IOBufferData> data{new_IOBufferData(iobuffer_size_to_index(doc->len, MAX_BUFFER_SIZE_INDEX), MEMALIGNED)};
+  memcpy(data->data(), doc, doc->len);
+  if (!vc->od->fragment_ring) {
+    vc->od->fragment_ring = new OpenDirFragmentRing(cache_config_read_while_writer_fragment_ring);
+  }
+  vc->od->fragment_ring->publish(doc->key, vc->fragment, data.get());
+  ts::Metrics::Counter::increment(cache_rsb.rww_fragments_published);
+  ts::Metrics::Counter::increment(this->cache_vol->vol_rsb.rww_fragments_published);
+}
+
 static void
 init_document(CacheVC const *vc, Doc *doc, int const len)
 {
@@ -1073,7 +1267,7 @@ StripeSM::agg_wrap()
   directory.header->phase     = !directory.header->phase;
 
   directory.header->cycle++;
-  directory.header->agg_pos = directory.header->write_pos;
+  this->_set_agg_pos(directory.header->write_pos);
   dir_lookaside_cleanup(this);
   this->directory.cleanup(this);
   {
@@ -1325,6 +1519,10 @@ StripeSM::shutdown(EThread *shutdown_thread)
   // be another aggWrite in progress
   SCOPED_MUTEX_LOCK(lock, this->mutex, shutdown_thread);
 
+  if (!this->is_ready()) {
+    Dbg(dbg_ctl_cache_dir_sync, "Dir %s: ignoring -- not loaded", this->hash_text.get());
+    return;
+  }
   if (DISK_BAD(this->disk)) {
     Dbg(dbg_ctl_cache_dir_sync, "Dir %s: ignoring -- bad disk", this->hash_text.get());
     return;
@@ -1340,7 +1538,7 @@ StripeSM::shutdown(EThread *shutdown_thread)
   // check if we have data in the agg buffer
   // dont worry about the cachevc s in the agg queue
   // directories have not been inserted for these writes
-  if (!this->_write_buffer.is_empty()) {
+  if (!this->_write_buffer.is_empty() || this->is_agg_write_in_flight()) {
     Dbg(dbg_ctl_cache_dir_sync, "Dir %s: flushing agg buffer first", this->hash_text.get());
     this->flush_aggregate_write_buffer(this->fd);
   }
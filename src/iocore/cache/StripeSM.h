@@ -34,6 +34,7 @@
 
 #include "tscore/CryptoHash.h"
 #include "tscore/List.h"
+#include "tscore/ink_hrtime.h"
 
 #include <atomic>
 
@@ -59,6 +60,26 @@ struct Cache;
 struct StripeInitInfo;
 class CacheEvacuateDocVC;
 class RamCache;
+class StripeSM;
+
+/**
+  The disk write of one aggregation buffer.
+
+  With proxy.config.cache.agg_write_queue_depth above 1 several buffers can be
+  on their way to disk at once and the writes may complete in any order, so
+  each carries its own callback. The stripe retires them in the order they
+  were submitted.
+ */
+struct AggWriteOp : public Continuation {
+  AIOCallback                     io;
+  StripeSM                       *stripe = nullptr;
+  AggregateWriteBuffer::InFlight *flight = nullptr;
+  ink_hrtime                      start  = 0;
+
+  AggWriteOp(StripeSM *stripe, AggregateWriteBuffer::InFlight *flight);
+
+  int handle_write_done(int event, void *data);
+};
 
 /**
   @class StripeSM
@@ -76,7 +97,7 @@ class RamCache;
     4. Directly from aggWriteDone
   end note
 
-  aggWrite --> aggWriteDone
+  aggWrite --> aggWriteDone : AggWriteOp
 
   note bottom of aggWriteDone
     calls aggWrite() directly
@@ -93,7 +114,7 @@ class RamCache;
   aggWrite --> handle_header_read  : init(false)
   aggWrite --> handle_dir_clear : init(true)
 
-  handle_header_read --> handle_dir_read
+  handle_header_read --> handle_dir_read : _read_dir()
   handle_header_read --> handle_dir_clear : clear_dir_aio()
 
   handle_dir_read --> handle_recover_from_data : recover_data()
@@ -135,6 +156,9 @@ public:
 
   StripeInitInfo *init_info = nullptr;
 
+  /// proxy.process.cache.volume_N.stripe_M.ready_time, created when the cache opens.
+  ts::Metrics::Gauge::AtomicType *ready_time = nullptr;
+
   Cache     *cache                = nullptr;
   uint32_t   last_sync_serial     = 0;
   uint32_t   last_write_serial    = 0;
@@ -176,6 +200,8 @@ public:
 
   int  is_io_in_progress() const;
   void set_io_not_in_progress();
+  /// Whether aggregation buffers are on their way to disk.
+  bool is_agg_write_in_flight() const;
 
   int aggWriteDone(int event, Event *e);
   int aggWrite(int event, void *e);
@@ -264,6 +290,26 @@ public:
    */
   void shutdown(EThread *shutdown_thread);
 
+  /**
+   * Whether the directory has been loaded and the stripe can serve requests.
+   *
+   * With proxy.config.cache.dir.async_load the cache opens before every
+   * stripe has loaded its directory. Requests for a stripe that is still
+   * loading fail as if the document were not in the cache.
+   */
+  bool is_ready() const;
+
+  /**
+   * Add the stripe to gstripes while its directory is still loading, so the
+   * cache can open without waiting for it.
+   *
+   * @see is_ready
+   */
+  void register_early();
+
+  /// Whether the stripe was registered by register_early().
+  bool is_async_load() const;
+
   bool
   evac_bucket_valid(off_t bucket) const
   {
@@ -291,9 +337,27 @@ public:
 private:
   mutable PreservationTable _preserved_dirs;
 
+  std::atomic<bool> _ready{false};
+  std::atomic<bool> _async_load{false};
+  ink_hrtime        _load_start{0};
+
+  void _register();
+  void _mark_ready();
+  void _read_dir(off_t offset);
+
+  /* Write serial the documents in the aggregation buffer will be written
+     under, counting the buffers still in flight ahead of it.
+   */
+  uint32_t _agg_write_serial() const;
+
   int _agg_copy(CacheVC *vc);
   int _copy_writer_to_aggregation(CacheVC *vc);
   int _copy_evacuator_to_aggregation(CacheVC *vc);
+
+  /* Copy a data fragment the writer @a vc has just aggregated into the ring
+     its readers share.
+   */
+  void _publish_fragment(CacheVC *vc, Doc const *doc);
 };
 
 // Global Data
@@ -320,6 +384,18 @@ StripeSM::open_read(const CryptoHash *key) const
   return open_dir.open_read(key);
 }
 
+inline bool
+StripeSM::is_ready() const
+{
+  return _ready.load(std::memory_order_acquire);
+}
+
+inline bool
+StripeSM::is_async_load() const
+{
+  return _async_load.load(std::memory_order_acquire);
+}
+
 inline int
 StripeSM::is_io_in_progress() const
 {
@@ -332,6 +408,18 @@ StripeSM::set_io_not_in_progress()
   io.aiocb.aio_fildes = AIO_NOT_IN_PROGRESS;
 }
 
+inline bool
+StripeSM::is_agg_write_in_flight() const
+{
+  return !this->_write_buffer.get_in_flight().empty();
+}
+
+inline uint32_t
+StripeSM::_agg_write_serial() const
+{
+  return directory.header->write_serial + this->_write_buffer.get_writes_in_flight();
+}
+
 inline Queue<CacheVC, Continuation::Link_link> &
 StripeSM::get_pending_writers()
 {
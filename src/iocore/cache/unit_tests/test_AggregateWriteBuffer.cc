@@ -23,6 +23,8 @@
 
 #include "main.h"
 
+#include <cstring>
+
 int  cache_vols           = 1;
 bool reuse_existing_cache = false;
 
@@ -50,3 +52,61 @@ TEST_CASE("Given 10 bytes are pending to the buffer, "
   write_buffer.emplace(10);
   CHECK(0 == write_buffer.get_bytes_pending_aggregation());
 }
+
+TEST_CASE("Given a filled buffer, "
+          "when we submit it, "
+          "then its bytes should be in flight and aggregation should continue in an empty buffer.")
+{
+  AggregateWriteBuffer write_buffer;
+  char                *filled = write_buffer.get_buffer();
+  memset(static_cast<void *>(write_buffer.emplace(1024)), 'a', 1024);
+
+  auto &flight = write_buffer.submit(8192);
+  CHECK(filled == flight.buffer);
+  CHECK(8192 == flight.offset);
+  CHECK(1024 == flight.len);
+  CHECK(1024 == write_buffer.get_bytes_in_flight());
+  CHECK(write_buffer.is_empty());
+  CHECK(filled != write_buffer.get_buffer());
+
+  SECTION("then the in flight bytes should be readable by stripe offset.")
+  {
+    char dest[16] = {};
+    CHECK(write_buffer.copy_from_in_flight(dest, 8192 + 100, sizeof(dest)));
+    CHECK(0 == memcmp(dest, filled + 100, sizeof(dest)));
+    CHECK_FALSE(write_buffer.copy_from_in_flight(dest, 8192 + 1024, sizeof(dest)));
+    CHECK_FALSE(write_buffer.copy_from_in_flight(dest, 0, sizeof(dest)));
+  }
+
+  SECTION("when the write completes and is retired, "
+          "then its buffer should be reused by the next submission.")
+  {
+    write_buffer.get_in_flight().front().done = true;
+    write_buffer.retire();
+    CHECK(0 == write_buffer.get_bytes_in_flight());
+    CHECK(write_buffer.get_in_flight().empty());
+
+    write_buffer.emplace(512);
+    write_buffer.submit(8192 + 1024);
+    CHECK(filled == write_buffer.get_buffer());
+  }
+}
+
+TEST_CASE("Given two buffers are in flight, "
+          "then each should be read back from its own offset.")
+{
+  AggregateWriteBuffer write_buffer;
+  memset(static_cast<void *>(write_buffer.emplace(1024)), 'a', 1024);
+  write_buffer.submit(0);
+  memset(static_cast<void *>(write_buffer.emplace(2048)), 'b', 2048);
+  write_buffer.submit(1024);
+
+  CHECK(2 == write_buffer.get_in_flight().size());
+  CHECK(3072 == write_buffer.get_bytes_in_flight());
+
+  char dest = 0;
+  CHECK(write_buffer.copy_from_in_flight(&dest, 1023, 1));
+  CHECK('a' == dest);
+  CHECK(write_buffer.copy_from_in_flight(&dest, 1024, 1));
+  CHECK('b' == dest);
+}
@@ -91,6 +91,30 @@ public:
 
     stripe->clear_dir();
 
+    // test incremental sync planning
+    {
+      CacheSync sync;
+      sync.buflen = stripe->dirlen();
+      sync.buf    = static_cast<char *>(ats_memalign(ats_pagesize(), sync.buflen));
+      stripe->directory.reset_sync_state();
+      sync.plan_writes(stripe, 0);
+      CHECK(sync.segments_written.size() == static_cast<size_t>(stripe->directory.segments));
+      for (auto [ws, version] : sync.segments_written) {
+        stripe->directory.synced_version[0][ws] = version;
+      }
+      // nothing changed, only the header and footer are written
+      sync.plan_writes(stripe, 0);
+      CHECK(sync.segments_written.empty());
+      CHECK(sync.writes.front().first == 0);
+      CHECK(sync.writes.back().first + static_cast<off_t>(sync.writes.back().second) == static_cast<off_t>(stripe->dirlen()));
+      stripe->directory.mark_dirty(0);
+      sync.plan_writes(stripe, 0);
+      CHECK(sync.segments_written.size() == 1);
+      // the other copy has never been written
+      sync.plan_writes(stripe, 1);
+      CHECK(sync.segments_written.size() == static_cast<size_t>(stripe->directory.segments));
+    }
+
     // coverity[var_decl]
     Dir dir;
     dir_clear(&dir);
@@ -155,6 +179,61 @@ public:
       Dbg(dbg_ctl_cache_dir_test, "probe rate = %d / second", static_cast<int>((newfree * static_cast<uint64_t>(1000000)) / us));
     }
 
+    // the vectorized probe finds the same entries
+    cache_config_dir_vectorized_probe = 1;
+    regress_rand_init(13);
+    for (i = 0; i < newfree; i++) {
+      Dir *last_collision = nullptr;
+      regress_rand_CacheKey(&key);
+      CHECK(stripe->directory.probe(&key, stripe, &dir, &last_collision));
+    }
+    cache_config_dir_vectorized_probe = 0;
+
+    // the vectorized bucket scan agrees with the scalar one on a populated segment
+    for (i = 0; i < stripe->directory.buckets; i++) {
+      Dir     *b    = dir_bucket(i, seg);
+      uint32_t base = dir_to_offset(b, seg);
+      regress_rand_CacheKey(&key);
+      DirBucketScan simd   = dir_bucket_scan(b, base, key.slice32(2));
+      DirBucketScan scalar = dir_bucket_scan_scalar(b, base, key.slice32(2));
+      CHECK(simd.tag_match == scalar.tag_match);
+      CHECK(simd.empty == scalar.empty);
+      CHECK(simd.local_next == scalar.local_next);
+      if (dir_bucket_scan_miss(b, base, simd)) {
+        for (Dir *e = b; e; e = next_dir(e, seg)) {
+          CHECK(!dir_compare_tag(e, &key));
+        }
+      }
+    }
+
+    // the wide layout keeps every bucket on its own cache line
+    cache_config_dir_wide_buckets = 1;
+    stripe->clear_dir();
+    CHECK(stripe->directory.layout == DirLayout::WIDE);
+    CHECK(stripe->directory.header->dir_layout == static_cast<uint32_t>(DirLayout::WIDE));
+    stripe->directory.header->agg_pos = stripe->directory.header->write_pos += 1024;
+    seg                               = stripe->directory.get_segment(s);
+    for (i = 0; i < stripe->directory.buckets; i++) {
+      CHECK(reinterpret_cast<uintptr_t>(stripe->directory.bucket(i, seg)) % DIR_WIDE_BUCKET_SIZE == 0);
+    }
+    CHECK(stripe->directory.freelist_length(s) == (DIR_WIDE_DEPTH - 1) * stripe->directory.buckets);
+    regress_rand_init(17);
+    for (i = 0; i < newfree; i++) {
+      regress_rand_CacheKey(&key);
+      stripe->directory.insert(&key, stripe, &dir);
+    }
+    regress_rand_init(17);
+    for (i = 0; i < newfree; i++) {
+      Dir *last_collision = nullptr;
+      regress_rand_CacheKey(&key);
+      CHECK(stripe->directory.probe(&key, stripe, &dir, &last_collision));
+    }
+    CHECK(stripe->directory.check());
+    cache_config_dir_wide_buckets = 0;
+    stripe->clear_dir();
+    stripe->directory.header->agg_pos = stripe->directory.header->write_pos += 1024;
+    seg                               = stripe->directory.get_segment(s);
+
     for (int c = 0; c < stripe->directory.entries() * 0.75; c++) {
       regress_rand_CacheKey(&key);
       stripe->directory.insert(&key, stripe, &dir);
@@ -236,7 +315,39 @@ public:
       CHECK(!stripe->directory.check());
 #endif
     }
+
+    // a segment loaded with a link out of range is cleared when first used
     stripe->clear_dir();
+    seg  = stripe->directory.get_segment(s);
+    free = stripe->directory.freelist_length(s);
+    dir_set_next(stripe->directory.bucket(0, seg), stripe->directory.buckets * stripe->directory.depth());
+    stripe->directory.segment_valid[s] = 0;
+    stripe->directory.validate_segment(s);
+    CHECK(dir_next(stripe->directory.bucket(0, seg)) == 0);
+    CHECK(stripe->directory.freelist_length(s) == free);
+    CHECK(stripe->directory.segment_valid[s]);
+    stripe->clear_dir();
+
+    // the read while writer fragment ring keeps only the newest fragments
+    {
+      OpenDirFragmentRing ring{2};
+      CacheKey            fkey[3];
+      Ptr<IOBufferData>   data[3];
+      int                 lag = 0;
+      for (int i = 0; i < 3; i++) {
+        rand_CacheKey(&fkey[i]);
+        data[i] = new_IOBufferData(BUFFER_SIZE_INDEX_4K);
+        ring.publish(fkey[i], i + 1, data[i].get());
+      }
+      CHECK(ring.newest == 3);
+      CHECK(ring.find(fkey[0], 1, &lag) == nullptr);
+      CHECK(lag == 2);
+      CHECK(ring.find(fkey[1], 2, &lag) == data[1].get());
+      CHECK(lag == 1);
+      CHECK(ring.find(fkey[2], 3, &lag) == data[2].get());
+      CHECK(lag == 0);
+      CHECK(ring.find(fkey[1], 3, &lag) == nullptr);
+    }
 
     // Teardown
     test_done();
@@ -0,0 +1,224 @@
+/** @file
+
+  Trace driven RAM cache simulator.
+
+  Replays a request trace against every RamCache algorithm, with and without
+  the TinyLFU admission policy, and reports the hit ratio and byte hit ratio
+  of each. Each request is a get() followed by a put() on a miss, the same
+  sequence CacheVC uses.
+
+  The trace is read from the file named by the RAM_CACHE_SIM_TRACE environment
+  variable, one request per line as "<key> <size in bytes>". Without it a
+  synthetic trace is generated: Zipf distributed requests for a hot set mixed
+  with requests for objects that are never asked for again.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "main.h"
+
+#include "../P_CacheInternal.h"
+#include "../P_RamCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std::literals;
+
+// Required by main.h
+int  cache_vols           = 1;
+bool reuse_existing_cache = false;
+
+namespace
+{
+constexpr int64_t RAM_CACHE_SIZE    = 16 * 1024 * 1024;
+constexpr int     HOT_OBJECTS       = 10000;
+constexpr int     REQUESTS          = 200000;
+constexpr double  ZIPF_ALPHA        = 0.9;
+constexpr double  ONE_HIT_FRACTION  = 0.3;
+constexpr double  WARMUP_FRACTION   = 0.1;
+constexpr int     OBJECT_SIZES[]    = {8 * 1024, 16 * 1024, 32 * 1024};
+constexpr char    TRACE_ENV[]       = "RAM_CACHE_SIM_TRACE";
+constexpr char    SYNTHETIC_TRACE[] = "synthetic";
+
+struct Request {
+  CryptoHash key;
+  uint32_t   size;
+};
+
+struct SimResult {
+  double hit_ratio      = 0;
+  double byte_hit_ratio = 0;
+};
+
+std::vector<Request>
+load_trace(const char *path)
+{
+  std::vector<Request> trace;
+  std::ifstream        in(path);
+  std::string          line;
+  while (std::getline(in, line)) {
+    std::istringstream fields(line);
+    std::string        name;
+    uint64_t           size = 0;
+    if (!(fields >> name >> size) || size == 0) {
+      continue;
+    }
+    Request r;
+    CryptoContext().hash_immediate(r.key, name.data(), name.size());
+    r.size = static_cast<uint32_t>(std::min<uint64_t>(size, BUFFER_SIZE_FOR_INDEX(MAX_BUFFER_SIZE_INDEX)));
+    trace.push_back(r);
+  }
+  return trace;
+}
+
+std::vector<Request>
+synthetic_trace()
+{
+  std::vector<double> cdf(HOT_OBJECTS);
+  double              sum = 0;
+  for (int i = 0; i < HOT_OBJECTS; i++) {
+    sum    += 1.0 / std::pow(i + 1, ZIPF_ALPHA);
+    cdf[i]  = sum;
+  }
+
+  std::mt19937                           rng(13);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  std::vector<Request>                   trace;
+  uint64_t                               one_hit = 0;
+  for (int i = 0; i < REQUESTS; i++) {
+    Request  r;
+    uint64_t id;
+    if (uniform(rng) < ONE_HIT_FRACTION) {
+      id = HOT_OBJECTS + one_hit++;
+    } else {
+      id = std::lower_bound(cdf.begin(), cdf.end(), uniform(rng) * sum) - cdf.begin();
+    }
+    r.key.u64[0] = (id << 32) + id;
+    r.key.u64[1] = id * 0x9E3779B97F4A7C15ULL;
+    r.size       = OBJECT_SIZES[id % std::size(OBJECT_SIZES)];
+    trace.push_back(r);
+  }
+  return trace;
+}
+
+SimResult
+replay(RamCache *cache, StripeSM *stripe, std::vector<Request> const &trace)
+{
+  cache->init(RAM_CACHE_SIZE, stripe);
+
+  size_t   warmup = trace.size() * WARMUP_FRACTION;
+  uint64_t requests = 0, hits = 0, bytes = 0, hit_bytes = 0;
+  for (size_t i = 0; i < trace.size(); i++) {
+    Request           r = trace[i];
+    Ptr<IOBufferData> data;
+    bool              hit = cache->get(&r.key, &data) != 0;
+    if (!hit) {
+      data = new_IOBufferData(iobuffer_size_to_index(r.size, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
+      cache->put(&r.key, data.get(), r.size);
+    }
+    if (i >= warmup) {
+      requests++;
+      bytes += r.size;
+      if (hit) {
+        hits++;
+        hit_bytes += r.size;
+      }
+    }
+  }
+
+  SimResult result;
+  result.hit_ratio      = requests ? static_cast<double>(hits) / requests : 0;
+  result.byte_hit_ratio = bytes ? static_cast<double>(hit_bytes) / bytes : 0;
+  delete cache;
+  return result;
+}
+
+} // namespace
+
+class RamCacheSim : public CacheInit
+{
+public:
+  int
+  cache_init_success_callback(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */) override
+  {
+    const char          *path  = getenv(TRACE_ENV);
+    std::vector<Request> trace = path ? load_trace(path) : synthetic_trace();
+    REQUIRE(!trace.empty());
+
+    CacheKey  key;
+    StripeSM *stripe = theCache->key_to_stripe(&key, "example.com"sv);
+
+    struct Algorithm {
+      const char *name;
+      RamCache *(*create)();
+    } const algorithms[] = {
+      {"LRU",     new_RamCacheLRU   },
+      {"CLFUS",   new_RamCacheCLFUS },
+      {"S3-FIFO", new_RamCacheS3FIFO},
+    };
+
+    int const saved_admission = cache_config_ram_cache_admission;
+    printf("trace %s: %zu requests, RAM cache %" PRId64 " bytes\n", path ? path : SYNTHETIC_TRACE, trace.size(), RAM_CACHE_SIZE);
+    printf("%-8s %-8s %10s %14s\n", "cache", "admit", "hit ratio", "byte hit ratio");
+    for (auto const &algorithm : algorithms) {
+      SimResult result[2];
+      for (int admission = RAM_CACHE_ADMISSION_NONE; admission <= RAM_CACHE_ADMISSION_TINYLFU; admission++) {
+        cache_config_ram_cache_admission = admission;
+        int64_t rejects                  = ts::Metrics::Counter::load(cache_rsb.ram_cache_admission_rejects);
+        result[admission]                = replay(algorithm.create(), stripe, trace);
+        rejects                          = ts::Metrics::Counter::load(cache_rsb.ram_cache_admission_rejects) - rejects;
+        printf("%-8s %-8s %10.4f %14.4f\n", algorithm.name, admission ? "tinylfu" : "none", result[admission].hit_ratio,
+               result[admission].byte_hit_ratio);
+
+        CHECK(result[admission].hit_ratio > 0);
+        CHECK(result[admission].hit_ratio <= 1);
+        if (admission == RAM_CACHE_ADMISSION_NONE) {
+          CHECK(rejects == 0);
+        }
+      }
+      // The synthetic trace is a third one-hit-wonders, which plain LRU lets displace hot objects.
+      if (!path && algorithm.create == new_RamCacheLRU) {
+        CHECK(result[RAM_CACHE_ADMISSION_TINYLFU].hit_ratio > result[RAM_CACHE_ADMISSION_NONE].hit_ratio);
+      }
+    }
+    cache_config_ram_cache_admission = saved_admission;
+
+    test_done();
+    delete this;
+    return EVENT_DONE;
+  }
+};
+
+TEST_CASE("RamCacheSim")
+{
+  init_cache(0);
+
+  RamCacheSim *init = new RamCacheSim;
+
+  this_ethread()->schedule_imm(init);
+  this_thread()->execute();
+}
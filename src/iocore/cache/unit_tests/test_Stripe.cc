@@ -30,6 +30,9 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <iterator>
+#include <limits>
+#include <string>
 
 // Required by main.h
 int  cache_vols           = 1;
@@ -118,11 +121,18 @@ attach_tmpfile_to_stripe(StripeSM &stripe)
 static std::FILE *
 init_stripe_for_writing(StripeSM &stripe, StripeHeaderFooter &header, CacheVol &cache_vol)
 {
-  stripe.cache_vol                             = &cache_vol;
-  cache_rsb.write_bytes                        = ts::Metrics::Counter::createPtr("unit_test.write.bytes");
-  stripe.cache_vol->vol_rsb.write_bytes        = ts::Metrics::Counter::createPtr("unit_test.write.bytes");
-  cache_rsb.gc_frags_evacuated                 = ts::Metrics::Counter::createPtr("unit_test.gc.frags.evacuated");
-  stripe.cache_vol->vol_rsb.gc_frags_evacuated = ts::Metrics::Counter::createPtr("unit_test.gc.frags.evacuated");
+  stripe.cache_vol                              = &cache_vol;
+  cache_rsb.write_bytes                         = ts::Metrics::Counter::createPtr("unit_test.write.bytes");
+  stripe.cache_vol->vol_rsb.write_bytes         = ts::Metrics::Counter::createPtr("unit_test.write.bytes");
+  cache_rsb.gc_frags_evacuated                  = ts::Metrics::Counter::createPtr("unit_test.gc.frags.evacuated");
+  stripe.cache_vol->vol_rsb.gc_frags_evacuated  = ts::Metrics::Counter::createPtr("unit_test.gc.frags.evacuated");
+  cache_rsb.agg_write_in_flight                 = ts::Metrics::Gauge::createPtr("unit_test.agg_write.in_flight");
+  stripe.cache_vol->vol_rsb.agg_write_in_flight = ts::Metrics::Gauge::createPtr("unit_test.agg_write.in_flight");
+  for (int i = 0; i < static_cast<int>(std::size(cache_rsb.agg_write_latency)); i++) {
+    std::string name                               = "unit_test.agg_write.latency." + std::to_string(i);
+    cache_rsb.agg_write_latency[i]                 = ts::Metrics::Counter::createPtr(name);
+    stripe.cache_vol->vol_rsb.agg_write_latency[i] = ts::Metrics::Counter::createPtr(name);
+  }
 
   stripe.sector_size = 256;
 
@@ -397,3 +407,115 @@ TEST_CASE("aggWrite behavior with f.evacuator set")
 
   delete[] source;
 }
+
+// Exposes the aggregation state aggWriteDone works on, so completions can be
+// delivered in a chosen order without going through the AIO threads.
+class InFlightStripe : public StripeSM
+{
+public:
+  using StripeSM::_write_buffer;
+  using StripeSM::flush_aggregate_write_buffer;
+  using StripeSM::StripeSM;
+};
+
+TEST_CASE("Given two aggregation writes are in flight, "
+          "when they complete out of order, "
+          "then the write position should only move over the written prefix.")
+{
+  CacheDisk disk;
+  init_disk(disk);
+  InFlightStripe     stripe{&disk, 10, 0};
+  StripeHeaderFooter header;
+  CacheVol           cache_vol;
+  init_stripe_for_writing(stripe, header, cache_vol);
+  stripe.scan_pos = std::numeric_limits<off_t>::max();
+
+  off_t base = header.write_pos;
+  memset(static_cast<void *>(stripe._write_buffer.emplace(1024)), 'a', 1024);
+  auto &first = stripe._write_buffer.submit(base);
+  memset(static_cast<void *>(stripe._write_buffer.emplace(2048)), 'b', 2048);
+  auto &second        = stripe._write_buffer.submit(base + 1024);
+  header.agg_pos      = base + 3072;
+  header.write_serial = 10;
+
+  SCOPED_MUTEX_LOCK(lock, stripe.mutex, this_ethread());
+
+  SECTION("when the later write completes first")
+  {
+    second.done = second.ok = true;
+    stripe.aggWriteDone(AIO_EVENT_DONE, nullptr);
+    CHECK(base == header.write_pos);
+    CHECK(2 == stripe._write_buffer.get_in_flight().size());
+
+    first.done = first.ok = true;
+    stripe.aggWriteDone(AIO_EVENT_DONE, nullptr);
+    CHECK(base + 3072 == header.write_pos);
+    CHECK(12 == header.write_serial);
+    CHECK(stripe._write_buffer.get_in_flight().empty());
+  }
+
+  SECTION("when the buffer is flushed before either write completes")
+  {
+    REQUIRE(stripe.flush_aggregate_write_buffer(stripe.fd));
+    CHECK(base + 3072 == header.write_pos);
+    CHECK(12 == header.write_serial);
+    CHECK(0 == stripe._write_buffer.get_bytes_in_flight());
+
+    second.done = second.ok = true;
+    stripe.aggWriteDone(AIO_EVENT_DONE, nullptr);
+    first.done = first.ok = true;
+    stripe.aggWriteDone(AIO_EVENT_DONE, nullptr);
+    CHECK(base + 3072 == header.write_pos);
+    CHECK(12 == header.write_serial);
+    CHECK(stripe._write_buffer.get_in_flight().empty());
+  }
+}
+
+// Exposes the aggregation position setter, so the writer can be moved over the
+// stripe without writing anything.
+class ReachStripe : public StripeSM
+{
+public:
+  using StripeSM::_set_agg_pos;
+  using StripeSM::StripeSM;
+};
+
+TEST_CASE("Given a fragment left on disk, "
+          "when the writer moves over the stripe, "
+          "then the write reach should pass the fragment only once the writer gets to it.")
+{
+  CacheDisk disk;
+  init_disk(disk);
+  ReachStripe        stripe{&disk, 10, 0};
+  StripeHeaderFooter header;
+  CacheVol           cache_vol;
+  init_stripe_for_writing(stripe, header, cache_vol);
+  header.agg_pos = stripe.start + 8192;
+
+  SECTION("when the fragment is ahead of the writer")
+  {
+    Dir dir;
+    dir_set_offset(&dir, stripe.offset_to_vol_offset(stripe.start + 16384));
+    int64_t reach = stripe.write_reach_at(&dir);
+
+    stripe._set_agg_pos(stripe.start + 16384);
+    CHECK(stripe.write_reach() <= reach);
+    stripe._set_agg_pos(stripe.start + 16384 + 512);
+    CHECK(stripe.write_reach() > reach);
+  }
+
+  SECTION("when the fragment is behind the writer")
+  {
+    Dir dir;
+    dir_set_offset(&dir, stripe.offset_to_vol_offset(stripe.start + 4096));
+    int64_t reach = stripe.write_reach_at(&dir);
+
+    stripe._set_agg_pos(stripe.skip + stripe.len - 512);
+    CHECK(stripe.write_reach() <= reach);
+    // The wrap skips the rest of the data, which takes the writer to the start.
+    stripe._set_agg_pos(stripe.start);
+    CHECK(stripe.write_reach() <= reach);
+    stripe._set_agg_pos(stripe.start + 4096 + 512);
+    CHECK(stripe.write_reach() > reach);
+  }
+}
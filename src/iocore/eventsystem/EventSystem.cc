@@ -32,9 +32,21 @@
 #include "tscore/Version.h"
 #include "tscore/hugepages.h"
 #include "records/RecCore.h"
+#include "iocore/eventsystem/LoopProfiler.h"
 
 static constexpr ts::ModuleVersion EVENT_SYSTEM_MODULE_INTERNAL_VERSION{EVENT_SYSTEM_MODULE_PUBLIC_VERSION,
                                                                         ts::ModuleVersion::PRIVATE};
+
+namespace
+{
+int
+update_profiler_config(const char * /* name ATS_UNUSED */, RecDataT, RecData data, void *)
+{
+  LoopProfiler::sample_period.store(static_cast<int>(data.rec_int), std::memory_order_relaxed);
+  return 0;
+}
+} // namespace
+
 void
 ink_event_system_init(ts::ModuleVersion v)
 {
@@ -50,6 +62,9 @@ ink_event_system_init(ts::ModuleVersion v)
   extern int loop_time_update_probability;
   RecEstablishStaticConfigInt32(loop_time_update_probability, "proxy.config.exec_thread.loop_time_update_probability");
 
+  LoopProfiler::sample_period = static_cast<int>(RecGetRecordInt("proxy.config.exec_thread.profiler.sample_period").value_or(0));
+  RecRegisterConfigUpdateCb("proxy.config.exec_thread.profiler.sample_period", update_profiler_config, nullptr);
+
   int chunk_sizes[DEFAULT_BUFFER_SIZES] = {0};
   {
     auto chunk_sizes_string{RecGetRecordStringAlloc("proxy.config.allocator.iobuf_chunk_sizes")};
@@ -34,6 +34,8 @@
 
 #include <optional>
 
+#include <sys/mman.h>
+
 // TODO: I think we're overly aggressive here on making MIOBuffer 64-bit
 // but not sure it's worthwhile changing anything to 32-bit honestly.
 
@@ -190,6 +192,43 @@ new_IOBufferData_internal(const char *loc, int64_t size_index, AllocType type)
   return d;
 }
 
+//
+// Registered buffers
+//
+namespace
+{
+char         *registered_region      = nullptr;
+int64_t       registered_region_size = 0;
+int64_t       registered_size_index  = BUFFER_SIZE_NOT_ALLOCATED;
+InkAtomicList registered_free_list;
+} // namespace
+
+void
+init_registered_buffers(int64_t size_index, int64_t count)
+{
+  ink_release_assert(registered_region == nullptr);
+  if (!BUFFER_SIZE_INDEX_IS_FAST_ALLOCATED(size_index) || count <= 0) {
+    return;
+  }
+
+  int64_t size           = index_to_buffer_size(size_index);
+  registered_region_size = size * count;
+  registered_region      = static_cast<char *>(ats_memalign(ats_pagesize(), registered_region_size));
+  // Free buffers hold the link to the next free buffer in their first bytes.
+  ink_atomiclist_init(&registered_free_list, "registered_buffers", 0);
+  for (int64_t i = count - 1; i >= 0; --i) {
+    ink_atomiclist_push(&registered_free_list, registered_region + i * size);
+  }
+  registered_size_index = size_index;
+}
+
+char *
+registered_buffer_region(int64_t *size)
+{
+  *size = registered_region_size;
+  return registered_region;
+}
+
 // IRIX has a compiler bug which prevents this function
 // from being compiled correctly at -O3
 // so it is DUPLICATED in IOBuffer.cc
@@ -204,6 +243,13 @@ IOBufferData::alloc(int64_t size_index, AllocType type)
   _mem_type   = type;
   iobuffer_mem_inc(_location, size_index);
   switch (type) {
+  case REGISTERED:
+    if (size_index == registered_size_index &&
+        (_data = static_cast<char *>(ink_atomiclist_pop(&registered_free_list))) != nullptr) {
+      break;
+    }
+    _mem_type = MEMALIGNED;
+    [[fallthrough]];
   case MEMALIGNED:
     if (BUFFER_SIZE_INDEX_IS_FAST_ALLOCATED(size_index)) {
       _data = static_cast<char *>(ioBufAllocator[size_index].alloc_void());
@@ -230,6 +276,9 @@ IOBufferData::dealloc()
 {
   iobuffer_mem_dec(_location, _size_index);
   switch (_mem_type) {
+  case REGISTERED:
+    ink_atomiclist_push(&registered_free_list, _data);
+    break;
   case MEMALIGNED:
     if (BUFFER_SIZE_INDEX_IS_FAST_ALLOCATED(_size_index)) {
       ioBufAllocator[_size_index].free_void(_data);
@@ -258,6 +307,37 @@ IOBufferData::free()
   THREAD_FREE(this, ioDataAllocator, this_thread());
 }
 
+namespace
+{
+// Address space without access that every file range points into, so the blocks of a range can
+// be sized and consumed like blocks in memory while reading their bytes faults.
+char *
+file_range_region()
+{
+  static char *region = [] {
+    void *p = mmap(nullptr, IOBufferFileRange::MAX_LEN, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    ink_release_assert(p != MAP_FAILED);
+    return static_cast<char *>(p);
+  }();
+  return region;
+}
+} // end anonymous namespace
+
+IOBufferFileRange::IOBufferFileRange(int fd, off_t offset, int64_t len) : _fd(fd), _offset(offset)
+{
+  ink_release_assert(len > 0 && len <= MAX_LEN);
+  _size_index = BUFFER_SIZE_INDEX_FOR_XMALLOC_SIZE(len);
+  _mem_type   = FILE_RANGE;
+  _data       = file_range_region();
+  _location   = RES_PATH("memory/IOBuffer/");
+}
+
+void
+IOBufferFileRange::free()
+{
+  delete this;
+}
+
 //////////////////////////////////////////////////////////////////
 //
 //  class IOBufferBlock --
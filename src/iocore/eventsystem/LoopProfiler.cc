@@ -0,0 +1,114 @@
+/** @file
+
+  Sampling profiler for event loop handlers.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "iocore/eventsystem/LoopProfiler.h"
+#include "tscore/ink_stack_trace.h"
+
+#include <algorithm>
+
+void
+LoopProfiler::record(uintptr_t site, ink_hrtime elapsed)
+{
+  _total.store(_total.load(std::memory_order_relaxed) + elapsed, std::memory_order_relaxed);
+
+  Entry *entry = nullptr;
+  for (size_t i = 0; i < _used; ++i) {
+    if (_table[i].site.load(std::memory_order_relaxed) == site) {
+      entry = &_table[i];
+      break;
+    }
+  }
+
+  uint32_t seq = 0;
+  if (entry == nullptr) {
+    // A new site, take a free entry or the one with the least time.
+    if (_used < TABLE_SIZE) {
+      entry = &_table[_used++];
+    } else {
+      entry = std::min_element(std::begin(_table), std::end(_table), [](Entry const &a, Entry const &b) {
+        return a.total.load(std::memory_order_relaxed) < b.total.load(std::memory_order_relaxed);
+      });
+    }
+    seq = entry->seq.load(std::memory_order_relaxed);
+    entry->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    entry->site.store(site, std::memory_order_relaxed);
+    entry->error.store(entry->total.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    entry->max.store(0, std::memory_order_relaxed);
+  } else {
+    seq = entry->seq.load(std::memory_order_relaxed);
+    entry->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  entry->samples.store(entry->samples.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  entry->total.store(entry->total.load(std::memory_order_relaxed) + elapsed, std::memory_order_relaxed);
+  if (elapsed > entry->max.load(std::memory_order_relaxed)) {
+    entry->max.store(elapsed, std::memory_order_relaxed);
+  }
+  entry->seq.store(seq + 2, std::memory_order_release);
+}
+
+std::vector<LoopProfiler::Site>
+LoopProfiler::snapshot() const
+{
+  std::vector<Site> sites;
+
+  for (auto const &entry : _table) {
+    Site site;
+    for (;;) {
+      uint32_t before = entry.seq.load(std::memory_order_acquire);
+      if (before & 1) {
+        continue; // Being written, which takes a moment.
+      }
+      site.site    = entry.site.load(std::memory_order_relaxed);
+      site.samples = entry.samples.load(std::memory_order_relaxed);
+      site.total   = entry.total.load(std::memory_order_relaxed);
+      site.max     = entry.max.load(std::memory_order_relaxed);
+      site.error   = entry.error.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (entry.seq.load(std::memory_order_relaxed) == before) {
+        break;
+      }
+    }
+    if (site.site != 0) {
+      sites.push_back(site);
+    }
+  }
+  std::sort(sites.begin(), sites.end(), [](Site const &a, Site const &b) { return a.total > b.total; });
+
+  return sites;
+}
+
+void
+LoopProfiler::set_dispatcher(ContinuationHandler handler, Resolver resolver)
+{
+  _dispatch_site     = _decode(handler, nullptr);
+  _dispatch_resolver = resolver;
+}
+
+std::string
+LoopProfiler::describe(uintptr_t site)
+{
+  return ink_stack_trace_symbol(reinterpret_cast<void const *>(site));
+}
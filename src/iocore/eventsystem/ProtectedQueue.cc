@@ -23,10 +23,11 @@
   @section details Details
 
   ProtectedQueue implements a FIFO queue with the following functionality:
-    -# Multiple threads could be simultaneously trying to enqueue and
-      dequeue. Hence the queue needs to be protected with mutex.
-    -# In case the queue is empty, dequeue() sleeps for a specified amount
-      of time, or until a new element is inserted, whichever is earlier.
+    -# Multiple threads could be simultaneously trying to enqueue, only the
+      owning thread dequeues. Both are lock free.
+    -# In case the queue is empty, the owning thread sleeps for a specified
+      amount of time, or until a new element is inserted, whichever is earlier.
+      Only the first insertion to find it asleep wakes it.
 
 */
 
@@ -48,17 +49,14 @@ void
 ProtectedQueue::enqueue(Event *e)
 {
   ink_assert(!e->in_the_prot_queue && !e->in_the_priority_queue);
-  EThread *e_ethread   = e->ethread;
+  EThread *e_ethread   = e->ethread; // @a e may be gone once pushed
   e->in_the_prot_queue = 1;
-  bool was_empty       = (ink_atomiclist_push(&al, e) == nullptr);
+  ink_atomiclist_push(&al, e);
 
-  if (was_empty) {
-    EThread *inserting_thread = this_ethread();
-    // queue e->ethread in the list of threads to be signalled
-    // inserting_thread == 0 means it is not a regular EThread
-    if (inserting_thread != e_ethread) {
-      e_ethread->tail_cb->signalActivity();
-    }
+  // A busy thread finds the event without being told. A sleeping one is woken once, however many
+  // events are queued for it before it runs.
+  if (claim_wakeup()) {
+    e_ethread->tail_cb->signalActivity();
   }
 }
 
@@ -86,14 +84,13 @@ ProtectedQueue::dequeue_external()
 void
 ProtectedQueue::wait(ink_hrtime timeout)
 {
-  /* If there are no external events available, will do a cond_timedwait.
-   *
-   *   - The `EThread::lock` will be released,
-   *   - And then the Event Thread goes to sleep and waits for the wakeup signal of `EThread::might_have_data`,
-   *   - The `EThread::lock` will be locked again when the Event Thread wakes up.
+  /* The lock is only held here. A thread that claimed the wakeup takes it to signal, so it either
+   * finds this thread in the condition wait or, having claimed first, keeps it out of it.
    */
-  if (INK_ATOMICLIST_EMPTY(al) && localQueue.empty()) {
+  ink_mutex_acquire(&lock);
+  if (sleeping.load(std::memory_order_acquire) && localQueue.empty()) {
     timespec ts = ink_hrtime_to_timespec(timeout);
     ink_cond_timedwait(&might_have_data, &lock, &ts);
   }
+  ink_mutex_release(&lock);
 }
@@ -168,7 +168,14 @@ EThread::process_event(Event *e, int calling_code, ink_hrtime event_time)
     // Restore the client IP debugging flags
     set_cont_flags(e->continuation->control_flags);
 
-    e->continuation->handleEvent(calling_code, e);
+    if (profiler && profiler->sample()) {
+      uintptr_t  site  = LoopProfiler::site_of(e->continuation);
+      ink_hrtime start = ink_get_hrtime();
+      e->continuation->handleEvent(calling_code, e);
+      profiler->record(site, ink_get_hrtime() - start);
+    } else {
+      e->continuation->handleEvent(calling_code, e);
+    }
     if (loop_time_update_probability == 100) {
       event_time = ink_get_hrtime();
     } else if (loop_time_update_probability > 0) {
@@ -203,9 +210,16 @@ EThread::process_queue(Que(Event, link) * NegativeQueue, int *ev_count, int *nq_
   // Move events from the external thread safe queues to the local queue.
   EventQueueExternal.dequeue_external();
 
+  // Stealable immediate events are held back to go on the work stealing deque.
+  SLL<Event, Event::Link_link> stealable;
+
   // execute all the available external events that have
   // already been dequeued
   while ((e = EventQueueExternal.dequeue_local())) {
+    if (e->stealable && work_stealing && !e->timeout_at && !e->cancelled) {
+      stealable.push(e);
+      continue;
+    }
     ++(*ev_count);
     if (e->cancelled) {
       free_event(e);
@@ -229,9 +243,147 @@ EThread::process_queue(Que(Event, link) * NegativeQueue, int *ev_count, int *nq_
     }
     ++(*nq_count);
   }
+
+  if (work_stealing) {
+    // Those queued on the inbox go after the local ones, so turn it oldest first to push.
+    SLL<Event, Event::Link_link> inbox;
+    inbox.head = static_cast<Event *>(ink_atomiclist_popall(&work_stealing->inbox));
+    SLL<Event, Event::Link_link> oldest_first;
+    while ((e = inbox.pop())) {
+      oldest_first.push(e);
+    }
+    while ((e = oldest_first.pop())) {
+      stealable.push(e);
+    }
+    // @a stealable is newest first, push in that order so the oldest is popped first.
+    while ((e = stealable.pop())) {
+      e->in_the_prot_queue = 1;
+      if (!work_stealing->deque.push(e)) {
+        // Full, run it now.
+        e->in_the_prot_queue = 0;
+        ++(*ev_count);
+        event_time = process_event(e, e->callback_event, event_time);
+      }
+    }
+    event_time = process_stealable(ev_count, event_time);
+  }
+  return event_time;
+}
+
+EThread::WorkStealing::WorkStealing()
+{
+  Event e;
+  ink_atomiclist_init(&inbox, "WorkStealing.inbox", (char *)&e.link.next - (char *)&e);
+}
+
+void
+EThread::enqueue_stealable(Event *e)
+{
+  ink_assert(!e->in_the_prot_queue && !e->in_the_priority_queue);
+  // A sibling can take @a e, run and free it as soon as it is pushed.
+  e->in_the_prot_queue = 1;
+  ink_atomiclist_push(&work_stealing->inbox, e);
+  if (EventQueueExternal.claim_wakeup()) {
+    tail_cb->signalActivity();
+  }
+}
+
+ink_hrtime
+EThread::process_stealable(int *ev_count, ink_hrtime event_time)
+{
+  auto  &ws    = *work_stealing;
+  size_t depth = ws.deque.size();
+
+  if (depth > ws.depth_max.load(std::memory_order_relaxed)) {
+    ws.depth_max.store(depth, std::memory_order_relaxed);
+  }
+  // There is more than this thread can start on, wake a sibling to take some.
+  if (depth > 1) {
+    auto &group = eventProcessor.thread_group[ws.type];
+    if (group._count > 1) {
+      EThread *t = group._thread[generator.random() % group._count];
+      if (t != this) {
+        t->wake();
+      }
+    }
+  }
+
+  Event *e;
+  while ((e = ws.deque.pop())) {
+    e->in_the_prot_queue = 0;
+    ++(*ev_count);
+    if (e->cancelled) {
+      free_event(e);
+    } else {
+      event_time = process_event(e, e->callback_event, event_time);
+    }
+  }
   return event_time;
 }
 
+int
+EThread::steal_work()
+{
+  auto &ws    = *work_stealing;
+  auto &group = eventProcessor.thread_group[ws.type];
+  int   taken = 0;
+
+  if (group._count < 2) {
+    return 0;
+  }
+  ws.attempts.fetch_add(1, std::memory_order_relaxed);
+
+  // Stolen events are pushed newest first so the oldest is popped first.
+  auto adopt = [&](Event *e) -> void {
+    e->ethread           = this;
+    e->in_the_prot_queue = 1;
+    if (!ws.deque.push(e)) {
+      e->in_the_prot_queue = 0;
+      EventQueueExternal.enqueue_local(e);
+    }
+    ++taken;
+  };
+
+  int start = generator.random() % group._count;
+  for (int i = 0; i < group._count && taken == 0; ++i) {
+    EThread *victim = group._thread[(start + i) % group._count];
+    if (victim == this || victim == nullptr || !victim->work_stealing) {
+      continue;
+    }
+
+    // Take half of what the sibling has on its deque. Steals come oldest first.
+    SLL<Event, Event::Link_link> batch;
+    Event                       *e;
+    size_t                       want = (victim->work_stealing->deque.size() + 1) / 2;
+    for (size_t n = 0; n < want && (e = victim->work_stealing->deque.steal()); ++n) {
+      batch.push(e);
+    }
+    while ((e = batch.pop())) {
+      adopt(e);
+    }
+    if (taken > 0) {
+      break;
+    }
+
+    // Nothing there. A busy sibling cannot get to what was queued for it since it started its
+    // current event, so take all of that. It is newest first, as it is adopted. Idle siblings can
+    // steal from here in turn. A sleeping sibling takes its events itself when woken.
+    if (INK_ATOMICLIST_EMPTY(victim->work_stealing->inbox) || victim->EventQueueExternal.sleeping.load(std::memory_order_relaxed)) {
+      continue;
+    }
+    SLL<Event, Event::Link_link> theirs;
+    theirs.head = static_cast<Event *>(ink_atomiclist_popall(&victim->work_stealing->inbox));
+    while ((e = theirs.pop())) {
+      adopt(e);
+    }
+  }
+
+  if (taken > 0) {
+    ws.stolen.fetch_add(taken, std::memory_order_relaxed);
+  }
+  return taken;
+}
+
 void
 EThread::execute_regular()
 {
@@ -302,6 +454,10 @@ EThread::execute_regular()
 
     next_time             = EventQueue.earliest_timeout();
     ink_hrtime sleep_time = next_time - event_time;
+    // Look for work on the other threads of the group before going idle.
+    if (sleep_time > 0 && work_stealing && steal_work() > 0) {
+      sleep_time = 0;
+    }
     if (sleep_time > 0) {
       if (EventQueueExternal.localQueue.empty()) {
         sleep_time = std::min(sleep_time, HRTIME_MSECONDS(thread_max_heartbeat_mseconds));
@@ -323,7 +479,13 @@ EThread::execute_regular()
     // Relaxed store because this EThread is the only writer and the watchdog only needs a coherent timestamp.
     this->heartbeat_state.last_sleep.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
 
+    // From here on, threads that queue events for this one wake it. It is not woken while busy.
+    if (sleep_time > 0 &&
+        (!EventQueueExternal.prepare_sleep() || (work_stealing && !INK_ATOMICLIST_EMPTY(work_stealing->inbox)))) {
+      sleep_time = 0;
+    }
     tail_cb->waitForActivity(sleep_time);
+    EventQueueExternal.finish_sleep();
 
     // watchdog kick - post-wake
     // Relaxed store/fetch because the monitor thread is the single reader and per-field coherence is sufficient.
@@ -372,16 +534,7 @@ EThread::execute()
 
   switch (tt) {
   case REGULAR: {
-    /* The Event Thread has two status: busy and sleep:
-     *   - Keep `EThread::lock` locked while Event Thread is busy,
-     *   - The `EThread::lock` is released while Event Thread is sleep.
-     * When other threads try to acquire the `EThread::lock` of the target Event Thread:
-     *   - Acquired, indicating that the target Event Thread is sleep,
-     *   - Failed, indicating that the target Event Thread is busy.
-     */
-    ink_mutex_acquire(&EventQueueExternal.lock);
     this->execute_regular();
-    ink_mutex_release(&EventQueueExternal.lock);
     break;
   }
   case DEDICATED: {
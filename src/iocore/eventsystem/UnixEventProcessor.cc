@@ -77,10 +77,14 @@ protected:
   /// Allocate a stack based on NUMA information, if possible.
   void *alloc_numa_stack(EThread *t, size_t stacksize);
 
+  /// The object thread @a t is bound to.
+  hwloc_obj_t obj_for(EThread *t) const;
+
 private:
-  hwloc_obj_type_t obj_type  = HWLOC_OBJ_MACHINE;
-  int              obj_count = 0;
-  char const      *obj_name  = nullptr;
+  hwloc_obj_type_t obj_type   = HWLOC_OBJ_MACHINE;
+  int              obj_count  = 0;
+  char const      *obj_name   = nullptr;
+  int              numa_count = 0; ///< NUMA nodes the threads are spread over, 0 if not in NUMA mode.
 #endif
 };
 
@@ -92,6 +96,12 @@ struct EventStatsBlock {
   static constexpr size_t STAT_COUNT =
     EThread::Metrics::Graph::N_BUCKETS * 2 + EThread::Metrics::Slice::N_STAT_ID * EThread::Metrics::N_TIMESCALES;
   std::array<ts::Metrics::Gauge::AtomicType *, STAT_COUNT> stats;
+
+  // Work stealing, over all groups that allow it.
+  ts::Metrics::Gauge::AtomicType *steal_attempts;
+  ts::Metrics::Gauge::AtomicType *steal_events;
+  ts::Metrics::Gauge::AtomicType *steal_queue_depth;
+  ts::Metrics::Gauge::AtomicType *steal_queue_depth_max;
 } events_rsb;
 
 void
@@ -140,6 +150,27 @@ EventMetricStatSync()
     ts::Metrics::Gauge::store(events_rsb.stats[id], summary._api_timing[idx]);
   }
 
+  uint64_t steal_attempts = 0;
+  uint64_t steal_events   = 0;
+  size_t   depth          = 0;
+  size_t   depth_max      = 0;
+  for (int type = 0; type < eventProcessor.n_thread_groups; ++type) {
+    if (!eventProcessor.thread_group[type]._work_stealing) {
+      continue;
+    }
+    for (EThread *t : eventProcessor.active_group_threads(type)) {
+      auto &ws        = *t->work_stealing;
+      steal_attempts += ws.attempts.load(std::memory_order_relaxed);
+      steal_events   += ws.stolen.load(std::memory_order_relaxed);
+      depth          += ws.deque.size();
+      depth_max       = std::max(depth_max, ws.depth_max.exchange(0, std::memory_order_relaxed));
+    }
+  }
+  ts::Metrics::Gauge::store(events_rsb.steal_attempts, steal_attempts);
+  ts::Metrics::Gauge::store(events_rsb.steal_events, steal_events);
+  ts::Metrics::Gauge::store(events_rsb.steal_queue_depth, depth);
+  ts::Metrics::Gauge::store(events_rsb.steal_queue_depth_max, depth_max);
+
   // Check if it's time to schedule a decay of the histogram data.
   // Done here so that it's (roughly) synchronized across the ET_NET threads.
   // The decay is done in the local threads, this bumps a counter to indicate it should be done.
@@ -259,6 +290,41 @@ ThreadAffinityInitializer::init()
 
   obj_count = hwloc_get_nbobjs_by_type(ink_get_topology(), obj_type);
   Dbg(dbg_ctl_iocore_thread, "Affinity: %d %ss: %d PU: %d", affinity, obj_name, obj_count, ink_number_of_processors());
+
+  if (RecGetRecordInt("proxy.config.exec_thread.numa").value_or(0) == 1) {
+    numa_count = hwloc_get_nbobjs_by_type(ink_get_topology(), HWLOC_OBJ_NODE);
+    if (numa_count <= 0) {
+      Warning("hwloc found no NUMA nodes -- NUMA mode disabled");
+      numa_count = 0;
+    } else if (obj_type != HWLOC_OBJ_CORE && obj_type != HWLOC_OBJ_PU) {
+      // Anything coarser than a core is bound to the whole node.
+      obj_type  = HWLOC_OBJ_NODE;
+      obj_name  = "NUMA Node";
+      obj_count = numa_count;
+    }
+    eventProcessor.numa_nodes = numa_count;
+    Note("NUMA mode: %d nodes, threads bound to a %s", numa_count, obj_name);
+  }
+}
+
+hwloc_obj_t
+ThreadAffinityInitializer::obj_for(EThread *t) const
+{
+  if (numa_count == 0) {
+    return hwloc_get_obj_by_type(ink_get_topology(), obj_type, t->id % obj_count);
+  }
+
+  // Deal the threads out over the nodes, then over the cores or PUs of each node, so every node
+  // gets its share of threads however few there are.
+  hwloc_obj_t node = hwloc_get_obj_by_type(ink_get_topology(), HWLOC_OBJ_NODE, t->id % numa_count);
+  if (obj_type == HWLOC_OBJ_NODE) {
+    return node;
+  }
+  int n = hwloc_get_nbobjs_inside_cpuset_by_type(ink_get_topology(), node->cpuset, obj_type);
+  if (n <= 0) {
+    return node;
+  }
+  return hwloc_get_obj_inside_cpuset_by_type(ink_get_topology(), node->cpuset, obj_type, (t->id / numa_count) % n);
 }
 
 int
@@ -268,7 +334,7 @@ ThreadAffinityInitializer::set_affinity(int, Event *)
 
   if (obj_count > 0) {
     // Get our `obj` instance with index based on the thread number we are on.
-    hwloc_obj_t obj = hwloc_get_obj_by_type(ink_get_topology(), obj_type, t->id % obj_count);
+    hwloc_obj_t obj = obj_for(t);
     t->hwloc_obj    = obj;
 
 #if HWLOC_API_VERSION >= 0x00010100
@@ -280,6 +346,20 @@ ThreadAffinityInitializer::set_affinity(int, Event *)
     Dbg(dbg_ctl_iocore_thread, "EThread: %d %s: %d", _name, obj->logical_index);
 #endif // HWLOC_API_VERSION
     hwloc_set_thread_cpubind(ink_get_topology(), t->tid, obj->cpuset, HWLOC_CPUBIND_STRICT);
+
+    if (numa_count > 0) {
+      // Keep everything the thread allocates from here on - freelist chunks, IOBuffer blocks, RAM
+      // cache copies - on its node. Not strict, so this is a preference the kernel may spill over
+      // from rather than fail the allocation when the node is full.
+      hwloc_obj_t node = hwloc_get_obj_by_type(ink_get_topology(), HWLOC_OBJ_NODE, t->id % numa_count);
+      t->numa_node     = node->logical_index;
+#if HWLOC_API_VERSION >= 0x20000
+      hwloc_set_membind(ink_get_topology(), node->nodeset, HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_THREAD | HWLOC_MEMBIND_BYNODESET);
+#else
+      hwloc_set_membind_nodeset(ink_get_topology(), node->nodeset, HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_THREAD);
+#endif
+      Dbg(dbg_ctl_iocore_thread, "EThread: %p memory bound to NUMA node %d", t, t->numa_node);
+    }
   } else {
     Warning("hwloc returned an unexpected number of objects -- CPU affinity disabled");
   }
@@ -293,7 +373,7 @@ ThreadAffinityInitializer::alloc_numa_stack(EThread *t, size_t stacksize)
   hwloc_nodeset_t        nodeset    = hwloc_bitmap_alloc();
   int                    num_nodes  = 0;
   void                  *stack      = nullptr;
-  hwloc_obj_t            obj        = hwloc_get_obj_by_type(ink_get_topology(), obj_type, t->id % obj_count);
+  hwloc_obj_t            obj        = obj_for(t);
 
   // Find the NUMA node set that correlates to our next thread CPU set
   hwloc_cpuset_to_nodeset(ink_get_topology(), obj->cpuset, nodeset);
@@ -456,6 +536,11 @@ EventProcessor::spawn_event_threads(EventType ev_type, int n_threads, size_t sta
     tg->_thread[i]               = t;
     t->id                        = i; // unfortunately needed to support affinity and NUMA logic.
     t->set_event_type(ev_type);
+    if (tg->_work_stealing) {
+      t->work_stealing       = std::make_unique<EThread::WorkStealing>();
+      t->work_stealing->type = ev_type;
+    }
+    t->profiler = std::make_unique<LoopProfiler>();
     t->schedule_spawn(&thread_initializer);
   }
   tg->_count  = n_threads;
@@ -548,6 +633,11 @@ EventProcessor::start(int n_event_threads, size_t stacksize)
 
   debug_assert_message(stat_idx == events_rsb.stats.size(), "events_rsp stats overrun!");
 
+  events_rsb.steal_attempts        = ts::Metrics::Gauge::createPtr("proxy.process.eventloop.steal.attempts");
+  events_rsb.steal_events          = ts::Metrics::Gauge::createPtr("proxy.process.eventloop.steal.events");
+  events_rsb.steal_queue_depth     = ts::Metrics::Gauge::createPtr("proxy.process.eventloop.steal.queue.depth");
+  events_rsb.steal_queue_depth_max = ts::Metrics::Gauge::createPtr("proxy.process.eventloop.steal.queue.depth.max");
+
   RecRegNewSyncStatSync(EventMetricStatSync);
 
   this->spawn_event_threads(ET_CALL, n_event_threads, stacksize);
@@ -687,7 +777,15 @@ EventProcessor::schedule(Event *e, EventType etype)
 
   EThread *affinity_thread = e->continuation->getThreadAffinity();
   EThread *curr_thread     = this_ethread();
-  if (affinity_thread != nullptr && affinity_thread->is_event_type(etype)) {
+  if (thread_group[etype]._work_stealing) {
+    // Whichever thread is free runs it, so thread affinity means nothing here.
+    e->stealable = true;
+    if (curr_thread != nullptr && curr_thread->is_event_type(etype)) {
+      e->ethread = curr_thread;
+    } else {
+      e->ethread = assign_thread(etype);
+    }
+  } else if (affinity_thread != nullptr && affinity_thread->is_event_type(etype)) {
     e->ethread = affinity_thread;
   } else {
     // Is the current thread eligible?
@@ -707,6 +805,8 @@ EventProcessor::schedule(Event *e, EventType etype)
 
   if (curr_thread != nullptr && e->ethread == curr_thread) {
     e->ethread->EventQueueExternal.enqueue_local(e);
+  } else if (e->stealable && !e->timeout_at) {
+    e->ethread->enqueue_stealable(e);
   } else {
     e->ethread->EventQueueExternal.enqueue(e);
   }
@@ -26,6 +26,7 @@
 #include "iocore/eventsystem/EThread.h"
 #include "tscore/Diags.h"
 #include "tscore/ink_assert.h"
+#include "tscore/ink_stack_trace.h"
 #include "tscore/ink_thread.h"
 #include "tsutil/DbgCtl.h"
 
@@ -33,12 +34,82 @@
 #include <chrono>
 #include <thread>
 #include <functional>
+#include <string>
 
 namespace Watchdog
 {
 
 DbgCtl dbg_ctl_watchdog("watchdog");
 
+namespace
+{
+  /// Most stack samples taken of one stall, each after it has lasted twice as long as the last.
+  constexpr int MAX_SAMPLES_PER_STALL = 8;
+  /// How long to wait for a stalled thread to take the sampling signal.
+  constexpr int CAPTURE_TIMEOUT_MS = 50;
+  /// Frames of a sample to put in the log.
+  constexpr int LOGGED_FRAMES = 4;
+} // namespace
+
+void
+StallLog::set_capacity(size_t n)
+{
+  std::lock_guard lock(_mutex);
+  _capacity = n;
+  _ring.clear();
+  _ring.reserve(n);
+  _next = 0;
+}
+
+size_t
+StallLog::capacity() const
+{
+  std::lock_guard lock(_mutex);
+  return _capacity;
+}
+
+void
+StallLog::add(Stall &&stall)
+{
+  std::lock_guard lock(_mutex);
+  if (_capacity == 0) {
+    return;
+  }
+  if (_ring.size() < _capacity) {
+    _ring.push_back(std::move(stall));
+  } else {
+    _ring[_next] = std::move(stall);
+    _next        = (_next + 1) % _capacity;
+  }
+  ++_total;
+}
+
+std::vector<Stall>
+StallLog::stalls() const
+{
+  std::lock_guard    lock(_mutex);
+  std::vector<Stall> stalls;
+  stalls.reserve(_ring.size());
+  for (size_t i = 0; i < _ring.size(); ++i) {
+    stalls.push_back(_ring[(_next + i) % _ring.size()]);
+  }
+  return stalls;
+}
+
+uint64_t
+StallLog::total() const
+{
+  std::lock_guard lock(_mutex);
+  return _total;
+}
+
+StallLog &
+stall_log()
+{
+  static StallLog log;
+  return log;
+}
+
 Monitor::Monitor(EThread *threads[], size_t n_threads, std::chrono::milliseconds timeout_ms)
   : _threads(threads, threads + n_threads), _timeout{timeout_ms}
 {
@@ -70,6 +141,10 @@ Monitor::monitor_loop() const
 
   ink_set_thread_name("[WATCHDOG]");
 
+  // The loop iteration each thread was last sampled in, and how many samples were taken of it.
+  std::vector<uint64_t> sampled_seq(_threads.size(), 0);
+  std::vector<int>      samples(_threads.size(), 0);
+
   while (!_shutdown.load(std::memory_order_acquire)) {
     std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
     for (size_t i = 0; i < _threads.size(); ++i) {
@@ -99,6 +174,15 @@ Monitor::monitor_loop() const
                   std::chrono::duration_cast<printable_milli>(awake_duration).count());
           t->heartbeat_state.warned_seq.store(seq, std::memory_order_relaxed);
         }
+        if (sampled_seq[i] != seq) {
+          sampled_seq[i] = seq;
+          samples[i]     = 0;
+        }
+        if (samples[i] < MAX_SAMPLES_PER_STALL && awake_duration > _timeout * (1 << samples[i]) &&
+            stall_log().capacity() > 0) {
+          sample_stall(t, i, seq, std::chrono::duration_cast<std::chrono::milliseconds>(awake_duration), samples[i] == 0);
+          ++samples[i];
+        }
       }
     }
 
@@ -106,4 +190,33 @@ Monitor::monitor_loop() const
   }
   Dbg(dbg_ctl_watchdog, "Stopping watchdog");
 }
+
+void
+Monitor::sample_stall(EThread *t, size_t idx, uint64_t seq, std::chrono::milliseconds awake, bool first) const
+{
+  void const *frames[INK_STACK_TRACE_MAX_LEVELS];
+  int         n = ink_stack_trace_thread(t->tid, frames, INK_STACK_TRACE_MAX_LEVELS, CAPTURE_TIMEOUT_MS);
+  if (n == 0) {
+    Dbg(dbg_ctl_watchdog, "Unable to take a stack sample of [ET_NET %zu]", idx);
+    return;
+  }
+
+  Stall stall;
+  stall.when   = std::chrono::system_clock::now();
+  stall.thread = "[ET_NET " + std::to_string(idx) + "]";
+  stall.awake  = awake;
+  stall.seq    = seq;
+  stall.frames.assign(frames, frames + n);
+
+  if (first) {
+    std::string where;
+    for (int i = 0; i < std::min(n, LOGGED_FRAMES); ++i) {
+      where += i ? " < " : "";
+      where += ink_stack_trace_symbol(frames[i]);
+    }
+    Warning("Watchdog: %s is in %s", stall.thread.c_str(), where.c_str());
+  }
+
+  stall_log().add(std::move(stall));
+}
 } // namespace Watchdog
@@ -377,6 +377,76 @@ TEST_CASE("block size parser", "[iocore]")
   REQUIRE(parse_buffer_chunk_sizes("bob:1 2 3", chunk_sizes) == false);
 }
 
+TEST_CASE("registered buffers", "[iocore]")
+{
+  int64_t size   = 0;
+  char   *region = registered_buffer_region(&size);
+  REQUIRE(region == nullptr);
+
+  init_registered_buffers(BUFFER_SIZE_INDEX_32K, 2);
+  region = registered_buffer_region(&size);
+  REQUIRE(region != nullptr);
+  REQUIRE(size == 2 * index_to_buffer_size(BUFFER_SIZE_INDEX_32K));
+
+  auto in_region = [&](IOBufferData *d) { return d->data() >= region && d->data() < region + size; };
+
+  Ptr<IOBufferData> a{new_IOBufferData(BUFFER_SIZE_INDEX_32K, REGISTERED)};
+  Ptr<IOBufferData> b{new_IOBufferData(BUFFER_SIZE_INDEX_32K, REGISTERED)};
+  CHECK(a->_mem_type == REGISTERED);
+  CHECK(in_region(a.get()));
+  CHECK(in_region(b.get()));
+  CHECK(a->data() != b->data());
+
+  // The region is used up.
+  Ptr<IOBufferData> c{new_IOBufferData(BUFFER_SIZE_INDEX_32K, REGISTERED)};
+  CHECK(c->_mem_type == MEMALIGNED);
+  CHECK_FALSE(in_region(c.get()));
+
+  // Other size classes never come from the region.
+  Ptr<IOBufferData> d{new_IOBufferData(BUFFER_SIZE_INDEX_8K, REGISTERED)};
+  CHECK(d->_mem_type == MEMALIGNED);
+
+  char *freed = a->data();
+  a           = nullptr;
+  Ptr<IOBufferData> e{new_IOBufferData(BUFFER_SIZE_INDEX_32K, REGISTERED)};
+  CHECK(e->data() == freed);
+}
+
+TEST_CASE("file ranges", "[iocore]")
+{
+  MIOBuffer      *miob   = new_empty_MIOBuffer(BUFFER_SIZE_INDEX_4K);
+  IOBufferReader *reader = miob->alloc_reader();
+
+  miob->write("head", 4);
+  Ptr<IOBufferData> range = make_ptr<IOBufferData>(new IOBufferFileRange(7, 1 << 20, 100000));
+  miob->append_block(new_IOBufferBlock(range, 100000, 0));
+  miob->write("tail", 4);
+
+  CHECK(reader->read_avail() == 100008);
+  CHECK(reader->get_current_block()->file_range() == nullptr);
+  reader->consume(4);
+
+  // The range is sized and consumed like memory, its bytes stay in the file.
+  IOBufferFileRange *r = reader->get_current_block()->file_range();
+  REQUIRE(r != nullptr);
+  CHECK(r->fd() == 7);
+  CHECK(reader->block_read_avail() == 100000);
+  CHECK(reader->get_current_block()->write_avail() == 0);
+  reader->consume(1000);
+  CHECK(r->file_offset(reader->start()) == (1 << 20) + 1000);
+
+  IOBufferBlock *c = reader->get_current_block()->clone();
+  CHECK(c->file_range() == r);
+  c->free();
+
+  reader->consume(99000);
+  CHECK(reader->block_read_avail() == 4);
+  CHECK(reader->get_current_block()->file_range() == nullptr);
+
+  range = nullptr;
+  free_MIOBuffer(miob);
+}
+
 struct EventProcessorListener : Catch::EventListenerBase {
   using EventListenerBase::EventListenerBase;
 
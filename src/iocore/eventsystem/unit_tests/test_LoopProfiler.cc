@@ -0,0 +1,184 @@
+/** @file
+
+    Catch-based unit tests for LoopProfiler.
+
+    @section license License
+
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "iocore/eventsystem/LoopProfiler.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace
+{
+struct Plain : public Continuation {
+  Plain() { SET_HANDLER(&Plain::run); }
+
+  int
+  run(int, void *)
+  {
+    return 0;
+  }
+};
+
+struct Base : public Continuation {
+  Base() { SET_HANDLER(&Base::run); }
+
+  virtual int
+  run(int, void *)
+  {
+    return 0;
+  }
+};
+
+struct Derived : public Base {
+  int
+  run(int, void *) override
+  {
+    return 1;
+  }
+};
+
+struct Dispatcher : public Continuation {
+  Dispatcher(uintptr_t t) : target(t) { SET_HANDLER(&Dispatcher::dispatch); }
+
+  int
+  dispatch(int, void *)
+  {
+    return 0;
+  }
+
+  uintptr_t target;
+};
+} // namespace
+
+TEST_CASE("LoopProfiler sampling", "[iocore][profiler]")
+{
+  LoopProfiler profiler;
+
+  LoopProfiler::sample_period = 0;
+  for (int i = 0; i < 4 * LoopProfiler::IDLE_CHECK; ++i) {
+    REQUIRE_FALSE(profiler.sample());
+  }
+
+  // Turning it on is seen within an idle check.
+  LoopProfiler::sample_period = 4;
+  int n                       = 0;
+  for (int i = 0; i < LoopProfiler::IDLE_CHECK + 400; ++i) {
+    n += profiler.sample();
+  }
+  CHECK(n >= 100);
+  CHECK(n <= 101 + LoopProfiler::IDLE_CHECK / 4);
+  LoopProfiler::sample_period = 0;
+}
+
+TEST_CASE("LoopProfiler sites", "[iocore][profiler]")
+{
+  Plain   p1, p2;
+  Base    b;
+  Derived d1, d2;
+
+  CHECK(LoopProfiler::site_of(&p1) != 0);
+  CHECK(LoopProfiler::site_of(&p1) == LoopProfiler::site_of(&p2));
+  CHECK(LoopProfiler::site_of(&p1) != LoopProfiler::site_of(&b));
+
+  // A virtual handler is charged to the override that runs.
+  CHECK(LoopProfiler::site_of(&b) != 0);
+  CHECK(LoopProfiler::site_of(&d1) != 0);
+  CHECK(LoopProfiler::site_of(&b) != LoopProfiler::site_of(&d1));
+  CHECK(LoopProfiler::site_of(&d1) == LoopProfiler::site_of(&d2));
+
+  // A dispatcher is seen through.
+  Dispatcher x{0x1234};
+  Dispatcher y{0x5678};
+  uintptr_t  dispatcher = LoopProfiler::site_of(&x);
+  LoopProfiler::set_dispatcher(continuation_handler_void_ptr(&Dispatcher::dispatch),
+                               [](Continuation *c) -> uintptr_t { return static_cast<Dispatcher *>(c)->target; });
+  CHECK(LoopProfiler::site_of(&x) == 0x1234);
+  CHECK(LoopProfiler::site_of(&y) == 0x5678);
+  CHECK(LoopProfiler::site_of(&p1) != 0x1234);
+  LoopProfiler::set_dispatcher(continuation_handler_void_ptr(&Dispatcher::dispatch), nullptr);
+  CHECK(LoopProfiler::site_of(&x) == dispatcher);
+}
+
+TEST_CASE("LoopProfiler table", "[iocore][profiler]")
+{
+  auto profiler = std::make_unique<LoopProfiler>();
+
+  profiler->record(1, 10);
+  profiler->record(2, 5);
+  profiler->record(1, 30);
+  auto sites = profiler->snapshot();
+  REQUIRE(sites.size() == 2);
+  CHECK(sites[0].site == 1);
+  CHECK(sites[0].samples == 2);
+  CHECK(sites[0].total == 40);
+  CHECK(sites[0].max == 30);
+  CHECK(sites[0].error == 0);
+  CHECK(sites[1].site == 2);
+  CHECK(profiler->total() == 45);
+
+  // One heavy site among many more light ones than fit stays at the top, with its time counted.
+  profiler = std::make_unique<LoopProfiler>();
+  for (int round = 0; round < 100; ++round) {
+    profiler->record(1000, 50);
+    for (uintptr_t site = 1; site <= 4 * LoopProfiler::TABLE_SIZE; ++site) {
+      profiler->record(site, 1);
+    }
+  }
+  sites = profiler->snapshot();
+  REQUIRE(sites.size() == LoopProfiler::TABLE_SIZE);
+  CHECK(sites[0].site == 1000);
+  CHECK(sites[0].total - sites[0].error <= 100 * 50);
+  CHECK(sites[0].total >= 100 * 50);
+  CHECK(profiler->total() == 100 * (50 + 4 * LoopProfiler::TABLE_SIZE));
+  for (auto const &site : sites) {
+    CHECK(site.total >= site.error);
+  }
+}
+
+TEST_CASE("LoopProfiler concurrent reads", "[iocore][profiler]")
+{
+  auto              profiler = std::make_unique<LoopProfiler>();
+  std::atomic<bool> done{false};
+
+  // Each sample takes one unit, so a consistent read has as much time as samples.
+  std::thread writer([&]() -> void {
+    for (int i = 0; i < 2000000; ++i) {
+      profiler->record(1 + i % LoopProfiler::TABLE_SIZE, 1);
+    }
+    done = true;
+  });
+
+  int reads = 0;
+  while (!done) {
+    for (auto const &site : profiler->snapshot()) {
+      REQUIRE(site.total == static_cast<ink_hrtime>(site.samples));
+      REQUIRE(site.max == 1);
+    }
+    ++reads;
+  }
+  writer.join();
+  CHECK(profiler->total() == 2000000);
+  INFO("reads " << reads);
+}
@@ -0,0 +1,173 @@
+/** @file
+
+    Catch-based unit tests for TimingWheel.
+
+    @section license License
+
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "iocore/eventsystem/TimingWheel.h"
+#include "tscore/List.h"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+struct Item {
+  TimingWheelEntry entry;
+  ink_hrtime       when    = 0;
+  bool             expired = false;
+  bool             dead    = false;
+  LINK(Item, link);
+};
+
+using Wheel = TimingWheel<Item, &Item::entry>;
+
+// Pop what expired in advancing from @a since to @a now, checking none of it is early or late.
+int
+drain(Wheel &wheel, ink_hrtime since, ink_hrtime now)
+{
+  int n = 0;
+  while (Item *item = wheel.pop_expired()) {
+    CHECK(item->when > since);
+    CHECK(item->when <= now);
+    CHECK_FALSE(item->expired);
+    item->expired = true;
+    ++n;
+  }
+  return n;
+}
+} // namespace
+
+TEST_CASE("TimingWheel expiry", "[iocore][wheel]")
+{
+  // One tick per time unit, so every level and the overflow list are reached quickly.
+  Wheel             wheel(1, 0);
+  std::vector<Item> items(20000);
+  std::mt19937_64   rng(13);
+
+  for (auto &item : items) {
+    // Mostly near, some far enough to need every level and the overflow list.
+    int bits  = std::uniform_int_distribution<int>(1, 36)(rng);
+    item.when = std::uniform_int_distribution<ink_hrtime>(0, (ink_hrtime(1) << bits) - 1)(rng);
+    wheel.schedule(&item, item.when);
+  }
+  REQUIRE(wheel.size() == items.size());
+
+  ink_hrtime now = 0;
+  drain(wheel, -1, now);
+  while (wheel.size() > 0) {
+    ink_hrtime next = wheel.next_expiry();
+    REQUIRE(next != Wheel::NEVER);
+    REQUIRE(next > now);
+    // Nothing expires before the wheel says it might.
+    wheel.advance(next - 1);
+    REQUIRE(drain(wheel, now, next - 1) == 0);
+    now = next - 1;
+    // Step to it, or well past it.
+    ink_hrtime step = std::uniform_int_distribution<ink_hrtime>(0, next)(rng);
+    if (rng() % 2) {
+      step = 0;
+    }
+    wheel.advance(next + step);
+    drain(wheel, now, next + step);
+    now = next + step;
+  }
+
+  // Everything expired.
+  for (auto &item : items) {
+    CHECK(item.expired);
+  }
+  CHECK(wheel.next_expiry() == Wheel::NEVER);
+}
+
+TEST_CASE("TimingWheel expires on time", "[iocore][wheel]")
+{
+  Wheel wheel(HRTIME_MSECOND, HRTIME_SECONDS(100));
+  Item  a;
+  Item  b;
+
+  a.when = HRTIME_SECONDS(100) + HRTIME_MSECONDS(300) + 1;
+  b.when = HRTIME_SECONDS(100) + HRTIME_SECONDS(70);
+  wheel.schedule(&a, a.when);
+  wheel.schedule(&b, b.when);
+  REQUIRE(wheel.expires_at(&a) == HRTIME_SECONDS(100) + HRTIME_MSECONDS(301));
+
+  // A tick late at most, never early.
+  wheel.advance(HRTIME_SECONDS(100) + HRTIME_MSECONDS(300));
+  REQUIRE(wheel.pop_expired() == nullptr);
+  wheel.advance(HRTIME_SECONDS(100) + HRTIME_MSECONDS(301));
+  REQUIRE(wheel.pop_expired() == &a);
+  REQUIRE(wheel.pop_expired() == nullptr);
+
+  wheel.advance(b.when - 1);
+  REQUIRE(wheel.pop_expired() == nullptr);
+  wheel.advance(b.when);
+  REQUIRE(wheel.pop_expired() == &b);
+
+  // Already due when scheduled, so due at once.
+  wheel.schedule(&a, HRTIME_SECONDS(1));
+  REQUIRE(wheel.next_expiry() == b.when);
+  REQUIRE(wheel.pop_expired() == &a);
+  REQUIRE(wheel.size() == 0);
+}
+
+TEST_CASE("TimingWheel cancel and reap", "[iocore][wheel]")
+{
+  Wheel             wheel(1, 0);
+  std::vector<Item> items(4096);
+
+  for (size_t i = 0; i < items.size(); ++i) {
+    items[i].when = 1 + i * 997;
+    wheel.schedule(&items[i], items[i].when);
+  }
+
+  // Cancel every third, mark every fifth of the rest dead.
+  size_t live = 0;
+  for (size_t i = 0; i < items.size(); ++i) {
+    if (i % 3 == 0) {
+      wheel.cancel(&items[i]);
+      REQUIRE_FALSE(wheel.scheduled(&items[i]));
+    } else if (i % 5 == 0) {
+      items[i].dead = true;
+    } else {
+      ++live;
+    }
+  }
+  // Cancelling twice is harmless.
+  wheel.cancel(&items[0]);
+
+  int reaped = 0;
+  wheel.reap(
+    Wheel::N_LISTS, [](Item *item) -> bool { return item->dead; },
+    [&reaped](Item *item) -> void {
+      CHECK(item->dead);
+      ++reaped;
+    });
+  REQUIRE(wheel.size() == live);
+
+  wheel.advance(items.back().when);
+  REQUIRE(drain(wheel, 0, items.back().when) == static_cast<int>(live));
+  for (size_t i = 0; i < items.size(); ++i) {
+    CHECK(items[i].expired == (i % 3 != 0 && i % 5 != 0));
+  }
+  CHECK(reaped > 0);
+}
@@ -0,0 +1,115 @@
+/** @file
+
+  Catch2 unit tests for work stealing between the threads of a group.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <atomic>
+
+#include "inkevent_test_fixtures.h"
+
+using inkevent_test::AtomicFlag;
+using inkevent_test::DEFAULT_TEST_STACKSIZE;
+using inkevent_test::EventProcessorListener;
+
+CATCH_REGISTER_LISTENER(EventProcessorListener)
+
+namespace
+{
+constexpr int STEAL_TEST_THREADS = 2;
+constexpr int STEAL_TEST_EVENTS  = 8;
+
+/// Holds the thread it runs on until released.
+class BlockingContinuation : public Continuation
+{
+public:
+  explicit BlockingContinuation(ProxyMutex *m) : Continuation(m) { SET_HANDLER(&BlockingContinuation::on_event); }
+
+  std::atomic<EThread *> thread{nullptr};
+  AtomicFlag             blocking;
+  AtomicFlag             release;
+  AtomicFlag             done;
+
+private:
+  int
+  on_event(int /* event */, void * /* data */)
+  {
+    thread.store(this_ethread(), std::memory_order_release);
+    blocking.set();
+    release.wait_until_set(std::chrono::seconds{30});
+    done.set();
+    return 0;
+  }
+};
+
+/// Notes the thread it ran on.
+class RecordingContinuation : public Continuation
+{
+public:
+  explicit RecordingContinuation(ProxyMutex *m) : Continuation(m) { SET_HANDLER(&RecordingContinuation::on_event); }
+
+  std::atomic<EThread *> thread{nullptr};
+  AtomicFlag             ran;
+
+private:
+  int
+  on_event(int /* event */, void * /* data */)
+  {
+    thread.store(this_ethread(), std::memory_order_release);
+    ran.set();
+    return 0;
+  }
+};
+
+} // namespace
+
+TEST_CASE("Events queued for a blocked thread run on its siblings", "[iocore][steal]")
+{
+  EventType type                                   = eventProcessor.register_event_type("WS_TEST");
+  eventProcessor.thread_group[type]._work_stealing = true;
+  eventProcessor.spawn_event_threads(type, STEAL_TEST_THREADS, DEFAULT_TEST_STACKSIZE);
+  while (eventProcessor.thread_group[type]._started < STEAL_TEST_THREADS) {
+    std::this_thread::yield();
+  }
+
+  BlockingContinuation blocker{new_ProxyMutex()};
+  eventProcessor.schedule_imm(&blocker, type);
+  REQUIRE(blocker.blocking.wait_until_set());
+  EThread *blocked = blocker.thread.load(std::memory_order_acquire);
+
+  // Scheduled from outside the group, so they are spread over its threads round robin and half of
+  // them are queued for the blocked one. They can only run if a sibling takes them.
+  RecordingContinuation *events[STEAL_TEST_EVENTS];
+  for (auto &cont : events) {
+    cont = new RecordingContinuation(new_ProxyMutex());
+    eventProcessor.schedule_imm(cont, type);
+  }
+  for (auto *cont : events) {
+    REQUIRE(cont->ran.wait_until_set());
+    CHECK(cont->thread.load(std::memory_order_acquire) != blocked);
+  }
+  CHECK_FALSE(blocker.done.is_set());
+
+  blocker.release.set();
+  REQUIRE(blocker.done.wait_until_set());
+  for (auto *cont : events) {
+    delete cont;
+  }
+}
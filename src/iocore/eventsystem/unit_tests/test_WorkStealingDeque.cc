@@ -0,0 +1,124 @@
+/** @file
+
+    Catch-based unit tests for WorkStealingDeque.
+
+    @section license License
+
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "iocore/eventsystem/WorkStealingDeque.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_CASE("WorkStealingDeque ends", "[iocore][steal]")
+{
+  WorkStealingDeque<int, 4> dq;
+  int                       items[5] = {0, 1, 2, 3, 4};
+
+  REQUIRE(dq.empty());
+  REQUIRE(dq.pop() == nullptr);
+  REQUIRE(dq.steal() == nullptr);
+
+  for (int i = 0; i < 4; ++i) {
+    REQUIRE(dq.push(&items[i]));
+  }
+  REQUIRE(dq.size() == 4);
+  REQUIRE_FALSE(dq.push(&items[4]));
+
+  // The owner takes the newest, thieves the oldest.
+  REQUIRE(dq.pop() == &items[3]);
+  REQUIRE(dq.steal() == &items[0]);
+  REQUIRE(dq.size() == 2);
+
+  // Space freed at either end can be reused.
+  REQUIRE(dq.push(&items[4]));
+  REQUIRE(dq.push(&items[0]));
+  REQUIRE_FALSE(dq.push(&items[3]));
+  REQUIRE(dq.steal() == &items[1]);
+  REQUIRE(dq.steal() == &items[2]);
+  REQUIRE(dq.pop() == &items[0]);
+  REQUIRE(dq.pop() == &items[4]);
+  REQUIRE(dq.pop() == nullptr);
+  REQUIRE(dq.empty());
+}
+
+TEST_CASE("WorkStealingDeque concurrent steals", "[iocore][steal]")
+{
+  constexpr int N_ITEMS   = 200000;
+  constexpr int N_THIEVES = 3;
+
+  WorkStealingDeque<int, 256>   dq;
+  std::vector<int>              items(N_ITEMS);
+  std::vector<std::atomic<int>> seen(N_ITEMS);
+  std::atomic<bool>             done{false};
+  std::atomic<int>              stolen{0};
+
+  for (int i = 0; i < N_ITEMS; ++i) {
+    items[i] = i;
+  }
+
+  auto take = [&](int *item) -> void { seen[*item].fetch_add(1, std::memory_order_relaxed); };
+
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < N_THIEVES; ++t) {
+    thieves.emplace_back([&]() -> void {
+      while (!done.load(std::memory_order_acquire) || !dq.empty()) {
+        if (int *item = dq.steal(); item) {
+          take(item);
+          stolen.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+
+  // The owner keeps pushing, popping every other time and whenever the deque is full.
+  for (int i = 0; i < N_ITEMS; ++i) {
+    while (!dq.push(&items[i])) {
+      if (int *item = dq.pop(); item) {
+        take(item);
+      }
+    }
+    if (i % 2) {
+      if (int *item = dq.pop(); item) {
+        take(item);
+      }
+    }
+  }
+  while (int *item = dq.pop()) {
+    take(item);
+  }
+  done.store(true, std::memory_order_release);
+  for (auto &t : thieves) {
+    t.join();
+  }
+
+  // Every item was taken exactly once.
+  int missing = 0;
+  int doubled = 0;
+  for (auto &n : seen) {
+    missing += n.load() == 0;
+    doubled += n.load() > 1;
+  }
+  CHECK(missing == 0);
+  CHECK(doubled == 0);
+  INFO("stolen " << stolen.load());
+}
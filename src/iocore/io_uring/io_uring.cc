@@ -22,9 +22,11 @@ Linux io_uring helper library
  */
 
 #include <sys/eventfd.h>
+#include <algorithm>
 #include <atomic>
 #include <cstring>
 #include <stdexcept>
+#include <vector>
 
 #include <unistd.h>
 
@@ -209,6 +211,41 @@ IOUringContext::register_eventfd()
   return evfd;
 }
 
+int
+IOUringContext::register_buffers(char *region, size_t size)
+{
+  std::vector<iovec> iovs;
+  for (size_t offset = 0; offset < size; offset += MAX_FIXED_BUFFER_SIZE) {
+    iovs.push_back(iovec{region + offset, std::min(size - offset, MAX_FIXED_BUFFER_SIZE)});
+  }
+
+  int ret = io_uring_register_buffers(&ring, iovs.data(), iovs.size());
+  if (ret < 0) {
+    Dbg(dbg_ctl_io_uring, "io_uring_register_buffers failed: (%d) %s", -ret, strerror(-ret));
+    return ret;
+  }
+  fixed_region = region;
+  fixed_size   = size;
+  return 0;
+}
+
+io_uring_buf_ring *
+IOUringContext::setup_buf_ring(unsigned entries, int bgid)
+{
+  int                ret = 0;
+  io_uring_buf_ring *br  = io_uring_setup_buf_ring(&ring, entries, bgid, 0, &ret);
+  if (br == nullptr) {
+    Dbg(dbg_ctl_io_uring, "io_uring_setup_buf_ring failed: (%d) %s", -ret, strerror(-ret));
+  }
+  return br;
+}
+
+void
+IOUringContext::free_buf_ring(io_uring_buf_ring *br, unsigned entries, int bgid)
+{
+  io_uring_free_buf_ring(&ring, br, entries, bgid);
+}
+
 IOUringContext *
 IOUringContext::local_context()
 {
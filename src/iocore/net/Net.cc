@@ -30,6 +30,13 @@
 
 #include "P_Net.h"
 #include "P_UnixNet.h"
+#include "records/RecProcess.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 
 NetStatsBlock net_rsb;
 
@@ -65,6 +72,47 @@ configure_net()
   }
 }
 
+// Work out the accept rate of each ET_NET thread since the last sync, and how uneven they are.
+static void
+NetAcceptRateSync()
+{
+  static ink_hrtime last = 0;
+
+  ink_hrtime now      = ink_get_hrtime();
+  ink_hrtime elapsed  = now - last;
+  uint64_t   rate_max = 0;
+  uint64_t   rate_min = UINT64_MAX;
+  uint64_t   total    = 0;
+  int        nthreads = 0;
+
+  for (EThread *t : eventProcessor.active_group_threads(ET_NET)) {
+    NetHandler *nh = get_NetHandler(t);
+    if (nh->accept_rate == nullptr) {
+      continue;
+    }
+    uint64_t count          = nh->accept_count.load(std::memory_order_relaxed);
+    uint64_t delta          = count - nh->accept_count_synced;
+    nh->accept_count_synced = count;
+    if (last == 0 || elapsed <= 0) {
+      continue;
+    }
+    uint64_t rate = delta * HRTIME_SECOND / elapsed;
+    Metrics::Gauge::store(nh->accept_rate, rate);
+    rate_max  = std::max(rate_max, rate);
+    rate_min  = std::min(rate_min, rate);
+    total    += rate;
+    ++nthreads;
+  }
+  last = now;
+
+  if (nthreads > 0) {
+    Metrics::Gauge::store(net_rsb.accept_rate_max, rate_max);
+    Metrics::Gauge::store(net_rsb.accept_rate_min, rate_min);
+    // The busiest thread against the mean, in percent, 100 when even.
+    Metrics::Gauge::store(net_rsb.accept_imbalance, total > 0 ? rate_max * nthreads * 100 / total : 100);
+  }
+}
+
 static inline void
 register_net_stats()
 {
@@ -126,6 +174,42 @@ register_net_stats()
   net_rsb.write_bytes                      = Metrics::Counter::createPtr("proxy.process.net.write_bytes");
   net_rsb.write_bytes_count                = Metrics::Counter::createPtr("proxy.process.net.write_bytes_count");
   net_rsb.connection_tracker_table_size    = Metrics::Gauge::createPtr("proxy.process.net.connection_tracker_table_size");
+  net_rsb.uring_recv_completions           = Metrics::Counter::createPtr("proxy.process.net.io_uring.recv_completions");
+  net_rsb.uring_recv_buffers_exhausted     = Metrics::Counter::createPtr("proxy.process.net.io_uring.recv_buffers_exhausted");
+  net_rsb.uring_send_completions           = Metrics::Counter::createPtr("proxy.process.net.io_uring.send_completions");
+  net_rsb.uring_sq_full                    = Metrics::Counter::createPtr("proxy.process.net.io_uring.sq_full");
+  net_rsb.zerocopy_bytes                   = Metrics::Counter::createPtr("proxy.process.net.zerocopy.bytes");
+  net_rsb.zerocopy_completions             = Metrics::Counter::createPtr("proxy.process.net.zerocopy.completions");
+  net_rsb.zerocopy_completion_time         = Metrics::Counter::createPtr("proxy.process.net.zerocopy.completion_time");
+  net_rsb.zerocopy_fallbacks               = Metrics::Counter::createPtr("proxy.process.net.zerocopy.fallbacks");
+  net_rsb.sendfile_bytes                   = Metrics::Counter::createPtr("proxy.process.net.sendfile.bytes");
+  net_rsb.sendfile_calls                   = Metrics::Counter::createPtr("proxy.process.net.sendfile.calls");
+  net_rsb.sendfile_aborts                  = Metrics::Counter::createPtr("proxy.process.net.sendfile.aborts");
+  net_rsb.accept_batches                   = Metrics::Counter::createPtr("proxy.process.net.accept.batches");
+  net_rsb.accept_rate_max                  = Metrics::Gauge::createPtr("proxy.process.net.accept.rate_max");
+  net_rsb.accept_rate_min                  = Metrics::Gauge::createPtr("proxy.process.net.accept.rate_min");
+  net_rsb.accept_imbalance                 = Metrics::Gauge::createPtr("proxy.process.net.accept.imbalance");
+
+  RecRegNewSyncStatSync(NetAcceptRateSync);
+}
+
+NetNumaStats *
+net_numa_stats(int node)
+{
+  static std::mutex                                   mutex;
+  static std::map<int, std::unique_ptr<NetNumaStats>> nodes;
+
+  std::lock_guard lock(mutex);
+  auto           &stats = nodes[node];
+  if (!stats) {
+    std::string prefix = "proxy.process.net.numa.node_" + std::to_string(node);
+
+    stats                       = std::make_unique<NetNumaStats>();
+    stats->read_bytes           = Metrics::Counter::createPtr(prefix + ".read_bytes");
+    stats->write_bytes          = Metrics::Counter::createPtr(prefix + ".write_bytes");
+    stats->connections_accepted = Metrics::Counter::createPtr(prefix + ".connections_accepted");
+  }
+  return stats.get();
 }
 
 void
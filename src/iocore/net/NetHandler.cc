@@ -23,12 +23,16 @@
 
 #include "P_Net.h"
 #include "P_UnixNet.h"
+#include "P_UnixNetZeroCopy.h"
 #include "iocore/net/NetHandler.h"
 #include "iocore/net/PollCont.h"
+#include "tscore/ink_atomic.h"
 #if TS_USE_LINUX_IO_URING
 #include "iocore/io_uring/IO_URING.h"
+#include "P_UnixNetUring.h"
 #endif
 
+#include <algorithm>
 #include <atomic>
 
 using namespace std::literals;
@@ -42,6 +46,7 @@ DbgCtl dbg_ctl_v_net_queue{"v_net_queue"};
 
 std::atomic<int32_t>  NetHandler::additional_accepts{0};
 std::atomic<uint32_t> NetHandler::per_client_max_connections_in{0};
+bool                  NetHandler::uring_data_path{false};
 
 // NetHandler method definitions
 
@@ -103,6 +108,7 @@ NetHandler::startCop(NetEvent *ne)
   ink_assert(!open_list.in(ne));
 
   open_list.enqueue(ne);
+  arm_cop(ne, ink_get_hrtime());
 }
 
 void
@@ -111,11 +117,71 @@ NetHandler::stopCop(NetEvent *ne)
   ink_release_assert(ne->nh == this);
 
   open_list.remove(ne);
-  cop_list.remove(ne);
+  cop_wheel.cancel(ne);
+  if (ne->in_cop_update_list) {
+    cop_update_list.remove(ne);
+    ne->in_cop_update_list = 0;
+  }
   remove_from_keep_alive_queue(ne);
   remove_from_active_queue(ne);
 }
 
+void
+NetHandler::arm_cop(NetEvent *ne, ink_hrtime now)
+{
+  if (!open_list.in(ne)) {
+    return;
+  }
+
+  ink_hrtime at = now + MAX_COP_INTERVAL;
+  if (ne->closed) {
+    // Closed but not freed yet, the cop frees it on the next run.
+    at = now;
+  } else if (ne->next_inactivity_timeout_at) {
+    at = std::min(at, ne->next_inactivity_timeout_at);
+  } else if (ne->default_inactivity_timeout_in != 0 && (ne->read.enabled || ne->write.enabled)) {
+    at = now;
+  }
+  if (ne->next_activity_timeout_at) {
+    at = std::min(at, ne->next_activity_timeout_at);
+  }
+  // A timeout that has passed is looked at again on the next run.
+  at = std::max(at, now + 1);
+
+  if (cop_wheel.scheduled(ne)) {
+    if (cop_wheel.expires_at(ne) <= at) {
+      return;
+    }
+    cop_wheel.cancel(ne);
+  }
+  cop_wheel.schedule(ne, at);
+}
+
+void
+NetHandler::update_cop(NetEvent *ne)
+{
+  EThread *t = this_ethread();
+
+  if (mutex->thread_holding == t) {
+    arm_cop(ne, ink_get_hrtime());
+    return;
+  }
+  MUTEX_TRY_LOCK(lock, mutex, t);
+  if (lock.is_locked()) {
+    arm_cop(ne, ink_get_hrtime());
+  } else if (!ink_atomic_swap(&ne->in_cop_update_list, 1)) {
+    cop_update_list.push(ne);
+  }
+}
+
+void
+NetEvent::timeouts_changed()
+{
+  if (nh) {
+    nh->update_cop(this);
+  }
+}
+
 int
 NetHandler::update_nethandler_config(const char *str, RecDataT, RecData data, void *)
 {
@@ -196,6 +262,11 @@ NetHandler::init_for_process()
     per_client_max_connections_in.store(val, std::memory_order_relaxed);
   }
 
+#if TS_USE_LINUX_IO_URING
+  uring_data_path = RecGetRecordInt("proxy.config.net.io_uring.data_path").value_or(0) != 0;
+#endif
+  NetZeroCopy::threshold = RecGetRecordInt("proxy.config.net.zerocopy.threshold").value_or(0);
+
   RecRegisterConfigUpdateCb("proxy.config.net.max_connections_in", update_nethandler_config, nullptr);
   RecRegisterConfigUpdateCb("proxy.config.net.max_requests_in", update_nethandler_config, nullptr);
   RecRegisterConfigUpdateCb("proxy.config.net.inactive_threshold_in", update_nethandler_config, nullptr);
@@ -216,6 +287,8 @@ NetHandler::init_for_process()
   Dbg(dbg_ctl_net_queue, "proxy.config.net.additional_accepts updated to %d", additional_accepts.load(std::memory_order_relaxed));
   Dbg(dbg_ctl_net_queue, "proxy.config.net.per_client.max_connections_in updated to %d",
       per_client_max_connections_in.load(std::memory_order_relaxed));
+  Dbg(dbg_ctl_net_queue, "proxy.config.net.io_uring.data_path is %d", uring_data_path);
+  Dbg(dbg_ctl_net_queue, "proxy.config.net.zerocopy.threshold is %" PRId64, NetZeroCopy::threshold);
 }
 
 //
@@ -265,6 +338,15 @@ NetHandler::process_enabled_list()
       write_ready_list.in_or_enqueue(ne);
     }
   }
+
+  SList(NetEvent, cop_update_link) cq(cop_update_list.popall());
+  if (cq.head) {
+    ink_hrtime now = ink_get_hrtime();
+    while ((ne = cq.pop())) {
+      ne->in_cop_update_list = 0;
+      arm_cop(ne, now);
+    }
+  }
 }
 
 //
@@ -354,12 +436,15 @@ NetHandler::waitForActivity(ink_hrtime timeout)
 
 #if TS_USE_LINUX_IO_URING
   ur->submit();
+  NetUringIO::retry_stalled();
 #endif
 
   // Polling event by PollCont
   PollCont  *p        = get_PollCont(this->thread);
   ink_hrtime pre_poll = ink_get_hrtime();
   p->do_poll(timeout);
+  // Awake, events queued for this thread from now on are seen without a signal.
+  this->thread->EventQueueExternal.finish_sleep();
   ink_hrtime post_poll = ink_get_hrtime();
   ink_hrtime poll_time = post_poll - pre_poll;
 
@@ -375,6 +460,7 @@ NetHandler::waitForActivity(ink_hrtime timeout)
   pd->result = 0;
 
   process_ready_list();
+  NetZeroCopy::release_retired();
   ink_hrtime post_process = ink_get_hrtime();
   ink_hrtime process_time = post_process - post_poll;
   this->thread->metrics.current_slice.load(std::memory_order_acquire)->record_io_stats(poll_time, process_time);
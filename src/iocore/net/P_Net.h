@@ -80,10 +80,35 @@ struct NetStatsBlock {
   Metrics::Counter::AtomicType *write_bytes;
   Metrics::Counter::AtomicType *write_bytes_count;
   Metrics::Gauge::AtomicType   *connection_tracker_table_size;
+  Metrics::Counter::AtomicType *uring_recv_completions;
+  Metrics::Counter::AtomicType *uring_recv_buffers_exhausted;
+  Metrics::Counter::AtomicType *uring_send_completions;
+  Metrics::Counter::AtomicType *uring_sq_full;
+  Metrics::Counter::AtomicType *zerocopy_bytes;
+  Metrics::Counter::AtomicType *zerocopy_completions;
+  Metrics::Counter::AtomicType *zerocopy_completion_time;
+  Metrics::Counter::AtomicType *zerocopy_fallbacks;
+  Metrics::Counter::AtomicType *sendfile_bytes;
+  Metrics::Counter::AtomicType *sendfile_calls;
+  Metrics::Counter::AtomicType *sendfile_aborts;
+  Metrics::Counter::AtomicType *accept_batches;
+  Metrics::Gauge::AtomicType   *accept_rate_max;
+  Metrics::Gauge::AtomicType   *accept_rate_min;
+  Metrics::Gauge::AtomicType   *accept_imbalance;
 };
 
 extern NetStatsBlock net_rsb;
 
+/// Traffic counters of one NUMA node, shared by the net threads on it.
+struct NetNumaStats {
+  Metrics::Counter::AtomicType *read_bytes;
+  Metrics::Counter::AtomicType *write_bytes;
+  Metrics::Counter::AtomicType *connections_accepted;
+};
+
+/// The counters for NUMA node @a node, registered on first use.
+NetNumaStats *net_numa_stats(int node);
+
 #define SSL_HANDSHAKE_WANT_READ    6
 #define SSL_HANDSHAKE_WANT_WRITE   7
 #define SSL_HANDSHAKE_WANT_ACCEPT  8
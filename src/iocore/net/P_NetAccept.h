@@ -44,6 +44,8 @@
 #include "Server.h"
 
 #include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 struct NetAccept;
@@ -94,11 +96,24 @@ struct NetAcceptAction : public Action, public RefCountObjInHeap {
   }
 };
 
+/** The listen sockets of a port in a @c SO_REUSEPORT group, one for each net thread.
+
+    The kernel numbers the sockets of a group in the order they listen, so they listen under
+    @a mutex and @a members records that order, which a steering program needs to pick a socket.
+ */
+struct ReuseportGroup {
+  std::mutex             mutex;
+  std::vector<EThread *> members; ///< The thread of each socket, by its index in the group.
+};
+
 //
 // NetAccept
 // Handles accepting connections.
 //
 struct NetAccept : public Continuation {
+  /// The most connections @c acceptFastEvent takes in one run of accept calls.
+  static constexpr int ACCEPT_BATCH = 32;
+
   ink_hrtime             period = 0;
   Server                 server;
   int                    ifd = NO_FD;
@@ -110,6 +125,9 @@ struct NetAccept : public Continuation {
   HttpProxyPort *proxyPort = nullptr;
   AcceptOptions  opt;
 
+  /// Shared by the per thread listeners of the port when connections are steered to them.
+  std::shared_ptr<ReuseportGroup> reuseport_group;
+
   virtual NetProcessor *getNetProcessor() const;
 
   virtual void       init_accept(EThread *t = nullptr);
@@ -232,6 +232,7 @@ public:
 
   int         populate_protocol(std::string_view *results, int n) const override;
   const char *protocol_contains(std::string_view tag) const override;
+  bool        supports_sendfile() const override;
 
   /**
    * Populate the current object based on the socket information in the
@@ -309,6 +310,12 @@ protected:
   // UnixNetVConnection
   bool _isReadyToTransferData() const override;
   void _beReadyToTransferData() override;
+  bool
+  _canUseUringDataPath() const override
+  {
+    // OpenSSL reads and writes the socket itself.
+    return false;
+  }
 
   // TLSBasicSupport
   SSL *
@@ -425,9 +432,12 @@ private:
   int         _ssl_read_from_net(int64_t &ret);
   ssl_error_t _ssl_read_buffer(void *buf, int64_t nbytes, int64_t &nread);
   ssl_error_t _ssl_write_buffer(const void *buf, int64_t nbytes, int64_t &nwritten);
+  ssl_error_t _ssl_sendfile(IOBufferFileRange *range, off_t offset, int64_t nbytes, int64_t &nwritten);
   ssl_error_t _ssl_connect();
   ssl_error_t _ssl_accept();
 
+  void _enable_ktls_zero_copy();
+
   void _in_context_tunnel() override;
   void _out_context_tunnel() override;
 };
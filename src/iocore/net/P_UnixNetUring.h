@@ -0,0 +1,203 @@
+/** @file
+
+  Socket I/O for UnixNetVConnection driven by the thread's io_uring.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "tscore/ink_config.h"
+
+#if TS_USE_LINUX_IO_URING
+
+#include "iocore/eventsystem/IOBuffer.h"
+#include "iocore/io_uring/IO_URING.h"
+#include "iocore/net/Net.h"
+#include "tscore/ink_memory.h"
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <sys/socket.h>
+
+class UnixNetVConnection;
+
+/**
+  The ring of provided buffers an ET_NET thread's multishot receives fill.
+
+  Each slot holds an IOBufferData. A completed receive hands its buffer to the connection as an
+  IOBufferBlock, so the data reaches the VIO without a copy, and the slot is refilled with a fresh
+  buffer at once.
+ */
+class NetUringBufferRing
+{
+public:
+  static constexpr int BUFFER_GROUP = 0;
+
+  /// @return The ring, or @c nullptr if the kernel does not support provided buffer rings.
+  static NetUringBufferRing *create(IOUringContext *ctx, unsigned entries, int64_t size_index);
+  ~NetUringBufferRing();
+
+  /// Take the buffer @a bid holding @a len received bytes and put a fresh one in its slot.
+  IOBufferBlock *take(unsigned bid, int len);
+
+  int64_t
+  buffer_size() const
+  {
+    return BUFFER_SIZE_FOR_INDEX(_size_index);
+  }
+
+private:
+  NetUringBufferRing(IOUringContext *ctx, io_uring_buf_ring *br, unsigned entries, int64_t size_index);
+
+  void _provide(unsigned bid);
+
+  IOUringContext                      *_ctx;
+  io_uring_buf_ring                   *_br;
+  unsigned                             _entries;
+  int64_t                              _size_index;
+  std::unique_ptr<Ptr<IOBufferData>[]> _slots;
+};
+
+/**
+  The io_uring state of one UnixNetVConnection.
+
+  A multishot receive stays armed on the socket and queues what it receives until @c net_read_io
+  moves it to the read VIO. Sends are queued on the ring and submitted with everything else once
+  per @c NetHandler::waitForActivity loop. Completions mark the connection triggered and put it
+  on the ready lists, as epoll readiness does, so the NetHandler state machine is unchanged.
+
+  The object outlives its connection while operations are in flight: @c detach cancels them and
+  the last completion frees it.
+ */
+class NetUringIO
+{
+public:
+  NetUringIO(UnixNetVConnection *vc, NetUringBufferRing *ring);
+
+  /// Whether reads go through the ring, false once the kernel has refused a multishot receive.
+  bool
+  can_recv() const
+  {
+    return !_recv_unsupported;
+  }
+
+  /**
+    Move up to @a toread received bytes to @a writer.
+
+    @return The number of bytes moved, 0 at end of stream, or a negative errno. -EAGAIN if nothing
+    has arrived yet.
+   */
+  int64_t recv(MIOBuffer *writer, int64_t toread);
+
+  /**
+    Report the last send and submit the next one, of up to @a towrite bytes from @a reader.
+
+    @return The number of bytes the last send wrote, which the caller consumes from @a reader, or
+    a negative errno. -EAGAIN if a send is still in flight.
+   */
+  int64_t send(IOBufferReader *reader, int64_t towrite);
+
+  /// The connection is going away. Cancel what is in flight; the last completion frees this.
+  void detach();
+
+  /**
+    Queue again what this thread's connections could not queue on a full submission queue.
+
+    Called right after the ring is submitted, while it has room. A send is retried by putting its
+    connection back on the write ready list, so it goes out in the same NetHandler loop.
+   */
+  static void retry_stalled();
+
+private:
+  struct RecvOp : public IOUringCompletionHandler {
+    NetUringIO *io;
+    void
+    handle_complete(io_uring_cqe *cqe) override
+    {
+      io->_recv_complete(cqe);
+    }
+  };
+  struct SendOp : public IOUringCompletionHandler {
+    NetUringIO *io;
+    void
+    handle_complete(io_uring_cqe *cqe) override
+    {
+      io->_send_complete(cqe);
+    }
+  };
+
+  bool _want_recv() const;
+  void _arm_recv();
+  void _cancel(IOUringCompletionHandler *op);
+  void _stall();
+  void _recv_complete(io_uring_cqe *cqe);
+  void _send_complete(io_uring_cqe *cqe);
+  void _submit_send(IOBufferReader *reader, int64_t skip, int64_t towrite);
+  void _trigger_read();
+  void _trigger_write();
+  void _free_if_idle();
+
+  UnixNetVConnection *_vc;
+  NetUringBufferRing *_ring;
+  IOUringContext     *_ctx;
+  int                 _fd;
+  RecvOp              _recv_op;
+  SendOp              _send_op;
+
+  // Received data not yet moved to the read VIO.
+  Ptr<IOBufferBlock> _pending;
+  IOBufferBlock     *_pending_tail  = nullptr;
+  int64_t            _pending_bytes = 0;
+
+  bool _recv_armed       = false;
+  bool _recv_cancelled   = false;
+  bool _recv_eos         = false;
+  bool _recv_unsupported = false;
+  int  _recv_error       = 0;
+
+  // The blocks of the send in flight, held so the data outlives a close.
+  Ptr<IOBufferBlock> _send_blocks;
+  IOVec              _send_iov[NET_MAX_IOV];
+  msghdr             _send_msg;
+  bool               _send_in_flight = false;
+  bool               _send_done      = false;
+  int64_t            _send_result    = 0;
+
+  // Zero copy sends the kernel may still be reading, oldest first, and when each was submitted.
+  struct ZeroCopySend {
+    Ptr<IOBufferBlock> blocks;
+    ink_hrtime         sent_at;
+  };
+  std::deque<ZeroCopySend> _zc_sends;
+  bool                     _send_zc = false;
+
+  // Operations the submission queue had no room for, queued again by retry_stalled().
+  bool _stalled           = false;
+  bool _retry_recv        = false;
+  bool _retry_send        = false;
+  bool _retry_recv_cancel = false;
+  bool _retry_send_cancel = false;
+
+  static thread_local std::vector<NetUringIO *> _stalled_ios;
+};
+
+#endif
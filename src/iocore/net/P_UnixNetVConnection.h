@@ -46,6 +46,8 @@
 
 class UnixNetVConnection;
 class NetHandler;
+class NetUringIO;
+class NetZeroCopy;
 struct PollDescriptor;
 
 // WARNING:  many or most of the member functions of UnixNetVConnection should only be used when it is instantiated
@@ -112,6 +114,7 @@ public:
 
   int         populate_protocol(std::string_view *results, int n) const override;
   const char *protocol_contains(std::string_view tag) const override;
+  bool        supports_sendfile() const override;
 
   // noncopyable
   UnixNetVConnection(const NetVConnection &)            = delete;
@@ -128,6 +131,7 @@ public:
   virtual void net_read_io(NetHandler *nh) override;
   virtual void net_write_io(NetHandler *nh) override;
   virtual void free_thread(EThread *t) override;
+  virtual void error_queue_ready() override;
   virtual int
   close() override
   {
@@ -186,6 +190,11 @@ public:
   bool       from_accept_thread = false;
   NetAccept *accept_object      = nullptr;
 
+  /// Socket I/O through the thread's io_uring, @c nullptr if the socket uses readv and writev.
+  NetUringIO *uring_io = nullptr;
+  /// Zero copy send state, created by the first write large enough to use it.
+  NetZeroCopy *zero_copy = nullptr;
+
   int         startEvent(int event, Event *e);
   int         acceptEvent(int event, Event *e);
   int         mainEvent(int event, Event *e);
@@ -227,12 +236,24 @@ protected:
   _beReadyToTransferData()
   {
   }
+  /// Whether the socket may be read and written through the thread's io_uring instead of readv and writev.
+  virtual bool
+  _canUseUringDataPath() const
+  {
+    return true;
+  }
 
   int _readSignalError(NetHandler *nh, int lerrno);
   int _writeSignalError(NetHandler *nh, int lerrno);
 
+  /// Send @a len bytes of the file range at the position of @a reader. @return As for @c sendmsg.
+  int64_t _send_file_range(IOBufferReader *reader, int64_t len);
+
 private:
   virtual void         *_prepareForMigration();
+  int64_t              _read_from_net(MIOBuffer *writer, int64_t toread);
+  void                 _start_uring_io();
+  bool                 _start_zero_copy();
   virtual NetProcessor *_getNetProcessor();
 
   bool _is_tunnel_endpoint{false};
@@ -322,6 +343,7 @@ UnixNetVConnection::set_active_timeout(ink_hrtime timeout_in)
   Dbg(_dbg_ctl_socket, "Set active timeout=%" PRId64 ", NetVC=%p", timeout_in, this);
   active_timeout_in        = timeout_in;
   next_activity_timeout_at = (active_timeout_in > 0) ? ink_get_hrtime() + timeout_in : 0;
+  timeouts_changed();
 }
 
 inline void
@@ -0,0 +1,103 @@
+/** @file
+
+  Zero copy sends for UnixNetVConnection.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "iocore/eventsystem/IOBuffer.h"
+#include "tscore/ink_hrtime.h"
+
+#include <cstdint>
+#include <deque>
+
+#include <sys/socket.h>
+
+/**
+  The sends of one socket made with @c MSG_ZEROCOPY.
+
+  The kernel transmits straight from the IOBufferData of such a send and tells the socket through
+  its error queue once it no longer needs the pages, so the blocks are held until then. A block
+  freed earlier could go back to the freelist and be overwritten while still being sent.
+ */
+class NetZeroCopy
+{
+public:
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+  static constexpr int SEND_FLAG = MSG_ZEROCOPY;
+#else
+  static constexpr int SEND_FLAG = 0;
+#endif
+
+  /// Writes of at least this many bytes are sent without a copy, 0 if disabled.
+  static int64_t threshold;
+
+  /// Whether a write of @a towrite bytes should go without a copy.
+  static bool
+  wanted(int64_t towrite)
+  {
+    return SEND_FLAG != 0 && threshold > 0 && towrite >= threshold;
+  }
+
+  /// Turn on zero copy sends for @a fd. @return @c false if the kernel refuses.
+  bool enable(int fd);
+
+  /// Hold the @a nblocks blocks from @a first on, which a zero copy send of @a len bytes has just been given.
+  void sent(IOBufferBlock *first, int nblocks, int64_t len);
+
+  /// Release the blocks of the sends the kernel has finished with.
+  void reap(int fd);
+
+  /// The socket is closing. Reap what is done and keep the rest for a grace period.
+  void retire(int fd);
+
+  /// Free the blocks of closed sockets whose grace period is over.
+  static void release_retired();
+
+  /// A chain of clones of the @a nblocks blocks holding data from @a first on.
+  static IOBufferBlock *hold(IOBufferBlock *first, int nblocks);
+
+  bool
+  enabled() const
+  {
+    return _enabled;
+  }
+
+  /// Whether the kernel may still be reading held blocks.
+  bool
+  busy() const
+  {
+    return !_pinned.empty();
+  }
+
+private:
+  struct Pinned {
+    uint32_t           id;
+    Ptr<IOBufferBlock> blocks;
+    ink_hrtime         sent_at;
+  };
+
+  void _complete(uint32_t hi, bool copied);
+
+  std::deque<Pinned> _pinned;
+  uint32_t           _next_id = 0;
+  bool               _enabled = false;
+};
@@ -33,6 +33,7 @@
 #include "P_SSLClientUtils.h"
 #include "P_SSLNetVConnection.h"
 #include "P_UnixNetProcessor.h"
+#include "P_UnixNetZeroCopy.h"
 #include "iocore/net/NetHandler.h"
 #include "iocore/net/NetVConnection.h"
 #include "iocore/net/ProxyProtocol.h"
@@ -49,6 +50,10 @@
 #include <string>
 #include <cstring>
 
+#if __has_include(<linux/tls.h>)
+#include <linux/tls.h>
+#endif
+
 #if TS_USE_TLS_ASYNC
 #include <openssl/async.h>
 #endif
@@ -104,6 +109,33 @@ resolve_client_ca_cert_path(const SSLConfigParams *params, const char *path, std
   return storage.c_str();
 }
 
+// Whether the @a len bytes from the position of @a reader reach a file range, which cannot be copied.
+bool
+reaches_file_range(IOBufferReader *reader, int64_t len)
+{
+  int64_t offset = reader->start_offset;
+  for (IOBufferBlock *b = reader->get_current_block(); b && len > 0; b = b->next.get()) {
+    if (b->file_range()) {
+      return true;
+    }
+    len    -= b->read_avail() - offset;
+    offset  = 0;
+  }
+  return false;
+}
+
+// Count the records SSL_write() makes of @a len bytes: full records, then the rest in one.
+void
+count_tls_records(int64_t len)
+{
+  if (int64_t full = len / SSL3_RT_MAX_PLAIN_LENGTH; full > 0) {
+    Metrics::Counter::increment(ssl_rsb.tls_record_size[TLSRecordSizeHistogram::bucket_for(SSL3_RT_MAX_PLAIN_LENGTH)], full);
+  }
+  if (int64_t rest = len % SSL3_RT_MAX_PLAIN_LENGTH; rest > 0) {
+    Metrics::Counter::increment(ssl_rsb.tls_record_size[TLSRecordSizeHistogram::bucket_for(rest)]);
+  }
+}
+
 } // namespace
 
 //
@@ -291,6 +323,9 @@ SSLNetVConnection::_ssl_read_from_net(int64_t &ret)
     // Decrypted application bytes, to match write_bytes (also plaintext for TLS).
     Metrics::Counter::increment(net_rsb.read_bytes, bytes_read);
     Metrics::Counter::increment(net_rsb.read_bytes_count);
+    if (this->nh && this->nh->numa_stats) {
+      Metrics::Counter::increment(this->nh->numa_stats->read_bytes, bytes_read);
+    }
     this->netActivity();
 
     ret = bytes_read;
@@ -785,14 +820,22 @@ SSLNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &buf
       break;
     }
 
-    // Coalesce across blocks only when it fits one record; else write in place, capped to the block.
-    const char *write_block;
-    int64_t     block_avail = reader->block_read_avail();
+    // Coalesce across blocks up to a record, so small blocks, such as the HTTP/2 frames of a batch,
+    // go out in full records rather than a record each. A block that fills the record is written in
+    // place, capped to the block. A file range is sent on its own, straight from the file.
+    const char        *write_block;
+    int64_t            block_avail = reader->block_read_avail();
+    IOBufferFileRange *range       = block_avail > 0 ? reader->get_current_block()->file_range() : nullptr;
+    int64_t            gather      = std::min(l, static_cast<int64_t>(sizeof(gather_buf)));
 
-    if (block_avail < l && l <= static_cast<int64_t>(sizeof(gather_buf))) {
+    if (range == nullptr && block_avail < gather && !reaches_file_range(reader, gather)) {
+      l = gather;
       reader->memcpy(gather_buf, l, 0);
       write_block = gather_buf;
     } else {
+      if (range) {
+        l = towrite - total_written; // kernel TLS cuts the records itself
+      }
       if (l > block_avail) {
         l = block_avail;
       }
@@ -802,12 +845,19 @@ SSLNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &buf
     try_to_write       = l;
     num_really_written = 0;
     Dbg(dbg_ctl_v_ssl, "b=%p l=%" PRId64, write_block, l);
-    err = this->_ssl_write_buffer(write_block, l, num_really_written);
+    if (range) {
+      err = this->_ssl_sendfile(range, range->file_offset(write_block), l, num_really_written);
+    } else {
+      err = this->_ssl_write_buffer(write_block, l, num_really_written);
+    }
 
     // We wrote all that we thought we should
     if (num_really_written > 0) {
       total_written += num_really_written;
       reader->consume(num_really_written);
+      if (range == nullptr) {
+        count_tls_records(num_really_written);
+      }
     }
 
     Dbg(dbg_ctl_ssl, "try_to_write=%" PRId64 " written=%" PRId64 " total_written=%" PRId64, try_to_write, num_really_written,
@@ -1422,6 +1472,7 @@ SSLNetVConnection::sslServerHandShakeEvent(int &err)
     }
 
     sslHandshakeStatus = SSLHandshakeStatus::SSL_HANDSHAKE_DONE;
+    this->_enable_ktls_zero_copy();
 
     if (this->get_tls_handshake_begin_time()) {
       this->_record_tls_handshake_end_time();
@@ -2542,3 +2593,59 @@ SSLNetVConnection::_ssl_read_buffer(void *buf, int64_t nbytes, int64_t &nread)
 
   return ssl_error;
 }
+
+bool
+SSLNetVConnection::supports_sendfile() const
+{
+#ifdef SSL_OP_ENABLE_KTLS
+  // With kernel TLS the kernel encrypts the records, so it can read the bytes from the file itself.
+  return this->ssl != nullptr && BIO_get_ktls_send(SSL_get_wbio(this->ssl)) && this->super::supports_sendfile();
+#else
+  return false;
+#endif
+}
+
+ssl_error_t
+SSLNetVConnection::_ssl_sendfile(IOBufferFileRange *range, off_t offset, int64_t nbytes, int64_t &nwritten)
+{
+  nwritten = 0;
+#ifdef SSL_OP_ENABLE_KTLS
+  if (!range->still_valid()) {
+    Metrics::Counter::increment(net_rsb.sendfile_aborts);
+    return SSL_ERROR_SSL;
+  }
+  ossl_ssize_t ret = SSL_sendfile(this->ssl, range->fd(), offset, static_cast<size_t>(nbytes), 0);
+  Metrics::Counter::increment(net_rsb.sendfile_calls);
+  if (ret > 0) {
+    // If the space was reused while the kernel read it the client got the wrong bytes.
+    if (!range->still_valid()) {
+      Metrics::Counter::increment(net_rsb.sendfile_aborts);
+      return SSL_ERROR_SSL;
+    }
+    Metrics::Counter::increment(net_rsb.sendfile_bytes, ret);
+    nwritten = ret;
+    return SSL_ERROR_NONE;
+  }
+  return SSL_get_error(this->ssl, static_cast<int>(ret));
+#else
+  (void)range;
+  (void)offset;
+  (void)nbytes;
+  ink_release_assert(!"SSL_sendfile is not supported");
+  return SSL_ERROR_SSL;
+#endif
+}
+
+void
+SSLNetVConnection::_enable_ktls_zero_copy()
+{
+#if defined(SSL_OP_ENABLE_KTLS) && defined(TLS_TX_ZEROCOPY_RO)
+  // The kernel TLS layer does not take MSG_ZEROCOPY, but it can send file pages without copying them.
+  if (NetZeroCopy::threshold > 0 && BIO_get_ktls_send(SSL_get_wbio(this->ssl))) {
+    int one = 1;
+    if (setsockopt(this->get_fd(), SOL_TLS, TLS_TX_ZEROCOPY_RO, &one, sizeof(one)) != 0) {
+      Metrics::Counter::increment(net_rsb.zerocopy_fallbacks);
+    }
+  }
+#endif
+}
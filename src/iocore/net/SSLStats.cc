@@ -261,6 +261,13 @@ SSLInitializeStatistics()
   ssl_rsb.tls_handshake_bytes_in_total      = Metrics::Counter::createPtr("proxy.process.ssl.total_handshake_bytes_read_in");
   ssl_rsb.tls_handshake_bytes_out_total     = Metrics::Counter::createPtr("proxy.process.ssl.total_handshake_bytes_write_out");
 
+  for (unsigned idx = 0; idx < TLSRecordSizeHistogram::N_BUCKETS; ++idx) {
+    char name[64];
+    snprintf(name, sizeof(name), "proxy.process.ssl.tls_record_size.%zu",
+             static_cast<size_t>(TLSRecordSizeHistogram::min_for_bucket(idx)));
+    ssl_rsb.tls_record_size[idx] = Metrics::Counter::createPtr(name);
+  }
+
 #if defined(OPENSSL_IS_BORINGSSL)
   size_t                    n = SSL_get_all_cipher_names(nullptr, 0);
   std::vector<const char *> cipher_list(n);
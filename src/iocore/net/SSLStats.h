@@ -24,14 +24,19 @@
 #pragma once
 
 #include "tscore/ink_config.h"
+#include "tsutil/Histogram.h"
 #include "tsutil/Metrics.h"
 
 #include <openssl/ssl.h>
 
+#include <array>
 #include <unordered_map>
 
 using ts::Metrics;
 
+/// Plaintext size of the TLS records written, 2 buckets per power of 2 up to a full record of 16 KiB.
+using TLSRecordSizeHistogram = ts::Histogram<13, 1>;
+
 // For some odd reason, these have to be initialized with nullptr, because the order
 // of initialization and how we load certs is weird... In reality only the metric
 // for ssl_rsb.total_ticket_keys_renewed needs this initialization, but lets be
@@ -128,6 +133,8 @@ struct SSLStatsBlock {
   Metrics::Gauge::AtomicType *user_agent_session_miss    = nullptr;
   Metrics::Gauge::AtomicType *user_agent_session_timeout = nullptr;
   Metrics::Gauge::AtomicType *user_agent_sessions        = nullptr;
+
+  std::array<Metrics::Counter::AtomicType *, TLSRecordSizeHistogram::N_BUCKETS> tls_record_size = {};
 };
 
 extern SSLStatsBlock                                                   ssl_rsb;
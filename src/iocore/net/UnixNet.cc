@@ -28,8 +28,12 @@
 #include "tscore/ink_hrtime.h"
 #include "ts/ats_probe.h"
 
+#include <mutex>
+#include <string>
+
 #if TS_USE_LINUX_IO_URING
 #include "iocore/io_uring/IO_URING.h"
+#include "P_UnixNetUring.h"
 #endif
 
 ink_hrtime        last_throttle_warning;
@@ -73,7 +77,7 @@ get_PollDescriptor(EThread *t)
 
 // INKqa10496
 // One Inactivity cop runs on each thread once every second and
-// loops through the list of NetEvents and calls the timeouts
+// calls the timeouts of the NetEvents that come off the cop wheel
 class InactivityCop : public Continuation
 {
 public:
@@ -86,13 +90,19 @@ public:
     NetHandler &nh  = *get_NetHandler(this_ethread());
 
     Dbg(dbg_ctl_inactivity_cop_check, "Checking inactivity on Thread-ID #%d", this_ethread()->id);
-    // The rest NetEvents in cop_list which are not triggered between InactivityCop runs.
-    // Use pop() to catch any closes caused by callbacks.
-    while (NetEvent *ne = nh.cop_list.pop()) {
+    // Only the NetEvents whose timeouts may have passed come off the wheel. Each is put back for
+    // its next timeout before its callback, which may close it.
+    nh.cop_wheel.advance(now);
+    while (NetEvent *ne = nh.cop_wheel.pop_expired()) {
+      if (ne->get_thread() != this_ethread()) {
+        nh.arm_cop(ne, now);
+        continue;
+      }
       // If we cannot get the lock don't stop just keep cleaning
       MUTEX_TRY_LOCK(lock, ne->get_mutex(), this_ethread());
       if (!lock.is_locked()) {
         Metrics::Counter::increment(net_rsb.inactivity_cop_lock_acquire_failure);
+        nh.arm_cop(ne, now);
         continue;
       }
 
@@ -122,6 +132,8 @@ public:
         Metrics::Counter::increment(net_rsb.default_inactivity_timeout_applied);
       }
 
+      nh.arm_cop(ne, now);
+
       if (ne->next_inactivity_timeout_at && ne->next_inactivity_timeout_at < now) {
         if (ne->is_default_inactivity_timeout()) {
           // track the connections that timed out due to default inactivity
@@ -145,19 +157,6 @@ public:
         ne->callback(VC_EVENT_ACTIVE_TIMEOUT, e);
       }
     }
-    // The cop_list is empty now.
-    // Let's reload the cop_list from open_list again.
-    forl_LL(NetEvent, ne, nh.open_list)
-    {
-      if (ne->get_thread() == this_ethread()) {
-        nh.cop_list.push(ne);
-      }
-    }
-    // NetHandler will remove NetEvent from cop_list if it is triggered.
-    // As the NetHandler runs, the number of NetEvents in the cop_list is decreasing.
-    // NetHandler runs 100 times maximum between InactivityCop runs.
-    // Therefore we don't have to check all the NetEvents as much as open_list.
-
     // Cleanup the active and keep-alive queues periodically
     nh.manage_active_queue(nullptr, true); // close any connections over the active timeout
     nh.manage_keep_alive_queue();
@@ -187,12 +186,30 @@ initialize_thread_for_net(EThread *thread)
   nh->configure_per_thread_values();
   thread->schedule_every(inactivityCop, HRTIME_SECONDS(cop_freq));
 
+  if (thread->numa_node >= 0) {
+    nh->numa_stats = net_numa_stats(thread->numa_node);
+  }
+  if (thread->is_event_type(ET_NET)) {
+    nh->accept_rate = Metrics::Gauge::createPtr("proxy.process.net.accept.thread_" + std::to_string(thread->id) + ".rate");
+  }
+
   thread->set_tail_handler(nh);
 
 #if HAVE_EVENTFD
 #if TS_USE_LINUX_IO_URING
   auto ep = new IOUringEventIO();
   ep->start(pd, IOUringContext::local_context());
+
+  if (NetHandler::uring_data_path && thread->is_event_type(ET_NET)) {
+    unsigned entries = RecGetRecordInt("proxy.config.net.io_uring.recv_buffers").value_or(0);
+    int64_t  size    = RecGetRecordInt("proxy.config.net.io_uring.recv_buffer_size").value_or(0);
+    nh->uring_buffers =
+      NetUringBufferRing::create(IOUringContext::local_context(), entries, iobuffer_size_to_index(size, MAX_BUFFER_SIZE_INDEX));
+    if (nh->uring_buffers == nullptr) {
+      static std::once_flag warned;
+      std::call_once(warned, [] { Warning("io_uring provided buffer rings are not supported, using readv and writev"); });
+    }
+  }
 #else
   auto ep = new AsyncSignalEventIO();
   ep->start(pd, thread->evfd, EVENTIO_READ);
@@ -30,6 +30,18 @@
 #include "tscore/TSSystemState.h"
 #include "tscore/ink_inet.h"
 #include "tscore/ink_defs.h"
+#include "tscore/ink_hw.h"
+
+#if TS_USE_HWLOC
+#include <hwloc.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/filter.h>
+#endif
+
+#include <algorithm>
+#include <mutex>
 
 using NetAcceptHandler = int (NetAccept::*)(int, void *);
 
@@ -77,6 +89,76 @@ handle_max_client_connections(IpEndpoint const &addr, std::shared_ptr<Connection
   return true;
 }
 
+#if TS_USE_HWLOC && defined(SO_ATTACH_REUSEPORT_CBPF)
+/** Steer the connections arriving at the @c SO_REUSEPORT group of @a fd by the CPU that received them.
+
+    A connection goes to a thread bound to the receiving CPU if there is one, otherwise to a thread
+    on the CPU's NUMA node, so it is accepted and served where the NIC queue delivered it. The
+    CPUs sharing threads are dealt out over them in turn. The program is a list of compares of the
+    CPU, each followed by the return of its socket index. A CPU no thread can take from gets an
+    index past the end of the group, for which the kernel falls back to its hash.
+
+    @a members lists the thread of each socket by its index in the group. It is rebuilt as each
+    socket joins, replacing the program for the whole group.
+ */
+void
+steer_by_cpu(int fd, std::vector<EThread *> const &members)
+{
+  hwloc_topology_t topology = ink_get_topology();
+  int              npu      = hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_PU);
+  int              nnodes   = std::max(1, hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_NODE));
+
+  std::vector<sock_filter> prog;
+  std::vector<unsigned>    next(nnodes + members.size(), 0); // Turn counters, per node then per thread.
+
+  prog.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)));
+  for (int i = 0; i < npu && prog.size() + 3 <= BPF_MAXINSNS; ++i) {
+    hwloc_obj_t pu   = hwloc_get_obj_by_type(topology, HWLOC_OBJ_PU, i);
+    int         node = -1;
+    for (int n = 0; n < nnodes; ++n) {
+      hwloc_obj_t obj = hwloc_get_obj_by_type(topology, HWLOC_OBJ_NODE, n);
+      if (obj && hwloc_bitmap_isset(obj->cpuset, pu->os_index)) {
+        node = n;
+        break;
+      }
+    }
+
+    std::vector<uint32_t> bound;
+    std::vector<uint32_t> local;
+    for (uint32_t idx = 0; idx < members.size(); ++idx) {
+      EThread *t = members[idx];
+      if (t->hwloc_obj && hwloc_bitmap_isset(t->hwloc_obj->cpuset, pu->os_index)) {
+        bound.push_back(idx);
+      } else if (node >= 0 && t->numa_node == node) {
+        local.push_back(idx);
+      }
+    }
+
+    uint32_t target;
+    if (!bound.empty()) {
+      target = bound[next[nnodes + bound.front()]++ % bound.size()];
+    } else if (!local.empty()) {
+      target = local[next[node]++ % local.size()];
+    } else {
+      continue;
+    }
+    prog.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, pu->os_index, 0, 1));
+    prog.push_back(BPF_STMT(BPF_RET | BPF_K, target));
+  }
+  prog.push_back(BPF_STMT(BPF_RET | BPF_K, UINT32_MAX));
+
+  sock_fprog fprog;
+  fprog.len    = prog.size();
+  fprog.filter = prog.data();
+  if (safe_setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &fprog, sizeof(fprog)) < 0) {
+    Warning("unable to attach the SO_REUSEPORT steering program to fd %d: %s", fd, strerror(errno));
+    return;
+  }
+  Dbg(dbg_ctl_iocore_net_accept, "fd %d steers %d CPUs over %zu listeners", fd, static_cast<int>(prog.size() - 2) / 2,
+      members.size());
+}
+#endif
+
 } // end anonymous namespace
 
 static void
@@ -178,6 +260,10 @@ net_accept(NetAccept *na, void *ep, bool blockable)
       vc->mutex = h->mutex;
       t->schedule_imm(vc);
     }
+    h->accept_count.fetch_add(1, std::memory_order_relaxed);
+    if (h->numa_stats) {
+      Metrics::Counter::increment(h->numa_stats->connections_accepted);
+    }
   } while (count < additional_accepts);
 
 Ldone:
@@ -273,7 +359,19 @@ NetAccept::accept_per_thread(int /* event ATS_UNUSED */, void * /* ep ATS_UNUSED
       ats_unix_append_id(&server.accept_addr.sun, id);
     }
 
-    if (do_listen()) {
+    int res = 0;
+    if (reuseport_group) {
+      std::lock_guard lock(reuseport_group->mutex);
+      if ((res = do_listen()) == 0) {
+        reuseport_group->members.push_back(this_ethread());
+#if TS_USE_HWLOC && defined(SO_ATTACH_REUSEPORT_CBPF)
+        steer_by_cpu(server.sock.get_fd(), reuseport_group->members);
+#endif
+      }
+    } else {
+      res = do_listen();
+    }
+    if (res) {
       Fatal("[NetAccept::accept_per_thread]:error listening on ports");
       return -1;
     }
@@ -303,6 +401,18 @@ NetAccept::init_accept_per_thread()
     }
   }
 
+  // Keep each connection on the CPU, or failing that the NUMA node, that received it. NUMA mode
+  // always does.
+  bool steering = RecGetRecordInt("proxy.config.exec_thread.listen_steering").value_or(0) == 1 || eventProcessor.numa_nodes > 0;
+  if (listen_per_thread == 1 && steering && !ats_is_unix(server.accept_addr)) {
+#if TS_USE_HWLOC && defined(SO_ATTACH_REUSEPORT_CBPF)
+    reuseport_group = std::make_shared<ReuseportGroup>();
+#else
+    static std::once_flag warned;
+    std::call_once(warned, [] { Warning("proxy.config.exec_thread.listen_steering needs hwloc and SO_ATTACH_REUSEPORT_CBPF"); });
+#endif
+  }
+
   SET_HANDLER(&NetAccept::accept_per_thread);
   n = eventProcessor.thread_group[ET_NET]._count;
 
@@ -454,6 +564,10 @@ NetAccept::do_blocking_accept(EThread *t)
     NetHandler *h      = get_NetHandler(localt);
     // Assign NetHandler->mutex to NetVC
     vc->mutex = h->mutex;
+    h->accept_count.fetch_add(1, std::memory_order_relaxed);
+    if (h->numa_stats) {
+      Metrics::Counter::increment(h->numa_stats->connections_accepted);
+    }
     localt->schedule_imm(vc);
   } while (count < additional_accepts);
 
@@ -514,20 +628,38 @@ NetAccept::acceptFastEvent(int event, void *ep)
 
   UnixNetVConnection *vc                 = nullptr;
   int                 count              = 0;
+  int                 taken              = 0;
   EThread            *t                  = e->ethread;
   NetHandler         *h                  = get_NetHandler(t);
   int                 additional_accepts = NetHandler::get_additional_accepts();
 
+  struct Accepted {
+    UnixSocket sock{NO_FD};
+    IpEndpoint addr;
+  } batch[ACCEPT_BATCH];
+  int n;
+
   do {
-    socklen_t  sz = sizeof(con.addr);
-    UnixSocket sock{-1};
-    if (int res{server.sock.accept4(&con.addr.sa, &sz, SOCK_NONBLOCK | SOCK_CLOEXEC)}; res >= 0) {
-      sock = UnixSocket{res};
+    // Take what is waiting in one run of accept calls and then set the connections up, rather than
+    // interleave the two, so a burst of connections keeps the accept path hot.
+    int want = std::min(additional_accepts - taken, ACCEPT_BATCH);
+    for (n = 0; n < want; ++n) {
+      socklen_t sz = sizeof(batch[n].addr);
+      int       fd = server.sock.accept4(&batch[n].addr.sa, &sz, SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if (fd < 0) {
+        res = -errno;
+        break;
+      }
+      batch[n].sock = UnixSocket{fd};
     }
-    con.sock = sock;
-    std::shared_ptr<ConnectionTracker::Group> conn_track_group;
+    taken += n;
+
+    for (int i = 0; i < n; ++i) {
+      UnixSocket sock = batch[i].sock;
+      con.sock        = sock;
+      ats_ip_copy(&con.addr, &batch[i].addr);
+      std::shared_ptr<ConnectionTracker::Group> conn_track_group;
 
-    if (likely(sock.is_ok())) {
       // check for throttle
       if (check_net_throttle(ACCEPT)) {
         // close the connection as we are in throttle state
@@ -563,13 +695,57 @@ NetAccept::acceptFastEvent(int event, void *ep)
           }
         }
       }
-    } else {
-      res = sock.get_fd();
+
+      vc = static_cast<UnixNetVConnection *>(this->getNetProcessor()->allocate_vc(e->ethread));
+      ink_release_assert(vc);
+      vc->enable_inbound_connection_tracking(conn_track_group);
+
+      count++;
+      Metrics::Gauge::increment(net_rsb.connections_currently_open);
+      h->accept_count.fetch_add(1, std::memory_order_relaxed);
+      if (h->numa_stats) {
+        Metrics::Counter::increment(h->numa_stats->connections_accepted);
+      }
+      vc->id = net_next_connection_number();
+      vc->con.move(con);
+      vc->set_remote_addr(con.addr);
+      vc->submit_time = ink_get_hrtime();
+      vc->action_     = *action_;
+      vc->set_is_transparent(opt.f_inbound_transparent);
+      vc->set_is_proxy_protocol(opt.f_proxy_protocol, opt.f_proxy_protocol_client_src);
+      vc->options.sockopt_flags        = opt.sockopt_flags;
+      vc->options.packet_mark          = opt.packet_mark;
+      vc->options.packet_tos           = opt.packet_tos;
+      vc->options.packet_notsent_lowat = opt.packet_notsent_lowat;
+      vc->options.ip_family            = opt.ip_family;
+      vc->apply_options();
+      vc->set_context(NET_VCONNECTION_IN);
+      if (opt.f_mptcp) {
+        vc->set_mptcp_state(); // Try to get the MPTCP state, and update accordingly
+      }
+
+#ifdef USE_EDGE_TRIGGER
+      // Set the vc as triggered and place it in the read ready queue later in case there is already data on the socket.
+      if (server.http_accept_filter) {
+        vc->read.triggered = 1;
+      }
+#endif
+      SET_CONTINUATION_HANDLER(vc, &UnixNetVConnection::acceptEvent);
+
+      // Assign NetHandler->mutex to NetVC
+      vc->mutex = h->mutex;
+      // We must be holding the lock already to do later do_io_read's
+      SCOPED_MUTEX_LOCK(lock, vc->mutex, e->ethread);
+      vc->handleEvent(EVENT_NONE, nullptr);
+      vc = nullptr;
+    }
+    if (n > 0) {
+      Metrics::Counter::increment(net_rsb.accept_batches);
     }
+
     // check return value from accept()
-    if (res < 0) {
-      Dbg(dbg_ctl_iocore_net, "received : %s", strerror(errno));
-      res = -errno;
+    if (n < want) {
+      Dbg(dbg_ctl_iocore_net, "received : %s", strerror(-res));
       if (res == -EAGAIN || res == -ECONNABORTED
 #if defined(__linux__)
           || res == -EPIPE
@@ -585,53 +761,14 @@ NetAccept::acceptFastEvent(int event, void *ep)
       }
       goto Lerror;
     }
-
-    vc = static_cast<UnixNetVConnection *>(this->getNetProcessor()->allocate_vc(e->ethread));
-    ink_release_assert(vc);
-    vc->enable_inbound_connection_tracking(conn_track_group);
-
-    count++;
-    Metrics::Gauge::increment(net_rsb.connections_currently_open);
-    vc->id = net_next_connection_number();
-    vc->con.move(con);
-    vc->set_remote_addr(con.addr);
-    vc->submit_time = ink_get_hrtime();
-    vc->action_     = *action_;
-    vc->set_is_transparent(opt.f_inbound_transparent);
-    vc->set_is_proxy_protocol(opt.f_proxy_protocol, opt.f_proxy_protocol_client_src);
-    vc->options.sockopt_flags        = opt.sockopt_flags;
-    vc->options.packet_mark          = opt.packet_mark;
-    vc->options.packet_tos           = opt.packet_tos;
-    vc->options.packet_notsent_lowat = opt.packet_notsent_lowat;
-    vc->options.ip_family            = opt.ip_family;
-    vc->apply_options();
-    vc->set_context(NET_VCONNECTION_IN);
-    if (opt.f_mptcp) {
-      vc->set_mptcp_state(); // Try to get the MPTCP state, and update accordingly
-    }
-
-#ifdef USE_EDGE_TRIGGER
-    // Set the vc as triggered and place it in the read ready queue later in case there is already data on the socket.
-    if (server.http_accept_filter) {
-      vc->read.triggered = 1;
-    }
-#endif
-    SET_CONTINUATION_HANDLER(vc, &UnixNetVConnection::acceptEvent);
-
-    // Assign NetHandler->mutex to NetVC
-    vc->mutex = h->mutex;
-    // We must be holding the lock already to do later do_io_read's
-    SCOPED_MUTEX_LOCK(lock, vc->mutex, e->ethread);
-    vc->handleEvent(EVENT_NONE, nullptr);
-    vc = nullptr;
-  } while (count < additional_accepts);
+  } while (taken < additional_accepts);
 
 Ldone:
   // if we stop looping as a result of hitting the accept limit,
   // resechedule accepting to the end of the thread event queue
   // for the goal of fairness between accepting and other work
-  Dbg(dbg_ctl_iocore_net_accepts, "exited accept loop - count: %d, limit: %d", count, additional_accepts);
-  if (count >= additional_accepts) {
+  Dbg(dbg_ctl_iocore_net_accepts, "exited accept loop - count: %d, taken: %d, limit: %d", count, taken, additional_accepts);
+  if (taken >= additional_accepts) {
     this_ethread()->schedule_imm_local(this);
   }
   return EVENT_CONT;
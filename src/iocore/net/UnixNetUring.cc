@@ -0,0 +1,419 @@
+/** @file
+
+  Socket I/O for UnixNetVConnection driven by the thread's io_uring.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_UnixNetUring.h"
+#include "P_Net.h"
+#include "P_UnixNet.h"
+#include "P_UnixNetVConnection.h"
+#include "P_UnixNetZeroCopy.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+DbgCtl dbg_ctl_net_uring{"net_uring"};
+
+// Stop receiving once this many provided buffers are waiting for the reader, so a connection the
+// state machine is not reading cannot hold on to the thread's buffers or lift TCP flow control.
+constexpr int64_t MAX_PENDING_BUFFERS = 8;
+
+// The completion of a cancel request carries nothing of interest.
+struct IgnoreCompletion : public IOUringCompletionHandler {
+  void
+  handle_complete(io_uring_cqe * /* cqe ATS_UNUSED */) override
+  {
+  }
+} ignore_completion;
+
+} // end anonymous namespace
+
+//
+// NetUringBufferRing
+//
+
+NetUringBufferRing *
+NetUringBufferRing::create(IOUringContext *ctx, unsigned entries, int64_t size_index)
+{
+  // The kernel wants a power of two.
+  unsigned n = 1;
+  while (n * 2 <= std::clamp(entries, 1u, 32768u)) {
+    n *= 2;
+  }
+  io_uring_buf_ring *br = ctx->setup_buf_ring(n, BUFFER_GROUP);
+  if (br == nullptr) {
+    return nullptr;
+  }
+  return new NetUringBufferRing(ctx, br, n, size_index);
+}
+
+NetUringBufferRing::NetUringBufferRing(IOUringContext *ctx, io_uring_buf_ring *br, unsigned entries, int64_t size_index)
+  : _ctx(ctx), _br(br), _entries(entries), _size_index(size_index), _slots(new Ptr<IOBufferData>[entries])
+{
+  for (unsigned bid = 0; bid < _entries; bid++) {
+    _provide(bid);
+  }
+  Dbg(dbg_ctl_net_uring, "provided %u buffers of %" PRId64 " bytes", _entries, buffer_size());
+}
+
+NetUringBufferRing::~NetUringBufferRing()
+{
+  _ctx->free_buf_ring(_br, _entries, BUFFER_GROUP);
+}
+
+void
+NetUringBufferRing::_provide(unsigned bid)
+{
+  _slots[bid] = new_IOBufferData(_size_index);
+  io_uring_buf_ring_add(_br, _slots[bid]->data(), _slots[bid]->block_size(), bid, io_uring_buf_ring_mask(_entries), 0);
+  io_uring_buf_ring_advance(_br, 1);
+}
+
+IOBufferBlock *
+NetUringBufferRing::take(unsigned bid, int len)
+{
+  ink_release_assert(bid < _entries);
+  IOBufferBlock *b = new_IOBufferBlock(_slots[bid], len, 0);
+  _provide(bid);
+  return b;
+}
+
+//
+// NetUringIO
+//
+
+thread_local std::vector<NetUringIO *> NetUringIO::_stalled_ios;
+
+NetUringIO::NetUringIO(UnixNetVConnection *vc, NetUringBufferRing *ring)
+  : _vc(vc), _ring(ring), _ctx(IOUringContext::local_context()), _fd(vc->get_fd())
+{
+  _recv_op.io = this;
+  _send_op.io = this;
+  _arm_recv();
+}
+
+bool
+NetUringIO::_want_recv() const
+{
+  return !_recv_armed && !_recv_eos && !_recv_error && !_recv_unsupported &&
+         _pending_bytes < MAX_PENDING_BUFFERS * _ring->buffer_size();
+}
+
+void
+NetUringIO::_arm_recv()
+{
+  io_uring_sqe *sqe = _ctx->next_sqe(&_recv_op);
+  if (sqe == nullptr) {
+    _retry_recv = true;
+    _stall();
+    return;
+  }
+  io_uring_prep_recv_multishot(sqe, _fd, nullptr, 0, 0);
+  sqe->flags      |= IOSQE_BUFFER_SELECT;
+  sqe->buf_group   = NetUringBufferRing::BUFFER_GROUP;
+  _recv_armed      = true;
+  _recv_cancelled  = false;
+}
+
+void
+NetUringIO::_cancel(IOUringCompletionHandler *op)
+{
+  io_uring_sqe *sqe = _ctx->next_sqe(&ignore_completion);
+  if (sqe == nullptr) {
+    (op == &_recv_op ? _retry_recv_cancel : _retry_send_cancel) = true;
+    _stall();
+    return;
+  }
+  io_uring_prep_cancel(sqe, op, 0);
+}
+
+void
+NetUringIO::_stall()
+{
+  Metrics::Counter::increment(net_rsb.uring_sq_full);
+  if (!_stalled) {
+    _stalled = true;
+    _stalled_ios.push_back(this);
+  }
+}
+
+void
+NetUringIO::retry_stalled()
+{
+  // A retry that stalls again queues itself for the next loop.
+  std::vector<NetUringIO *> ios;
+  ios.swap(_stalled_ios);
+  for (NetUringIO *io : ios) {
+    io->_stalled = false;
+    if (std::exchange(io->_retry_recv_cancel, false)) {
+      io->_cancel(&io->_recv_op);
+    }
+    if (std::exchange(io->_retry_send_cancel, false)) {
+      io->_cancel(&io->_send_op);
+    }
+    if (std::exchange(io->_retry_recv, false) && io->_vc != nullptr && io->_want_recv()) {
+      io->_arm_recv();
+    }
+    if (std::exchange(io->_retry_send, false)) {
+      io->_trigger_write();
+    }
+    io->_free_if_idle();
+  }
+}
+
+void
+NetUringIO::_trigger_read()
+{
+  if (_vc == nullptr || _vc->nh == nullptr) {
+    return;
+  }
+  _vc->read.triggered = 1;
+  if (!_vc->nh->read_ready_list.in(_vc)) {
+    _vc->nh->read_ready_list.enqueue(_vc);
+  }
+}
+
+void
+NetUringIO::_trigger_write()
+{
+  if (_vc == nullptr || _vc->nh == nullptr) {
+    return;
+  }
+  _vc->write.triggered = 1;
+  if (!_vc->nh->write_ready_list.in(_vc)) {
+    _vc->nh->write_ready_list.enqueue(_vc);
+  }
+}
+
+void
+NetUringIO::_recv_complete(io_uring_cqe *cqe)
+{
+  if (!(cqe->flags & IORING_CQE_F_MORE)) {
+    _recv_armed = false;
+  }
+  Metrics::Counter::increment(net_rsb.uring_recv_completions);
+
+  if (cqe->flags & IORING_CQE_F_BUFFER) {
+    IOBufferBlock *b = _ring->take(cqe->flags >> IORING_CQE_BUFFER_SHIFT, std::max(cqe->res, 0));
+    if (_vc == nullptr || cqe->res <= 0) {
+      b->free();
+    } else {
+      if (_pending_tail) {
+        _pending_tail->next = b;
+      } else {
+        _pending = b;
+      }
+      _pending_tail   = b;
+      _pending_bytes += cqe->res;
+      if (_recv_armed && !_recv_cancelled && _pending_bytes >= MAX_PENDING_BUFFERS * _ring->buffer_size()) {
+        _cancel(&_recv_op);
+        _recv_cancelled = true;
+      }
+    }
+  }
+
+  if (cqe->res == 0) {
+    _recv_eos = true;
+  } else if (cqe->res == -ENOBUFS) {
+    // The ring ran dry within one batch of completions; it is refilled, receive again.
+    Metrics::Counter::increment(net_rsb.uring_recv_buffers_exhausted);
+  } else if (cqe->res == -EINVAL || cqe->res == -EOPNOTSUPP) {
+    // A kernel without multishot receive.
+    Dbg(dbg_ctl_net_uring, "multishot recv not supported on fd %d, using readv", _fd);
+    _recv_unsupported = true;
+  } else if (cqe->res < 0 && cqe->res != -ECANCELED) {
+    _recv_error = -cqe->res;
+  }
+
+  _trigger_read();
+  _free_if_idle();
+}
+
+int64_t
+NetUringIO::recv(MIOBuffer *writer, int64_t toread)
+{
+  int64_t moved = 0;
+  while (_pending && moved < toread) {
+    IOBufferBlock *b     = _pending.get();
+    int64_t        avail = b->read_avail();
+    if (avail <= toread - moved) {
+      // Hand the whole block over.
+      Ptr<IOBufferBlock> next = b->next;
+      b->next                 = nullptr;
+      writer->append_block(b);
+      _pending = next;
+      if (!_pending) {
+        _pending_tail = nullptr;
+      }
+      moved += avail;
+    } else {
+      IOBufferBlock *part = b->clone();
+      part->_end          = part->_start + (toread - moved);
+      part->_buf_end      = part->_end;
+      writer->append_block(part);
+      b->consume(toread - moved);
+      moved = toread;
+    }
+  }
+  _pending_bytes -= moved;
+
+  if (_want_recv()) {
+    _arm_recv();
+  }
+
+  if (moved > 0) {
+    return moved;
+  }
+  if (_recv_error) {
+    return -_recv_error;
+  }
+  if (_recv_eos) {
+    return 0;
+  }
+  return -EAGAIN;
+}
+
+void
+NetUringIO::_submit_send(IOBufferReader *reader, int64_t skip, int64_t towrite)
+{
+  IOBufferReader *tmp_reader = reader->clone();
+  tmp_reader->consume(skip);
+
+  unsigned niov         = 0;
+  int64_t  try_to_write = 0;
+  _send_blocks          = tmp_reader->get_current_block();
+  IOBufferBlock *first  = _send_blocks.get();
+  while (niov < NET_MAX_IOV && try_to_write < towrite) {
+    int64_t len = std::min(tmp_reader->block_read_avail(), towrite - try_to_write);
+    if (len <= 0) {
+      break;
+    }
+    _send_iov[niov].iov_base  = tmp_reader->start();
+    _send_iov[niov].iov_len   = len;
+    try_to_write             += len;
+    tmp_reader->consume(len);
+    niov++;
+  }
+  tmp_reader->dealloc();
+
+  if (niov == 0) {
+    _send_blocks = nullptr;
+    return;
+  }
+  io_uring_sqe *sqe = _ctx->next_sqe(&_send_op);
+  if (sqe == nullptr) {
+    _send_blocks = nullptr;
+    _retry_send  = true;
+    _stall();
+    return;
+  }
+  ink_zero(_send_msg);
+  _send_msg.msg_iov    = _send_iov;
+  _send_msg.msg_iovlen = niov;
+  _send_zc             = NetZeroCopy::wanted(try_to_write) && _ctx->supports_op(IORING_OP_SENDMSG_ZC);
+  if (_send_zc) {
+    io_uring_prep_sendmsg_zc(sqe, _fd, &_send_msg, 0);
+    _zc_sends.push_back({make_ptr(NetZeroCopy::hold(first, niov)), ink_get_hrtime()});
+  } else {
+    io_uring_prep_sendmsg(sqe, _fd, &_send_msg, 0);
+  }
+  _send_in_flight = true;
+  Metrics::Counter::increment(net_rsb.calls_to_write);
+}
+
+void
+NetUringIO::_send_complete(io_uring_cqe *cqe)
+{
+  if (cqe->flags & IORING_CQE_F_NOTIF) {
+    // The kernel is done with the pages of the oldest zero copy send.
+    Metrics::Counter::increment(net_rsb.zerocopy_completions);
+    Metrics::Counter::increment(net_rsb.zerocopy_completion_time, (ink_get_hrtime() - _zc_sends.front().sent_at) / HRTIME_USECOND);
+#ifdef IORING_NOTIF_USAGE_ZC_COPIED
+    if (cqe->res & IORING_NOTIF_USAGE_ZC_COPIED) {
+      Metrics::Counter::increment(net_rsb.zerocopy_fallbacks);
+    }
+#endif
+    _zc_sends.pop_front();
+    _free_if_idle();
+    return;
+  }
+  if (_send_zc) {
+    if (cqe->flags & IORING_CQE_F_MORE) {
+      Metrics::Counter::increment(net_rsb.zerocopy_bytes, std::max(cqe->res, 0));
+    } else {
+      _zc_sends.pop_back(); // failed, no notification follows
+    }
+    _send_zc = false;
+  }
+  Metrics::Counter::increment(net_rsb.uring_send_completions);
+  _send_in_flight = false;
+  _send_done      = true;
+  _send_result    = cqe->res;
+  _send_blocks    = nullptr;
+  _trigger_write();
+  _free_if_idle();
+}
+
+int64_t
+NetUringIO::send(IOBufferReader *reader, int64_t towrite)
+{
+  if (_send_in_flight) {
+    return -EAGAIN;
+  }
+  if (!_send_done) {
+    _submit_send(reader, 0, towrite);
+    return -EAGAIN;
+  }
+
+  // Keep the socket busy: queue what is left before reporting what was written.
+  int64_t r  = _send_result;
+  _send_done = false;
+  if (r > 0 && r < towrite) {
+    _submit_send(reader, r, towrite - r);
+  }
+  return r;
+}
+
+void
+NetUringIO::detach()
+{
+  _vc           = nullptr;
+  _pending      = nullptr;
+  _pending_tail = nullptr;
+  if (_recv_armed && !_recv_cancelled) {
+    _cancel(&_recv_op);
+    _recv_cancelled = true;
+  }
+  if (_send_in_flight) {
+    _cancel(&_send_op);
+  }
+  _free_if_idle();
+}
+
+void
+NetUringIO::_free_if_idle()
+{
+  if (_vc == nullptr && !_recv_armed && !_send_in_flight && _zc_sends.empty() && !_stalled) {
+    delete this;
+  }
+}
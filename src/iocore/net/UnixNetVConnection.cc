@@ -25,6 +25,8 @@
 #include "P_NetAccept.h"
 #include "P_UnixNet.h"
 #include "P_UnixNetVConnection.h"
+#include "P_UnixNetUring.h"
+#include "P_UnixNetZeroCopy.h"
 #include "iocore/net/ConnectionTracker.h"
 #include "iocore/net/NetHandler.h"
 #include "ts/ats_probe.h"
@@ -35,6 +37,11 @@
 #include <termios.h>
 #include <utility>
 
+#if __has_include(<sys/sendfile.h>)
+#include <sys/sendfile.h>
+#define HAVE_LINUX_SENDFILE 1
+#endif
+
 #define STATE_VIO_OFFSET   ((uintptr_t) & ((NetState *)0)->vio)
 #define STATE_FROM_VIO(_x) ((NetState *)(((char *)(_x)) - STATE_VIO_OFFSET))
 
@@ -291,6 +298,9 @@ UnixNetVConnection::do_io_close(int alerrno /* = -1 */)
     } else {
       this->free_thread(t);
     }
+  } else if (nh) {
+    // Have the cop free it on its next run instead of at the next timeout check.
+    nh->update_cop(this);
   }
 }
 
@@ -382,9 +392,9 @@ UnixNetVConnection::reenable(VIO *vio)
         }
       }
       if (likely(nh->thread)) {
-        nh->thread->tail_cb->signalActivity();
+        nh->thread->wake();
       } else if (nh->trigger_event) {
-        nh->trigger_event->ethread->tail_cb->signalActivity();
+        nh->trigger_event->ethread->wake();
       }
     } else {
       if (vio == &read.vio) {
@@ -453,8 +463,12 @@ UnixNetVConnection::set_enabled(VIO *vio)
   ink_assert(vio->mutex->thread_holding == this_ethread() && thread);
   ink_release_assert(!closed);
   STATE_FROM_VIO(vio)->enabled = 1;
-  if (!next_inactivity_timeout_at && inactivity_timeout_in) {
-    next_inactivity_timeout_at = ink_get_hrtime() + inactivity_timeout_in;
+  if (!next_inactivity_timeout_at) {
+    // Either way there is a timeout to run, the explicit one or the default.
+    if (inactivity_timeout_in) {
+      next_inactivity_timeout_at = ink_get_hrtime() + inactivity_timeout_in;
+    }
+    timeouts_changed();
   }
 }
 
@@ -502,56 +516,9 @@ UnixNetVConnection::net_read_io(NetHandler *nh)
   }
 
   // read data
-  int64_t  rattempted = 0, total_read = 0;
-  unsigned niov = 0;
-  IOVec    tiovec[NET_MAX_IOV];
   if (toread) {
-    IOBufferBlock *b = buf.writer()->first_write_block();
-    do {
-      niov       = 0;
-      rattempted = 0;
-      while (b && niov < NET_MAX_IOV) {
-        int64_t a = b->write_avail();
-        if (a > 0) {
-          tiovec[niov].iov_base = b->_end;
-          int64_t togo          = toread - total_read - rattempted;
-          if (a > togo) {
-            a = togo;
-          }
-          tiovec[niov].iov_len  = a;
-          rattempted           += a;
-          niov++;
-          if (a >= togo) {
-            break;
-          }
-        }
-        b = b->next.get();
-      }
-
-      ink_assert(niov > 0);
-      ink_assert(niov <= countof(tiovec));
-      struct msghdr msg;
-
-      ink_zero(msg);
-      msg.msg_name    = const_cast<sockaddr *>(this->get_remote_addr());
-      msg.msg_namelen = ats_ip_size(this->get_remote_addr());
-      msg.msg_iov     = &tiovec[0];
-      msg.msg_iovlen  = niov;
-      r               = this->con.sock.recvmsg(&msg, 0);
-
-      Metrics::Counter::increment(net_rsb.calls_to_read);
+    r = this->_read_from_net(buf.writer(), toread);
 
-      total_read += rattempted;
-    } while (rattempted && r == rattempted && total_read < toread);
-
-    // if we have already moved some bytes successfully, summarize in r
-    if (total_read != rattempted) {
-      if (r <= 0) {
-        r = total_read - rattempted;
-      } else {
-        r = total_read - rattempted + r;
-      }
-    }
     // check for errors
     if (r <= 0) {
       if (r == -EAGAIN || r == -ENOTCONN) {
@@ -573,9 +540,10 @@ UnixNetVConnection::net_read_io(NetHandler *nh)
     }
     Metrics::Counter::increment(net_rsb.read_bytes, r);
     Metrics::Counter::increment(net_rsb.read_bytes_count);
+    if (nh->numa_stats) {
+      Metrics::Counter::increment(nh->numa_stats->read_bytes, r);
+    }
 
-    // Add data to buffer and signal continuation.
-    buf.writer()->fill(r);
 #ifdef DEBUG
     if (buf.writer()->write_avail() <= 0) {
       Dbg(dbg_ctl_iocore_net, "read_from_net, read buffer full");
@@ -618,6 +586,77 @@ UnixNetVConnection::net_read_io(NetHandler *nh)
   read_reschedule(nh, this);
 }
 
+// Read up to @a toread bytes from the socket into @a writer, as one or more
+// readv, or by taking what the io_uring receive has queued. Returns the number
+// of bytes read, 0 at end of stream, or a negative errno.
+int64_t
+UnixNetVConnection::_read_from_net(MIOBuffer *writer, int64_t toread)
+{
+#if TS_USE_LINUX_IO_URING
+  if (this->uring_io && this->uring_io->can_recv()) {
+    return this->uring_io->recv(writer, toread);
+  }
+#endif
+
+  int64_t  r          = 0;
+  int64_t  rattempted = 0, total_read = 0;
+  unsigned niov = 0;
+  IOVec    tiovec[NET_MAX_IOV];
+
+  IOBufferBlock *b = writer->first_write_block();
+  do {
+    niov       = 0;
+    rattempted = 0;
+    while (b && niov < NET_MAX_IOV) {
+      int64_t a = b->write_avail();
+      if (a > 0) {
+        tiovec[niov].iov_base = b->_end;
+        int64_t togo          = toread - total_read - rattempted;
+        if (a > togo) {
+          a = togo;
+        }
+        tiovec[niov].iov_len  = a;
+        rattempted           += a;
+        niov++;
+        if (a >= togo) {
+          break;
+        }
+      }
+      b = b->next.get();
+    }
+
+    ink_assert(niov > 0);
+    ink_assert(niov <= countof(tiovec));
+    struct msghdr msg;
+
+    ink_zero(msg);
+    msg.msg_name    = const_cast<sockaddr *>(this->get_remote_addr());
+    msg.msg_namelen = ats_ip_size(this->get_remote_addr());
+    msg.msg_iov     = &tiovec[0];
+    msg.msg_iovlen  = niov;
+    r               = this->con.sock.recvmsg(&msg, 0);
+
+    Metrics::Counter::increment(net_rsb.calls_to_read);
+
+    total_read += rattempted;
+  } while (rattempted && r == rattempted && total_read < toread);
+
+  // if we have already moved some bytes successfully, summarize in r
+  if (total_read != rattempted) {
+    if (r <= 0) {
+      r = total_read - rattempted;
+    } else {
+      r = total_read - rattempted + r;
+    }
+  }
+
+  // Add data to buffer
+  if (r > 0) {
+    writer->fill(r);
+  }
+  return r;
+}
+
 //
 // Write the data for a UnixNetVConnection.
 // Rescheduling the UnixNetVConnection when necessary.
@@ -715,6 +754,9 @@ UnixNetVConnection::net_write_io(NetHandler *nh)
   if (total_written > 0) {
     Metrics::Counter::increment(net_rsb.write_bytes, total_written);
     Metrics::Counter::increment(net_rsb.write_bytes_count);
+    if (nh->numa_stats) {
+      Metrics::Counter::increment(nh->numa_stats->write_bytes, total_written);
+    }
     s->vio.ndone += total_written;
     ATS_PROBE4(net_sock_write, this->get_fd(), total_written, s->vio.ndone, s->vio.nbytes);
     this->netActivity();
@@ -805,14 +847,45 @@ UnixNetVConnection::net_write_io(NetHandler *nh)
 int64_t
 UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &buf, int64_t &total_written, int &needs)
 {
+#if TS_USE_LINUX_IO_URING
+  if (this->uring_io) {
+    // The send completes asynchronously; this reports the previous one and queues the next.
+    int64_t r = this->uring_io->send(buf.reader(), towrite);
+    if (r > 0) {
+      buf.reader()->consume(r);
+      total_written += r;
+    }
+    needs |= EVENTIO_WRITE;
+    return r;
+  }
+#endif
+
   int64_t         r            = 0;
   int64_t         try_to_write = 0;
   IOBufferReader *tmp_reader   = buf.reader()->clone();
 
+  if (this->zero_copy && this->zero_copy->busy()) {
+    this->zero_copy->reap(this->get_fd());
+  }
+
   do {
-    IOVec    tiovec[NET_MAX_IOV];
-    unsigned niov = 0;
-    try_to_write  = 0;
+    IOVec          tiovec[NET_MAX_IOV];
+    unsigned       niov  = 0;
+    IOBufferBlock *first = tmp_reader->get_current_block();
+    try_to_write         = 0;
+
+    // A file range goes to the kernel on its own, without passing through user space.
+    if (tmp_reader->block_read_avail() > 0 && tmp_reader->get_current_block()->file_range()) {
+      try_to_write = std::min(tmp_reader->block_read_avail(), towrite - total_written);
+      r            = this->_send_file_range(tmp_reader, try_to_write);
+      if (r > 0) {
+        buf.reader()->consume(r);
+        total_written += r;
+      }
+      tmp_reader->consume(try_to_write);
+      Metrics::Counter::increment(net_rsb.calls_to_write);
+      continue;
+    }
 
     while (niov < NET_MAX_IOV) {
       int64_t wavail = towrite - total_written - try_to_write;
@@ -823,6 +896,11 @@ UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &bu
         break;
       }
 
+      // Leave a file range to the next round.
+      if (tmp_reader->get_current_block()->file_range()) {
+        break;
+      }
+
       // Check if the amount to write exceeds that in this buffer.
       if (len > wavail) {
         len = wavail;
@@ -862,7 +940,17 @@ UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &bu
       Metrics::Counter::increment(net_rsb.fastopen_attempts);
       flags = MSG_FASTOPEN;
     }
+    bool zero_copy = flags == 0 && NetZeroCopy::wanted(try_to_write) && this->_start_zero_copy();
+    if (zero_copy) {
+      flags |= NetZeroCopy::SEND_FLAG;
+    }
     r = con.sock.sendmsg(&msg, flags);
+    if (zero_copy && r == -ENOBUFS) {
+      // No socket memory left to track the send, copy this one.
+      Metrics::Counter::increment(net_rsb.zerocopy_fallbacks);
+      zero_copy = false;
+      r         = con.sock.sendmsg(&msg, 0);
+    }
     if (!this->con.is_connected && this->options.f_tcp_fastopen) {
       if (r < 0) {
         if (r == -EINPROGRESS || r == -EWOULDBLOCK) {
@@ -875,6 +963,9 @@ UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &bu
     }
 
     if (r > 0) {
+      if (zero_copy) {
+        this->zero_copy->sent(first, niov, r);
+      }
       buf.reader()->consume(r);
       total_written += r;
     }
@@ -963,6 +1054,69 @@ UnixNetVConnection::startEvent(int /* event ATS_UNUSED */, Event *e)
   return EVENT_DONE;
 }
 
+bool
+UnixNetVConnection::_start_zero_copy()
+{
+  if (this->zero_copy == nullptr) {
+    this->zero_copy = new NetZeroCopy;
+    this->zero_copy->enable(this->get_fd());
+  }
+  return this->zero_copy->enabled();
+}
+
+bool
+UnixNetVConnection::supports_sendfile() const
+{
+#ifdef HAVE_LINUX_SENDFILE
+  // The io_uring data path only sends memory.
+  return this->uring_io == nullptr;
+#else
+  return false;
+#endif
+}
+
+int64_t
+UnixNetVConnection::_send_file_range(IOBufferReader *reader, int64_t len)
+{
+#ifdef HAVE_LINUX_SENDFILE
+  IOBufferFileRange *range = reader->get_current_block()->file_range();
+  off_t              off   = range->file_offset(reader->start());
+
+  if (!range->still_valid()) {
+    Metrics::Counter::increment(net_rsb.sendfile_aborts);
+    return -EIO;
+  }
+  int64_t r = ::sendfile(this->get_fd(), range->fd(), &off, len);
+  Metrics::Counter::increment(net_rsb.sendfile_calls);
+  if (r <= 0) {
+    return r < 0 ? -errno : -EIO;
+  }
+  // If the space was reused while the kernel read it the client got the wrong bytes. Cut the
+  // response short rather than go on.
+  if (!range->still_valid()) {
+    Metrics::Counter::increment(net_rsb.sendfile_aborts);
+    return -EIO;
+  }
+  Metrics::Counter::increment(net_rsb.sendfile_bytes, r);
+  return r;
+#else
+  (void)reader;
+  (void)len;
+  ink_release_assert(!"sendfile is not supported on this platform");
+  return -ENOTSUP;
+#endif
+}
+
+void
+UnixNetVConnection::_start_uring_io()
+{
+#if TS_USE_LINUX_IO_URING
+  if (NetHandler::uring_data_path && nh->uring_buffers && this->_canUseUringDataPath()) {
+    uring_io = new NetUringIO(this, nh->uring_buffers);
+  }
+#endif
+}
+
 int
 UnixNetVConnection::acceptEvent(int /* event ATS_UNUSED */, Event *e)
 {
@@ -976,6 +1130,7 @@ UnixNetVConnection::acceptEvent(int /* event ATS_UNUSED */, Event *e)
     this->free_thread(t);
     return EVENT_DONE;
   }
+  this->_start_uring_io();
 
   // Switch vc->mutex from NetHandler->mutex to new mutex
   mutex = new_ProxyMutex();
@@ -1241,6 +1396,16 @@ UnixNetVConnection::clear()
   ink_assert(!link.next && !link.prev);
 }
 
+// Zero copy completions arrive on the error queue, reap them here so an idle
+// connection does not hold on to the blocks of its last send.
+void
+UnixNetVConnection::error_queue_ready()
+{
+  if (this->zero_copy && this->zero_copy->busy()) {
+    this->zero_copy->reap(this->get_fd());
+  }
+}
+
 void
 UnixNetVConnection::free_thread(EThread *t)
 {
@@ -1253,6 +1418,17 @@ UnixNetVConnection::free_thread(EThread *t)
     release_inbound_connection_tracking();
     Metrics::Gauge::decrement(net_rsb.connections_currently_open);
   }
+#if TS_USE_LINUX_IO_URING
+  if (uring_io) {
+    uring_io->detach();
+    uring_io = nullptr;
+  }
+#endif
+  if (zero_copy) {
+    zero_copy->retire(get_fd());
+    delete zero_copy;
+    zero_copy = nullptr;
+  }
   con.close();
 
   if (is_tunnel_endpoint()) {
@@ -1294,6 +1470,7 @@ UnixNetVConnection::set_inactivity_timeout(ink_hrtime timeout_in)
   Dbg(dbg_ctl_socket, "Set inactive timeout=%" PRId64 ", for NetVC=%p", timeout_in, this);
   inactivity_timeout_in      = timeout_in;
   next_inactivity_timeout_at = (timeout_in > 0) ? ink_get_hrtime() + inactivity_timeout_in : 0;
+  timeouts_changed();
 }
 
 TS_INLINE void
@@ -1344,6 +1521,9 @@ UnixNetVConnection::migrateToCurrentThread(Continuation *cont, EThread *t)
   if (newvc) {
     newvc->set_context(get_context());
     newvc->options = this->options;
+    // The kernel numbers zero copy sends per socket, so the count goes with it.
+    newvc->zero_copy = this->zero_copy;
+    this->zero_copy  = nullptr;
   }
 
   // Do not mark this closed until the end so it does not get freed by the other thread too soon
@@ -0,0 +1,171 @@
+/** @file
+
+  Zero copy sends for UnixNetVConnection.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_Net.h"
+#include "P_UnixNetZeroCopy.h"
+#include "tscore/Diags.h"
+#include "tscore/ink_memory.h"
+
+#include <netinet/in.h>
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+#include <linux/errqueue.h>
+#endif
+
+int64_t NetZeroCopy::threshold = 0;
+
+namespace
+{
+DbgCtl dbg_ctl_net_zerocopy{"net_zerocopy"};
+
+// How long the blocks of a closed socket are held. The kernel cannot report on a closed socket,
+// so this has to outlast the transmission of what was still in its send buffer.
+constexpr ink_hrtime RETIRE_GRACE = HRTIME_SECONDS(30);
+
+struct Retired {
+  ink_hrtime         release_at;
+  Ptr<IOBufferBlock> blocks;
+};
+
+thread_local std::deque<Retired> retired;
+
+} // end anonymous namespace
+
+IOBufferBlock *
+NetZeroCopy::hold(IOBufferBlock *first, int nblocks)
+{
+  // Clone the blocks rather than keep @a first, whose chain reaches every block later appended to
+  // the buffer.
+  IOBufferBlock *head = nullptr;
+  IOBufferBlock *tail = nullptr;
+  for (IOBufferBlock *b = first; b && nblocks > 0; b = b->next.get()) {
+    if (b->read_avail() <= 0) {
+      continue;
+    }
+    IOBufferBlock *c = b->clone();
+    if (tail) {
+      tail->next = c;
+    } else {
+      head = c;
+    }
+    tail = c;
+    --nblocks;
+  }
+  return head;
+}
+
+bool
+NetZeroCopy::enable(int fd)
+{
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+  int one = 1;
+  if (setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) == 0) {
+    _enabled = true;
+    return true;
+  }
+  Dbg(dbg_ctl_net_zerocopy, "SO_ZEROCOPY refused on fd %d: %s", fd, strerror(errno));
+#else
+  (void)fd;
+#endif
+  Metrics::Counter::increment(net_rsb.zerocopy_fallbacks);
+  return false;
+}
+
+void
+NetZeroCopy::sent(IOBufferBlock *first, int nblocks, int64_t len)
+{
+  _pinned.push_back({_next_id++, make_ptr(hold(first, nblocks)), ink_get_hrtime()});
+  Metrics::Counter::increment(net_rsb.zerocopy_bytes, len);
+}
+
+void
+NetZeroCopy::_complete(uint32_t hi, bool copied)
+{
+  ink_hrtime now = ink_get_hrtime();
+  // TCP reports completions in order, so everything up to @a hi is done.
+  while (!_pinned.empty() && static_cast<int32_t>(_pinned.front().id - hi) <= 0) {
+    Metrics::Counter::increment(net_rsb.zerocopy_completions);
+    Metrics::Counter::increment(net_rsb.zerocopy_completion_time, (now - _pinned.front().sent_at) / HRTIME_USECOND);
+    if (copied) {
+      Metrics::Counter::increment(net_rsb.zerocopy_fallbacks);
+    }
+    _pinned.pop_front();
+  }
+}
+
+void
+NetZeroCopy::reap(int fd)
+{
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+  while (!_pinned.empty()) {
+    char   control[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+    msghdr msg;
+    ink_zero(msg);
+    msg.msg_control    = control;
+    msg.msg_controllen = sizeof(control);
+    if (recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+      break; // nothing more to report
+    }
+    for (cmsghdr *cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+      if (!((cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR) ||
+            (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR))) {
+        continue;
+      }
+      auto *err = reinterpret_cast<sock_extended_err *>(CMSG_DATA(cm));
+      if (err->ee_origin != SO_EE_ORIGIN_ZEROCOPY || err->ee_errno != 0) {
+        continue;
+      }
+      // The kernel copied after all, e.g. for a device without scatter-gather.
+      _complete(err->ee_data, err->ee_code & SO_EE_CODE_ZEROCOPY_COPIED);
+    }
+  }
+#else
+  (void)fd;
+#endif
+}
+
+void
+NetZeroCopy::retire(int fd)
+{
+  reap(fd);
+  if (_pinned.empty()) {
+    return;
+  }
+  Dbg(dbg_ctl_net_zerocopy, "fd %d closed with %zu sends in flight", fd, _pinned.size());
+  ink_hrtime release_at = ink_get_hrtime() + RETIRE_GRACE;
+  for (auto &p : _pinned) {
+    retired.push_back({release_at, std::move(p.blocks)});
+  }
+  _pinned.clear();
+}
+
+void
+NetZeroCopy::release_retired()
+{
+  if (retired.empty()) {
+    return;
+  }
+  ink_hrtime now = ink_get_hrtime();
+  while (!retired.empty() && retired.front().release_at <= now) {
+    retired.pop_front();
+  }
+}
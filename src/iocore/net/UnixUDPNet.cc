@@ -1867,6 +1867,7 @@ UDPNetHandler::waitForActivity(ink_hrtime timeout)
   UnixUDPConnection *uc;
   PollCont          *pc = get_UDPPollCont(this->thread);
   pc->do_poll(timeout);
+  this->thread->EventQueueExternal.finish_sleep();
 
   /* Notice: the race between traversal of newconn_list and UDPBind()
    *
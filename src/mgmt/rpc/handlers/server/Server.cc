@@ -20,13 +20,18 @@
 
 #include "../../../../iocore/cache/P_CacheDir.h"
 #include "iocore/eventsystem/EventProcessor.h"
+#include "iocore/eventsystem/LoopProfiler.h"
+#include "iocore/eventsystem/Watchdog.h"
 #include "iocore/net/ConnectionTracker.h"
 #include "mgmt/rpc/handlers/server/Server.h"
 #include "mgmt/rpc/handlers/common/ErrorUtils.h"
 #include "mgmt/rpc/handlers/common/Utils.h"
 #include "tscore/TSSystemState.h"
+#include "tscore/ink_stack_trace.h"
 #include "tsutil/Metrics.h"
 
+#include <map>
+
 namespace
 {
 DbgCtl dbg_ctl_rpc_server{"rpc.server"};
@@ -218,6 +223,132 @@ get_server_status(std::string_view const & /* params ATS_UNUSED */, YAML::Node c
   return resp;
 }
 
+swoc::Rv<YAML::Node>
+get_event_loop_profile(std::string_view const & /* id ATS_UNUSED */, YAML::Node const &params)
+{
+  swoc::Rv<YAML::Node> resp;
+  try {
+    size_t top = LoopProfiler::TABLE_SIZE;
+    if (params.IsMap() && params["top"]) {
+      top = params["top"].as<size_t>();
+    }
+
+    // Names are looked up once per site, which is the slow part.
+    std::map<uintptr_t, std::string> names;
+    auto name_of = [&names](uintptr_t site) -> std::string const & {
+      auto spot = names.find(site);
+      if (spot == names.end()) {
+        spot = names.emplace(site, LoopProfiler::describe(site)).first;
+      }
+      return spot->second;
+    };
+    auto site_node = [&name_of](LoopProfiler::Site const &site, ink_hrtime thread_total) -> YAML::Node {
+      YAML::Node node;
+      node["handler"]  = name_of(site.site);
+      node["samples"]  = site.samples;
+      node["total_us"] = ink_hrtime_to_usec(site.total);
+      node["max_us"]   = ink_hrtime_to_usec(site.max);
+      node["error_us"] = ink_hrtime_to_usec(site.error);
+      node["percent"]  = thread_total > 0 ? 100.0 * site.total / thread_total : 0.0;
+      return node;
+    };
+
+    YAML::Node                              threads;
+    std::map<uintptr_t, LoopProfiler::Site> merged;
+    ink_hrtime                              all_total = 0;
+    for (int type = 0; type < eventProcessor.n_thread_groups; ++type) {
+      auto const &tg = eventProcessor.thread_group[type];
+      for (int i = 0; i < tg._count; ++i) {
+        EThread *t = tg._thread[i];
+        if (t == nullptr || !t->profiler) {
+          continue;
+        }
+        auto       sites = t->profiler->snapshot();
+        ink_hrtime total = t->profiler->total();
+        if (sites.empty()) {
+          continue;
+        }
+        YAML::Node thread;
+        thread["name"]     = tg._name + " " + std::to_string(i);
+        thread["total_us"] = ink_hrtime_to_usec(total);
+        YAML::Node list{YAML::NodeType::Sequence};
+        for (size_t n = 0; n < sites.size(); ++n) {
+          if (n < top) {
+            list.push_back(site_node(sites[n], total));
+          }
+          auto &m    = merged[sites[n].site];
+          m.site     = sites[n].site;
+          m.samples += sites[n].samples;
+          m.total   += sites[n].total;
+          m.error   += sites[n].error;
+          m.max      = std::max(m.max, sites[n].max);
+        }
+        thread["sites"] = list;
+        threads.push_back(thread);
+        all_total += total;
+      }
+    }
+
+    std::vector<LoopProfiler::Site> all;
+    for (auto const &[site, m] : merged) {
+      all.push_back(m);
+    }
+    std::sort(all.begin(), all.end(), [](auto const &a, auto const &b) { return a.total > b.total; });
+    YAML::Node list{YAML::NodeType::Sequence};
+    for (size_t n = 0; n < std::min(top, all.size()); ++n) {
+      list.push_back(site_node(all[n], all_total));
+    }
+
+    YAML::Node data;
+    data["sample_period"] = LoopProfiler::sample_period.load();
+    data["total_us"]      = ink_hrtime_to_usec(all_total);
+    data["sites"]         = list;
+    data["threads"]       = threads.IsNull() ? YAML::Node{YAML::NodeType::Sequence} : threads;
+
+    resp.result()["data"] = data;
+  } catch (std::exception const &ex) {
+    resp.errata()
+      .assign(std::error_code{errors::Codes::SERVER})
+      .note("Error found when calling get_event_loop_profile API: {}", ex.what());
+  }
+  return resp;
+}
+
+swoc::Rv<YAML::Node>
+get_thread_stalls(std::string_view const & /* id ATS_UNUSED */, YAML::Node const & /* params ATS_UNUSED */)
+{
+  swoc::Rv<YAML::Node> resp;
+  try {
+    auto &log = Watchdog::stall_log();
+
+    YAML::Node stalls{YAML::NodeType::Sequence};
+    for (auto const &stall : log.stalls()) {
+      YAML::Node node;
+      node["thread"]   = stall.thread;
+      node["time_ms"]  = std::chrono::duration_cast<std::chrono::milliseconds>(stall.when.time_since_epoch()).count();
+      node["awake_ms"] = stall.awake.count();
+      node["loop"]     = stall.seq;
+      YAML::Node frames{YAML::NodeType::Sequence};
+      for (auto frame : stall.frames) {
+        frames.push_back(ink_stack_trace_symbol(frame));
+      }
+      node["frames"] = frames;
+      stalls.push_back(node);
+    }
+
+    YAML::Node data;
+    data["capacity"]      = log.capacity();
+    data["total"]         = log.total();
+    data["stalls"]        = stalls;
+    resp.result()["data"] = data;
+  } catch (std::exception const &ex) {
+    resp.errata()
+      .assign(std::error_code{errors::Codes::SERVER})
+      .note("Error found when calling get_thread_stalls API: {}", ex.what());
+  }
+  return resp;
+}
+
 swoc::Rv<YAML::Node>
 get_connection_tracker_info(std::string_view const & /* params ATS_UNUSED */, YAML::Node const &params)
 {
@@ -187,6 +187,13 @@ ProxySession::is_chunked_encoding_supported() const
   return false;
 }
 
+// Override if the session writes response bodies to its netvc unchanged.
+bool
+ProxySession::supports_sendfile() const
+{
+  return false;
+}
+
 // Override if your session protocol cares.
 void
 ProxySession::set_half_close_flag(bool /* flag ATS_UNUSED */)
@@ -0,0 +1,77 @@
+/** @file
+
+  Extensible prioritization of HTTP responses, RFC 9218.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "proxy/hdrs/HttpPriority.h"
+#include "proxy/hdrs/HTTP.h"
+
+using namespace std::literals;
+
+namespace
+{
+constexpr std::string_view PRIORITY_FIELD = "priority"sv;
+
+bool
+is_ows(char c)
+{
+  return c == ' ' || c == '\t';
+}
+} // namespace
+
+void
+HttpPriority::parse(swoc::TextView text)
+{
+  // The field is a Structured Field Dictionary, [RFC 8941] 3.2. Only the members this needs are
+  // looked at, the parameters of a member are skipped.
+  while (text.trim_if(&is_ows)) {
+    swoc::TextView item  = text.take_prefix_at(',').trim_if(&is_ows).take_prefix_at(';');
+    swoc::TextView key   = item.take_prefix_at('=');
+    swoc::TextView value = item;
+
+    if (key == "u"sv) {
+      // An Integer, [RFC 8941] 3.3.1.
+      swoc::TextView parsed;
+      intmax_t       n = swoc::svtoi(value, &parsed, 10);
+      if (!value.empty() && parsed.size() == value.size() && 0 <= n && n <= URGENCY_LOWEST) {
+        urgency = static_cast<uint8_t>(n);
+      }
+    } else if (key == "i"sv) {
+      // A Boolean, [RFC 8941] 3.3.6, where a bare key is true.
+      if (value.empty() || value == "?1"sv) {
+        incremental = true;
+      } else if (value == "?0"sv) {
+        incremental = false;
+      }
+    }
+  }
+}
+
+HttpPriority
+HttpPriority::from_header(HTTPHdr const *hdr)
+{
+  HttpPriority priority;
+  // Several field lines are one comma separated value, which is the same as parsing each in turn.
+  for (MIMEField const *field = hdr->field_find(PRIORITY_FIELD); field != nullptr; field = field->m_next_dup) {
+    priority.parse(field->value_get());
+  }
+  return priority;
+}
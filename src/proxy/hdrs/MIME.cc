@@ -2231,6 +2231,7 @@ MIMEScanner::get(TextView &input, TextView &output, bool &output_shares_input, b
   static const char RAW_CR{ParseRules::CHAR_CR};
 
   auto text = input;
+  bool nul  = false;
   while (ParseResult::CONT == zret && !text.empty()) {
     switch (m_state) {
     case MimeParseState::BEFORE: // waiting to find a field.
@@ -2265,9 +2266,11 @@ MIMEScanner::get(TextView &input, TextView &output, bool &output_shares_input, b
       }
       break;
     case MimeParseState::INSIDE: {
-      auto lf_off = text.find(ParseRules::CHAR_LF);
-      if (lf_off != TextView::npos) {
-        text.remove_prefix(lf_off + 1); // drop up to and including LF
+      // Everything but the CR and LF the other states take is scanned here, so this finds any NUL too.
+      auto scan  = mime_scan_line(text);
+      nul       |= scan.nul != text.size();
+      if (scan.lf != text.size()) {
+        text.remove_prefix(scan.lf + 1); // drop up to and including LF
         if (ScanType::LINE == scan_type) {
           zret    = ParseResult::OK;
           m_state = MimeParseState::BEFORE;
@@ -2354,7 +2357,7 @@ MIMEScanner::get(TextView &input, TextView &output, bool &output_shares_input, b
   }
 
   // Make sure there are no null characters in the input scanned so far
-  if (zret != ParseResult::ERROR && TextView::npos != parsed_text.find('\0')) {
+  if (zret != ParseResult::ERROR && nul) {
     zret = ParseResult::ERROR;
   }
 
@@ -2437,7 +2440,10 @@ mime_parser_parse(MIMEParser *parser, HdrHeap *heap, MIMEHdrImpl *mh, const char
 
     // find name last
     auto field_value = parsed; // need parsed as is later on.
-    auto field_name  = field_value.split_prefix_at(':');
+    auto scan        = mime_scan_line(parsed);
+    // A line glued together from pieces can have a LF before its end, where the scan stops.
+    bool scanned    = scan.lf + 1 >= parsed.size();
+    auto field_name = scanned ? field_value.split_prefix(scan.colon) : field_value.split_prefix_at(':');
     if (field_name.empty()) {
       continue; // toss away garbage line
     }
@@ -2465,6 +2471,7 @@ mime_parser_parse(MIMEParser *parser, HdrHeap *heap, MIMEHdrImpl *mh, const char
     // find value first
     field_value.ltrim_if(&ParseRules::is_ws);
     field_value.rtrim_if(&ParseRules::is_wslfcr);
+    size_t value_end = field_value.data_end() - parsed.data();
 
     // Make sure the name + value is not longer than configured max_hdr_field_size
     if (field_name.size() + field_value.size() > max_hdr_field_size) {
@@ -2498,11 +2505,19 @@ mime_parser_parse(MIMEParser *parser, HdrHeap *heap, MIMEHdrImpl *mh, const char
     }
 
     // RFC 9110 Section 5.5. Field Values
-    for (char i : field_value) {
-      // FIXME: ParseRules::is_http_field_value() should be used but the implementation looks wrong
-      if (ParseRules::is_control(i)) {
+    // FIXME: ParseRules::is_http_field_value() should be used but the implementation looks wrong
+    if (scanned) {
+      // Only spaces are trimmed from the front of the value, so the first control character after
+      // the colon is either in the value or trails it.
+      if (scan.ctl < value_end) {
         return ParseResult::ERROR;
       }
+    } else {
+      for (char i : field_value) {
+        if (ParseRules::is_control(i)) {
+          return ParseResult::ERROR;
+        }
+      }
     }
 
     ///////////////////////////////////////////
@@ -0,0 +1,153 @@
+/** @file
+
+  Vectorized scan of a MIME header line.
+
+  Parsing a header field needs the end of the line, the colon after the
+  field name, and whether there are NUL or other control characters in it.
+  Rather than looking for each a byte at a time, a vector of bytes is
+  compared against all of them at once, and only a vector that has one of
+  them in it is looked at more closely. The kernel is compiled for each
+  target supported by Highway and the best one is selected at runtime.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "proxy/hdrs/MIME.h"
+#include "tscore/ParseRules.h"
+
+#include <algorithm>
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "MIMEScan.cc"
+#include "hwy/foreach_target.h" // IWYU pragma: keep
+#include "hwy/highway.h"
+
+// This part is compiled once per Highway target.
+HWY_BEFORE_NAMESPACE();
+namespace mime_scan
+{
+namespace HWY_NAMESPACE
+{
+  namespace hn = hwy::HWY_NAMESPACE;
+
+  MIMELineScan
+  ScanLine(const char *text, size_t n)
+  {
+    MIMELineScan scan{n, n, n, n};
+
+    // At most 64 lanes, so the lanes of a mask fit a word.
+    const hn::CappedTag<uint8_t, 64> d;
+    const size_t                     N = hn::Lanes(d);
+    const uint8_t                   *p = reinterpret_cast<const uint8_t *>(text);
+
+    const auto v_zero  = hn::Zero(d);
+    const auto v_lf    = hn::Set(d, static_cast<uint8_t>(ParseRules::CHAR_LF));
+    const auto v_ht    = hn::Set(d, static_cast<uint8_t>(ParseRules::CHAR_HT));
+    const auto v_colon = hn::Set(d, static_cast<uint8_t>(':'));
+    const auto v_space = hn::Set(d, static_cast<uint8_t>(' '));
+    const auto v_del   = hn::Set(d, static_cast<uint8_t>(0x7F));
+
+    for (size_t i = 0; i < n; i += N) {
+      const size_t avail = std::min(N, n - i);
+      const auto   valid = hn::FirstN(d, avail);
+      const auto   v     = avail == N ? hn::LoadU(d, p + i) : hn::LoadN(d, p + i, avail);
+
+      // Control characters are those below space other than HT, and DEL. LF and NUL are among them.
+      const auto m_ctl   = hn::And(valid, hn::AndNot(hn::Eq(v, v_ht), hn::Or(hn::Lt(v, v_space), hn::Eq(v, v_del))));
+      const auto m_colon = hn::And(valid, hn::Eq(v, v_colon));
+      if (hn::AllFalse(d, hn::Or(m_ctl, m_colon))) {
+        continue;
+      }
+
+      uint64_t ctl   = hn::BitsFromMask(d, m_ctl);
+      uint64_t colon = hn::BitsFromMask(d, m_colon);
+      uint64_t lf    = hn::BitsFromMask(d, hn::Eq(v, v_lf)) & ctl;
+      uint64_t nul   = hn::BitsFromMask(d, hn::Eq(v, v_zero)) & ctl;
+
+      // Only what is before the LF counts.
+      if (lf) {
+        const uint64_t before  = (lf & (~lf + 1)) - 1;
+        ctl                   &= before;
+        colon                 &= before;
+        nul                   &= before;
+      }
+      if (scan.colon == n) {
+        if (colon) {
+          const uint64_t first  = colon & (~colon + 1);
+          scan.colon            = i + hwy::Num0BitsBelowLS1Bit_Nonzero64(colon);
+          ctl                  &= ~((first << 1) - 1);
+        } else {
+          ctl = 0;
+        }
+      }
+      if (scan.ctl == n && ctl) {
+        scan.ctl = i + hwy::Num0BitsBelowLS1Bit_Nonzero64(ctl);
+      }
+      if (scan.nul == n && nul) {
+        scan.nul = i + hwy::Num0BitsBelowLS1Bit_Nonzero64(nul);
+      }
+      if (lf) {
+        scan.lf = i + hwy::Num0BitsBelowLS1Bit_Nonzero64(lf);
+        break;
+      }
+    }
+    return scan;
+  }
+
+} // namespace HWY_NAMESPACE
+} // namespace mime_scan
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+
+namespace mime_scan
+{
+HWY_EXPORT(ScanLine);
+} // namespace mime_scan
+
+MIMELineScan
+mime_scan_line(swoc::TextView text)
+{
+  return HWY_DYNAMIC_DISPATCH(mime_scan::ScanLine)(text.data(), text.size());
+}
+
+MIMELineScan
+mime_scan_line_scalar(swoc::TextView text)
+{
+  size_t const n = text.size();
+  MIMELineScan scan{n, n, n, n};
+  for (size_t i = 0; i < n; ++i) {
+    char c = text[i];
+    if (ParseRules::is_lf(c)) {
+      scan.lf = i;
+      break;
+    }
+    if (c == ':' && scan.colon == n) {
+      scan.colon = i;
+    } else if (ParseRules::is_control(c) && scan.colon != n && scan.ctl == n) {
+      scan.ctl = i;
+    }
+    if (c == '\0' && scan.nul == n) {
+      scan.nul = i;
+    }
+  }
+  return scan;
+}
+
+#endif // HWY_ONCE
@@ -30,6 +30,8 @@
 #include "tscore/ink_memory.h"
 #include "tsutil/LocalBuffer.h"
 #include <cstdint>
+#include <functional>
+#include <utility>
 
 namespace
 {
@@ -55,6 +57,19 @@ match(const char *s1, int s1_len, const char *s2, int s2_len)
   return true;
 }
 
+uint64_t
+hash_string(const char *s, size_t len)
+{
+  return std::hash<std::string_view>{}({s, len});
+}
+
+// Combine the hashes of a name and a value into the hash of the field.
+uint64_t
+hash_field(uint64_t name_hash, uint64_t value_hash)
+{
+  return name_hash ^ (value_hash + 0x9e3779b97f4a7c15 + (name_hash << 6) + (name_hash >> 2));
+}
+
 } // end anonymous namespace
 
 //
@@ -233,6 +248,16 @@ XpackDynamicTable::XpackDynamicTable(uint32_t size) : _maximum_size(size), _avai
   this->_entries      = static_cast<struct XpackDynamicTableEntry *>(ats_malloc(sizeof(struct XpackDynamicTableEntry) * size));
   this->_entries_head = size - 1;
   this->_entries_tail = size - 1;
+
+  // Twice as many buckets as the entries that fit, each entry taking at least 32 bytes.
+  if (size > 0) {
+    size_t buckets = 16;
+    while (buckets < 2 * (size / ADDITIONAL_32_BYTES)) {
+      buckets <<= 1;
+    }
+    this->_name_index.resize(buckets);
+    this->_field_index.resize(buckets);
+  }
 }
 
 XpackDynamicTable::~XpackDynamicTable()
@@ -278,31 +303,46 @@ XpackDynamicTable::lookup(const char *name, size_t name_len, const char *value,
 {
   XPACKDbg("Lookup entry: name=%.*s, value=%.*s", static_cast<int>(name_len), name, static_cast<int>(value_len), value);
   XpackLookupResult::MatchType match_type      = XpackLookupResult::MatchType::NONE;
-  uint32_t                     i               = this->_calc_index(this->_entries_tail, 1);
-  uint32_t                     end             = this->_calc_index(this->_entries_head, 1);
   uint32_t                     candidate_index = 0;
   const char                  *tmp_name        = nullptr;
   const char                  *tmp_value       = nullptr;
 
   // DynamicTable is empty
-  if (this->is_empty()) {
+  if (this->is_empty() || name_len == 0) {
     return {candidate_index, match_type};
   }
 
-  for (; i != end; i = this->_calc_index(i, 1)) {
-    if (name_len != 0 && this->_entries[i].name_len == name_len) {
-      this->_storage.read(this->_entries[i].offset, &tmp_name, this->_entries[i].name_len, &tmp_value, this->_entries[i].value_len);
-      if (match(name, name_len, tmp_name, this->_entries[i].name_len)) {
-        candidate_index = this->_entries[i].index;
-        if (match(value, value_len, tmp_value, this->_entries[i].value_len)) {
-          // Exact match
-          match_type = XpackLookupResult::MatchType::EXACT;
+  uint32_t const oldest     = this->_entries[this->_calc_index(this->_entries_tail, 1)].index;
+  size_t const   mask       = this->_name_index.size() - 1;
+  uint64_t const name_hash  = hash_string(name, name_len);
+  uint64_t const field_hash = hash_field(name_hash, hash_string(value, value_len));
+
+  // Exact match. Keep going to the oldest one, which is the one a scan from the tail would find.
+  for (uint32_t link = this->_field_index[field_hash & mask]; link != 0 && link - 1 >= oldest;) {
+    auto const &entry = this->_entries[this->_position(link - 1)];
+    if (entry.field_hash == static_cast<uint32_t>(field_hash) && entry.name_len == name_len && entry.value_len == value_len) {
+      this->_storage.read(entry.offset, &tmp_name, entry.name_len, &tmp_value, entry.value_len);
+      if (match(name, name_len, tmp_name, entry.name_len) && match(value, value_len, tmp_value, entry.value_len)) {
+        candidate_index = entry.index;
+        match_type      = XpackLookupResult::MatchType::EXACT;
+      }
+    }
+    link = entry.field_next;
+  }
+
+  // Name match, the newest one.
+  if (match_type == XpackLookupResult::MatchType::NONE) {
+    for (uint32_t link = this->_name_index[name_hash & mask]; link != 0 && link - 1 >= oldest;) {
+      auto const &entry = this->_entries[this->_position(link - 1)];
+      if (entry.name_hash == static_cast<uint32_t>(name_hash) && entry.name_len == name_len) {
+        this->_storage.read(entry.offset, &tmp_name, entry.name_len, &tmp_value, entry.value_len);
+        if (match(name, name_len, tmp_name, entry.name_len)) {
+          candidate_index = entry.index;
+          match_type      = XpackLookupResult::MatchType::NAME;
           break;
-        } else {
-          // Name match -- Keep it for no exact matches
-          match_type = XpackLookupResult::MatchType::NAME;
         }
       }
+      link = entry.name_next;
     }
   }
 
@@ -377,6 +417,16 @@ XpackDynamicTable::insert_entry(const char *name, size_t name_len, const char *v
     wks};
   this->_available -= required_size;
 
+  // Index it, as the newest entry in its buckets.
+  auto          &entry      = this->_entries[this->_entries_head];
+  size_t const   mask       = this->_name_index.size() - 1;
+  uint64_t const name_hash  = hash_string(name, name_len);
+  uint64_t const field_hash = hash_field(name_hash, hash_string(value, value_len));
+  entry.name_hash           = name_hash;
+  entry.field_hash          = field_hash;
+  entry.name_next           = std::exchange(this->_name_index[name_hash & mask], entry.index + 1);
+  entry.field_next          = std::exchange(this->_field_index[field_hash & mask], entry.index + 1);
+
   XPACKDbg("Insert Entry: entry=%u, index=%u, size=%zu", this->_entries_head, this->_entries_inserted - 1, name_len + value_len);
   XPACKDbg("Available size: %u", this->_available);
   return {this->_entries_inserted, value_len ? XpackLookupResult::MatchType::EXACT : XpackLookupResult::MatchType::NAME};
@@ -550,6 +600,13 @@ XpackDynamicTable::_calc_index(uint32_t base, int64_t offset) const
   }
 }
 
+uint32_t
+XpackDynamicTable::_position(uint32_t index) const
+{
+  uint32_t const back = this->_entries[this->_entries_head].index - index;
+  return (this->_entries_head + this->_max_entries - back) % this->_max_entries;
+}
+
 //
 // DynamicTableStorage
 //
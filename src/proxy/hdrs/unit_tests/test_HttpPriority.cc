@@ -0,0 +1,189 @@
+/** @file
+ *
+ *  Catch-based unit tests for HttpPriority and HttpPriorityScheduler
+ *
+ *  @section license License
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "proxy/hdrs/HTTP.h"
+#include "proxy/hdrs/HttpPriority.h"
+
+#include <string_view>
+#include <vector>
+
+namespace
+{
+HttpPriority
+parse(std::string_view text)
+{
+  HttpPriority priority;
+  priority.parse(text);
+  return priority;
+}
+
+using Scheduler = HttpPriorityScheduler<int>;
+
+std::vector<int>
+drain(Scheduler &scheduler, int frames)
+{
+  std::vector<int> sent;
+  for (int i = 0; i < frames; ++i) {
+    Scheduler::Node *node = scheduler.top();
+    if (node == nullptr) {
+      break;
+    }
+    sent.push_back(node->t);
+    scheduler.update(*node);
+  }
+  return sent;
+}
+} // end anonymous namespace
+
+TEST_CASE("HttpPriority parse", "[proxy][hdrtest][priority]")
+{
+  CHECK(parse("") == HttpPriority{3, false});
+  CHECK(parse("u=0") == HttpPriority{0, false});
+  CHECK(parse("u=7, i") == HttpPriority{7, true});
+  CHECK(parse("i, u=5") == HttpPriority{5, true});
+  CHECK(parse("i=?1") == HttpPriority{3, true});
+  CHECK(parse("u=1,i=?0") == HttpPriority{1, false});
+  CHECK(parse("  u=2  ,\ti  ") == HttpPriority{2, true});
+  // The last of repeated members wins.
+  CHECK(parse("u=1, u=6") == HttpPriority{6, false});
+  // Parameters of a member are skipped.
+  CHECK(parse("u=4;foo=bar, i;x") == HttpPriority{4, true});
+
+  // Invalid values and unknown members leave the defaults.
+  CHECK(parse("u=8") == HttpPriority{3, false});
+  CHECK(parse("u=-1") == HttpPriority{3, false});
+  CHECK(parse("u=1.5") == HttpPriority{3, false});
+  CHECK(parse("u") == HttpPriority{3, false});
+  CHECK(parse("u=\"1\"") == HttpPriority{3, false});
+  CHECK(parse("i=1") == HttpPriority{3, false});
+  CHECK(parse("U=1, I") == HttpPriority{3, false});
+  CHECK(parse("foo=1, bar") == HttpPriority{3, false});
+
+  // Parsing updates a priority that was already set.
+  HttpPriority priority{1, true};
+  priority.parse("i=?0");
+  CHECK(priority == HttpPriority{1, false});
+}
+
+TEST_CASE("HttpPriority from_header", "[proxy][hdrtest][priority]")
+{
+  HTTPHdr hdr;
+  hdr.create(HTTPType::REQUEST);
+
+  CHECK(HttpPriority::from_header(&hdr) == HttpPriority{});
+
+  MIMEField *field = hdr.field_create("Priority");
+  field->value_set(hdr.m_heap, hdr.m_mime, "u=1");
+  hdr.field_attach(field);
+  CHECK(HttpPriority::from_header(&hdr) == HttpPriority{1, false});
+
+  field = hdr.field_create("priority");
+  field->value_set(hdr.m_heap, hdr.m_mime, "i");
+  hdr.field_attach(field);
+  CHECK(HttpPriority::from_header(&hdr) == HttpPriority{1, true});
+
+  hdr.destroy();
+}
+
+TEST_CASE("HttpPriorityScheduler", "[proxy][priority]")
+{
+  Scheduler scheduler;
+
+  SECTION("urgency first")
+  {
+    Scheduler::Node a{1}, b{2}, c{3};
+    a.id = 1, a.priority = {5, false};
+    b.id = 3, b.priority = {0, false};
+    c.id = 5, c.priority = {3, false};
+    scheduler.activate(a);
+    scheduler.activate(b);
+    scheduler.activate(c);
+    CHECK(scheduler.size() == 3);
+    CHECK(scheduler.top() == &b);
+    scheduler.deactivate(b);
+    CHECK(scheduler.top() == &c);
+    scheduler.deactivate(c);
+    CHECK(scheduler.top() == &a);
+    scheduler.deactivate(a);
+    CHECK(scheduler.top() == nullptr);
+  }
+
+  SECTION("non-incremental in order of identifier, each to completion")
+  {
+    Scheduler::Node a{1}, b{2};
+    a.id = 7;
+    b.id = 5;
+    scheduler.activate(a);
+    scheduler.activate(b);
+    CHECK(drain(scheduler, 3) == std::vector<int>{2, 2, 2});
+    // Blocked on flow control and back, it keeps its place.
+    scheduler.deactivate(b);
+    CHECK(scheduler.top() == &a);
+    scheduler.activate(b);
+    CHECK(scheduler.top() == &b);
+    scheduler.deactivate(a);
+    scheduler.deactivate(b);
+  }
+
+  SECTION("incremental take turns after non-incremental of the same urgency")
+  {
+    Scheduler::Node a{1}, b{2}, c{3}, d{4};
+    a.id = 1, a.priority = {3, true};
+    b.id = 3, b.priority = {3, true};
+    c.id = 5, c.priority = {3, true};
+    d.id = 7, d.priority = {3, false};
+    scheduler.activate(a);
+    scheduler.activate(b);
+    scheduler.activate(c);
+    CHECK(drain(scheduler, 7) == std::vector<int>{1, 2, 3, 1, 2, 3, 1});
+    scheduler.activate(d);
+    CHECK(drain(scheduler, 2) == std::vector<int>{4, 4});
+    scheduler.deactivate(d);
+    CHECK(drain(scheduler, 3) == std::vector<int>{2, 3, 1});
+    scheduler.deactivate(a);
+    scheduler.deactivate(b);
+    scheduler.deactivate(c);
+    CHECK(scheduler.size() == 0);
+  }
+
+  SECTION("reprioritize")
+  {
+    Scheduler::Node a{1}, b{2};
+    a.id = 1;
+    b.id = 3;
+    scheduler.reprioritize(b, {6, false});
+    CHECK(b.priority == HttpPriority{6, false});
+    scheduler.activate(a);
+    scheduler.activate(b);
+    CHECK(scheduler.top() == &a);
+    scheduler.reprioritize(b, {1, true});
+    CHECK(scheduler.top() == &b);
+    scheduler.reprioritize(b, {3, true});
+    CHECK(scheduler.top() == &a);
+    CHECK(scheduler.size() == 2);
+    scheduler.deactivate(a);
+    scheduler.deactivate(b);
+  }
+}
@@ -21,6 +21,7 @@
   limitations under the License.
  */
 
+#include <deque>
 #include <string>
 #include <string_view>
 
@@ -410,6 +411,68 @@ TEST_CASE("XPACK_String", "[xpack]")
   }
 }
 
+TEST_CASE("XpackDynamicTable lookup", "[xpack]")
+{
+  // Many entries come and go with the same names and values, and lookups find what a scan of the
+  // table from the oldest entry would: the oldest exact match, or else the newest name match.
+  struct Field {
+    std::string name;
+    std::string value;
+    uint32_t    index;
+  };
+  uint32_t          max_size = 1024;
+  XpackDynamicTable dt(max_size);
+  std::deque<Field> fields;
+  uint32_t          used     = 0;
+  uint32_t          inserted = 0;
+  unsigned int      seed     = 13;
+
+  auto random = [&seed](unsigned int n) -> unsigned int {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) % n;
+  };
+  auto expected = [&fields](std::string_view name, std::string_view value) -> XpackLookupResult {
+    XpackLookupResult result;
+    for (auto const &f : fields) {
+      if (f.name == name) {
+        result = {f.index, XpackLookupResult::MatchType::NAME};
+        if (f.value == value) {
+          return {f.index, XpackLookupResult::MatchType::EXACT};
+        }
+      }
+    }
+    return result;
+  };
+
+  for (int round = 0; round < 20000; ++round) {
+    std::string name  = "x-name-" + std::to_string(random(12));
+    std::string value = std::string(random(40), 'v') + std::to_string(random(20));
+
+    if (round == 10000) {
+      // Growing the table moves every entry.
+      max_size *= 2;
+      REQUIRE(dt.update_maximum_size(max_size));
+    }
+    if (random(3) == 0) {
+      uint32_t required = name.size() + value.size() + 32;
+      while (used + required > max_size) {
+        used -= fields.front().name.size() + fields.front().value.size() + 32;
+        fields.pop_front();
+      }
+      dt.insert_entry(name, value);
+      fields.push_back({name, value, inserted++});
+      used += required;
+      REQUIRE(dt.count() == fields.size());
+    }
+
+    XpackLookupResult want = expected(name, value);
+    XpackLookupResult got  = dt.lookup(name, value);
+    CAPTURE(round, name, value);
+    REQUIRE(got.match_type == want.match_type);
+    REQUIRE(got.index == want.index);
+  }
+}
+
 // Return a 110 character string.
 std::string
 get_long_string(std::string_view prefix)
@@ -219,3 +219,51 @@ TEST_CASE("MimeDateParser", "[proxy][mimedateparser]")
 
   CHECK(d1 == d2);
 }
+
+TEST_CASE("MimeScanLine", "[proxy][mimescan]")
+{
+  auto check = [](std::string_view line) -> MIMELineScan {
+    MIMELineScan scan   = mime_scan_line(line);
+    MIMELineScan scalar = mime_scan_line_scalar(line);
+    CAPTURE(line);
+    CHECK(scan.lf == scalar.lf);
+    CHECK(scan.colon == scalar.colon);
+    CHECK(scan.nul == scalar.nul);
+    CHECK(scan.ctl == scalar.ctl);
+    return scan;
+  };
+
+  MIMELineScan scan = check("Host: example.com\r\n"sv);
+  CHECK(scan.lf == 18);
+  CHECK(scan.colon == 4);
+  CHECK(scan.ctl == 17);
+  CHECK(scan.nul == 19);
+
+  // Nothing past the LF counts, nor a control character before the colon.
+  scan = check("X-\x01Name\tx:\ty\x7f\n: \0\r\n"sv);
+  CHECK(scan.lf == 13);
+  CHECK(scan.colon == 9);
+  CHECK(scan.ctl == 12);
+  CHECK(scan.nul == 19);
+
+  scan = check("no end"sv);
+  CHECK(scan.lf == 6);
+  CHECK(scan.colon == 6);
+
+  // Every length and position across several vectors, including partial ones at the end.
+  std::string  text;
+  unsigned int seed = 13;
+  for (int round = 0; round < 2000; ++round) {
+    seed = seed * 1103515245 + 12345;
+    text.assign(1 + (seed >> 16) % 200, 'a');
+    for (int n = (seed >> 8) % 4; n > 0; --n) {
+      seed = seed * 1103515245 + 12345;
+      // Mostly the characters the scan looks for, among others.
+      static constexpr char SPECIAL[] = {':', '\n', '\r', '\0', '\t', '\x7f', '\x1f', ' ', '\x80'};
+      text[(seed >> 16) % text.size()] = SPECIAL[(seed >> 4) % sizeof(SPECIAL)];
+    }
+    for (size_t start = 0; start < 4 && start < text.size(); ++start) {
+      check(std::string_view{text}.substr(start));
+    }
+  }
+}
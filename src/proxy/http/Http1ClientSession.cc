@@ -565,6 +565,12 @@ Http1ClientSession::is_chunked_encoding_supported() const
   return true;
 }
 
+bool
+Http1ClientSession::supports_sendfile() const
+{
+  return _vc && _vc->supports_sendfile();
+}
+
 int
 Http1ClientSession::get_transact_count() const
 {
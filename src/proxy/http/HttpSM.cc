@@ -7050,6 +7050,12 @@ HttpSM::setup_cache_read_transfer()
     tunnel.set_producer_chunking_action(p, client_response_hdr_bytes, TunnelChunkingAction_t::CHUNK_CONTENT, drop_chunked_trailers,
                                         parse_chunk_strictly);
     tunnel.set_producer_chunking_size(p, t_state.txn_conf->http_chunking_size);
+  } else if (doc_size != INT64_MAX && _ua.get_txn()->supports_sendfile()) {
+    // The body goes to the client unchanged, transforms take setup_cache_transfer_to_transform(),
+    // so the client connection can send it from the cache disk.
+    if (cache_sm.cache_read_vc->enable_sendfile()) {
+      SMDbg(dbg_ctl_http, "sending cached body with sendfile");
+    }
   }
   _ua.get_entry()->in_tunnel = true;
   cache_sm.cache_read_vc     = nullptr;
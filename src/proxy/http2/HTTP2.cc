@@ -643,6 +643,13 @@ Http2::init()
   http2_frame_metrics_in[9]  = http2_rsb.continuation_frames_in;
   http2_frame_metrics_in[10] = http2_rsb.unknown_frames_in;
 
+  for (unsigned idx = 0; idx < Http2FramesPerWriteHistogram::N_BUCKETS; ++idx) {
+    char name[64];
+    snprintf(name, sizeof(name), "proxy.process.http2.frames_per_write.%zu",
+             static_cast<size_t>(Http2FramesPerWriteHistogram::min_for_bucket(idx)));
+    http2_rsb.frames_per_write[idx] = Metrics::Counter::createPtr(name);
+  }
+
   http2_init();
 }
 
@@ -171,6 +171,7 @@ Http2ClientSession::main_event_handler(int event, void *edata)
   bool set_closed = false;
 
   recursion++;
+  this->begin_batch();
 
   Event *e = static_cast<Event *>(edata);
   if (e == schedule_event) {
@@ -249,6 +250,7 @@ Http2ClientSession::main_event_handler(int event, void *edata)
     send_connection_event(&this->connection_state, HTTP2_SESSION_EVENT_SHUTDOWN_INIT, this);
   }
 
+  this->end_batch();
   recursion--;
   if (!connection_state.is_recursing() && this->recursion == 0 && kill_me) {
     this->free();
@@ -160,6 +160,7 @@ Http2CommonSession::xmit(const Http2TxFrame &frame, bool flush)
 {
   int64_t len                       = frame.write_to(this->write_buffer);
   this->_pending_sending_data_size += len;
+  ++this->_pending_frames;
   if (!flush) {
     // Flush if we already use half of the buffer to avoid adding a new block to the chain.
     // A frame size can be 16MB at maximum so blocks can be added, but that's fine.
@@ -181,14 +182,31 @@ Http2CommonSession::xmit(const Http2TxFrame &frame, bool flush)
 void
 Http2CommonSession::flush()
 {
+  if (this->_batch_depth > 0) {
+    this->_flush_pending = true;
+    return;
+  }
+
+  this->_flush_pending = false;
   this->connection_state.cancel_retransmit();
   if (this->_pending_sending_data_size > 0) {
+    Metrics::Counter::increment(http2_rsb.frames_per_write[Http2FramesPerWriteHistogram::bucket_for(this->_pending_frames)]);
     this->_pending_sending_data_size = 0;
+    this->_pending_frames            = 0;
     this->_write_buffer_last_flush   = ink_get_hrtime();
     write_reenable();
   }
 }
 
+void
+Http2CommonSession::end_batch()
+{
+  ink_assert(this->_batch_depth > 0);
+  if (--this->_batch_depth == 0 && this->_flush_pending) {
+    this->flush();
+  }
+}
+
 int
 Http2CommonSession::state_read_connection_preface(int event, void *edata)
 {
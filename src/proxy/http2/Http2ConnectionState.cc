@@ -44,7 +44,6 @@
 #include "tsutil/LocalBuffer.h"
 
 #include <cstdint>
-#include <sstream>
 #include <numeric>
 
 namespace
@@ -304,7 +303,6 @@ Http2ConnectionState::rcv_headers_frame(const Http2Frame &frame)
   }
 
   Http2Stream *stream                      = nullptr;
-  bool         new_stream                  = false;
   bool         reset_header_after_decoding = false;
   bool         free_stream_after_decoding  = false;
 
@@ -343,8 +341,7 @@ Http2ConnectionState::rcv_headers_frame(const Http2Frame &frame)
     } else {
       // Create new stream
       Http2Error error(Http2ErrorClass::HTTP2_ERROR_CLASS_NONE);
-      stream     = this->create_stream(stream_id, error);
-      new_stream = true;
+      stream = this->create_stream(stream_id, error);
       if (!stream) {
         // Terminate the connection with COMPRESSION_ERROR because we don't decompress the field block in this HEADERS frame.
         // TODO: try to decompress to keep HPACK Dynamic Table in sync.
@@ -424,21 +421,6 @@ Http2ConnectionState::rcv_headers_frame(const Http2Frame &frame)
     header_block_fragment_length -= HTTP2_PRIORITY_LEN;
   }
 
-  if (new_stream && Http2::stream_priority_enabled) {
-    Http2DependencyTree::Node *node = this->dependency_tree->find(stream_id);
-    if (node != nullptr) {
-      stream->priority_node = node;
-      node->t               = stream;
-    } else {
-      Http2StreamDebug(this->session, stream_id, "HEADER PRIORITY - dep: %d, weight: %d, excl: %d, tree size: %d",
-                       params.priority.stream_dependency, params.priority.weight, params.priority.exclusive_flag,
-                       this->dependency_tree->size());
-
-      stream->priority_node = this->dependency_tree->add(params.priority.stream_dependency, stream_id, params.priority.weight,
-                                                         params.priority.exclusive_flag, stream);
-    }
-  }
-
   stream->header_blocks_length = header_block_fragment_length;
 
   // ATS advertises SETTINGS_MAX_HEADER_LIST_SIZE as a limit of total header blocks length. (Details in [RFC 7560] 10.5.1.)
@@ -525,6 +507,9 @@ Http2ConnectionState::rcv_headers_frame(const Http2Frame &frame)
     // Set up the State Machine
     if (!stream->is_outbound_connection() && !stream->trailing_header_is_possible()) {
       SCOPED_MUTEX_LOCK(stream_lock, stream->mutex, this_ethread());
+      if (Http2::stream_priority_enabled) {
+        this->_set_stream_priority(stream);
+      }
       stream->mark_milestone(Http2StreamMilestone::START_TXN);
       stream->cancel_active_timeout();
       stream->new_transaction(frame.is_from_early_data());
@@ -614,29 +599,10 @@ Http2ConnectionState::rcv_priority_frame(const Http2Frame &frame)
                       "recv priority too frequent priority changes");
   }
 
-  Http2StreamDebug(this->session, stream_id, "PRIORITY - dep: %d, weight: %d, excl: %d, tree size: %d", priority.stream_dependency,
-                   priority.weight, priority.exclusive_flag, this->dependency_tree->size());
-
-  Http2DependencyTree::Node *node = this->dependency_tree->find(stream_id);
-
-  if (node != nullptr) {
-    // [RFC 7540] 5.3.3 Reprioritization
-    Http2StreamDebug(this->session, stream_id, "Reprioritize");
-    this->dependency_tree->reprioritize(node, priority.stream_dependency, priority.exclusive_flag);
-    if (dbg_ctl_http2_priority.on()) {
-      std::stringstream output;
-      this->dependency_tree->dump_tree(output);
-      Dbg(dbg_ctl_http2_priority, "[%" PRId64 "] reprioritize %s", this->session->get_connection_id(), output.str().c_str());
-    }
-  } else {
-    // PRIORITY frame is received before HEADERS frame.
-
-    // Restrict number of inactive node in dependency tree smaller than max_concurrent_streams.
-    // Current number of inactive node is size of tree minus active node count.
-    if (this->_get_configured_max_concurrent_streams() > this->dependency_tree->size() - this->get_peer_stream_count() + 1) {
-      this->dependency_tree->add(priority.stream_dependency, stream_id, priority.weight, priority.exclusive_flag, nullptr);
-    }
-  }
+  // [RFC 9113] 5.3.2 The priority signals of RFC 7540 are deprecated. Streams are scheduled by
+  // their RFC 9218 priority, so these are only checked.
+  Http2StreamDebug(this->session, stream_id, "PRIORITY - dep: %d, weight: %d, excl: %d, ignored", priority.stream_dependency,
+                   priority.weight, priority.exclusive_flag);
 
   return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_NONE);
 }
@@ -1154,6 +1120,9 @@ Http2ConnectionState::rcv_continuation_frame(const Http2Frame &frame)
 
     // Set up the State Machine
     SCOPED_MUTEX_LOCK(stream_lock, stream->mutex, this_ethread());
+    if (Http2::stream_priority_enabled) {
+      this->_set_stream_priority(stream);
+    }
     stream->mark_milestone(Http2StreamMilestone::START_TXN);
     // This should be fine, need to verify whether we need to replace this with the
     // "from_early_data" flag from the associated HEADERS frame.
@@ -1170,6 +1139,79 @@ Http2ConnectionState::rcv_continuation_frame(const Http2Frame &frame)
   return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_NONE);
 }
 
+/*
+ * [RFC 9218] 7.1 PRIORITY_UPDATE
+ *
+ */
+Http2Error
+Http2ConnectionState::rcv_priority_update_frame(const Http2Frame &frame)
+{
+  const Http2StreamId stream_id      = frame.header().streamid;
+  const uint32_t      payload_length = frame.header().length;
+
+  Http2StreamDebug(this->session, stream_id, "Received PRIORITY_UPDATE frame");
+
+  // The PRIORITY_UPDATE frame is sent on the control stream, stream 0. Receiving it on any other
+  // stream MUST be treated as a connection error of type PROTOCOL_ERROR.
+  if (stream_id != HTTP2_CONNECTION_CONTROL_STREAM) {
+    return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_CONNECTION, Http2ErrorCode::HTTP2_ERROR_PROTOCOL_ERROR,
+                      "priority update on non-zero stream");
+  }
+
+  if (payload_length < HTTP2_PRIORITY_UPDATE_LEN) {
+    return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_CONNECTION, Http2ErrorCode::HTTP2_ERROR_FRAME_SIZE_ERROR,
+                      "priority update bad length");
+  }
+
+  uint8_t buf[HTTP2_PRIORITY_UPDATE_LEN];
+  frame.reader()->memcpy(buf, HTTP2_PRIORITY_UPDATE_LEN, 0);
+  const Http2StreamId prioritized_id = ((buf[0] & 0x7f) << 24) | (buf[1] << 16) | (buf[2] << 8) | buf[3];
+
+  // Only requests are prioritized, so the stream must be one the client can open.
+  if (prioritized_id == HTTP2_CONNECTION_CONTROL_STREAM || !http2_is_client_streamid(prioritized_id)) {
+    return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_CONNECTION, Http2ErrorCode::HTTP2_ERROR_PROTOCOL_ERROR,
+                      "priority update bad prioritized stream");
+  }
+
+  if (!Http2::stream_priority_enabled) {
+    return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_NONE);
+  }
+
+  // These are limited together with PRIORITY frames, both only reorder the streams.
+  this->increment_received_priority_frame_count();
+  if (configured_max_priority_frames_per_minute >= 0 &&
+      this->get_received_priority_frame_count() > static_cast<uint32_t>(configured_max_priority_frames_per_minute)) {
+    Metrics::Counter::increment(http2_rsb.max_priority_frames_per_minute_exceeded);
+    Http2StreamDebug(this->session, stream_id, "Observed too frequent priority changes: %u priority changes within a last minute",
+                     this->get_received_priority_frame_count());
+    return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_CONNECTION, Http2ErrorCode::HTTP2_ERROR_ENHANCE_YOUR_CALM,
+                      "recv priority update too frequent priority changes");
+  }
+
+  const uint32_t        value_length = payload_length - HTTP2_PRIORITY_UPDATE_LEN;
+  ts::LocalBuffer<char> value(value_length);
+  frame.reader()->memcpy(value.data(), value_length, HTTP2_PRIORITY_UPDATE_LEN);
+
+  HttpPriority priority;
+  priority.parse(swoc::TextView{value.data(), value_length});
+  Dbg(dbg_ctl_http2_priority, "[%" PRId64 "] [%u] PRIORITY_UPDATE - u=%u, i=%d", this->session->get_connection_id(), prioritized_id,
+      priority.urgency, priority.incremental);
+
+  if (Http2Stream *stream = find_stream(prioritized_id); stream != nullptr) {
+    priority_scheduler.reprioritize(stream->priority_node, priority);
+  } else if (prioritized_id > latest_streamid_in) {
+    // The stream is not open yet, keep the priority for when it is. The number of these is limited
+    // like that of open streams.
+    if (pending_priorities.size() < this->_get_configured_max_concurrent_streams() ||
+        pending_priorities.count(prioritized_id) != 0) {
+      pending_priorities[prioritized_id] = priority;
+    }
+  }
+  // Otherwise the stream is closed and the frame is ignored.
+
+  return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_NONE);
+}
+
 ////////
 // Configuration Getters.
 //
@@ -1327,9 +1369,6 @@ Http2ConnectionState::init(Http2CommonSession *ssn)
 
   local_hpack_handle = new HpackHandle(HTTP2_HEADER_TABLE_SIZE);
   peer_hpack_handle  = new HpackHandle(HTTP2_HEADER_TABLE_SIZE);
-  if (Http2::stream_priority_enabled) {
-    dependency_tree = new DependencyTree(this->_get_configured_max_concurrent_streams());
-  }
 
   // Generally speaking, before enforcing h2 settings we wait upon the client to
   // acknowledge the settings via a SETTINGS ACK. This is important for things
@@ -1439,9 +1478,7 @@ Http2ConnectionState::destroy()
   local_hpack_handle = nullptr;
   delete peer_hpack_handle;
   peer_hpack_handle = nullptr;
-  delete dependency_tree;
-  dependency_tree = nullptr;
-  this->session   = nullptr;
+  this->session = nullptr;
 
   if (fini_event) {
     fini_event->cancel();
@@ -1474,7 +1511,7 @@ Http2ConnectionState::rcv_frame(const Http2Frame *frame)
 
   // [RFC 7540] 5.5. Extending HTTP/2
   //   Implementations MUST discard frames that have unknown or unsupported types.
-  if (frame->header().type >= HTTP2_FRAME_TYPE_MAX) {
+  if (frame->header().type >= HTTP2_FRAME_TYPE_MAX && frame->header().type != HTTP2_FRAME_TYPE_PRIORITY_UPDATE) {
     Http2StreamDebug(session, stream_id, "Discard a frame which has unknown type, type=%x", frame->header().type);
     return;
   }
@@ -1490,6 +1527,7 @@ Http2ConnectionState::rcv_frame(const Http2Frame *frame)
   // GOAWAY:        NO
   // WINDOW_UPDATE: YES
   // CONTINUATION:  YES (safe http methods only, same as HEADERS frame).
+  // PRIORITY_UPDATE: YES
   if (frame->is_from_early_data() &&
       (frame->header().type == HTTP2_FRAME_TYPE_DATA || frame->header().type == HTTP2_FRAME_TYPE_RST_STREAM ||
        frame->header().type == HTTP2_FRAME_TYPE_PUSH_PROMISE || frame->header().type == HTTP2_FRAME_TYPE_GOAWAY)) {
@@ -1497,7 +1535,9 @@ Http2ConnectionState::rcv_frame(const Http2Frame *frame)
     return;
   }
 
-  if (this->_frame_handlers[frame->header().type]) {
+  if (frame->header().type == HTTP2_FRAME_TYPE_PRIORITY_UPDATE) {
+    error = this->rcv_priority_update_frame(*frame);
+  } else if (this->_frame_handlers[frame->header().type]) {
     error = (this->*_frame_handlers[frame->header().type])(*frame);
   } else {
     error = Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_CONNECTION, Http2ErrorCode::HTTP2_ERROR_INTERNAL_ERROR, "no handler");
@@ -1551,6 +1591,10 @@ Http2ConnectionState::main_event_handler(int event, void *edata)
     retransmit_event = nullptr;
   }
   ++recursion;
+  Http2CommonSession *batch_session = this->session;
+  if (batch_session) {
+    batch_session->begin_batch();
+  }
 
   switch (event) {
   // Finalize HTTP/2 Connection
@@ -1642,6 +1686,9 @@ Http2ConnectionState::main_event_handler(int event, void *edata)
     break;
   }
 
+  if (batch_session) {
+    batch_session->end_batch();
+  }
   --recursion;
   if (recursion == 0 && session && !session->is_recursing()) {
     if (this->session->ready_to_free()) {
@@ -1697,6 +1744,10 @@ Http2ConnectionState::set_stream_id(Http2Stream *stream)
     Http2StreamId stream_id = (latest_streamid_in == 0) ? 3 : latest_streamid_in + 2;
     stream->set_transaction_id(stream_id);
     latest_streamid_in = stream_id;
+    if (stream_list.in(stream)) {
+      stream_table.insert(stream_id, stream);
+    }
+    stream->priority_node.id = stream_id;
   }
 }
 
@@ -1884,6 +1935,8 @@ Http2ConnectionState::create_stream(Http2StreamId new_id, Http2Error &error)
   new_stream->is_first_transaction_flag = get_stream_requests() == 0;
 
   stream_list.enqueue(new_stream);
+  stream_table.insert(new_id, new_stream);
+  new_stream->priority_node.id = new_id;
   if (is_client_streamid) {
     latest_streamid_in = new_id;
     ink_assert(peer_streams_count_in < UINT32_MAX);
@@ -1921,13 +1974,7 @@ Http2ConnectionState::create_stream(Http2StreamId new_id, Http2Error &error)
 Http2Stream *
 Http2ConnectionState::find_stream(Http2StreamId id) const
 {
-  for (Http2Stream *s = stream_list.head; s; s = static_cast<Http2Stream *>(s->link.next)) {
-    if (s->get_id() == id) {
-      return s;
-    }
-    ink_assert(s != s->link.next);
-  }
-  return nullptr;
+  return stream_table.find(id);
 }
 
 void
@@ -2060,30 +2107,15 @@ Http2ConnectionState::delete_stream(Http2Stream *stream)
   Http2StreamDebug(session, stream->get_id(), "Delete stream");
   REMEMBER(NO_EVENT, this->recursion);
 
-  if (Http2::stream_priority_enabled) {
-    Http2DependencyTree::Node *node       = stream->priority_node;
-    Http2DependencyTree::Node *node_by_id = this->dependency_tree->find(stream->get_id());
-    ink_assert(node == node_by_id);
-    if (node != nullptr) {
-      if (node->active) {
-        dependency_tree->deactivate(node, 0);
-      }
-      if (dbg_ctl_http2_priority.on()) {
-        std::stringstream output;
-        dependency_tree->dump_tree(output);
-        Dbg(dbg_ctl_http2_priority, "[%" PRId64 "] %s", session->get_connection_id(), output.str().c_str());
-      }
-      dependency_tree->remove(node);
-      // ink_release_assert(dependency_tree->find(stream->get_id()) == nullptr);
-    }
-    stream->priority_node = nullptr;
-  }
+  // The stream may have been scheduled before stream priority was disabled.
+  priority_scheduler.deactivate(stream->priority_node);
 
   if (stream->get_state() != Http2StreamState::HTTP2_STREAM_STATE_CLOSED) {
     send_rst_stream_frame(stream->get_id(), Http2ErrorCode::HTTP2_ERROR_NO_ERROR);
   }
 
   stream_list.remove(stream);
+  stream_table.erase(stream->get_id());
   if (http2_is_client_streamid(stream->get_id())) {
     ink_release_assert(peer_streams_count_in > 0);
     --peer_streams_count_in;
@@ -2184,16 +2216,32 @@ Http2ConnectionState::update_initial_local_rwnd(Http2WindowSize new_size)
   }
 }
 
+void
+Http2ConnectionState::_set_stream_priority(Http2Stream *stream)
+{
+  // Those for streams the client skipped over are of no more use.
+  auto pending = pending_priorities.lower_bound(stream->get_id());
+  pending      = pending_priorities.erase(pending_priorities.begin(), pending);
+
+  HttpPriority priority;
+  if (pending != pending_priorities.end() && pending->first == stream->get_id()) {
+    priority = pending->second;
+    pending_priorities.erase(pending);
+  } else {
+    priority = HttpPriority::from_header(stream->get_receive_header());
+  }
+  Dbg(dbg_ctl_http2_priority, "[%" PRId64 "] [%u] priority u=%u, i=%d", session->get_connection_id(), stream->get_id(),
+      priority.urgency, priority.incremental);
+  priority_scheduler.reprioritize(stream->priority_node, priority);
+}
+
 void
 Http2ConnectionState::schedule_stream_to_send_priority_frames(Http2Stream *stream)
 {
   Http2StreamDebug(session, stream->get_id(), "Scheduling sending priority frames");
 
-  Http2DependencyTree::Node *node = stream->priority_node;
-  ink_release_assert(node != nullptr);
-
   SCOPED_MUTEX_LOCK(lock, this->mutex, this_ethread());
-  dependency_tree->activate(node);
+  priority_scheduler.activate(stream->priority_node);
 
   if (_priority_event == nullptr) {
     SET_HANDLER(&Http2ConnectionState::main_event_handler);
@@ -2246,42 +2294,41 @@ Http2ConnectionState::cancel_retransmit()
 void
 Http2ConnectionState::send_data_frames_depends_on_priority()
 {
-  Http2DependencyTree::Node *node = dependency_tree->top();
+  PriorityScheduler::Node *node = priority_scheduler.top();
 
   // No node to send or no connection level window left
   if (node == nullptr || _peer_rwnd <= 0) {
     return;
   }
 
-  Http2Stream *stream = static_cast<Http2Stream *>(node->t);
+  Http2Stream *stream = node->t;
   ink_release_assert(stream != nullptr);
-  ink_release_assert(stream->priority_node == node);
-  Http2StreamDebug(session, stream->get_id(), "top node, point=%d", node->point);
+  Http2StreamDebug(session, stream->get_id(), "top node, urgency=%u, incremental=%d", node->priority.urgency,
+                   node->priority.incremental);
 
   size_t                   len    = 0;
   Http2SendDataFrameResult result = send_a_data_frame(stream, len);
-  ink_release_assert(stream->priority_node != nullptr);
 
   switch (result) {
   case Http2SendDataFrameResult::NO_ERROR: {
     // No response body to send
     if (len == 0 && !stream->is_write_vio_done()) {
-      dependency_tree->deactivate(node, len);
+      priority_scheduler.deactivate(*node);
     } else {
-      dependency_tree->update(node, len);
+      priority_scheduler.update(*node);
       SCOPED_MUTEX_LOCK(stream_lock, stream->mutex, this_ethread());
       stream->signal_write_event(stream->is_write_vio_done() ? VC_EVENT_WRITE_COMPLETE : VC_EVENT_WRITE_READY);
     }
     break;
   }
   case Http2SendDataFrameResult::DONE: {
-    dependency_tree->deactivate(node, len);
+    priority_scheduler.deactivate(*node);
     stream->initiating_close();
     break;
   }
   default:
     // When no stream level window left, deactivate node once and wait window_update frame
-    dependency_tree->deactivate(node, len);
+    priority_scheduler.deactivate(*node);
     break;
   }
 
@@ -2541,6 +2588,8 @@ Http2ConnectionState::send_headers_frame(Http2Stream *stream)
   }
 
   Http2StreamDebug(session, stream->get_id(), "Send HEADERS frame flags: 0x%x length: %d", flags, payload_length);
+  // The HEADERS frame and its CONTINUATION frames go out in one write.
+  Http2FrameBatch   batch(this->session);
   Http2HeadersFrame headers(stream->get_id(), flags, buf, payload_length);
   this->session->xmit(headers);
   uint64_t sent = payload_length;
@@ -2620,22 +2669,26 @@ Http2ConnectionState::send_push_promise_frame(Http2Stream *stream, URL &url, con
   push_promise.promised_streamid = id;
 
   Http2PushPromiseFrame push_promise_frame(stream->get_id(), flags, push_promise, buf, payload_length);
-  this->session->xmit(push_promise_frame);
-  uint64_t sent = payload_length;
+  {
+    // The PUSH_PROMISE frame and its CONTINUATION frames go out in one write.
+    Http2FrameBatch batch(this->session);
+    this->session->xmit(push_promise_frame);
+    uint64_t sent = payload_length;
+
+    // Send CONTINUATION frames
+    flags = 0;
+    while (sent < header_blocks_size) {
+      Http2StreamDebug(session, stream->get_id(), "Send CONTINUATION frame");
+      payload_length = std::min(static_cast<uint32_t>(BUFFER_SIZE_FOR_INDEX(buffer_size_index[HTTP2_FRAME_TYPE_CONTINUATION])),
+                                static_cast<uint32_t>(header_blocks_size - sent));
+      if (sent + payload_length == header_blocks_size) {
+        flags |= HTTP2_FLAGS_CONTINUATION_END_HEADERS;
+      }
 
-  // Send CONTINUATION frames
-  flags = 0;
-  while (sent < header_blocks_size) {
-    Http2StreamDebug(session, stream->get_id(), "Send CONTINUATION frame");
-    payload_length = std::min(static_cast<uint32_t>(BUFFER_SIZE_FOR_INDEX(buffer_size_index[HTTP2_FRAME_TYPE_CONTINUATION])),
-                              static_cast<uint32_t>(header_blocks_size - sent));
-    if (sent + payload_length == header_blocks_size) {
-      flags |= HTTP2_FLAGS_CONTINUATION_END_HEADERS;
+      Http2ContinuationFrame continuation(stream->get_id(), flags, buf + sent, payload_length);
+      this->session->xmit(continuation);
+      sent += payload_length;
     }
-
-    Http2ContinuationFrame continuation(stream->get_id(), flags, buf + sent, payload_length);
-    this->session->xmit(continuation);
-    sent += payload_length;
   }
 
   Http2Error error(Http2ErrorClass::HTTP2_ERROR_CLASS_NONE);
@@ -2645,19 +2698,6 @@ Http2ConnectionState::send_push_promise_frame(Http2Stream *stream, URL &url, con
   }
 
   SCOPED_MUTEX_LOCK(stream_lock, stream->mutex, this_ethread());
-  if (Http2::stream_priority_enabled) {
-    Http2DependencyTree::Node *node = this->dependency_tree->find(id);
-    if (node != nullptr) {
-      stream->priority_node = node;
-    } else {
-      Http2StreamDebug(this->session, id, "PRIORITY - dep: %d, weight: %d, excl: %d, tree size: %d",
-                       HTTP2_PRIORITY_DEFAULT_STREAM_DEPENDENCY, HTTP2_PRIORITY_DEFAULT_WEIGHT, false,
-                       this->dependency_tree->size());
-
-      stream->priority_node =
-        this->dependency_tree->add(HTTP2_PRIORITY_DEFAULT_STREAM_DEPENDENCY, id, HTTP2_PRIORITY_DEFAULT_WEIGHT, false, stream);
-    }
-  }
   stream->change_state(HTTP2_FRAME_TYPE_PUSH_PROMISE, HTTP2_FLAGS_PUSH_PROMISE_END_HEADERS);
   stream->set_receive_headers(hdr);
   stream->new_transaction();
@@ -1197,20 +1197,18 @@ Http2Stream::_switch_thread_if_not_on_right_thread(int event, void *edata)
   return true;
 }
 
+// Streams are scheduled by their RFC 9218 priority. The RFC 7540 weight and dependency are not
+// kept, so these report a stream without one.
 int
 Http2Stream::get_transaction_priority_weight() const
 {
-  return priority_node ? priority_node->weight : 0;
+  return 0;
 }
 
 int
 Http2Stream::get_transaction_priority_dependence() const
 {
-  if (!priority_node) {
-    return -1;
-  } else {
-    return priority_node->parent ? priority_node->parent->id : 0;
-  }
+  return -1;
 }
 
 int64_t
@@ -0,0 +1,101 @@
+/** @file
+
+    Unit tests for Http2StreamTable
+
+    @section license License
+
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#include <catch2/catch_test_macros.hpp>
+
+#include "proxy/http2/Http2StreamTable.h"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <random>
+
+namespace
+{
+struct Stream {
+  Http2StreamId id = 0;
+};
+
+using Table = Http2StreamTable<Stream>;
+} // namespace
+
+TEST_CASE("Http2StreamTable basics", "[http2][Http2StreamTable]")
+{
+  Table  table;
+  Stream a{1}, b{3}, c{2};
+
+  CHECK(table.find(1) == nullptr);
+  CHECK_FALSE(table.erase(1));
+
+  table.insert(a.id, &a);
+  table.insert(b.id, &b);
+  table.insert(c.id, &c);
+  CHECK(table.size() == 3);
+  CHECK(table.find(1) == &a);
+  CHECK(table.find(3) == &b);
+  CHECK(table.find(2) == &c);
+  CHECK(table.find(5) == nullptr);
+
+  CHECK(table.erase(1));
+  CHECK_FALSE(table.erase(1));
+  CHECK(table.find(1) == nullptr);
+  CHECK(table.find(3) == &b);
+  CHECK(table.find(2) == &c);
+  CHECK(table.size() == 2);
+}
+
+TEST_CASE("Http2StreamTable churn", "[http2][Http2StreamTable]")
+{
+  // Streams opened in order and closed at random, as on a busy connection, with some that stay
+  // open a long time so the open identifiers wrap around the table and collide.
+  Table                           table;
+  std::map<Http2StreamId, Stream> open;
+  std::mt19937                    rng(13);
+  Http2StreamId                   next = 1;
+
+  for (int round = 0; round < 50000; ++round) {
+    if (open.empty() || rng() % 100 < 52) {
+      Stream &s = open[next];
+      s.id      = next;
+      table.insert(s.id, &s);
+      next += 2;
+    } else {
+      // Mostly recent streams close, now and then an old one.
+      size_t back = rng() % 10 ? rng() % std::min<size_t>(open.size(), 8) : rng() % open.size();
+      auto   it   = std::prev(open.end(), 1 + back);
+      REQUIRE(table.erase(it->first));
+      open.erase(it);
+    }
+    REQUIRE(table.size() == open.size());
+
+    if (round % 97 == 0) {
+      for (auto &[id, s] : open) {
+        REQUIRE(table.find(id) == &s);
+      }
+      for (Http2StreamId id = next; id > 2 && id + 256 > next; id -= 2) {
+        if (open.count(id - 2) == 0) {
+          REQUIRE(table.find(id - 2) == nullptr);
+        }
+      }
+    }
+  }
+}
@@ -24,6 +24,7 @@
 #include "proxy/http3/Http3HeaderVIOAdaptor.h"
 #include "proxy/http3/Http3Transaction.h"
 #include "proxy/hdrs/HeaderValidator.h"
+#include "proxy/hdrs/HttpPriority.h"
 
 #include "iocore/eventsystem/VIO.h"
 #include "proxy/hdrs/HTTP.h"
@@ -129,6 +130,12 @@ Http3HeaderVIOAdaptor::_on_qpack_decode_complete()
     return 0;
   }
 
+  // The priority comes from the request header. A later header block on the stream is trailers,
+  // which must not reset it.
+  if (this->_txn != nullptr && !this->_is_complete && this->_txn->direction() == NET_VCONNECTION_IN) {
+    this->_txn->set_priority(HttpPriority::from_header(&this->_header));
+  }
+
   SCOPED_MUTEX_LOCK(lock, this->_sink_vio->mutex, this_ethread());
   MIOBuffer *writer = this->_sink_vio->get_writer();
 
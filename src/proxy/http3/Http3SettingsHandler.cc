@@ -78,7 +78,9 @@ Http3SettingsHandler::handle_frame(std::shared_ptr<const Http3Frame> frame, Http
 
   if (settings_frame->contains(Http3SettingsId::NUM_PLACEHOLDERS)) {
     uint64_t num_placeholders = settings_frame->get(Http3SettingsId::NUM_PLACEHOLDERS);
-    // TODO: update settings for priority tree
+    // Placeholders were nodes of the priority tree of early HTTP/3 drafts. Streams are prioritized
+    // by their RFC 9218 priority instead, see HQTransaction::set_priority, so there is nothing to
+    // update.
 
     Dbg(dbg_ctl_http3, "SETTINGS_NUM_PLACEHOLDERS: %" PRId64, num_placeholders);
   }
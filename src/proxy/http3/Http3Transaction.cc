@@ -236,6 +236,14 @@ HQTransaction::direction() const
   return this->_proxy_ssn->get_netvc()->get_context();
 }
 
+void
+HQTransaction::set_priority(const HttpPriority &priority)
+{
+  // quiche decides which stream of the connection goes into the next packet, so the priority is
+  // handed to it rather than to an HttpPriorityScheduler as HTTP/2 does.
+  this->_info.adapter.stream().set_priority(priority.urgency, priority.incremental);
+}
+
 void
 HQTransaction::_schedule_read_ready_event()
 {
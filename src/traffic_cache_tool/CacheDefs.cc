@@ -249,6 +249,7 @@ StripeSM::InitializeMeta()
       j.phase = j.cycle = j.sync_serial = j.write_serial = j.dirty = 0;
       j.create_time                                                = time(nullptr);
       j.sector_size                                                = DEFAULT_HW_SECTOR_SIZE;
+      j.dir_layout                                                 = static_cast<uint32_t>(_dir_layout);
     }
   }
   if (!freelist) // freelist is not allocated yet
@@ -359,16 +360,17 @@ StripeSM::updateHeaderFooter()
 size_t
 StripeSM::vol_dirlen()
 {
-  return vol_headerlen() + ROUND_TO_STORE_BLOCK(((size_t)this->_buckets) * DIR_DEPTH * this->_segments * SIZEOF_DIR) +
+  return vol_headerlen() + ROUND_TO_STORE_BLOCK(((size_t)this->_buckets) * dir_bucket_size() * this->_segments) +
          ROUND_TO_STORE_BLOCK(sizeof(StripeMeta));
 }
 
 void
 StripeSM::vol_init_data_internal()
 {
+  int64_t max_buckets = MAX_ENTRIES_PER_SEGMENT / dir_depth();
   this->_buckets =
-    ((this->_len.count() * 8192 - (this->_content - this->_start)) / cache_config_min_average_object_size) / DIR_DEPTH;
-  this->_segments = (this->_buckets + (((1 << 16) - 1) / DIR_DEPTH)) / ((1 << 16) / DIR_DEPTH);
+    ((this->_len.count() * 8192 - (this->_content - this->_start)) / cache_config_min_average_object_size) / dir_depth();
+  this->_segments = (this->_buckets + max_buckets - 1) / max_buckets;
   this->_buckets  = (this->_buckets + this->_segments - 1) / this->_segments;
   this->_content  = this->_start + Bytes(2 * vol_dirlen());
 }
@@ -382,6 +384,54 @@ StripeSM::vol_init_data()
   this->vol_init_data_internal();
 }
 
+int
+StripeSM::dir_depth() const
+{
+  return _dir_layout == ts::DirLayout::WIDE ? DIR_WIDE_DEPTH : DIR_DEPTH;
+}
+
+int
+StripeSM::dir_bucket_size() const
+{
+  return _dir_layout == ts::DirLayout::WIDE ? DIR_WIDE_BUCKET_SIZE : DIR_DEPTH * SIZEOF_DIR;
+}
+
+CacheDirEntry *
+StripeSM::dir_bucket(int64_t b, CacheDirEntry *seg) const
+{
+  return reinterpret_cast<CacheDirEntry *>(reinterpret_cast<char *>(seg) + b * dir_bucket_size());
+}
+
+CacheDirEntry *
+StripeSM::dir_from_offset(int64_t i, CacheDirEntry *seg) const
+{
+  if (!i) {
+    return nullptr;
+  }
+  return dir_bucket_row(dir_bucket(i / dir_depth(), seg), i % dir_depth());
+}
+
+int64_t
+StripeSM::dir_to_offset(const CacheDirEntry *d, const CacheDirEntry *seg) const
+{
+  int64_t bytes = reinterpret_cast<const char *>(d) - reinterpret_cast<const char *>(seg);
+  return (bytes / dir_bucket_size()) * dir_depth() + (bytes % dir_bucket_size()) / SIZEOF_DIR;
+}
+
+CacheDirEntry *
+StripeSM::next_dir(CacheDirEntry *d, CacheDirEntry *seg) const
+{
+  return dir_from_offset(dir_next(d), seg);
+}
+
+void
+StripeSM::set_dir_layout(ts::DirLayout layout)
+{
+  _dir_layout = layout;
+  _content    = Bytes(0);
+  this->vol_init_data();
+}
+
 void
 StripeSM::updateLiveData([[maybe_unused]] enum Copy c)
 {
@@ -591,8 +641,8 @@ StripeSM::dir_init_segment(int s)
   this->freelist[s]  = 0;
   CacheDirEntry *seg = this->dir_segment(s);
   int            l, b;
-  memset(seg, 0, SIZEOF_DIR * DIR_DEPTH * this->_buckets);
-  for (l = 1; l < DIR_DEPTH; l++) {
+  memset(seg, 0, dir_bucket_size() * this->_buckets);
+  for (l = 1; l < dir_depth(); l++) {
     for (b = 0; b < this->_buckets; b++) {
       CacheDirEntry *bucket = dir_bucket(b, seg);
       this->dir_free_entry(dir_bucket_row(bucket, l), s);
@@ -607,7 +657,7 @@ StripeSM::init_dir()
     this->freelist[s]  = 0;
     CacheDirEntry *seg = this->dir_segment(s);
     int            l, b;
-    for (l = 1; l < DIR_DEPTH; l++) {
+    for (l = 1; l < dir_depth(); l++) {
       for (b = 0; b < this->_buckets; b++) {
         CacheDirEntry *bucket = dir_bucket(b, seg);
         this->dir_free_entry(dir_bucket_row(bucket, l), s);
@@ -631,6 +681,150 @@ StripeSM::loadDir()
   }
   return zret;
 }
+
+Errata
+StripeSM::convertDir(ts::DirLayout layout)
+{
+  Errata zret;
+  if (layout == _dir_layout) {
+    std::cout << "Stripe " << hashText << " already uses the requested directory layout" << std::endl;
+    return zret;
+  }
+  if (_meta_pos[A][FOOT] == 0 || _meta[A][HEAD].sync_serial != _meta[A][FOOT].sync_serial) {
+    zret.note("Stripe {} has no consistent directory copy A, not converting", hashText);
+    return zret;
+  }
+
+  // The directory does not record keys, only 12 bits of tag. Read the key of
+  // every live entry back from its Doc so it can be placed in the new geometry.
+  struct Entry {
+    CacheDirEntry dir;
+    CryptoHash    key;
+    Bytes         pos;
+  };
+  std::vector<Entry> entries;
+  char              *doc_buff = static_cast<char *>(ats_memalign(ats_pagesize(), CACHE_BLOCK_SIZE));
+  for (int s = 0; s < _segments; s++) {
+    CacheDirEntry     *seg = this->dir_segment(s);
+    std::bitset<65536> seen;
+    for (int b = 0; b < _buckets; b++) {
+      for (CacheDirEntry *e = dir_bucket(b, seg); e && dir_offset(e); e = next_dir(e, seg)) {
+        int64_t i = dir_to_offset(e, seg);
+        if (seen.test(i)) {
+          break; // loop
+        }
+        seen.set(i);
+        if (!dir_valid(e)) {
+          continue;
+        }
+        Bytes pos = stripe_offset(e);
+        if (pread(_span->_fd, doc_buff, CACHE_BLOCK_SIZE, pos) < CACHE_BLOCK_SIZE) {
+          continue;
+        }
+        Doc const *doc = reinterpret_cast<Doc *>(doc_buff);
+        if (doc->magic != DOC_MAGIC) {
+          continue;
+        }
+        // Heads are filed under the first key of the object, fragments under their own key.
+        CryptoHash const &key =
+          dir_head(e) && dir_tag(e) == DIR_MASK_TAG(doc->first_key.slice32(2)) ? doc->first_key : doc->key;
+        if (dir_tag(e) == DIR_MASK_TAG(key.slice32(2))) {
+          entries.push_back({*e, key, pos});
+        }
+      }
+    }
+  }
+  ats_free(doc_buff);
+
+  Bytes old_content = _content;
+  ats_free(reinterpret_cast<char *>(const_cast<CacheDirEntry *>(dir)) - vol_headerlen());
+  this->set_dir_layout(layout);
+  std::cout << "Stripe " << hashText << ": content moves from " << old_content << " to " << _content << ", " << _segments
+            << " segments of " << _buckets << " buckets" << std::endl;
+
+  int64_t hdr_size    = vol_headerlen();
+  int64_t dir_size    = vol_dirlen();
+  int64_t footer_size = ROUND_TO_STORE_BLOCK(sizeof(StripeMeta));
+  char   *raw_dir     = static_cast<char *>(ats_memalign(ats_pagesize(), dir_size));
+  memset(raw_dir, 0, dir_size);
+  dir = reinterpret_cast<CacheDirEntry *>(raw_dir + hdr_size);
+  free(freelist);
+  freelist = static_cast<uint16_t *>(malloc(_segments * sizeof(uint16_t)));
+
+  // Place the entries, spilling past full buckets into free rows taken from
+  // the end of the segment. The freelists are built from whatever is left.
+  std::vector<int64_t> spill(_segments, _buckets * dir_depth());
+  int64_t              kept = 0, dropped = 0;
+  for (auto const &[d, key, pos] : entries) {
+    if (pos < _content) {
+      ++dropped; // overwritten by the larger directory
+      continue;
+    }
+    int            s      = key.slice32(0) % _segments;
+    CacheDirEntry *seg    = this->dir_segment(s);
+    CacheDirEntry *bucket = dir_bucket(key.slice32(1) % _buckets, seg);
+    CacheDirEntry *e      = nullptr;
+    for (int l = 0; l < dir_depth() && !e; l++) {
+      if (!dir_offset(dir_bucket_row(bucket, l))) {
+        e = dir_bucket_row(bucket, l);
+      }
+    }
+    while (!e && --spill[s] > 0) {
+      CacheDirEntry *row = dir_from_offset(spill[s], seg);
+      if (spill[s] % dir_depth() && !dir_offset(row)) {
+        e = row;
+      }
+    }
+    if (!e) {
+      ++dropped; // segment full
+      continue;
+    }
+    int64_t offset = (pos - _content).count() / CACHE_BLOCK_SIZE + 1;
+    dir_assign(e, &d);
+    dir_set_next(e, 0);
+    dir_set_offset(e, offset);
+    if (e != bucket) {
+      CacheDirEntry *last = bucket;
+      while (dir_next(last)) {
+        last = next_dir(last, seg);
+      }
+      dir_set_next(last, dir_to_offset(e, seg));
+    }
+    ++kept;
+  }
+  for (int s = 0; s < _segments; s++) {
+    CacheDirEntry *seg = this->dir_segment(s);
+    freelist[s]        = 0;
+    for (int l = 1; l < dir_depth(); l++) {
+      for (int b = 0; b < _buckets; b++) {
+        CacheDirEntry *e = dir_bucket_row(dir_bucket(b, seg), l);
+        if (!dir_offset(e)) {
+          dir_free_entry(e, s);
+        }
+      }
+    }
+  }
+  std::cout << "Stripe " << hashText << ": kept " << kept << " directory entries, dropped " << dropped << std::endl;
+
+  StripeMeta meta = _meta[A][HEAD];
+  meta.dir_layout = static_cast<uint32_t>(layout);
+  meta.dirty      = 0;
+  for (off_t *p : {&meta.write_pos, &meta.last_write_pos, &meta.agg_pos}) {
+    *p = std::max(*p, static_cast<off_t>(_content.count()));
+  }
+  memcpy(raw_dir, &meta, sizeof(StripeMeta));
+  memcpy(raw_dir + sizeof(StripeMeta) - sizeof(uint16_t), freelist, _segments * sizeof(uint16_t));
+  memcpy(raw_dir + dir_size - footer_size, &meta, sizeof(StripeMeta));
+  for (auto i : {A, B}) {
+    ssize_t n = pwrite(_span->_fd, raw_dir, dir_size, _start + Bytes(i * dir_size));
+    if (n < dir_size) {
+      zret = Errata(make_errno_code(), "Failed to write stripe directory ");
+      break;
+    }
+    _meta[i][HEAD] = _meta[i][FOOT] = meta;
+  }
+  return zret;
+}
 //
 // Cache Directory
 //
@@ -675,7 +869,7 @@ StripeSM::dir_freelist_length(int s)
   CacheDirEntry *seg  = this->dir_segment(s);
   CacheDirEntry *e    = dir_from_offset(this->freelist[s], seg);
   if (this->check_loop(s)) {
-    return (DIR_DEPTH - 1) * this->_buckets;
+    return (dir_depth() - 1) * this->_buckets;
   }
   while (e) {
     free++;
@@ -736,10 +930,10 @@ StripeSM::dir_check()
   ink_zero(frag_demographics);
 
   std::cout << "Stripe '[" << hashText << "]'" << std::endl;
-  std::cout << "  Directory Bytes: " << _segments * _buckets * SIZEOF_DIR << std::endl;
+  std::cout << "  Directory Bytes: " << _segments * _buckets * dir_bucket_size() << std::endl;
   std::cout << "  Segments:  " << _segments << std::endl;
   std::cout << "  Buckets per segment:  " << _buckets << std::endl;
-  std::cout << "  Entries:  " << _segments * _buckets * DIR_DEPTH << std::endl;
+  std::cout << "  Entries:  " << _segments * _buckets * dir_depth() << std::endl;
 
   for (int s = 0; s < _segments; s++) {
     CacheDirEntry *seg                = this->dir_segment(s);
@@ -768,7 +962,7 @@ StripeSM::dir_check()
           ink_assert(nullptr == next_dir(e, seg));
           break;
         } else {
-          int e_idx = e - seg;
+          int e_idx = dir_to_offset(e, seg);
           ++h;
           chain_tag[chain_idx++] = dir_tag(e);
           if (chain_mark[e_idx] == mark) {
@@ -913,6 +1107,10 @@ StripeSM::loadMeta()
   meta = static_cast<StripeMeta *>(data.data());
   // TODO:: We need to read more data at this point  to populate dir
   if (this->validateMeta(meta)) {
+    // The directory geometry depends on the layout recorded in the header.
+    if (meta->dir_layout != static_cast<uint32_t>(_dir_layout) && meta->dir_layout <= static_cast<uint32_t>(ts::DirLayout::WIDE)) {
+      this->set_dir_layout(static_cast<ts::DirLayout>(meta->dir_layout));
+    }
     delta               = Bytes(data.rebind<char>().data() - stripe_buff2);
     _meta[A][HEAD]      = *meta;
     _meta_pos[A][HEAD]  = round_down(pos + Bytes(delta));
@@ -78,6 +78,13 @@ constexpr static int MAX_VOLUME_IDX          = 255;
 constexpr static int ENTRIES_PER_BUCKET      = 4;
 constexpr static int MAX_BUCKETS_PER_SEGMENT = (1 << 16) / ENTRIES_PER_BUCKET;
 
+/// Arrangement of the stripe directory, recorded in the stripe header.
+/// @internal DirLayout in P_CacheDir.h
+enum class DirLayout : uint32_t {
+  CLASSIC = 0, ///< ENTRIES_PER_BUCKET entries per bucket, packed.
+  WIDE    = 1, ///< DIR_WIDE_DEPTH entries per bucket, padded to one cache line.
+};
+
 using Bytes     = swoc::Scalar<1, off_t, ts::tag::bytes>;
 using Kilobytes = swoc::Scalar<1024, off_t, ts::tag::bytes>;
 using Megabytes = swoc::Scalar<1024 * Kilobytes::SCALE, off_t, ts::tag::bytes>;
@@ -160,7 +167,7 @@ public:
   uint32_t      write_serial;
   uint32_t      dirty;
   uint32_t      sector_size;
-  uint32_t      unused; // pad out to 8 byte boundary
+  uint32_t      dir_layout; // DirLayout, also pads out to 8 byte boundary
   uint16_t      freelist[1];
 };
 
@@ -362,6 +369,9 @@ constexpr int            STRIPE_HASH_TABLE_SIZE  = 32707;
 constexpr unsigned short STRIPE_HASH_EMPTY       = 65535;
 constexpr int            DIR_TAG_WIDTH           = 12;
 constexpr int            DIR_DEPTH               = 4;
+constexpr int            DIR_WIDE_DEPTH          = 6;
+constexpr int            DIR_WIDE_BUCKET_SIZE    = 64;
+constexpr uint32_t       DOC_MAGIC               = 0x5F129B13;
 constexpr int            SIZEOF_DIR              = 10;
 constexpr int            MAX_ENTRIES_PER_SEGMENT = (1 << 16);
 constexpr int            DIR_SIZE_WIDTH          = 6;
@@ -536,8 +546,9 @@ struct StripeSM {
   int8_t           _idx        = -1; ///< StripeSM index in span.
   int              agg_buf_pos = 0;
 
-  int64_t _buckets  = 0; ///< Number of buckets per segment.
-  int64_t _segments = 0; ///< Number of segments.
+  int64_t       _buckets    = 0;                      ///< Number of buckets per segment.
+  int64_t       _segments   = 0;                      ///< Number of segments.
+  ts::DirLayout _dir_layout = ts::DirLayout::CLASSIC; ///< Directory layout.
 
   std::string hashText;
 
@@ -555,7 +566,7 @@ struct StripeSM {
   inline CacheDirEntry *
   vol_dir_segment(int s)
   {
-    return (CacheDirEntry *)(((char *)this->dir) + (s * this->_buckets) * DIR_DEPTH * SIZEOF_DIR);
+    return (CacheDirEntry *)(((char *)this->dir) + (s * this->_buckets) * dir_bucket_size());
   }
   inline CacheDirEntry *
   dir_segment(int s)
@@ -563,6 +574,17 @@ struct StripeSM {
     return vol_dir_segment(s);
   }
 
+  /// Entries, and bytes, per bucket for the directory layout.
+  int dir_depth() const;
+  int dir_bucket_size() const;
+  /// Layout aware versions of the directory position helpers.
+  CacheDirEntry *dir_bucket(int64_t b, CacheDirEntry *seg) const;
+  CacheDirEntry *dir_from_offset(int64_t i, CacheDirEntry *seg) const;
+  int64_t        dir_to_offset(const CacheDirEntry *d, const CacheDirEntry *seg) const;
+  CacheDirEntry *next_dir(CacheDirEntry *d, CacheDirEntry *seg) const;
+  /// Switch to @a layout and recompute the stripe geometry.
+  void set_dir_layout(ts::DirLayout layout);
+
   Bytes  stripe_offset(CacheDirEntry *e); // offset w.r.t the stripe content
   size_t vol_dirlen();
   inline int
@@ -583,5 +605,7 @@ struct StripeSM {
   Errata InitializeMeta();
   void   init_dir();
   Errata clear(); // clears striped headers and footers
+  /// Rewrite the directory in @a layout, keeping the entries whose content survives the move.
+  Errata convertDir(ts::DirLayout layout);
 };
 } // namespace ct
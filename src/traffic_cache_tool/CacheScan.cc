@@ -44,11 +44,11 @@ CacheScan::Scan(bool search)
     dir_bitset.reset();
     for (int b = 0; b < this->stripe->_buckets; b++) {
       CacheDirEntry *seg = this->stripe->dir_segment(s);
-      CacheDirEntry *e   = dir_bucket(b, seg);
+      CacheDirEntry *e   = this->stripe->dir_bucket(b, seg);
       if (dir_offset(e)) {
         do {
           // loop detected
-          if (dir_bitset[dir_to_offset(e, seg)]) {
+          if (dir_bitset[this->stripe->dir_to_offset(e, seg)]) {
             break;
           }
           int64_t size = dir_approx_size(e);
@@ -65,8 +65,8 @@ CacheScan::Scan(bool search)
             Doc *doc = reinterpret_cast<Doc *>(stripe_buff2);
             get_alternates(doc->hdr(), doc->hlen, search);
           }
-          dir_bitset[dir_to_offset(e, seg)] = true;
-          e                                 = next_dir(e, seg);
+          dir_bitset[this->stripe->dir_to_offset(e, seg)] = true;
+          e                                               = this->stripe->next_dir(e, seg);
         } while (e);
       }
     }
@@ -607,8 +607,8 @@ Cache::dumpSpans(SpanDumpDepth depth)
                     << " type=" << static_cast<int>(stripe->_type) << " " << (stripe->isFree() ? "free" : "in-use") << std::endl;
 
           std::cout << "      " << stripe->_segments << " segments with " << stripe->_buckets << " buckets per segment for "
-                    << stripe->_buckets * stripe->_segments * ts::ENTRIES_PER_BUCKET << " total directory entries taking "
-                    << stripe->_buckets * stripe->_segments * sizeof(CacheDirEntry) * ts::ENTRIES_PER_BUCKET
+                    << stripe->_buckets * stripe->_segments * stripe->dir_depth() << " total directory entries taking "
+                    << stripe->_buckets * stripe->_segments * stripe->dir_bucket_size()
                     //                        << " out of " << (delta-header_len).units() << " bytes."
                     << std::endl;
           if (depth >= SpanDumpDepth::STRIPE) {
@@ -1273,6 +1273,34 @@ Check_Freelist(const std::string &devicePath)
   }
 }
 
+void
+Convert_Dir(const std::string &devicePath, ts::DirLayout layout)
+{
+  Cache cache;
+
+  if (!OPEN_RW_FLAG) {
+    err.note("Writing Not Enabled.. Please use --write to enable writing to disk");
+    return;
+  }
+
+  if ((err = cache.loadSpan(SpanFile))) {
+    cache.dumpSpans(Cache::SpanDumpDepth::SPAN);
+    for (auto &sp : cache._spans) {
+      if (devicePath.size() > 0 && sp->_path.view() != devicePath) {
+        continue;
+      }
+      for (auto strp : sp->_stripes) {
+        if (strp->isFree()) {
+          continue;
+        }
+        strp->loadMeta();
+        strp->loadDir();
+        err.note(strp->convertDir(layout));
+      }
+    }
+  }
+}
+
 void
 Init_disk(swoc::file::path const &input_file_path)
 {
@@ -1394,6 +1422,9 @@ main([[maybe_unused]] int argc, const char *argv[])
   parser.add_command("init", " Initializes uninitialized span", [&]() { Init_disk(input_url_file); });
   parser.add_command("scan", " Scans the whole cache and lists the urls of the cached contents",
                      [&]() { Scan_Cache(input_url_file); });
+  auto &conv = parser.add_command("dir_convert", "Rewrite stripe directories in another layout, offline only").require_commands();
+  conv.add_command("wide", "one cache line per bucket", [&]() { Convert_Dir(inputFile, ts::DirLayout::WIDE); });
+  conv.add_command("classic", "four packed entries per bucket", [&]() { Convert_Dir(inputFile, ts::DirLayout::CLASSIC); });
 
   // parse the arguments
   auto arguments = parser.parse(argv);
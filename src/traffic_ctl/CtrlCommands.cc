@@ -1152,6 +1152,9 @@ ServerCommand::ServerCommand(ts::Arguments *args) : CtrlCommand(args)
   } else if (get_parsed_arguments()->get(STATUS_STR)) {
     _printer      = std::make_unique<ServerStatusPrinter>(printOpts);
     _invoked_func = [&]() { server_status(); };
+  } else if (get_parsed_arguments()->get(PROFILE_STR)) {
+    _printer      = std::make_unique<EventLoopProfilePrinter>(printOpts);
+    _invoked_func = [&]() { server_profile(); };
   }
 }
 
@@ -1225,6 +1228,14 @@ ServerCommand::server_status()
   _printer->write_output(response);
 }
 
+void
+ServerCommand::server_profile()
+{
+  GetEventLoopProfileRequest   request{{std::stoi(get_parsed_arguments()->get(TOP_STR).value())}};
+  shared::rpc::JSONRPCResponse response = invoke_rpc(request);
+  _printer->write_output(response);
+}
+
 // //------------------------------------------------------------------------------------------------------------------------------------
 StorageCommand::StorageCommand(ts::Arguments *args) : CtrlCommand(args)
 {
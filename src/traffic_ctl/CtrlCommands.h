@@ -252,9 +252,13 @@ private:
 
   static inline const std::string STATUS_STR{"status"};
 
+  static inline const std::string PROFILE_STR{"profile"};
+  static inline const std::string TOP_STR{"top"};
+
   void server_drain();
   void server_debug();
   void server_status();
+  void server_profile();
 };
 //
 // -----------------------------------------------------------------------------------------------------------------------------------
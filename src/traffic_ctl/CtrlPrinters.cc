@@ -671,3 +671,36 @@ ServerStatusPrinter::write_output(YAML::Node const &result)
   write_output_json(result["data"] ? result["data"] : result);
 }
 //-------------------------------------------------------------------------------------------------------------------------------------
+void
+EventLoopProfilePrinter::write_output(YAML::Node const &result)
+{
+  auto const &data = result["data"];
+  std::string text;
+
+  auto print_sites = [&text](YAML::Node const &sites) {
+    std::cout << swoc::bwprint(text, "  {:>6} {:>12} {:>10} {:>10}  {}\n", "%", "total(us)", "max(us)", "samples", "handler");
+    for (auto &&site : sites) {
+      std::cout << swoc::bwprint(text, "  {:>6.1} {:>12} {:>10} {:>10}  {}\n", site["percent"].as<double>(),
+                                 site["total_us"].as<std::string>(), site["max_us"].as<std::string>(),
+                                 site["samples"].as<std::string>(), site["handler"].as<std::string>());
+    }
+  };
+
+  int period = data["sample_period"].as<int>();
+  if (period > 0) {
+    std::cout << swoc::bwprint(text, "Sampling 1 in {} events\n", period);
+  } else {
+    std::cout << "Not sampling, set proxy.config.exec_thread.profiler.sample_period to start\n";
+  }
+  if (data["threads"].size() == 0) {
+    return;
+  }
+
+  std::cout << swoc::bwprint(text, "All threads, {} us sampled\n", data["total_us"].as<std::string>());
+  print_sites(data["sites"]);
+  for (auto &&thread : data["threads"]) {
+    std::cout << swoc::bwprint(text, "\n{}, {} us sampled\n", thread["name"].as<std::string>(), thread["total_us"].as<std::string>());
+    print_sites(thread["sites"]);
+  }
+}
+//-------------------------------------------------------------------------------------------------------------------------------------
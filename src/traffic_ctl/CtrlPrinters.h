@@ -333,6 +333,14 @@ public:
   ServerStatusPrinter(BasePrinter::Options opt) : BasePrinter(opt) {}
 };
 //------------------------------------------------------------------------------------------------------------------------------------
+class EventLoopProfilePrinter : public BasePrinter
+{
+  void write_output(YAML::Node const &result) override;
+
+public:
+  EventLoopProfilePrinter(BasePrinter::Options opt) : BasePrinter(opt) {}
+};
+//------------------------------------------------------------------------------------------------------------------------------------
 
 /// In case a derived class needs to call derived class functions. Ugly but works.
 /// Note: CRTP may worth a try.
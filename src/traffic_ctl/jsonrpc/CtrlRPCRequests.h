@@ -266,6 +266,19 @@ struct GetServerStatusRequest : shared::rpc::ClientRequest {
   }
 };
 //------------------------------------------------------------------------------------------------------------------------------------
+struct GetEventLoopProfileRequest : shared::rpc::ClientRequest {
+  using super = shared::rpc::ClientRequest;
+  struct Params {
+    int top{10}; // number of handlers to show, overall and for each thread.
+  };
+  GetEventLoopProfileRequest(Params p) { super::params = p; }
+  std::string
+  get_method() const override
+  {
+    return "get_event_loop_profile";
+  }
+};
+//------------------------------------------------------------------------------------------------------------------------------------
 struct SetStorageDeviceOfflineRequest : shared::rpc::ClientRequest {
   using super = shared::rpc::ClientRequest;
   struct Params {
@@ -235,6 +235,16 @@ template <> struct convert<ServerStartDrainRequest::Params> {
   }
 };
 //------------------------------------------------------------------------------------------------------------------------------------
+template <> struct convert<GetEventLoopProfileRequest::Params> {
+  static Node
+  encode(GetEventLoopProfileRequest::Params const &params)
+  {
+    Node node;
+    node["top"] = params.top;
+    return node;
+  }
+};
+//------------------------------------------------------------------------------------------------------------------------------------
 template <> struct convert<SetStorageDeviceOfflineRequest::Params> {
   static Node
   encode(SetStorageDeviceOfflineRequest::Params const &params)
@@ -272,6 +272,9 @@ main([[maybe_unused]] int argc, const char **argv)
                              [&]() { CtrlUnimplementedCommand("backtrace"); });
   server_command.add_command("status", "Show the proxy status", [&]() { command->execute(); })
     .add_example_usage("traffic_ctl server status");
+  server_command.add_command("profile", "Show where the event threads spend their time", [&]() { command->execute(); })
+    .add_option("--top", "-t", "Number of handlers to show", "", 1, "10")
+    .add_example_usage("traffic_ctl server profile [--top N]");
   auto &drain_cmd = server_command.add_command("drain", "Drain the requests", [&]() { command->execute(); });
   drain_cmd.add_example_usage("traffic_ctl server drain [OPTIONS]");
 
@@ -67,6 +67,10 @@ register_admin_jsonrpc_handlers()
                           {{rpc::RESTRICTED_API}});
   rpc::add_method_handler("get_server_status", &get_server_status, &core_ats_rpc_service_provider_handle,
                           {{rpc::NON_RESTRICTED_API}});
+  rpc::add_method_handler("get_event_loop_profile", &get_event_loop_profile, &core_ats_rpc_service_provider_handle,
+                          {{rpc::NON_RESTRICTED_API}});
+  rpc::add_method_handler("get_thread_stalls", &get_thread_stalls, &core_ats_rpc_service_provider_handle,
+                          {{rpc::NON_RESTRICTED_API}});
   rpc::add_method_handler("get_connection_tracker_info", &get_connection_tracker_info, &core_ats_rpc_service_provider_handle,
                           {{rpc::NON_RESTRICTED_API}});
   // storage
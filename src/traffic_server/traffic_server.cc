@@ -2294,6 +2294,12 @@ main(int /* argc ATS_UNUSED */, const char **argv)
   // Start the watchdog
   int watchdog_timeout_ms = RecGetRecordInt("proxy.config.exec_thread.watchdog.timeout_ms").value_or(0);
   if (watchdog_timeout_ms > 0) {
+    int stall_log_size = RecGetRecordInt("proxy.config.exec_thread.watchdog.stall_log_size").value_or(0);
+    Watchdog::stall_log().set_capacity(stall_log_size);
+    if (stall_log_size > 0) {
+      // Load the unwinder now, not in the middle of the first stall.
+      ink_stack_trace_thread_init();
+    }
     watchdog = std::make_unique<Watchdog::Monitor>(eventProcessor.thread_group[ET_NET]._thread,
                                                    static_cast<size_t>(eventProcessor.thread_group[ET_NET]._count),
                                                    std::chrono::milliseconds{watchdog_timeout_ms});
@@ -2338,6 +2344,8 @@ main(int /* argc ATS_UNUSED */, const char **argv)
     // We don't need task threads in the "command_flag" case.
     tasksProcessor.register_event_type();
     eventProcessor.thread_group[ET_TASK]._afterStartCallback = task_threads_started_callback;
+    eventProcessor.thread_group[ET_TASK]._work_stealing =
+      RecGetRecordInt("proxy.config.task_threads.work_stealing").value_or(0) != 0;
     tasksProcessor.start(num_task_threads, stacksize);
 
     RecProcessStart();
@@ -25,10 +25,20 @@
 #include "tscore/ink_stack_trace.h"
 #include "tscore/ink_args.h"
 
+#include <cxxabi.h>
+#include <dlfcn.h>
 #include <strings.h>
+#include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
 #include <unistd.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#endif
 
 #ifndef STDERR_FILENO
 #define STDERR_FILENO 2
@@ -85,6 +95,131 @@ ink_backtrace(const int n)
   return symbol;
 }
 
+#if defined(SIGRTMIN)
+
+/// The signal that asks a thread for its stack. The real time signals are otherwise unused.
+#define INK_STACK_TRACE_SIGNAL (SIGRTMIN + 1)
+
+namespace
+{
+enum CaptureState : int { IDLE, REQUESTED, RUNNING, DONE };
+
+/** The one capture that can be in progress.
+
+    The signal handler can only use what it finds here. The frames are kept here rather than in the
+    caller's buffer because a handler that starts after the caller gave up must still have somewhere
+    to write them.
+ */
+struct Capture {
+  std::atomic<int>        state{IDLE};
+  std::atomic<ink_thread> target{};
+  void                   *frames[INK_STACK_TRACE_MAX_LEVELS];
+  int                     depth = 0;
+  std::mutex              mutex; ///< Serializes the callers.
+} capture;
+
+void
+capture_handler(int /* signo ATS_UNUSED */, siginfo_t * /* info ATS_UNUSED */, void * /* ctx ATS_UNUSED */)
+{
+  int saved_errno = errno;
+  int expected    = REQUESTED;
+  // A signal that arrives after its capture was given up on, or for another thread, is ignored.
+  if (pthread_equal(capture.target.load(std::memory_order_acquire), pthread_self()) &&
+      capture.state.compare_exchange_strong(expected, RUNNING, std::memory_order_acq_rel)) {
+    if (pthread_equal(capture.target.load(std::memory_order_acquire), pthread_self())) {
+      capture.depth = backtrace(capture.frames, INK_STACK_TRACE_MAX_LEVELS);
+      capture.state.store(DONE, std::memory_order_release);
+    } else {
+      // The capture this was sent for was given up on and another one started in between.
+      capture.state.store(REQUESTED, std::memory_order_release);
+    }
+  }
+  errno = saved_errno;
+}
+
+bool
+capture_init()
+{
+  // The first backtrace() loads the unwinder, which is not safe in a signal handler, so do it here.
+  void *warm[2];
+  backtrace(warm, 2);
+
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sigemptyset(&sa.sa_mask);
+  sa.sa_sigaction = capture_handler;
+  sa.sa_flags     = SA_SIGINFO | SA_RESTART;
+  return sigaction(INK_STACK_TRACE_SIGNAL, &sa, nullptr) == 0;
+}
+} // namespace
+
+bool
+ink_stack_trace_thread_init()
+{
+  static bool ready = capture_init();
+  return ready;
+}
+
+int
+ink_stack_trace_thread(ink_thread thread, const void **frames, int max, int timeout_ms)
+{
+  bool ready = ink_stack_trace_thread_init();
+
+  std::lock_guard lock(capture.mutex);
+
+  if (!ready || pthread_equal(thread, pthread_self())) {
+    return 0;
+  }
+  if (int state = capture.state.load(std::memory_order_acquire); state != IDLE) {
+    // An earlier capture that was given up on is still running, or finished late.
+    if (state != DONE) {
+      return 0;
+    }
+    capture.state.store(IDLE, std::memory_order_relaxed);
+  }
+
+  capture.target.store(thread, std::memory_order_relaxed);
+  capture.state.store(REQUESTED, std::memory_order_release);
+  if (pthread_kill(thread, INK_STACK_TRACE_SIGNAL) != 0) {
+    capture.state.store(IDLE, std::memory_order_relaxed);
+    return 0;
+  }
+
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+  while (capture.state.load(std::memory_order_acquire) != DONE) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      int expected = REQUESTED;
+      capture.state.compare_exchange_strong(expected, IDLE, std::memory_order_acq_rel);
+      return 0;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+
+  // Leave out the handler and the signal trampoline.
+  int n = 0;
+  for (int i = 2; i < capture.depth && n < max; ++i) {
+    frames[n++] = capture.frames[i];
+  }
+  capture.state.store(IDLE, std::memory_order_relaxed);
+  return n;
+}
+
+#else /* !SIGRTMIN */
+
+bool
+ink_stack_trace_thread_init()
+{
+  return false;
+}
+
+int
+ink_stack_trace_thread(ink_thread /* thread */, const void ** /* frames */, int /* max */, int /* timeout_ms */)
+{
+  return 0;
+}
+
+#endif /* SIGRTMIN */
+
 #else /* !TS_HAS_BACKTRACE */
 
 void
@@ -102,4 +237,65 @@ ink_backtrace(const int /* n */)
   return nullptr;
 }
 
+bool
+ink_stack_trace_thread_init()
+{
+  return false;
+}
+
+int
+ink_stack_trace_thread(ink_thread /* thread */, const void ** /* frames */, int /* max */, int /* timeout_ms */)
+{
+  return 0;
+}
+
 #endif /* TS_HAS_BACKTRACE */
+
+std::string
+ink_stack_trace_symbol(const void *addr)
+{
+  char    buf[64];
+  Dl_info info;
+
+  if (dladdr(addr, &info) == 0) {
+    snprintf(buf, sizeof(buf), "%p", addr);
+    return buf;
+  }
+
+  uintptr_t   pc = reinterpret_cast<uintptr_t>(addr);
+  std::string name;
+  if (info.dli_sname != nullptr) {
+    int   status    = 0;
+    char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+    name            = status == 0 && demangled ? demangled : info.dli_sname;
+    free(demangled);
+    // A static function has no symbol of its own, and is named after the one before it.
+    if (uintptr_t offset = pc - reinterpret_cast<uintptr_t>(info.dli_saddr); offset != 0) {
+      snprintf(buf, sizeof(buf), "+0x%jx", static_cast<uintmax_t>(offset));
+      name += buf;
+    }
+  } else {
+    snprintf(buf, sizeof(buf), "0x%jx", static_cast<uintmax_t>(pc - reinterpret_cast<uintptr_t>(info.dli_fbase)));
+    name = buf;
+  }
+
+  // Name the module if it is not the program, which is where a plugin's code is. The program headers
+  // are in the program's image, which this function is not if tscore is a shared library.
+  static void const *program_base = [] {
+    Dl_info program;
+#if defined(__linux__)
+    void const *in_program = reinterpret_cast<void const *>(getauxval(AT_PHDR));
+#else
+    void const *in_program = reinterpret_cast<void const *>(&ink_stack_trace_symbol);
+#endif
+    return in_program && dladdr(in_program, &program) ? program.dli_fbase : nullptr;
+  }();
+  if (info.dli_fbase != program_base && info.dli_fname != nullptr) {
+    char const *slash  = strrchr(info.dli_fname, '/');
+    name              += " [";
+    name              += slash ? slash + 1 : info.dli_fname;
+    name              += "]";
+  }
+
+  return name;
+}
@@ -54,3 +54,29 @@ TEST_CASE("Histogram Basic", "[libts][histogram]")
   REQUIRE(h[12] == 1); // sample 19 should be here.
   REQUIRE(h[14] == 1); // sample 27 should be here.
 };
+
+TEST_CASE("Histogram bucket_for", "[libts][histogram]")
+{
+  using H = ts::Histogram<7, 2>;
+
+  // Every bucket starts at its minimum, and the sample before it is in the bucket before.
+  for (unsigned idx = 1; idx < H::N_BUCKETS; ++idx) {
+    REQUIRE(H::bucket_for(H::min_for_bucket(idx)) == idx);
+    REQUIRE(H::bucket_for(H::min_for_bucket(idx) - 1) == idx - 1);
+  }
+  REQUIRE(H::bucket_for(0) == 0);
+  REQUIRE(H::bucket_for(19) == 12);
+  REQUIRE(H::bucket_for(1 << 20) == H::N_BUCKETS - 1);
+
+  // No span bits, a bucket per power of 2.
+  using P = ts::Histogram<9, 0>;
+  REQUIRE(P::N_BUCKETS == 11);
+  REQUIRE(P::bucket_for(1) == 1);
+  REQUIRE(P::bucket_for(3) == 2);
+  REQUIRE(P::bucket_for(4) == 3);
+  REQUIRE(P::bucket_for(256) == 9);
+  REQUIRE(P::bucket_for(511) == 9);
+  REQUIRE(P::bucket_for(512) == 10);
+  REQUIRE(P::min_for_bucket(9) == 256);
+  REQUIRE(P::min_for_bucket(10) == 512);
+};
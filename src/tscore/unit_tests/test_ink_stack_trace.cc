@@ -0,0 +1,88 @@
+/** @file
+
+    ink_stack_trace unit tests.
+
+    @section license License
+
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "tscore/ink_config.h"
+#include "tscore/ink_stack_trace.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+namespace
+{
+std::atomic<bool> spinning{false};
+std::atomic<bool> stop{false};
+
+__attribute__((noinline)) void
+spin()
+{
+  spinning = true;
+  while (!stop.load(std::memory_order_relaxed)) {
+    asm volatile("" ::: "memory");
+  }
+}
+} // namespace
+
+TEST_CASE("ink_stack_trace_thread", "[libts][stack_trace]")
+{
+  void const *frames[INK_STACK_TRACE_MAX_LEVELS];
+
+  // A thread can not capture itself this way.
+  REQUIRE(ink_stack_trace_thread(pthread_self(), frames, INK_STACK_TRACE_MAX_LEVELS, 100) == 0);
+
+#if TS_HAS_BACKTRACE && defined(SIGRTMIN)
+  REQUIRE(ink_stack_trace_thread_init());
+
+  std::thread busy(spin);
+  while (!spinning) {
+    std::this_thread::yield();
+  }
+
+  // Twice, to check a finished capture leaves things ready for the next.
+  for (int round = 0; round < 2; ++round) {
+    int n = ink_stack_trace_thread(busy.native_handle(), frames, INK_STACK_TRACE_MAX_LEVELS, 1000);
+    REQUIRE(n > 0);
+    // The thread was stopped in the loop, so the stack goes through it.
+    auto fn    = reinterpret_cast<uintptr_t>(&spin);
+    bool found = false;
+    for (int i = 0; i < n && !found; ++i) {
+      auto pc = reinterpret_cast<uintptr_t>(frames[i]);
+      found   = pc > fn && pc < fn + 256;
+    }
+    CHECK(found);
+  }
+
+  stop = true;
+  busy.join();
+#endif
+}
+
+TEST_CASE("ink_stack_trace_symbol", "[libts][stack_trace]")
+{
+  std::string name = ink_stack_trace_symbol(reinterpret_cast<void const *>(&fopen));
+  CHECK(name.find("fopen") != std::string::npos);
+  CHECK(!ink_stack_trace_symbol(nullptr).empty());
+}
@@ -0,0 +1,211 @@
+/** @file
+
+  Micro benchmark for the cache directory bucket layouts: the classic four
+  entry buckets packed back to back against the wide six entry buckets that
+  each occupy a single cache line. Both segments hold the same number of
+  entries and are filled to the same fraction before being probed.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "P_CacheDir.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr int ENTRIES = 65532; // one full segment, divisible by both depths
+constexpr int PROBES  = 4096;
+
+/** A single directory segment in the given layout, populated the way
+    Directory::insert does it: bucket rows first, then entries popped from
+    the segment freelist.
+ */
+struct Segment {
+  Directory             directory;
+  char                 *mem = nullptr;
+  std::vector<uint32_t> free_rows;
+  std::vector<uint32_t> keys;
+  int                   chained = 0; // entries living outside their bucket
+
+  Segment(DirLayout layout, double fill, uint32_t seed)
+  {
+    directory.layout  = layout;
+    directory.buckets = ENTRIES / directory.depth();
+    size_t bytes      = directory.buckets * directory.bucket_size();
+    bytes             = (bytes + DIR_WIDE_BUCKET_SIZE - 1) / DIR_WIDE_BUCKET_SIZE * DIR_WIDE_BUCKET_SIZE;
+    mem               = static_cast<char *>(std::aligned_alloc(DIR_WIDE_BUCKET_SIZE, bytes));
+    memset(mem, 0, bytes);
+    directory.dir = reinterpret_cast<Dir *>(mem);
+
+    int depth = directory.depth();
+    for (uint32_t i = directory.buckets * depth; i-- > 0;) {
+      if (i % depth) {
+        free_rows.push_back(i);
+      }
+    }
+    std::mt19937 rng(seed);
+    for (int n = static_cast<int>(fill * ENTRIES); n > 0 && insert(rng()); --n) {}
+  }
+
+  ~Segment() { std::free(mem); }
+
+  Segment(const Segment &)            = delete;
+  Segment &operator=(const Segment &) = delete;
+
+  Dir *
+  seg()
+  {
+    return directory.dir;
+  }
+
+  Dir *
+  bucket(uint32_t key)
+  {
+    return directory.bucket((key >> DIR_TAG_WIDTH) % directory.buckets, seg());
+  }
+
+  bool
+  insert(uint32_t key)
+  {
+    Dir *b = bucket(key);
+    Dir *e = b;
+    if (!dir_is_empty(b)) {
+      e = nullptr;
+      for (int l = 1; l < directory.depth() && !e; ++l) {
+        Dir *row = dir_bucket_row(b, l);
+        if (dir_is_empty(row)) {
+          e = row;
+        }
+      }
+      // Rows taken directly above stay on free_rows, skip them here.
+      while (!e) {
+        if (free_rows.empty()) {
+          return false;
+        }
+        Dir *f = directory.from_offset(free_rows.back(), seg());
+        free_rows.pop_back();
+        if (dir_is_empty(f)) {
+          e = f;
+          ++chained;
+        }
+      }
+      Dir *last = b;
+      while (dir_next(last)) {
+        last = directory.next_dir(last, seg());
+      }
+      dir_set_next(e, 0);
+      dir_set_next(last, directory.to_offset(e, seg()));
+    }
+    int64_t offset = keys.size() + 1;
+    dir_set_offset(e, offset);
+    dir_set_tag(e, key);
+    keys.push_back(key);
+    return true;
+  }
+
+  bool
+  probe(uint32_t key)
+  {
+    Dir *b = bucket(key);
+    if (!dir_offset(b)) {
+      return false;
+    }
+    for (Dir *e = b; e; e = directory.next_dir(e, seg())) {
+      if (dir_tag(e) == DIR_MASK_TAG(key)) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+void
+run(double fill)
+{
+  Segment               classic(DirLayout::CLASSIC, fill, 13);
+  Segment               wide(DirLayout::WIDE, fill, 13);
+  std::mt19937          rng(42);
+  std::vector<uint32_t> hits, misses;
+
+  // Both segments draw keys from the same sequence, so the shorter key list
+  // is a prefix of the longer one.
+  size_t common = std::min(classic.keys.size(), wide.keys.size());
+  for (int i = 0; i < PROBES; ++i) {
+    hits.push_back(classic.keys[rng() % common]);
+    misses.push_back(rng());
+  }
+  // The wide layout should spill far fewer entries out of their bucket.
+  CHECK(wide.chained <= classic.chained);
+
+  auto probe_all = [](Segment &segment, std::vector<uint32_t> const &keys) {
+    int found = 0;
+    for (uint32_t key : keys) {
+      found += segment.probe(key);
+    }
+    return found;
+  };
+
+  REQUIRE(probe_all(classic, hits) == PROBES);
+  REQUIRE(probe_all(wide, hits) == PROBES);
+
+  BENCHMARK("classic: hit")
+  {
+    return probe_all(classic, hits);
+  };
+  BENCHMARK("wide: hit")
+  {
+    return probe_all(wide, hits);
+  };
+  BENCHMARK("classic: miss")
+  {
+    return probe_all(classic, misses);
+  };
+  BENCHMARK("wide: miss")
+  {
+    return probe_all(wide, misses);
+  };
+}
+
+} // namespace
+
+TEST_CASE("cache dir layout: 50% full", "[bench][cache_dir]")
+{
+  run(0.5);
+}
+
+TEST_CASE("cache dir layout: 90% full", "[bench][cache_dir]")
+{
+  run(0.9);
+}
+
+TEST_CASE("cache dir layout: 95% full", "[bench][cache_dir]")
+{
+  run(0.95);
+}
@@ -0,0 +1,201 @@
+/** @file
+
+  Micro benchmark for the cache directory bucket probe: the scalar chain walk
+  used by Directory::probe against the vectorized bucket scan that rejects
+  misses before walking the chain.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "P_CacheDir.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr int BUCKETS = 16384; // one full segment
+constexpr int PROBES  = 4096;
+
+/** A single directory segment populated the way Directory::insert does it:
+    bucket rows first, then entries popped from the segment freelist.
+ */
+struct Segment {
+  std::vector<Dir>      dirs;
+  std::vector<uint32_t> free_rows;
+  std::vector<uint32_t> keys;
+
+  explicit Segment(double fill, uint32_t seed) : dirs(BUCKETS * DIR_DEPTH)
+  {
+    for (uint32_t i = BUCKETS * DIR_DEPTH; i-- > 0;) {
+      if (i % DIR_DEPTH) {
+        free_rows.push_back(i);
+      }
+    }
+    std::mt19937 rng(seed);
+    for (int n = static_cast<int>(fill * BUCKETS * DIR_DEPTH); n > 0 && insert(rng()); --n) {}
+  }
+
+  Dir *
+  seg()
+  {
+    return dirs.data();
+  }
+
+  Dir *
+  bucket(uint32_t key)
+  {
+    return dir_bucket((key >> DIR_TAG_WIDTH) % BUCKETS, seg());
+  }
+
+  bool
+  insert(uint32_t key)
+  {
+    Dir *b = bucket(key);
+    Dir *e = b;
+    if (!dir_is_empty(b)) {
+      e = nullptr;
+      for (int l = 1; l < DIR_DEPTH && !e; ++l) {
+        Dir *row = dir_bucket_row(b, l);
+        if (dir_is_empty(row)) {
+          e = row;
+        }
+      }
+      // Rows taken directly above stay on free_rows, skip them here.
+      while (!e) {
+        if (free_rows.empty()) {
+          return false;
+        }
+        Dir *f = dir_from_offset(free_rows.back(), seg());
+        free_rows.pop_back();
+        if (dir_is_empty(f)) {
+          e = f;
+        }
+      }
+      Dir *last = b;
+      while (dir_next(last)) {
+        last = next_dir(last, seg());
+      }
+      dir_set_next(e, 0);
+      dir_set_next(last, dir_to_offset(e, seg()));
+    }
+    int64_t offset = keys.size() + 1;
+    dir_set_offset(e, offset);
+    dir_set_tag(e, key);
+    keys.push_back(key);
+    return true;
+  }
+};
+
+bool
+probe_walk(Dir *b, Dir *seg, uint32_t key)
+{
+  if (!dir_offset(b)) {
+    return false;
+  }
+  for (Dir *e = b; e; e = next_dir(e, seg)) {
+    if (dir_tag(e) == DIR_MASK_TAG(key)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <DirBucketScan (*SCAN)(const Dir *, uint32_t, uint32_t)>
+bool
+probe_scan(Dir *b, Dir *seg, uint32_t key)
+{
+  if (!dir_offset(b)) {
+    return false;
+  }
+  uint32_t base = dir_to_offset(b, seg);
+  if (dir_bucket_scan_miss(b, base, SCAN(b, base, key))) {
+    return false;
+  }
+  return probe_walk(b, seg, key);
+}
+
+void
+run(double fill)
+{
+  Segment               segment(fill, 13);
+  std::mt19937          rng(42);
+  std::vector<uint32_t> hits, misses;
+  for (int i = 0; i < PROBES; ++i) {
+    hits.push_back(segment.keys[rng() % segment.keys.size()]);
+    misses.push_back(rng());
+  }
+
+  for (uint32_t key : misses) {
+    Dir *b = segment.bucket(key);
+    REQUIRE(probe_walk(b, segment.seg(), key) == probe_scan<dir_bucket_scan>(b, segment.seg(), key));
+    REQUIRE(probe_walk(b, segment.seg(), key) == probe_scan<dir_bucket_scan_scalar>(b, segment.seg(), key));
+  }
+
+  auto probe_all = [&](auto probe, std::vector<uint32_t> const &keys) {
+    int found = 0;
+    for (uint32_t key : keys) {
+      found += probe(segment.bucket(key), segment.seg(), key);
+    }
+    return found;
+  };
+
+  BENCHMARK("walk: hit")
+  {
+    return probe_all(probe_walk, hits);
+  };
+  BENCHMARK("scalar scan: hit")
+  {
+    return probe_all(probe_scan<dir_bucket_scan_scalar>, hits);
+  };
+  BENCHMARK("simd scan: hit")
+  {
+    return probe_all(probe_scan<dir_bucket_scan>, hits);
+  };
+  BENCHMARK("walk: miss")
+  {
+    return probe_all(probe_walk, misses);
+  };
+  BENCHMARK("scalar scan: miss")
+  {
+    return probe_all(probe_scan<dir_bucket_scan_scalar>, misses);
+  };
+  BENCHMARK("simd scan: miss")
+  {
+    return probe_all(probe_scan<dir_bucket_scan>, misses);
+  };
+}
+
+} // namespace
+
+TEST_CASE("cache dir probe: 50% full", "[bench][cache_dir]")
+{
+  run(0.5);
+}
+
+TEST_CASE("cache dir probe: 90% full", "[bench][cache_dir]")
+{
+  run(0.9);
+}
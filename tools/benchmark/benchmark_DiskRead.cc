@@ -0,0 +1,241 @@
+/** @file
+
+  Micro benchmark of random 1 MiB disk reads through AIO, the way cache misses
+  read fragments from a span. A file is filled once, opened with O_DIRECT, and
+  read at random block aligned offsets with a fixed number of reads in flight.
+
+  Run once per backend to compare them:
+  ```
+  $ ./benchmark_DiskRead --ts-backend thread --ts-depth 32
+  $ ./benchmark_DiskRead --ts-backend io_uring --ts-depth 32
+  $ ./benchmark_DiskRead --ts-backend io_uring --ts-depth 32 --ts-registered
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "iocore/aio/AIO.h"
+#include "iocore/eventsystem/EventSystem.h"
+#include "iocore/utils/diags.i"
+
+#include "tscore/Layout.h"
+
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+extern RecInt cache_config_threads_per_disk;
+
+namespace
+{
+// Args
+struct Conf {
+  std::string path       = "benchmark_DiskRead.db";
+  std::string backend    = "thread";
+  int         size_mb    = 1024;
+  int         depth      = 32;
+  int         nreads     = 512;
+  int         threads    = 8;
+  bool        registered = false;
+};
+
+Conf conf;
+
+constexpr int64_t READ_SIZE = 1024 * 1024;
+
+#if TS_USE_LINUX_IO_URING
+bool use_io_uring = false;
+#endif
+
+/// Keeps one read in flight, reissuing it at a new offset until the run has read enough.
+struct Reader : public Continuation {
+  AIOCallback       io;
+  Ptr<IOBufferData> buf;
+  std::mt19937_64   rng;
+
+  static inline std::atomic<int> issued    = 0;
+  static inline std::atomic<int> completed = 0;
+  static inline std::atomic<int> failed    = 0;
+
+  Reader(int fd, int seed) : Continuation(new_ProxyMutex()), rng(seed)
+  {
+    AllocType type      = conf.registered ? REGISTERED : MEMALIGNED;
+    buf                 = new_IOBufferData(iobuffer_size_to_index(READ_SIZE, MAX_BUFFER_SIZE_INDEX), type);
+    io.aiocb.aio_fildes = fd;
+    io.aiocb.aio_buf    = buf->data();
+    io.aiocb.aio_nbytes = READ_SIZE;
+    io.action           = this;
+    io.thread           = AIO_CALLBACK_THREAD_AIO;
+    SET_HANDLER(&Reader::handle_read);
+  }
+
+  void
+  issue()
+  {
+    if (issued++ >= conf.nreads) {
+      return;
+    }
+    int64_t blocks      = static_cast<int64_t>(conf.size_mb) * 1024 * 1024 / READ_SIZE;
+    io.aiocb.aio_offset = (rng() % blocks) * READ_SIZE;
+    ink_aio_read(&io);
+  }
+
+  int
+  handle_read(int /* event ATS_UNUSED */, void * /* data ATS_UNUSED */)
+  {
+    if (!io.ok()) {
+      ++failed;
+    }
+    ++completed;
+    issue();
+    return EVENT_DONE;
+  }
+};
+
+int
+open_span()
+{
+  int fd = open(conf.path.c_str(), O_RDWR | O_CREAT | O_DIRECT, 0644);
+  if (fd < 0) { // e.g. tmpfs
+    fd = open(conf.path.c_str(), O_RDWR | O_CREAT, 0644);
+  }
+  REQUIRE(fd >= 0);
+
+  // Fill the file so reads hit the device rather than holes.
+  off_t       size = static_cast<off_t>(conf.size_mb) * 1024 * 1024;
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size >= size) {
+    return fd;
+  }
+  char *block = static_cast<char *>(ats_memalign(ats_pagesize(), READ_SIZE));
+  memset(block, 'x', READ_SIZE);
+  for (off_t offset = 0; offset < size; offset += READ_SIZE) {
+    REQUIRE(pwrite(fd, block, READ_SIZE, offset) == READ_SIZE);
+  }
+  ats_free(block);
+  return fd;
+}
+
+int
+run(std::vector<Reader *> &readers)
+{
+  Reader::issued    = 0;
+  Reader::completed = 0;
+  for (auto *reader : readers) {
+    SCOPED_MUTEX_LOCK(lock, reader->mutex, this_ethread());
+    reader->issue();
+  }
+  while (Reader::completed < conf.nreads) {
+#if TS_USE_LINUX_IO_URING
+    if (use_io_uring) {
+      IOUringContext::local_context()->submit_and_wait(HRTIME_MSECONDS(10));
+      continue;
+    }
+#endif
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  return Reader::completed;
+}
+
+} // namespace
+
+TEST_CASE("Random 1 MiB disk reads", "[bench][aio]")
+{
+  int fd = open_span();
+
+  std::vector<Reader *> readers;
+  for (int i = 0; i < conf.depth; ++i) {
+    readers.push_back(new Reader(fd, i));
+  }
+
+  REQUIRE(run(readers) == conf.nreads);
+  REQUIRE(Reader::failed == 0);
+
+  BENCHMARK("random reads")
+  {
+    return run(readers);
+  };
+
+  for (auto *reader : readers) {
+    delete reader;
+  }
+  close(fd);
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::Clara;
+
+  // clang-format off
+  auto cli = session.cli() |
+    Opt(conf.path, "")["--ts-path"]("file to read from, filled if shorter than --ts-size (default: benchmark_DiskRead.db)") |
+    Opt(conf.backend, "")["--ts-backend"]("AIO backend, thread or io_uring (default: thread)") |
+    Opt(conf.size_mb, "")["--ts-size"]("size of the file in MiB (default: 1024)") |
+    Opt(conf.depth, "")["--ts-depth"]("number of reads in flight (default: 32)") |
+    Opt(conf.nreads, "")["--ts-nreads"]("number of reads per run (default: 512)") |
+    Opt(conf.threads, "")["--ts-threads"]("AIO threads for the thread backend (default: 8)") |
+    Opt(conf.registered)["--ts-registered"]("read into registered buffers with io_uring");
+  // clang-format on
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  Layout::create();
+  init_diags("", nullptr);
+  RecProcessInit();
+  ink_event_system_init(EVENT_SYSTEM_MODULE_PUBLIC_VERSION);
+  eventProcessor.start(1);
+  EThread *main_thread = new EThread;
+  main_thread->set_specific();
+
+  AIOBackend backend = AIO_BACKEND_THREAD;
+#if TS_USE_LINUX_IO_URING
+  if (conf.backend == "io_uring") {
+    backend      = AIO_BACKEND_IO_URING;
+    use_io_uring = true;
+    if (conf.registered) {
+      init_registered_buffers(iobuffer_size_to_index(READ_SIZE, MAX_BUFFER_SIZE_INDEX), conf.depth);
+    }
+  }
+#endif
+  ink_aio_init(AIO_MODULE_PUBLIC_VERSION, backend);
+  cache_config_threads_per_disk = conf.threads;
+
+  return session.run();
+}
@@ -37,11 +37,22 @@
 #include "tscore/Layout.h"
 #include "tscore/TSSystemState.h"
 
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
 namespace
 {
 // Args
 int nevents  = 1;
 int nthreads = 1;
+int slow_ms  = 20;
+int fast_us  = 20;
+
+// Thread groups for the work stealing benchmark, one without and one with stealing.
+EventType ET_ROUND_ROBIN;
+EventType ET_STEALING;
 
 std::atomic<int> counter = 0;
 
@@ -60,8 +71,69 @@ struct Task : public Continuation {
     return 0;
   }
 };
+/// A job that keeps its thread busy for a while, as a plugin job on a task thread would.
+struct Job : public Continuation {
+  Job(std::atomic<int> &remaining, ink_hrtime busy) : Continuation(new_ProxyMutex()), _remaining(remaining), _busy(busy)
+  {
+    SET_HANDLER(&Job::event_handler);
+  }
+
+  int
+  event_handler(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+  {
+    ink_hrtime until = ink_get_hrtime() + _busy;
+    while (ink_get_hrtime() < until) {
+      ;
+    }
+    --_remaining;
+    return 0;
+  }
+
+  std::atomic<int> &_remaining;
+  ink_hrtime        _busy;
+};
+
+/// Schedule @a jobs on @a type and wait for them all to finish.
+void
+run_jobs(EventType type, std::vector<std::unique_ptr<Job>> &jobs, std::atomic<int> &remaining)
+{
+  remaining = jobs.size();
+  for (auto &job : jobs) {
+    eventProcessor.schedule_imm(job.get(), type);
+  }
+  while (remaining > 0) {
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+}
 } // namespace
 
+// Run this on its own with "[steal]", the benchmark below shuts the event system down.
+TEST_CASE("work stealing benchmark", "[steal]")
+{
+  std::atomic<int>                  remaining{0};
+  std::vector<std::unique_ptr<Job>> jobs;
+
+  jobs.push_back(std::make_unique<Job>(remaining, HRTIME_MSECONDS(slow_ms)));
+  for (int i = 0; i < nevents; ++i) {
+    jobs.push_back(std::make_unique<Job>(remaining, HRTIME_USECONDS(fast_us)));
+  }
+
+  char name[128];
+  snprintf(name, sizeof(name), "round robin nevents = %d nthreads = %d slow = %dms", nevents,
+           eventProcessor.thread_group[ET_ROUND_ROBIN]._count, slow_ms);
+  BENCHMARK(name)
+  {
+    run_jobs(ET_ROUND_ROBIN, jobs, remaining);
+  };
+
+  snprintf(name, sizeof(name), "work stealing nevents = %d nthreads = %d slow = %dms", nevents,
+           eventProcessor.thread_group[ET_STEALING]._count, slow_ms);
+  BENCHMARK(name)
+  {
+    run_jobs(ET_STEALING, jobs, remaining);
+  };
+}
+
 TEST_CASE("event process benchmark", "")
 {
   char name[64];
@@ -95,6 +167,12 @@ struct EventProcessorListener : Catch::EventListenerBase {
     ink_event_system_init(EVENT_SYSTEM_MODULE_PUBLIC_VERSION);
     eventProcessor.start(nthreads, 1048576); // Hardcoded stacksize at 1MB
 
+    // Stealing needs at least two threads.
+    ET_ROUND_ROBIN = eventProcessor.spawn_event_threads("ET_ROUND_ROBIN", std::max(2, nthreads), 1048576);
+    ET_STEALING    = eventProcessor.register_event_type("ET_STEALING");
+    eventProcessor.thread_group[ET_STEALING]._work_stealing = true;
+    eventProcessor.spawn_event_threads(ET_STEALING, std::max(2, nthreads), 1048576);
+
     EThread *main_thread = new EThread;
     main_thread->set_specific();
 
@@ -112,7 +190,9 @@ main(int argc, char *argv[])
   using namespace Catch::Clara;
 
   auto cli = session.cli() | Opt(nevents, "n")["--ts-nevents"]("number of events (default: 1)\n") |
-             Opt(nthreads, "n")["--ts-nthreads"]("number of ethreads (default: 1)\n");
+             Opt(nthreads, "n")["--ts-nthreads"]("number of ethreads (default: 1)\n") |
+             Opt(slow_ms, "ms")["--ts-slow-ms"]("time the slow job of the work stealing benchmark takes (default: 20)\n") |
+             Opt(fast_us, "us")["--ts-fast-us"]("time the other jobs of the work stealing benchmark take (default: 20)\n");
 
   session.cli(cli);
 
@@ -0,0 +1,222 @@
+/** @file
+
+  Micro Benchmark tool for HPACK header block encoding - requires Catch2 v2.9.0+
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "proxy/hdrs/HTTP.h"
+#include "proxy/http2/HPACK.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+extern int cmd_disable_pfreelist;
+
+namespace
+{
+// Args
+int      nblocks    = 1000;
+uint32_t table_size = 65536;
+
+struct Field {
+  std::string_view name;
+  std::string_view value;
+};
+
+// Response headers of a CDN tier, replayed as a connection would send them. Most of the fields
+// repeat from one response to the next, some vary per object.
+const std::vector<std::vector<Field>> RESPONSES = {
+  {
+   {"content-type", "application/javascript; charset=utf-8"},
+   {"cache-control", "public, max-age=31536000, immutable"},
+   {"etag", "W/\"5e3b-18f2c4a1d70\""},
+   {"last-modified", "Tue, 14 May 2024 09:12:44 GMT"},
+   {"vary", "Accept-Encoding"},
+   {"content-encoding", "br"},
+   {"server", "ATS/10.0.0"},
+   {"strict-transport-security", "max-age=63072000; includeSubDomains; preload"},
+   {"x-content-type-options", "nosniff"},
+   {"access-control-allow-origin", "*"},
+   {"age", "1843"},
+   {"via", "http/1.1 edge-fra-03 (ApacheTrafficServer/10.0.0)"},
+   {"x-cache", "HIT"},
+   },
+  {
+   {"content-type", "image/webp"},
+   {"cache-control", "public, max-age=86400"},
+   {"etag", "\"a91f4c2e7d\""},
+   {"last-modified", "Mon, 13 May 2024 22:01:09 GMT"},
+   {"accept-ranges", "bytes"},
+   {"server", "ATS/10.0.0"},
+   {"strict-transport-security", "max-age=63072000; includeSubDomains; preload"},
+   {"x-content-type-options", "nosniff"},
+   {"access-control-allow-origin", "*"},
+   {"age", "97"},
+   {"via", "http/1.1 edge-fra-03 (ApacheTrafficServer/10.0.0)"},
+   {"x-cache", "HIT"},
+   },
+  {
+   {"content-type", "application/json"},
+   {"cache-control", "private, no-store"},
+   {"vary", "Accept-Encoding, Authorization"},
+   {"content-encoding", "gzip"},
+   {"server", "ATS/10.0.0"},
+   {"set-cookie", "session_id=8c1f3b2a9d7e4f60a1b2c3d4e5f60718; Path=/; Secure; HttpOnly; SameSite=Lax"},
+   {"strict-transport-security", "max-age=63072000; includeSubDomains; preload"},
+   {"x-content-type-options", "nosniff"},
+   {"x-request-id", "0f6c2d1e-5b8a-4e7c-9d3f-2a1b0c9d8e7f"},
+   {"via", "http/1.1 edge-fra-03 (ApacheTrafficServer/10.0.0)"},
+   {"x-cache", "MISS"},
+   },
+  {
+   {"content-type", "video/iso.segment"},
+   {"cache-control", "public, max-age=604800"},
+   {"etag", "\"00042-1080p-7c1d\""},
+   {"accept-ranges", "bytes"},
+   {"content-range", "bytes 0-1048575/3811024"},
+   {"server", "ATS/10.0.0"},
+   {"timing-allow-origin", "*"},
+   {"access-control-allow-origin", "*"},
+   {"age", "12"},
+   {"via", "http/1.1 edge-fra-03 (ApacheTrafficServer/10.0.0)"},
+   {"x-cache", "HIT"},
+   },
+};
+
+struct Corpus {
+  std::unique_ptr<HTTPHdr[]> hdrs{new HTTPHdr[RESPONSES.size()]};
+
+  Corpus()
+  {
+    for (size_t i = 0; i < RESPONSES.size(); ++i) {
+      HTTPHdr &hdr = hdrs[i];
+      hdr.create(HTTPType::RESPONSE);
+      for (auto const &[name, value] : RESPONSES[i]) {
+        MIMEField *field = mime_field_create(hdr.m_heap, hdr.m_http->m_fields_impl);
+        field->name_set(hdr.m_heap, hdr.m_http->m_fields_impl, name);
+        field->value_set(hdr.m_heap, hdr.m_http->m_fields_impl, value);
+        mime_hdr_field_attach(hdr.m_http->m_fields_impl, field, 1, nullptr);
+      }
+    }
+  }
+
+  ~Corpus()
+  {
+    for (size_t i = 0; i < RESPONSES.size(); ++i) {
+      hdrs[i].destroy();
+    }
+  }
+
+  /// Encode @a n blocks in turn through @a table. @return The number of encoded bytes.
+  size_t
+  encode(HpackIndexingTable &table, int n)
+  {
+    uint8_t buf[16384];
+    size_t  total = 0;
+    for (int i = 0; i < n; ++i) {
+      int64_t len = hpack_encode_header_block(table, buf, sizeof(buf), &hdrs[i % RESPONSES.size()]);
+      if (len > 0) {
+        total += len;
+      }
+    }
+    return total;
+  }
+
+  /// @return The size of the fields of the first @a n blocks as HTTP/1 text.
+  size_t
+  text_size(int n) const
+  {
+    size_t total = 0;
+    for (int i = 0; i < n; ++i) {
+      for (auto const &[name, value] : RESPONSES[i % RESPONSES.size()]) {
+        total += name.size() + 2 + value.size() + 2;
+      }
+    }
+    return total;
+  }
+
+  size_t
+  field_count(int n) const
+  {
+    size_t total = 0;
+    for (int i = 0; i < n; ++i) {
+      total += RESPONSES[i % RESPONSES.size()].size();
+    }
+    return total;
+  }
+};
+} // namespace
+
+TEST_CASE("hpack encode", "")
+{
+  Corpus corpus;
+  char   name[64];
+
+  // One pass outside the benchmark for the figures Catch does not report.
+  {
+    using namespace std::chrono;
+
+    HpackIndexingTable table(table_size);
+    size_t const       fields  = corpus.field_count(nblocks);
+    auto const         start   = steady_clock::now();
+    size_t const       encoded = corpus.encode(table, nblocks);
+    auto const         ns      = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+    size_t const       text    = corpus.text_size(nblocks);
+    printf("%d blocks, %zu headers: %.1f ns/header, %zu bytes as text, %zu encoded, ratio %.2f\n", nblocks, fields,
+           static_cast<double>(ns) / fields, text, encoded, encoded ? static_cast<double>(text) / encoded : 0.0);
+  }
+
+  snprintf(name, sizeof(name), "encode %d blocks, %u byte table", nblocks, table_size);
+  BENCHMARK(name)
+  {
+    HpackIndexingTable table(table_size);
+    return corpus.encode(table, nblocks);
+  };
+}
+
+int
+main(int argc, char *argv[])
+{
+  // No thread setup, forbid use of thread local allocators.
+  cmd_disable_pfreelist = true;
+  http_init();
+
+  Catch::Session session;
+
+  using namespace Catch::Clara;
+
+  auto cli = session.cli() | Opt(nblocks, "n")["--ts-nblocks"]("number of header blocks to encode (default: 1000)\n") |
+             Opt(table_size, "bytes")["--ts-table-size"]("dynamic table size (default: 65536)\n");
+
+  session.cli(cli);
+
+  if (int res = session.applyCommandLine(argc, argv); res != 0) {
+    return res;
+  }
+
+  return session.run();
+}
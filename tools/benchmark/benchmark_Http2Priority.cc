@@ -0,0 +1,212 @@
+/** @file
+
+  Micro Benchmark tool for HTTP/2 response scheduling - requires Catch2 v2.9.0+
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "proxy/hdrs/HttpPriority.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace
+{
+// Args
+int nsmall       = 200;
+int large_frames = 16384;
+int small_frames = 2;
+int interval     = 32;
+int backlog      = 64;
+
+constexpr int FRAME_SIZE = 16384;
+
+using Scheduler = HttpPriorityScheduler<int>;
+
+struct Stream {
+  explicit Stream(int index) : node(index) {}
+
+  Scheduler::Node node;
+  int             arrival = 0;  ///< Tick the response is ready to send.
+  int             frames  = 0;  ///< DATA frames left to send.
+  int             first   = -1; ///< Tick of the first frame on the wire.
+  int             last    = -1; ///< Tick of the last frame on the wire.
+};
+
+/** A connection downloading one large response, with small responses arriving while it does.
+
+    The connection puts one DATA frame on the wire each tick. The large response is the first
+    stream and, as a browser would signal for a download or a video, has a lower urgency and is
+    incremental. The small responses, as for scripts and API calls, have the default priority.
+ */
+struct Connection {
+  std::vector<std::unique_ptr<Stream>> streams;
+
+  Connection()
+  {
+    auto &large          = streams.emplace_back(std::make_unique<Stream>(0));
+    large->node.id       = 1;
+    large->node.priority = {4, true};
+    large->frames        = large_frames;
+    for (int i = 1; i <= nsmall; ++i) {
+      auto &small    = streams.emplace_back(std::make_unique<Stream>(i));
+      small->node.id = 1 + 2 * i;
+      small->arrival = i * interval;
+      small->frames  = small_frames;
+    }
+  }
+
+  /** Without priorities each response is written to the session as its data arrives.
+
+      The large response, from the cache, keeps @c backlog frames queued ahead of the wire, and a
+      small response is queued behind them.
+   */
+  uint64_t
+  run_fifo()
+  {
+    std::deque<int> queue;
+    size_t          next   = 1;
+    int             queued = 0; // Frames of the large response written so far.
+    int             tick   = 0;
+    for (; next < streams.size() || queued < large_frames || !queue.empty(); ++tick) {
+      for (; next < streams.size() && streams[next]->arrival <= tick; ++next) {
+        queue.insert(queue.end(), streams[next]->frames, static_cast<int>(next));
+      }
+      for (; queued < large_frames && queue.size() < static_cast<size_t>(backlog); ++queued) {
+        queue.push_back(0);
+      }
+      if (!queue.empty()) {
+        sent(*streams[queue.front()], tick);
+        queue.pop_front();
+      }
+    }
+    return tick;
+  }
+
+  /// With priorities the next frame is from the stream the scheduler picks when the wire is free.
+  uint64_t
+  run_scheduled()
+  {
+    Scheduler scheduler;
+    size_t    next = 1;
+    int       tick = 0;
+    scheduler.activate(streams[0]->node);
+    for (; next < streams.size() || scheduler.size() > 0; ++tick) {
+      for (; next < streams.size() && streams[next]->arrival <= tick; ++next) {
+        scheduler.activate(streams[next]->node);
+      }
+      if (Scheduler::Node *node = scheduler.top(); node != nullptr) {
+        Stream &stream = *streams[node->t];
+        sent(stream, tick);
+        if (--stream.frames == 0) {
+          scheduler.deactivate(*node);
+        } else {
+          scheduler.update(*node);
+        }
+      }
+    }
+    return tick;
+  }
+
+  void
+  sent(Stream &stream, int tick)
+  {
+    if (stream.first < 0) {
+      stream.first = tick;
+    }
+    stream.last = tick;
+  }
+
+  void
+  report(char const *policy)
+  {
+    std::vector<int> ttfb;
+    for (size_t i = 1; i < streams.size(); ++i) {
+      ttfb.push_back(streams[i]->first - streams[i]->arrival);
+    }
+    std::sort(ttfb.begin(), ttfb.end());
+    auto const pct = [&](int p) { return ttfb.empty() ? 0 : ttfb[(ttfb.size() - 1) * p / 100]; };
+    double     sum = 0;
+    for (int t : ttfb) {
+      sum += t;
+    }
+    printf("%-9s small TTFB in frames: mean %.1f p50 %d p99 %d max %d (p99 %d KiB queued ahead), large done at %d\n", policy,
+           ttfb.empty() ? 0.0 : sum / ttfb.size(), pct(50), pct(99), ttfb.empty() ? 0 : ttfb.back(), pct(99) * FRAME_SIZE / 1024,
+           streams[0]->last);
+  }
+};
+} // namespace
+
+TEST_CASE("http2 priority", "")
+{
+  char name[96];
+
+  // One pass of each outside the benchmark for the time to first byte Catch does not report.
+  {
+    Connection fifo;
+    fifo.run_fifo();
+    fifo.report("fifo");
+    Connection scheduled;
+    scheduled.run_scheduled();
+    scheduled.report("rfc9218");
+  }
+
+  snprintf(name, sizeof(name), "fifo %d frames, %d small streams", large_frames, nsmall);
+  BENCHMARK(name)
+  {
+    Connection connection;
+    return connection.run_fifo();
+  };
+
+  snprintf(name, sizeof(name), "rfc9218 %d frames, %d small streams", large_frames, nsmall);
+  BENCHMARK(name)
+  {
+    Connection connection;
+    return connection.run_scheduled();
+  };
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::Clara;
+
+  auto cli = session.cli() | Opt(nsmall, "n")["--ts-nsmall"]("number of small responses (default: 200)\n") |
+             Opt(large_frames, "n")["--ts-large-frames"]("DATA frames of the large response (default: 16384)\n") |
+             Opt(small_frames, "n")["--ts-small-frames"]("DATA frames of each small response (default: 2)\n") |
+             Opt(interval, "ticks")["--ts-interval"]("frames sent between small responses (default: 32)\n") |
+             Opt(backlog, "n")["--ts-backlog"]("frames queued ahead of the wire without priorities (default: 64)\n");
+
+  session.cli(cli);
+
+  if (int res = session.applyCommandLine(argc, argv); res != 0) {
+    return res;
+  }
+
+  return session.run();
+}
@@ -0,0 +1,164 @@
+/** @file
+
+  Micro Benchmark tool for finding the HTTP/2 stream of a frame - requires Catch2 v2.9.0+
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "proxy/http2/Http2StreamTable.h"
+#include "tscore/List.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Args
+int nstreams = 500;
+int nframes  = 100000;
+
+struct Stream {
+  Http2StreamId id     = 0;
+  uint64_t      frames = 0;
+  LINK(Stream, link);
+};
+
+/** The frames of a connection with @c nstreams long lived streams, as gRPC streaming has.
+
+    Each frame is for an open stream, picked at random. Now and then a stream closes and the client
+    opens the next one in its place.
+ */
+struct Connection {
+  std::vector<std::unique_ptr<Stream>> streams;
+  std::vector<Http2StreamId>           frames;
+  std::vector<size_t>                  reopen; ///< Which stream is replaced after each frame, or @c nstreams.
+
+  Connection()
+  {
+    std::mt19937               rng(13);
+    Http2StreamId              next = 1;
+    std::vector<Http2StreamId> open;
+    for (int i = 0; i < nstreams; ++i, next += 2) {
+      open.push_back(next);
+    }
+    for (int i = 0; i < nframes; ++i) {
+      size_t s = rng() % open.size();
+      frames.push_back(open[s]);
+      if (rng() % 100 == 0) {
+        reopen.push_back(s);
+        open[s]  = next;
+        next    += 2;
+      } else {
+        reopen.push_back(nstreams);
+      }
+    }
+  }
+
+  template <typename Open, typename Find, typename Close>
+  uint64_t
+  run(Open &&open_stream, Find &&find_stream, Close &&close_stream)
+  {
+    streams.clear();
+    Http2StreamId next = 1;
+    for (int i = 0; i < nstreams; ++i, next += 2) {
+      streams.push_back(std::make_unique<Stream>());
+      streams.back()->id = next;
+      open_stream(streams.back().get());
+    }
+
+    uint64_t found = 0;
+    for (size_t i = 0; i < frames.size(); ++i) {
+      if (Stream *s = find_stream(frames[i]); s != nullptr) {
+        ++s->frames;
+        ++found;
+      }
+      if (size_t r = reopen[i]; r < streams.size()) {
+        close_stream(streams[r].get());
+        streams[r]->id  = next;
+        next           += 2;
+        open_stream(streams[r].get());
+      }
+    }
+    return found;
+  }
+};
+} // namespace
+
+TEST_CASE("stream lookup", "")
+{
+  Connection connection;
+  char       name[64];
+
+  snprintf(name, sizeof(name), "stream list %d streams", nstreams);
+  BENCHMARK(name)
+  {
+    Queue<Stream> list;
+    return connection.run([&](Stream *s) -> void { list.enqueue(s); },
+                          [&](Http2StreamId id) -> Stream * {
+                            for (Stream *s = list.head; s; s = s->link.next) {
+                              if (s->id == id) {
+                                return s;
+                              }
+                            }
+                            return nullptr;
+                          },
+                          [&](Stream *s) -> void { list.remove(s); });
+  };
+
+  snprintf(name, sizeof(name), "stream table %d streams", nstreams);
+  BENCHMARK(name)
+  {
+    Queue<Stream>            list;
+    Http2StreamTable<Stream> table;
+    return connection.run(
+      [&](Stream *s) -> void {
+        list.enqueue(s);
+        table.insert(s->id, s);
+      },
+      [&](Http2StreamId id) -> Stream * { return table.find(id); },
+      [&](Stream *s) -> void {
+        list.remove(s);
+        table.erase(s->id);
+      });
+  };
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::Clara;
+
+  auto cli = session.cli() | Opt(nstreams, "n")["--ts-nstreams"]("number of concurrent streams (default: 500)\n") |
+             Opt(nframes, "n")["--ts-nframes"]("number of frames received (default: 100000)\n");
+
+  session.cli(cli);
+
+  if (int res = session.applyCommandLine(argc, argv); res != 0) {
+    return res;
+  }
+
+  return session.run();
+}
@@ -0,0 +1,390 @@
+/** @file
+
+  Micro benchmark of socket throughput over loopback TCP, comparing the two ways
+  an ET_NET thread can drive its sockets: epoll readiness with readv and writev,
+  and io_uring with a multishot receive into a ring of provided buffers and
+  sendmsg operations submitted in one batch per loop. One thread runs both ends
+  of every connection, so the numbers measure the per byte and per call cost of
+  the I/O path rather than the scheduler.
+
+  Run once per backend to compare them:
+  ```
+  $ ./benchmark_Loopback --ts-backend epoll --ts-conns 16
+  $ ./benchmark_Loopback --ts-backend io_uring --ts-conns 16
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "tscore/ink_config.h"
+#include "tscore/ink_hrtime.h"
+
+#if TS_USE_LINUX_IO_URING
+#include "iocore/io_uring/IO_URING.h"
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace
+{
+// Args
+struct Conf {
+  std::string backend    = "epoll";
+  int         conns      = 16;
+  int         mb         = 64;
+  int         write_size = 65536;
+  int         buffers    = 1024;
+  int         buf_size   = 16384;
+};
+
+Conf conf;
+
+constexpr int IOV_COUNT = 4;
+
+struct Pair {
+  int                wfd     = -1;
+  int                rfd     = -1;
+  int64_t            to_send = 0;
+  int64_t            to_recv = 0;
+  std::vector<char>  out;
+  std::vector<char>  in;
+  std::vector<iovec> wiov;
+  std::vector<iovec> riov;
+  msghdr             msg = {};
+};
+
+std::vector<Pair> pairs;
+
+void
+set_nonblocking(int fd)
+{
+  REQUIRE(fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) == 0);
+}
+
+void
+connect_pairs()
+{
+  int lfd = socket(AF_INET, SOCK_STREAM, 0);
+  REQUIRE(lfd >= 0);
+  sockaddr_in addr{};
+  addr.sin_family      = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t len        = sizeof(addr);
+  REQUIRE(bind(lfd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+  REQUIRE(listen(lfd, conf.conns) == 0);
+  REQUIRE(getsockname(lfd, reinterpret_cast<sockaddr *>(&addr), &len) == 0);
+
+  pairs.resize(conf.conns);
+  for (auto &p : pairs) {
+    p.wfd = socket(AF_INET, SOCK_STREAM, 0);
+    REQUIRE(connect(p.wfd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+    p.rfd   = accept(lfd, nullptr, nullptr);
+    int one = 1;
+    REQUIRE(p.rfd >= 0);
+    setsockopt(p.wfd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    set_nonblocking(p.wfd);
+    set_nonblocking(p.rfd);
+
+    // The writer cycles through a few blocks of the write size, as a response body spread over
+    // IOBuffer blocks would.
+    p.out.assign(static_cast<size_t>(conf.write_size) * IOV_COUNT, 'x');
+    p.in.resize(static_cast<size_t>(conf.buf_size) * IOV_COUNT);
+    for (int i = 0; i < IOV_COUNT; ++i) {
+      p.wiov.push_back({p.out.data() + i * conf.write_size, static_cast<size_t>(conf.write_size)});
+      p.riov.push_back({p.in.data() + i * conf.buf_size, static_cast<size_t>(conf.buf_size)});
+    }
+  }
+  close(lfd);
+}
+
+void
+close_pairs()
+{
+  for (auto &p : pairs) {
+    close(p.wfd);
+    close(p.rfd);
+  }
+  pairs.clear();
+}
+
+void
+reset_pairs()
+{
+  for (auto &p : pairs) {
+    p.to_send = static_cast<int64_t>(conf.mb) * 1024 * 1024;
+    p.to_recv = p.to_send;
+  }
+}
+
+// The iovec to send next, trimmed to what is left.
+int
+fill_send_iov(Pair &p, iovec *iov)
+{
+  int     n    = 0;
+  int64_t left = p.to_send;
+  for (; n < IOV_COUNT && left > 0; ++n) {
+    int64_t l = std::min<int64_t>(left, p.wiov[n].iov_len);
+    iov[n]    = {p.wiov[n].iov_base, static_cast<size_t>(l)};
+    left     -= l;
+  }
+  return n;
+}
+
+//
+// epoll readiness with readv and writev
+//
+
+int64_t
+run_epoll()
+{
+  reset_pairs();
+  int efd = epoll_create1(0);
+  REQUIRE(efd >= 0);
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    epoll_event ev{};
+    ev.events   = EPOLLOUT | EPOLLET;
+    ev.data.u64 = i << 1;
+    epoll_ctl(efd, EPOLL_CTL_ADD, pairs[i].wfd, &ev);
+    ev.events   = EPOLLIN | EPOLLET;
+    ev.data.u64 = (i << 1) | 1;
+    epoll_ctl(efd, EPOLL_CTL_ADD, pairs[i].rfd, &ev);
+  }
+
+  int64_t     received = 0;
+  int64_t     total    = static_cast<int64_t>(conf.mb) * 1024 * 1024 * conf.conns;
+  epoll_event events[256];
+  while (received < total) {
+    int n = epoll_wait(efd, events, 256, 1000);
+    REQUIRE(n > 0);
+    for (int e = 0; e < n; ++e) {
+      Pair &p = pairs[events[e].data.u64 >> 1];
+      if (events[e].data.u64 & 1) {
+        ssize_t r;
+        while ((r = readv(p.rfd, p.riov.data(), IOV_COUNT)) > 0) {
+          p.to_recv -= r;
+          received  += r;
+        }
+        REQUIRE((r < 0 && errno == EAGAIN));
+      } else {
+        iovec   iov[IOV_COUNT];
+        int     niov;
+        ssize_t r = 0;
+        while ((niov = fill_send_iov(p, iov)) > 0 && (r = writev(p.wfd, iov, niov)) > 0) {
+          p.to_send -= r;
+        }
+        REQUIRE((p.to_send == 0 || (r < 0 && errno == EAGAIN)));
+      }
+    }
+  }
+  close(efd);
+  return received;
+}
+
+//
+// io_uring multishot receive and batched sends
+//
+
+#if TS_USE_LINUX_IO_URING
+constexpr int BUFFER_GROUP = 0;
+
+struct UringState {
+  IOUringContext    *ctx      = nullptr;
+  io_uring_buf_ring *br       = nullptr;
+  unsigned           entries  = 0;
+  std::vector<char>  buffers;
+  int64_t            received = 0;
+
+  void
+  provide(unsigned bid)
+  {
+    io_uring_buf_ring_add(br, buffers.data() + static_cast<size_t>(bid) * conf.buf_size, conf.buf_size, bid,
+                          io_uring_buf_ring_mask(entries), 0);
+    io_uring_buf_ring_advance(br, 1);
+  }
+};
+
+UringState uring;
+
+struct RecvOp : public IOUringCompletionHandler {
+  Pair *p = nullptr;
+
+  void
+  arm()
+  {
+    io_uring_sqe *sqe = uring.ctx->next_sqe(this);
+    REQUIRE(sqe != nullptr);
+    io_uring_prep_recv_multishot(sqe, p->rfd, nullptr, 0, 0);
+    sqe->flags    |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group = BUFFER_GROUP;
+  }
+
+  void
+  handle_complete(io_uring_cqe *cqe) override
+  {
+    if (cqe->flags & IORING_CQE_F_BUFFER) {
+      uring.provide(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+    }
+    if (cqe->res > 0) {
+      p->to_recv     -= cqe->res;
+      uring.received += cqe->res;
+    } else {
+      REQUIRE(cqe->res == -ENOBUFS);
+    }
+    if (!(cqe->flags & IORING_CQE_F_MORE) && p->to_recv > 0) {
+      arm();
+    }
+  }
+};
+
+struct SendOp : public IOUringCompletionHandler {
+  Pair *p = nullptr;
+  iovec iov[IOV_COUNT];
+
+  void
+  submit()
+  {
+    int niov = fill_send_iov(*p, iov);
+    if (niov == 0) {
+      return;
+    }
+    io_uring_sqe *sqe = uring.ctx->next_sqe(this);
+    REQUIRE(sqe != nullptr);
+    p->msg            = {};
+    p->msg.msg_iov    = iov;
+    p->msg.msg_iovlen = niov;
+    io_uring_prep_sendmsg(sqe, p->wfd, &p->msg, 0);
+  }
+
+  void
+  handle_complete(io_uring_cqe *cqe) override
+  {
+    REQUIRE(cqe->res > 0);
+    p->to_send -= cqe->res;
+    submit();
+  }
+};
+
+int64_t
+run_io_uring()
+{
+  reset_pairs();
+  uring.received = 0;
+
+  std::vector<RecvOp> recvs(pairs.size());
+  std::vector<SendOp> sends(pairs.size());
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    recvs[i].p = &pairs[i];
+    sends[i].p = &pairs[i];
+    recvs[i].arm();
+    sends[i].submit();
+  }
+
+  int64_t total = static_cast<int64_t>(conf.mb) * 1024 * 1024 * conf.conns;
+  while (uring.received < total) {
+    // One submit for everything queued since the last loop, as NetHandler::waitForActivity does.
+    uring.ctx->submit_and_wait(HRTIME_MSECONDS(10));
+  }
+  return uring.received;
+}
+#endif
+
+} // namespace
+
+TEST_CASE("Loopback TCP throughput", "[bench][net]")
+{
+  connect_pairs();
+
+  if (conf.backend == "epoll") {
+    BENCHMARK("epoll readv/writev")
+    {
+      return run_epoll();
+    };
+  }
+#if TS_USE_LINUX_IO_URING
+  if (conf.backend == "io_uring") {
+    uring.ctx     = IOUringContext::local_context();
+    uring.entries = 1;
+    while (uring.entries * 2 <= static_cast<unsigned>(conf.buffers)) {
+      uring.entries *= 2;
+    }
+    uring.buffers.resize(static_cast<size_t>(uring.entries) * conf.buf_size);
+    uring.br = uring.ctx->setup_buf_ring(uring.entries, BUFFER_GROUP);
+    if (uring.br == nullptr) {
+      SKIP("provided buffer rings are not supported by this kernel");
+    }
+    for (unsigned bid = 0; bid < uring.entries; ++bid) {
+      uring.provide(bid);
+    }
+
+    BENCHMARK("io_uring multishot recv/batched sendmsg")
+    {
+      return run_io_uring();
+    };
+
+    uring.ctx->free_buf_ring(uring.br, uring.entries, BUFFER_GROUP);
+  }
+#endif
+
+  close_pairs();
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::Clara;
+
+  // clang-format off
+  auto cli = session.cli() |
+    Opt(conf.backend, "")["--ts-backend"]("socket I/O, epoll or io_uring (default: epoll)") |
+    Opt(conf.conns, "")["--ts-conns"]("number of connections (default: 16)") |
+    Opt(conf.mb, "")["--ts-mb"]("MiB sent over each connection per run (default: 64)") |
+    Opt(conf.write_size, "")["--ts-write-size"]("bytes in each of the blocks a write sends (default: 65536)") |
+    Opt(conf.buffers, "")["--ts-buffers"]("provided receive buffers for io_uring (default: 1024)") |
+    Opt(conf.buf_size, "")["--ts-buffer-size"]("bytes per receive buffer (default: 16384)");
+  // clang-format on
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  return session.run();
+}
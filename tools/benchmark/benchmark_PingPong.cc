@@ -0,0 +1,141 @@
+/** @file
+
+  Micro Benchmark tool for cross thread event hand offs - requires Catch2 v2.9.0+
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/reporters/catch_reporter_event_listener.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+#include <catch2/interfaces/catch_interfaces_config.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "iocore/eventsystem/Continuation.h"
+#include "iocore/eventsystem/EventSystem.h"
+#include "iocore/eventsystem/Lock.h"
+
+#include "iocore/utils/diags.i"
+
+#include "tscore/Layout.h"
+#include "tscore/TSSystemState.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+// Args
+int nrounds = 10000;
+
+/** One side of the exchange.
+
+    Each side has its own mutex, so the peer can run as soon as it is scheduled rather than retry
+    for a lock still held by the side that scheduled it.
+ */
+struct Side : public Continuation {
+  Side() : Continuation(new_ProxyMutex()) { SET_HANDLER(&Side::event_handler); }
+
+  int
+  event_handler(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+  {
+    if (counts && --remaining <= 0) {
+      done = true;
+    } else {
+      thread->schedule_imm(peer);
+    }
+    return 0;
+  }
+
+  Side    *peer   = nullptr;
+  EThread *thread = nullptr; ///< The thread the peer runs on.
+  bool     counts = false;   ///< Count a round trip each time this side runs.
+
+  static inline std::atomic<int>  remaining{0};
+  static inline std::atomic<bool> done{false};
+};
+} // namespace
+
+TEST_CASE("cross thread ping pong", "")
+{
+  Side ping;
+  Side pong;
+
+  // Each side runs on its own ET_CALL thread and schedules the other one there, waking it.
+  ping.peer   = &pong;
+  ping.thread = eventProcessor.thread_group[ET_CALL]._thread[1];
+  ping.counts = true;
+  pong.peer   = &ping;
+  pong.thread = eventProcessor.thread_group[ET_CALL]._thread[0];
+
+  char name[64];
+  snprintf(name, sizeof(name), "round trips = %d", nrounds);
+
+  BENCHMARK(name)
+  {
+    Side::remaining = nrounds;
+    Side::done      = false;
+    pong.thread->schedule_imm(&ping);
+    while (!Side::done) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  };
+}
+
+struct EventProcessorListener : Catch::EventListenerBase {
+  using EventListenerBase::EventListenerBase;
+
+  void
+  testRunStarting(Catch::TestRunInfo const & /* testRunInfo ATS_UNUSED */) override
+  {
+    Layout::create();
+    init_diags("", nullptr);
+    RecProcessInit();
+
+    ink_event_system_init(EVENT_SYSTEM_MODULE_PUBLIC_VERSION);
+    eventProcessor.start(2, 1048576); // Hardcoded stacksize at 1MB
+
+    EThread *main_thread = new EThread;
+    main_thread->set_specific();
+
+    TSSystemState::initialization_done();
+  }
+};
+
+CATCH_REGISTER_LISTENER(EventProcessorListener);
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::Clara;
+
+  auto cli = session.cli() | Opt(nrounds, "n")["--ts-nrounds"]("number of round trips per sample (default: 10000)\n");
+
+  session.cli(cli);
+
+  if (int res = session.applyCommandLine(argc, argv); res != 0) {
+    return res;
+  }
+
+  return session.run();
+}
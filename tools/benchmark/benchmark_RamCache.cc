@@ -0,0 +1,195 @@
+/** @file
+
+  Micro benchmark of RAM cache hits under contention: N threads looking up a
+  small hot set that lives in a single stripe. The baseline is one RAM cache
+  behind one mutex, as every lookup is serialized on the stripe mutex today.
+  It is compared against the sharded RAM cache, which needs no outer lock.
+
+  - e.g. 16 threads, 64 hot objects, 16 shards
+  ```
+  $ ./benchmark_RamCache --ts-nthreads 16 --ts-nloop 10000 --ts-hot 64 --ts-shards 16
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "P_CacheDisk.h"
+#include "P_CacheInternal.h"
+#include "P_RamCache.h"
+#include "StripeSM.h"
+
+#include "iocore/eventsystem/EventSystem.h"
+#include "iocore/utils/diags.i"
+
+#include "tscore/Layout.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+extern void register_cache_stats(CacheStatsBlock *rsb, const std::string &prefix);
+
+namespace
+{
+// Args
+struct Conf {
+  int nloop    = 1000;
+  int nthreads = 1;
+  int nhot     = 64;
+  int nshards  = 16;
+};
+
+Conf conf;
+
+constexpr int64_t RAM_CACHE_SIZE = 16 * 1024 * 1024;
+constexpr int     OBJECT_SIZE    = 8 * 1024;
+
+std::vector<CryptoHash>
+hot_set()
+{
+  std::vector<CryptoHash> keys(conf.nhot);
+  for (int i = 0; i < conf.nhot; ++i) {
+    CryptoContext().hash_immediate(keys[i], &i, sizeof(i));
+  }
+  return keys;
+}
+
+void
+fill(RamCache &cache, StripeSM *stripe, std::vector<CryptoHash> &keys)
+{
+  cache.init(RAM_CACHE_SIZE, stripe);
+  for (auto &key : keys) {
+    Ptr<IOBufferData> data{new_IOBufferData(iobuffer_size_to_index(OBJECT_SIZE, MAX_BUFFER_SIZE_INDEX), MEMALIGNED)};
+    cache.put(&key, data.get(), OBJECT_SIZE);
+  }
+}
+
+/// Every thread walks the hot set from its own starting point, @a lookup does one get().
+template <typename F>
+int
+run(std::vector<CryptoHash> &keys, F const &lookup)
+{
+  std::vector<std::thread> threads;
+  std::atomic<int>         hits = 0;
+
+  for (int t = 0; t < conf.nthreads; ++t) {
+    threads.emplace_back([&, t]() {
+      int h = 0;
+      for (int i = 0; i < conf.nloop; ++i) {
+        h += lookup(&keys[(t + i) % keys.size()]);
+      }
+      hits += h;
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return hits;
+}
+
+} // namespace
+
+TEST_CASE("RAM cache hits under contention", "[bench][ram_cache]")
+{
+  // A minimal stripe, enough for the RAM cache stats.
+  CacheDisk disk;
+  disk.path                = static_cast<char *>(ats_malloc(1));
+  disk.path[0]             = '\0';
+  disk.disk_stripes        = static_cast<DiskStripe **>(ats_malloc(sizeof(DiskStripe *)));
+  disk.disk_stripes[0]     = nullptr;
+  disk.header              = static_cast<DiskHeader *>(ats_malloc(sizeof(DiskHeader)));
+  disk.header->num_volumes = 0;
+  CacheVol vol;
+  register_cache_stats(&vol.vol_rsb, "proxy.process.cache.volume_0");
+  StripeSM stripe{&disk, 10, 0};
+  stripe.cache_vol = &vol;
+
+  cache_config_ram_cache_use_seen_filter = 0;
+  auto keys                              = hot_set();
+  int  expected                          = conf.nthreads * conf.nloop;
+
+  std::unique_ptr<RamCache> single{new_RamCacheLRU()};
+  std::unique_ptr<RamCache> sharded{new_RamCacheSharded(new_RamCacheLRU, conf.nshards)};
+  fill(*single, &stripe, keys);
+  fill(*sharded, &stripe, keys);
+
+  std::mutex stripe_mutex;
+  auto       locked = [&](CryptoHash *key) {
+    Ptr<IOBufferData> data;
+    std::lock_guard   lock(stripe_mutex);
+    return single->get(key, &data);
+  };
+  auto unlocked = [&](CryptoHash *key) {
+    Ptr<IOBufferData> data;
+    return sharded->get(key, &data);
+  };
+
+  REQUIRE(run(keys, locked) == expected);
+  REQUIRE(run(keys, unlocked) == expected);
+
+  BENCHMARK("stripe mutex")
+  {
+    return run(keys, locked);
+  };
+  BENCHMARK("sharded")
+  {
+    return run(keys, unlocked);
+  };
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::Clara;
+
+  // clang-format off
+  auto cli = session.cli() |
+    Opt(conf.nthreads, "")["--ts-nthreads"]("number of threads (default: 1)") |
+    Opt(conf.nloop, "")["--ts-nloop"]("number of lookups per thread (default: 1000)") |
+    Opt(conf.nhot, "")["--ts-hot"]("number of hot objects (default: 64)") |
+    Opt(conf.nshards, "")["--ts-shards"]("number of RAM cache shards (default: 16)");
+  // clang-format on
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  Layout::create();
+  init_diags("", nullptr);
+  RecProcessInit();
+  ink_event_system_init(EVENT_SYSTEM_MODULE_PUBLIC_VERSION);
+  EThread *main_thread = new EThread;
+  main_thread->set_specific();
+  register_cache_stats(&cache_rsb, "proxy.process.cache");
+
+  return session.run();
+}
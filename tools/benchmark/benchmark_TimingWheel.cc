@@ -0,0 +1,197 @@
+/** @file
+
+  Micro Benchmark tool for the timing wheel - requires Catch2 v2.9.0+
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "iocore/eventsystem/TimingWheel.h"
+#include "tscore/List.h"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Args
+int ntimers = 1000000;
+int span    = 120; // seconds
+
+struct Timer {
+  TimingWheelEntry entry;
+  ink_hrtime       when = 0;
+  LINK(Timer, link);
+};
+
+using Wheel = TimingWheel<Timer, &Timer::entry>;
+using Map   = std::multimap<ink_hrtime, Timer *>;
+
+constexpr ink_hrtime START = HRTIME_SECONDS(1000);
+
+std::vector<Timer>
+make_timers()
+{
+  std::vector<Timer>                        timers(ntimers);
+  std::mt19937_64                           rng(13);
+  std::uniform_int_distribution<ink_hrtime> dist(1, HRTIME_SECONDS(span));
+  for (auto &t : timers) {
+    t.when = START + dist(rng);
+  }
+  return timers;
+}
+} // namespace
+
+TEST_CASE("timing wheel", "")
+{
+  auto timers = make_timers();
+  char name[64];
+
+  snprintf(name, sizeof(name), "schedule + cancel %d", ntimers);
+  BENCHMARK(name)
+  {
+    auto wheel = std::make_unique<Wheel>(HRTIME_MSECOND, START);
+    for (auto &t : timers) {
+      wheel->schedule(&t, t.when);
+    }
+    for (auto &t : timers) {
+      wheel->cancel(&t);
+    }
+    return wheel->size();
+  };
+
+  snprintf(name, sizeof(name), "reschedule %d", ntimers);
+  BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter)
+  {
+    auto wheel = std::make_unique<Wheel>(HRTIME_MSECOND, START);
+    for (auto &t : timers) {
+      wheel->schedule(&t, t.when);
+    }
+    // As an inactivity timeout is pushed back on each read.
+    ink_hrtime later = 0;
+    meter.measure([&]() -> size_t {
+      later += HRTIME_SECOND;
+      for (auto &t : timers) {
+        wheel->cancel(&t);
+        wheel->schedule(&t, t.when + later);
+      }
+      return wheel->size();
+    });
+    for (auto &t : timers) {
+      wheel->cancel(&t);
+    }
+  };
+
+  snprintf(name, sizeof(name), "schedule + expire %d", ntimers);
+  BENCHMARK(name)
+  {
+    auto wheel = std::make_unique<Wheel>(HRTIME_MSECOND, START);
+    for (auto &t : timers) {
+      wheel->schedule(&t, t.when);
+    }
+    // Advance a millisecond at a time, as a busy event loop does.
+    size_t expired = 0;
+    for (ink_hrtime now = START; wheel->size() > 0; now += HRTIME_MSECOND) {
+      wheel->advance(now);
+      while (wheel->pop_expired()) {
+        ++expired;
+      }
+    }
+    return expired;
+  };
+}
+
+TEST_CASE("ordered map", "")
+{
+  auto                       timers = make_timers();
+  std::vector<Map::iterator> where(timers.size());
+  char                       name[64];
+
+  snprintf(name, sizeof(name), "schedule + cancel %d", ntimers);
+  BENCHMARK(name)
+  {
+    Map map;
+    for (size_t i = 0; i < timers.size(); ++i) {
+      where[i] = map.emplace(timers[i].when, &timers[i]);
+    }
+    for (size_t i = 0; i < timers.size(); ++i) {
+      map.erase(where[i]);
+    }
+    return map.size();
+  };
+
+  snprintf(name, sizeof(name), "reschedule %d", ntimers);
+  BENCHMARK_ADVANCED(name)(Catch::Benchmark::Chronometer meter)
+  {
+    Map map;
+    for (size_t i = 0; i < timers.size(); ++i) {
+      where[i] = map.emplace(timers[i].when, &timers[i]);
+    }
+    ink_hrtime later = 0;
+    meter.measure([&]() -> size_t {
+      later += HRTIME_SECOND;
+      for (size_t i = 0; i < timers.size(); ++i) {
+        map.erase(where[i]);
+        where[i] = map.emplace(timers[i].when + later, &timers[i]);
+      }
+      return map.size();
+    });
+  };
+
+  snprintf(name, sizeof(name), "schedule + expire %d", ntimers);
+  BENCHMARK(name)
+  {
+    Map map;
+    for (auto &t : timers) {
+      map.emplace(t.when, &t);
+    }
+    size_t expired = 0;
+    for (ink_hrtime now = START; !map.empty(); now += HRTIME_MSECOND) {
+      while (!map.empty() && map.begin()->first <= now) {
+        map.erase(map.begin());
+        ++expired;
+      }
+    }
+    return expired;
+  };
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::Clara;
+
+  auto cli = session.cli() | Opt(ntimers, "n")["--ts-ntimers"]("number of timers (default: 1000000)\n") |
+             Opt(span, "seconds")["--ts-span"]("timers are spread over this many seconds (default: 120)\n");
+
+  session.cli(cli);
+
+  if (int res = session.applyCommandLine(argc, argv); res != 0) {
+    return res;
+  }
+
+  return session.run();
+}